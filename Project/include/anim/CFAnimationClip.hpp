@@ -0,0 +1,65 @@
+﻿/**	@file	CFAnimationClip.hpp
+ *	@brief	等間隔標本化されたアニメーションクリップ
+ */
+#pragma once
+#include "math/CFVector3.hpp"
+#include "math/CFQuaternion.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFAnimationClip
+	 *	@brief	等間隔標本化されたアニメーションクリップ
+	 *	@note	キーはトラック毎に連続して並ぶ (track * frameCount + frame)。
+	 */
+	class CFAnimationClip final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFAnimationClip(CFAnimationClip&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFAnimationClip(CFAnimationClip const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFAnimationClip& operator=(CFAnimationClip&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFAnimationClip& operator=(CFAnimationClip const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFAnimationClip() noexcept;
+		//!	@brief	デストラクタ
+		~CFAnimationClip() noexcept = default;
+
+		//!	@brief	初期化関数
+		CFAnimationClip& init(unsigned int const& trackCount, unsigned int const& frameCount, float const& frameRate);
+
+		//!	@brief	回転量取得関数
+		CFQuaternion& rotation(unsigned int const& track, unsigned int const& frame) noexcept;
+		//!	@brief	回転量取得関数
+		CFQuaternion const& rotation(unsigned int const& track, unsigned int const& frame) const noexcept;
+		//!	@brief	移動量取得関数
+		CFVector3& translation(unsigned int const& track, unsigned int const& frame) noexcept;
+		//!	@brief	移動量取得関数
+		CFVector3 const& translation(unsigned int const& track, unsigned int const& frame) const noexcept;
+
+		//!	@brief	トラック数取得関数
+		unsigned int const trackCount() const noexcept;
+		//!	@brief	フレーム数取得関数
+		unsigned int const frameCount() const noexcept;
+		//!	@brief	フレームレート取得関数
+		float const frameRate() const noexcept;
+		//!	@brief	再生時間取得関数
+		float const duration() const noexcept;
+		//!	@brief	未圧縮時のデータ量取得関数
+		size_t const byteSize() const noexcept;
+
+	private	:
+		//!	@brief	トラック数
+		unsigned int m_trackCount;
+		//!	@brief	フレーム数
+		unsigned int m_frameCount;
+		//!	@brief	フレームレート
+		float m_frameRate;
+		//!	@brief	回転量
+		std::vector<CFQuaternion> m_rotations;
+		//!	@brief	移動量
+		std::vector<CFVector3> m_translations;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+﻿/**	@file	CFCompressedClip.hpp
+ *	@brief	圧縮済みアニメーションクリップ
+ */
+#pragma once
+#include "SQuantized3.hpp"
+#include "CFAnimationClip.hpp"
+#include "CFPoseSoA.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@struct	SClipCompressionReport
+	 *	@brief	クリップ圧縮結果の報告
+	 */
+	struct SClipCompressionReport final {
+		//!	@brief	未圧縮時のデータ量 (byte)
+		size_t rawBytes;
+		//!	@brief	圧縮後のデータ量 (byte)
+		size_t compressedBytes;
+		//!	@brief	圧縮率 (未圧縮時 / 圧縮後)
+		float ratio;
+		//!	@brief	回転量の最大誤差 (弧度法)
+		float maxRotationError;
+		//!	@brief	移動量の最大誤差
+		float maxTranslationError;
+		//!	@brief	回転キー数
+		unsigned int rotationKeys;
+		//!	@brief	移動キー数
+		unsigned int translationKeys;
+	};
+
+	/**	@class	CFCompressedClip
+	 *	@brief	圧縮済みアニメーションクリップ
+	 *	@note	回転量は最大成分を省略した 48 bit の四元数 (最小三成分圧縮)、
+	 *			移動量はトラック毎の範囲で正規化した 16 bit 固定小数点数で保持する。
+	 *			キーは許容誤差を超えない範囲でトラック毎に間引かれる。
+	 *			フレーム番号を 16 bit で保持する為、フレーム数は 65536 未満に限る。
+	 */
+	class CFCompressedClip final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFCompressedClip(CFCompressedClip&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFCompressedClip(CFCompressedClip const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFCompressedClip& operator=(CFCompressedClip&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFCompressedClip& operator=(CFCompressedClip const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFCompressedClip() noexcept;
+		//!	@brief	デストラクタ
+		~CFCompressedClip() noexcept = default;
+
+		/**	@brief	圧縮関数
+		 *	@param[in] clip 圧縮対象のクリップ
+		 *	@param[in] rotTolerance 回転量の許容誤差 (弧度法)
+		 *	@param[in] posTolerance 移動量の許容誤差
+		 */
+		CFCompressedClip& compress(CFAnimationClip const& clip, float const& rotTolerance, float const& posTolerance);
+
+		/**	@brief	標本化関数
+		 *	@param[in] time 再生時刻 (秒)
+		 *	@param[out] pose 出力先の姿勢 (trackCount() 以上の関節数で初期化済みであること)
+		 */
+		void sample(float const& time, CFPoseSoA& pose) const noexcept;
+
+		//!	@brief	圧縮結果の報告生成関数
+		SClipCompressionReport const report(CFAnimationClip const&) const;
+
+		//!	@brief	トラック数取得関数
+		unsigned int const trackCount() const noexcept;
+		//!	@brief	フレーム数取得関数
+		unsigned int const frameCount() const noexcept;
+		//!	@brief	フレームレート取得関数
+		float const frameRate() const noexcept;
+		//!	@brief	圧縮後のデータ量取得関数
+		size_t const byteSize() const noexcept;
+
+	private	:
+		//!	@brief	トラック数
+		unsigned int m_trackCount;
+		//!	@brief	フレーム数
+		unsigned int m_frameCount;
+		//!	@brief	フレームレート
+		float m_frameRate;
+		//!	@brief	各トラックの回転キーの開始位置
+		std::vector<unsigned int> m_rotOffsets;
+		//!	@brief	回転キーのフレーム番号
+		std::vector<unsigned short> m_rotFrames;
+		//!	@brief	回転キー
+		std::vector<SQuantized3> m_rotKeys;
+		//!	@brief	各トラックの移動キーの開始位置
+		std::vector<unsigned int> m_posOffsets;
+		//!	@brief	移動キーのフレーム番号
+		std::vector<unsigned short> m_posFrames;
+		//!	@brief	移動キー
+		std::vector<SQuantized3> m_posKeys;
+		//!	@brief	各トラックの移動量の最小値
+		std::vector<float> m_posMin;
+		//!	@brief	各トラックの移動量の量子化幅
+		std::vector<float> m_posScale;
+	};
+}
\ No newline at end of file
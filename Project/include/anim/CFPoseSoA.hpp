@@ -0,0 +1,64 @@
+﻿/**	@file	CFPoseSoA.hpp
+ *	@brief	単精度浮動小数点数型の SoA 形式姿勢
+ */
+#pragma once
+#include "EPoseChannel.hpp"
+#include "math/CFVector3.hpp"
+#include "math/CFQuaternion.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFPoseSoA
+	 *	@brief	単精度浮動小数点数型の SoA 形式姿勢
+	 *	@note	各チャンネルは SIMD 幅 (LANE_CNT) の倍数まで確保される為、
+	 *			末尾の余剰要素へ書き込んでも安全である。
+	 */
+	class CFPoseSoA final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFPoseSoA(CFPoseSoA&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFPoseSoA(CFPoseSoA const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFPoseSoA& operator=(CFPoseSoA&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFPoseSoA& operator=(CFPoseSoA const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFPoseSoA() noexcept;
+		//!	@brief	デストラクタ
+		~CFPoseSoA() noexcept = default;
+
+		//!	@brief	初期化関数
+		CFPoseSoA& init(unsigned int const& count);
+
+		//!	@brief	関節数取得関数
+		unsigned int const size() const noexcept;
+		//!	@brief	確保済み要素数取得関数
+		unsigned int const capacity() const noexcept;
+
+		//!	@brief	チャンネル取得関数
+		float* const channel(EPoseChannel const&) noexcept;
+		//!	@brief	チャンネル取得関数
+		float const* const channel(EPoseChannel const&) const noexcept;
+
+		//!	@brief	回転量設定関数
+		CFPoseSoA& rotation(unsigned int const&, CFQuaternion const&) noexcept;
+		//!	@brief	移動量設定関数
+		CFPoseSoA& translation(unsigned int const&, CFVector3 const&) noexcept;
+
+		//!	@brief	回転量取得関数
+		CFQuaternion const rotation(unsigned int const&) const noexcept;
+		//!	@brief	移動量取得関数
+		CFVector3 const translation(unsigned int const&) const noexcept;
+
+	private	:
+		//!	@brief	関節数
+		unsigned int m_count;
+		//!	@brief	各チャンネルの成分
+		std::vector<float> m_channels[POSE_CHANNEL_CNT];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+﻿/**	@file	EPoseChannel.hpp
+ *	@brief	姿勢の成分チャンネル
+ */
+#pragma once
+
+namespace dlav {
+	/**	@enum	EPoseChannel
+	 *	@brief	姿勢の成分チャンネル一覧
+	 */
+	enum class EPoseChannel : unsigned char {
+		//!	@brief	回転四元数の第一成分
+		ROT_X,
+		//!	@brief	回転四元数の第二成分
+		ROT_Y,
+		//!	@brief	回転四元数の第三成分
+		ROT_Z,
+		//!	@brief	回転四元数の第四成分
+		ROT_W,
+		//!	@brief	移動量の第一成分
+		POS_X,
+		//!	@brief	移動量の第二成分
+		POS_Y,
+		//!	@brief	移動量の第三成分
+		POS_Z
+	};
+
+	//!	@brief	チャンネル数
+	static unsigned int constexpr POSE_CHANNEL_CNT = 7U;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+﻿/**	@file	SQuantized3.hpp
+ *	@brief	三つの 16 bit 量子化値を束ねた構造体
+ */
+#pragma once
+#pragma warning(disable : 4201)
+
+namespace dlav {
+	/**	@struct	SQuantized3
+	 *	@brief	三つの 16 bit 量子化値を束ねた構造体 (48 bit)
+	 *	@note	四元数の最小三成分圧縮では、第一・第二成分の最上位 bit に
+	 *			省略した最大成分の添え字を格納する。
+	 */
+	struct SQuantized3 {
+		union {
+			//!	@brief	全成分
+			unsigned short p[3U];
+			struct {
+				//!	@brief	第一成分
+				unsigned short x;
+				//!	@brief	第二成分
+				unsigned short y;
+				//!	@brief	第三成分
+				unsigned short z;
+			};
+		};
+	};
+}
\ No newline at end of file
@@ -2,30 +2,57 @@
  *	@brief	Ｎ次ベジエ曲線
  */
 #pragma once
+#include "geo/CFArcLength.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
 namespace dlav {
-	/**	@file	CBezierCurves
-	 *	@brief	Ｎ次ベジエ曲線
+	/**	@class	CBezierCurves<T>
+	 *	@brief	Ｎ次の有理ベジエ曲線
+	 *	@note	T は成分配列 p を持つ単精度浮動小数点数型ベクトルとする。
+	 *			制御点は重みを掛けた同次座標で保持し、同次座標のまま評価してから重みで割る。
+	 *			二項係数と一様な媒介変数でのバーンシュタイン基底は表として保持し、次数か分割数が変わった時のみ作り直す。
+	 *			弧長表は制御点が変わった後、最初に length か locate を呼んだ時に作り直す。
 	 */
 	template <typename T>
 	class CBezierCurves final {
 	public	:
-		template <typename T>
-		struct Vertex final {
+		//!	@brief	頂点の成分数
+		static unsigned int constexpr DIM = static_cast<unsigned int>(std::extent<decltype(T::p)>::value);
+		//!	@brief	前進差分で分割する最大の次数
+		static unsigned int constexpr FORWARD_MAX_DEGREE = 3U;
+		//!	@brief	前進差分で誤差の蓄積を抑える為に基準点を取り直す間隔
+		static unsigned int constexpr FORWARD_SPAN = 64U;
+
+		/**	@struct	SVertex
+		 *	@brief	制御点
+		 */
+		struct SVertex final {
 			//!	@brief	頂点
-			T& vertex;
+			T vertex;
 			//!	@brief	重み
-			float& weight;
+			float weight;
+		};
+
+		/**	@struct	SPoints
+		 *	@brief	成分毎に並べた点列
+		 */
+		struct SPoints final {
+			//!	@brief	成分毎の座標
+			std::vector<float> p[DIM];
 		};
+
 		//!	@brief	ムーブコンストラクタ
 		CBezierCurves<T>(CBezierCurves<T>&&) noexcept = default;
 		//!	@brief	コピーコンストラクタ
-		CBezierCurves<T>(CBezierCurves<T> const&) noexcept = default;
+		CBezierCurves<T>(CBezierCurves<T> const&) = default;
 		//!	@brief	ムーブ代入演算子
 		CBezierCurves<T>& operator=(CBezierCurves<T>&&) noexcept = default;
 		//!	@brief	コピー代入演算子
-		CBezierCurves<T>& operator=(CBezierCurves<T> const&) noexcept = default;
+		CBezierCurves<T>& operator=(CBezierCurves<T> const&) = default;
 
 		//! @brief デフォルトコンストラクタ
 		CBezierCurves() noexcept;
@@ -36,31 +63,112 @@ namespace dlav {
 		CBezierCurves<T>& add(unsigned int const& index, T const& vertex, float const& weight) noexcept;
 		//!	@brief	頂点除去関数
 		CBezierCurves<T>& remove(unsigned int const& index) noexcept;
+		//!	@brief	頂点設定関数
+		CBezierCurves<T>& set(unsigned int const& index, T const& vertex, float const& weight) noexcept;
 
 		//!	@brief	添え字演算子
-		Vertex<T> const operator[](unsigned int const&) const noexcept;
-		//!	@brief	添え字演算子
-		Vertex<T> operator[](unsigned int const&) noexcept;
+		SVertex const operator[](unsigned int const&) const noexcept;
+		//!	@brief	制御点数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	次数取得関数
+		unsigned int const degree() const noexcept;
 
-		//!	@brief	補間値取得関数
+		/**	@brief	補間値取得関数
+		 *	@note	de Casteljau 法で評価する。媒介変数は [0, 1] に丸める。
+		 */
 		T const interpolate(float const&) noexcept;
+		/**	@brief	一様な媒介変数での分割関数
+		 *	@param[in] count 両端を含む点数
+		 *	@param[out] dst 成分毎の点列
+		 *	@note	基底の表との積和で八点ずつ求める。表は (次数 + 1) × count 個の要素を持ち、点数が変わると作り直す。
+		 *			次数が FORWARD_MAX_DEGREE 以下で、直前と異なる点数の場合は表を作らずに倍精度の前進差分で求める。
+		 */
+		void tessellate(size_t const& count, SPoints& dst);
+		//!	@brief	一様な媒介変数での分割関数
+		SPoints const tessellate(size_t const& count);
+
+		//!	@brief	媒介変数での微分係数取得関数
+		T const derivative(float const&) noexcept;
+		//!	@brief	全長取得関数
+		float const length();
+		/**	@brief	距離から媒介変数への変換関数
+		 *	@note	interpolate(locate(s)) で始点から弧長 s の位置が得られる。距離を等間隔に進めると等速で移動する。
+		 */
+		float const locate(float const& distance);
 
 	private	:
+		//!	@brief	同次座標の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_POINTS = 0x1U;
+		//!	@brief	二項係数と基底の表の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_DEGREE = 0x2U;
+		//!	@brief	弧長表の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_LENGTH = 0x4U;
+		//!	@brief	全ての再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_ALL = DIRTY_POINTS | DIRTY_DEGREE | DIRTY_LENGTH;
+		//!	@brief	同次座標の成分数
+		static unsigned int constexpr COMP_CNT = DIM + 1U;
+		//!	@brief	基底の表の一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+
+		//!	@brief	同次座標と二項係数の更新関数
+		void update();
+		/**	@brief	de Casteljau 法による同次座標の評価関数
+		 *	@param[out] tangent 同次座標の微分係数 (不要なら nullptr)
+		 */
+		void casteljau(double const& rate, double (&dst)[COMP_CNT], double* const tangent) noexcept;
+		//!	@brief	速さ |P'(t)| の計算関数
+		double const speed(double const& rate) noexcept;
+		//!	@brief	前進差分による分割関数
+		void forward(size_t const& count, SPoints& dst);
+		//!	@brief	基底の表による分割関数
+		void bernstein(size_t const& count, SPoints& dst);
+
 		//!	@brief	頂点
 		std::vector<T> m_vertices;
 		//!	@brief	重み
 		std::vector<float> m_rate;
-
-		//!	@brief	バーンシュタイン多項式計算関数
-		float const bern(const unsigned int& n, const unsigned int& k, const float& t) noexcept;
+		//!	@brief	重みを掛けた同次座標 (制御点毎に COMP_CNT 成分)
+		std::vector<float> m_homo;
+		//!	@brief	de Casteljau 法の作業領域
+		std::vector<double> m_work;
+		//!	@brief	二項係数
+		std::vector<double> m_binomial;
+		//!	@brief	一様な媒介変数でのバーンシュタイン基底 (制御点毎に m_stride 個)
+		std::vector<float> m_basis;
+		//!	@brief	基底の表の点数 (0 は未計算)
+		size_t m_samples;
+		//!	@brief	直前に分割した点数
+		size_t m_requested;
+		//!	@brief	基底の表の制御点毎の間隔
+		size_t m_stride;
+		//!	@brief	弧長表
+		CFArcLength m_arc;
+		//!	@brief	再計算が必要なものを示すフラグ
+		unsigned char m_dirty;
 	};
 
 	/* 実装 */
 
+	template<typename T>
+	inline CBezierCurves<T>::CBezierCurves() noexcept :
+		m_vertices(),
+		m_rate(),
+		m_homo(),
+		m_work(),
+		m_binomial(),
+		m_basis(),
+		m_samples(0U),
+		m_requested(0U),
+		m_stride(0U),
+		m_arc(),
+		m_dirty(DIRTY_ALL)
+	{}
+
 	template<typename T>
 	inline CBezierCurves<T>& CBezierCurves<T>::add(unsigned int const& index, T const& vertex, float const& weight) noexcept {
 		m_vertices.insert(m_vertices.begin() + index, vertex);
 		m_rate.insert(m_rate.begin() + index, weight);
+		m_dirty |= DIRTY_ALL;
 		return *this;
 	}
 
@@ -68,63 +176,288 @@ namespace dlav {
 	inline CBezierCurves<T>& CBezierCurves<T>::remove(unsigned int const& index) noexcept {
 		m_vertices.erase(m_vertices.begin() + index);
 		m_rate.erase(m_rate.begin() + index);
+		m_dirty |= DIRTY_ALL;
 		return *this;
 	}
 
 	template<typename T>
-	inline CBezierCurves<T>::Vertex<T> const CBezierCurves<T>::operator[](unsigned int const& idx) const noexcept {
-		CBezierCurves<T>::Vertex<T> result;
-		result.vertex = m_vertices[idx];
-		result.weight = m_rate[idx];
-		return result;
+	inline CBezierCurves<T>& CBezierCurves<T>::set(unsigned int const& index, T const& vertex, float const& weight) noexcept {
+		m_vertices[index] = vertex;
+		m_rate[index] = weight;
+		m_dirty |= DIRTY_POINTS | DIRTY_LENGTH;
+		return *this;
 	}
 
 	template<typename T>
-	inline CBezierCurves<T>::Vertex<T> CBezierCurves<T>::operator[](unsigned int const& idx) noexcept {
-		CBezierCurves<T>::Vertex<T> result;
-		result.vertex = m_vertices[idx];
-		result.weight = m_rate[idx];
-		return result;
+	inline typename CBezierCurves<T>::SVertex const CBezierCurves<T>::operator[](unsigned int const& idx) const noexcept {
+		return SVertex{ m_vertices[idx], m_rate[idx] };
+	}
+
+	template<typename T>
+	inline size_t const CBezierCurves<T>::size() const noexcept {
+		return m_vertices.size();
+	}
+
+	template<typename T>
+	inline unsigned int const CBezierCurves<T>::degree() const noexcept {
+		return m_vertices.empty() ? 0U : static_cast<unsigned int>(m_vertices.size() - 1U);
 	}
 
 	template<typename T>
 	inline T const CBezierCurves<T>::interpolate(float const& rate) noexcept {
+		T result;
+		if (m_vertices.empty()) {
+			return result;
+		}
 		if (rate <= 0.0f) {
-			return m_vertices[0];
+			return m_vertices.front();
 		}
 		if (rate >= 1.0f) {
-			return m_vertices[mContents.size() - 1];
+			return m_vertices.back();
+		}
+
+		update();
+		double homo[COMP_CNT];
+		casteljau(static_cast<double>(rate), homo, nullptr);
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			result.p[comp] = static_cast<float>(homo[comp] / homo[DIM]);
+		}
+		return result;
+	}
+
+	template<typename T>
+	inline void CBezierCurves<T>::tessellate(size_t const& count, SPoints& dst) {
+		for (auto& comp : dst.p) {
+			comp.resize(count);
+		}
+		if (count == 0U || m_vertices.empty()) {
+			return;
+		}
+		update();
+		//	一度きりの分割では表の作成が前進差分と同程度の費用となる為、同じ点数が続いた時に表を作る
+		bool once = m_samples != count && m_requested != count;
+		m_requested = count;
+		if (count < LANE_CNT || (once && degree() <= FORWARD_MAX_DEGREE)) {
+			forward(count, dst);
+		}
+		else {
+			bernstein(count, dst);
+		}
+	}
+
+	template<typename T>
+	inline typename CBezierCurves<T>::SPoints const CBezierCurves<T>::tessellate(size_t const& count) {
+		SPoints result;
+		tessellate(count, result);
+		return result;
+	}
+
+	template<typename T>
+	inline T const CBezierCurves<T>::derivative(float const& rate) noexcept {
+		T result;
+		if (m_vertices.empty()) {
+			return result;
+		}
+		update();
+		double homo[COMP_CNT];
+		double tangent[COMP_CNT];
+		casteljau(static_cast<double>(std::min(std::max(rate, 0.0f), 1.0f)), homo, tangent);
+		//	(H / w)' = (H' w - H w') / w^2
+		double iw = 1.0 / homo[DIM];
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			result.p[comp] = static_cast<float>((tangent[comp] - homo[comp] * iw * tangent[DIM]) * iw);
+		}
+		return result;
+	}
+
+	template<typename T>
+	inline float const CBezierCurves<T>::length() {
+		if (m_dirty & DIRTY_LENGTH) {
+			m_arc.clear();
+			if (m_vertices.size() > 1U) {
+				update();
+				m_arc.build([this](double const& rate) { return speed(rate); }, degree());
+			}
+			m_dirty &= static_cast<unsigned char>(~DIRTY_LENGTH);
+		}
+		return m_arc.length();
+	}
+
+	template<typename T>
+	inline float const CBezierCurves<T>::locate(float const& distance) {
+		length();
+		return m_arc.rate(distance);
+	}
+
+	template<typename T>
+	inline void CBezierCurves<T>::update() {
+		size_t cnt = m_vertices.size();
+		if (m_dirty & DIRTY_POINTS) {
+			m_homo.resize(cnt * COMP_CNT);
+			for (size_t idx = 0U; idx < cnt; ++idx) {
+				float* homo = &m_homo[idx * COMP_CNT];
+				for (unsigned int comp = 0U; comp < DIM; ++comp) {
+					homo[comp] = m_vertices[idx].p[comp] * m_rate[idx];
+				}
+				homo[DIM] = m_rate[idx];
+			}
+			m_work.resize(cnt * COMP_CNT);
+		}
+		if (m_dirty & DIRTY_DEGREE) {
+			//	パスカルの三角形で一行ずつ求める (整数除算による切り捨てが起きない)
+			m_binomial.assign(cnt, 0.0);
+			if (cnt > 0U) {
+				m_binomial[0] = 1.0;
+			}
+			for (size_t row = 1U; row < cnt; ++row) {
+				for (size_t idx = row; idx > 0U; --idx) {
+					m_binomial[idx] += m_binomial[idx - 1U];
+				}
+			}
+			m_samples = 0U;
 		}
+		m_dirty &= DIRTY_LENGTH;
+	}
 
-		T vertex;
-		float weight, temp;
-		CBezierCurves<T>::Vertex<T> arg;
-		//	ベルンシュタイン多項式を利用して座標を求める。
-		for (unsigned int idx = 0; idx < mContents.size(); idx++) {
-			arg = (*this)[idx];
-			temp = arg.weight * bern(m_vertices.size(), idx, t);
-			vertex += arg.vertex * temp;
-			weight += temp;
+	template<typename T>
+	inline void CBezierCurves<T>::casteljau(double const& rate, double (&dst)[COMP_CNT], double* const tangent) noexcept {
+		size_t cnt = m_vertices.size();
+		for (size_t idx = 0U; idx < cnt * COMP_CNT; ++idx) {
+			m_work[idx] = static_cast<double>(m_homo[idx]);
+		}
+		//	隣り合う制御点の内分を繰り返す (凸結合のみで桁落ちしない)
+		double inv = 1.0 - rate;
+		for (size_t len = cnt - 1U; len > 1U; --len) {
+			for (size_t idx = 0U; idx < len * COMP_CNT; ++idx) {
+				m_work[idx] = inv * m_work[idx] + rate * m_work[idx + COMP_CNT];
+			}
 		}
+		if (cnt < 2U) {
+			std::copy(m_work.begin(), m_work.begin() + COMP_CNT, dst);
+			if (tangent) {
+				std::fill(tangent, tangent + COMP_CNT, 0.0);
+			}
+			return;
+		}
+		//	最後に残った二点の差を次数倍すると微分係数となる
+		double order = static_cast<double>(cnt - 1U);
+		for (unsigned int comp = 0U; comp < COMP_CNT; ++comp) {
+			dst[comp] = inv * m_work[comp] + rate * m_work[comp + COMP_CNT];
+			if (tangent) {
+				tangent[comp] = order * (m_work[comp + COMP_CNT] - m_work[comp]);
+			}
+		}
+	}
 
-		return vertex / weight;
+	template<typename T>
+	inline double const CBezierCurves<T>::speed(double const& rate) noexcept {
+		double homo[COMP_CNT];
+		double tangent[COMP_CNT];
+		casteljau(rate, homo, tangent);
+		double iw = 1.0 / homo[DIM];
+		double sum = 0.0;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			double diff = (tangent[comp] - homo[comp] * iw * tangent[DIM]) * iw;
+			sum += diff * diff;
+		}
+		return std::sqrt(sum);
 	}
 
 	template<typename T>
-	inline float const CBezierCurves<T>::bern(const unsigned int& n, const unsigned int& k, const float& t) noexcept {
-		if (k > n) {
-			return 1.0f;
+	inline void CBezierCurves<T>::forward(size_t const& count, SPoints& dst) {
+		unsigned int deg = degree();
+		double step = count > 1U ? 1.0 / static_cast<double>(count - 1U) : 0.0;
+		//	差分表 (次数 + 1 段、各段 COMP_CNT 成分)
+		double diff[(FORWARD_MAX_DEGREE + 1U) * COMP_CNT];
+		std::vector<double> large;
+		double* table = diff;
+		if (deg > FORWARD_MAX_DEGREE) {
+			large.resize((deg + 1U) * COMP_CNT);
+			table = large.data();
+		}
+
+		for (size_t head = 0U; head < count; head += FORWARD_SPAN) {
+			//	基準点から次数 + 1 点を評価し、ニュートンの前進差分を作る
+			for (unsigned int ord = 0U; ord <= deg; ++ord) {
+				double homo[COMP_CNT];
+				casteljau(static_cast<double>(head + ord) * step, homo, nullptr);
+				std::copy(homo, homo + COMP_CNT, table + ord * COMP_CNT);
+			}
+			for (unsigned int ord = 1U; ord <= deg; ++ord) {
+				for (unsigned int idx = deg; idx >= ord; --idx) {
+					for (unsigned int comp = 0U; comp < COMP_CNT; ++comp) {
+						table[idx * COMP_CNT + comp] -= table[(idx - 1U) * COMP_CNT + comp];
+					}
+				}
+			}
+
+			size_t tail = std::min<size_t>(head + FORWARD_SPAN, count);
+			for (size_t idx = head; idx < tail; ++idx) {
+				double iw = 1.0 / table[DIM];
+				for (unsigned int comp = 0U; comp < DIM; ++comp) {
+					dst.p[comp][idx] = static_cast<float>(table[comp] * iw);
+				}
+				for (unsigned int ord = 0U; ord < deg; ++ord) {
+					for (unsigned int comp = 0U; comp < COMP_CNT; ++comp) {
+						table[ord * COMP_CNT + comp] += table[(ord + 1U) * COMP_CNT + comp];
+					}
+				}
+			}
 		}
-		
-		//	組み合わせを求める。
-		unsigned int tmp = 1U;
-		for (unsigned int i = 1U; i < k; i++) {
-			tmp *= (n + 1 - i) / i;
+	}
+
+	template<typename T>
+	inline void CBezierCurves<T>::bernstein(size_t const& count, SPoints& dst) {
+		size_t cnt = m_vertices.size();
+		if (m_samples != count) {
+			//	B_i(t) = C(n, i) t^i (1 - t)^(n - i) を倍精度で求めて表にする
+			m_stride = (count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT;
+			m_basis.assign(cnt * m_stride, 0.0f);
+			std::vector<double> pows(cnt);
+			double step = 1.0 / static_cast<double>(count - 1U);
+			for (size_t smp = 0U; smp < count; ++smp) {
+				double rate = static_cast<double>(smp) * step;
+				double inv = 1.0 - rate;
+				double pw = 1.0;
+				for (size_t idx = cnt; idx > 0U; --idx) {
+					pows[idx - 1U] = pw;
+					pw *= inv;
+				}
+				pw = 1.0;
+				for (size_t idx = 0U; idx < cnt; ++idx) {
+					m_basis[idx * m_stride + smp] = static_cast<float>(m_binomial[idx] * pw * pows[idx]);
+					pw *= rate;
+				}
+			}
+			m_samples = count;
 		}
 
-		//	組み合わせからベルンシュタイン多項式を求める。
-		return static_cast<float>(tmp)
-			* powf(t, static_cast<float>(k))
-			* powf((1.0f - t), static_cast<float>(n - k));
+		__m256 const one = _mm256_set1_ps(1.0f);
+		for (size_t smp = 0U; smp < count; smp += LANE_CNT) {
+			__m256 acc[COMP_CNT];
+			for (auto& lane : acc) {
+				lane = _mm256_setzero_ps();
+			}
+			for (size_t idx = 0U; idx < cnt; ++idx) {
+				__m256 basis = _mm256_loadu_ps(&m_basis[idx * m_stride + smp]);
+				float const* homo = &m_homo[idx * COMP_CNT];
+				for (unsigned int comp = 0U; comp < COMP_CNT; ++comp) {
+					acc[comp] = _mm256_fmadd_ps(basis, _mm256_set1_ps(homo[comp]), acc[comp]);
+				}
+			}
+			__m256 iw = _mm256_div_ps(one, acc[DIM]);
+			size_t rest = std::min<size_t>(count - smp, LANE_CNT);
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				__m256 val = _mm256_mul_ps(acc[comp], iw);
+				if (rest == LANE_CNT) {
+					_mm256_storeu_ps(&dst.p[comp][smp], val);
+				}
+				else {
+					alignas(32) float tail[LANE_CNT];
+					_mm256_store_ps(tail, val);
+					std::copy(tail, tail + rest, &dst.p[comp][smp]);
+				}
+			}
+		}
 	}
 }
\ No newline at end of file
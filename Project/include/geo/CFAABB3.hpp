@@ -0,0 +1,74 @@
+﻿/**	@file	CFAABB3.hpp
+ *	@brief	三次元軸並行境界箱
+ */
+#pragma once
+#include "math/EHandSide.hpp"
+#include "math/CFVector3.hpp"
+#include "math/CFMatrix4x4.hpp"
+
+namespace dlav {
+	class CFSphere3;
+
+	/**	@class	CFAABB3
+	 *	@brief	三次元軸並行境界箱
+	 *	@note	デフォルトコンストラクタは何も含まない空の箱を作り、merge で広げていく。
+	 */
+	class CFAABB3 final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFAABB3(CFAABB3&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFAABB3(CFAABB3 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFAABB3& operator=(CFAABB3&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFAABB3& operator=(CFAABB3 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ (空の箱)
+		CFAABB3() noexcept;
+		//!	@brief	デストラクタ
+		~CFAABB3() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		CFAABB3(CFVector3 const& lo, CFVector3 const& hi) noexcept;
+
+		//!	@brief	初期化関数
+		CFAABB3& init(CFVector3 const& lo, CFVector3 const& hi) noexcept;
+
+		//!	@brief	最小点取得関数
+		CFVector3 const& lower() const noexcept;
+		//!	@brief	最大点取得関数
+		CFVector3 const& upper() const noexcept;
+		//!	@brief	中心取得関数
+		CFVector3 const center() const noexcept;
+		//!	@brief	半径 (各軸方向の半分の長さ) 取得関数
+		CFVector3 const extent() const noexcept;
+		//!	@brief	空判定関数
+		bool const empty() const noexcept;
+
+		//!	@brief	点を含むよう拡張する関数
+		CFAABB3& merge(CFVector3 const&) noexcept;
+		//!	@brief	箱を含むよう拡張する関数
+		CFAABB3& merge(CFAABB3 const&) noexcept;
+
+		/**	@brief	変換関数
+		 *	@return 変換後の箱を囲む軸並行境界箱
+		 *	@note	中心を変換し、半径には線形部分の各成分の絶対値を取った行列を掛ける。
+		 *			八頂点を変換するより少ない演算で同じ結果となる。空の箱はそのまま返す。
+		 */
+		CFAABB3 const transform(EHandSide const&, CFMatrix4x4 const&) const noexcept;
+
+		//!	@brief	点の包含判定関数
+		bool const contains(CFVector3 const&) const noexcept;
+		//!	@brief	箱との交差判定関数
+		bool const overlaps(CFAABB3 const&) const noexcept;
+		//!	@brief	球との交差判定関数
+		bool const overlaps(CFSphere3 const&) const noexcept;
+
+	private	:
+		//!	@brief	最小点
+		CFVector3 m_lower;
+		//!	@brief	最大点
+		CFVector3 m_upper;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+﻿/**	@file	CFArcLength.hpp
+ *	@brief	曲線の弧長表
+ */
+#pragma once
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFArcLength
+	 *	@brief	曲線の弧長表
+	 *	@note	速さ |P'(t)| を五点のガウス・ルジャンドル求積で適応的に積分し、区間の端の媒介変数と累積弧長を表にする。
+	 *			距離から媒介変数への変換は二分探索で区間を求め、端の dt/ds を用いた三次エルミート補間で逆関数を近似する。
+	 *			表の各区間を四等分し、積分値と三つの分点での逆関数の両方が許容誤差に収まるまで分割する。
+	 */
+	class CFArcLength final {
+	public	:
+		//!	@brief	積分の相対許容誤差の既定値
+		static float constexpr TOLERANCE = 1.0e-5f;
+		//!	@brief	区間の分割の最大深さ
+		static unsigned int constexpr MAX_DEPTH = 16U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFArcLength(CFArcLength&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFArcLength(CFArcLength const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFArcLength& operator=(CFArcLength&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFArcLength& operator=(CFArcLength const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFArcLength() noexcept;
+		//!	@brief	デストラクタ
+		~CFArcLength() noexcept = default;
+
+		/**	@brief	構築関数
+		 *	@param[in] speed 媒介変数 t (double) での速さを返す関数
+		 *	@param[in] pieces 最初に等分する区間数 (曲線の次数程度)
+		 *	@param[in] tolerance 相対許容誤差
+		 */
+		template <typename F>
+		void build(F const& speed, unsigned int const& pieces, float const& tolerance = TOLERANCE);
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	空判定関数
+		bool const empty() const noexcept;
+		//!	@brief	区間数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	全長取得関数
+		float const length() const noexcept;
+		/**	@brief	距離から媒介変数への変換関数
+		 *	@note	距離は [0, length()] に丸める。区間の探索は O(log n)。
+		 */
+		float const rate(float const& distance) const noexcept;
+
+	private	:
+		/**	@brief	区間の追加関数
+		 *	@param[in] rate 区間の終端の媒介変数
+		 *	@param[in] distance 区間の弧長
+		 *	@param[in] speed 終端の速さ
+		 */
+		void append(double const& rate, double const& distance, double const& speed);
+		/**	@brief	区間の受理判定関数
+		 *	@param[in] rates 区間を四等分する五点の媒介変数
+		 *	@param[in] speeds 同じく速さ
+		 *	@param[in] quarters 四等分した各区間の弧長
+		 *	@param[in] whole 区間をより粗く積分した弧長
+		 *	@param[in] limit 弧長の許容誤差
+		 *	@note	逆関数の誤差は分点の速さを掛けて弧長の誤差に換算する。
+		 *			誤差の符号が区間内で変わると中点のみでは見逃すため、三つの分点で許容誤差の半分と比べる。
+		 */
+		static bool const accept(double const (&rates)[5], double const (&speeds)[5], double const (&quarters)[4], double const& whole, double const& limit) noexcept;
+		//!	@brief	五点のガウス・ルジャンドル求積関数
+		template <typename F>
+		static double const quadrature(F const& speed, double const& lo, double const& hi);
+
+		//!	@brief	区間の端の媒介変数
+		std::vector<float> m_rates;
+		//!	@brief	区間の端までの累積弧長
+		std::vector<float> m_lengths;
+		//!	@brief	区間の端での dt/ds (速さが 0 の場合は負)
+		std::vector<float> m_slopes;
+	};
+
+	/* 実装 */
+
+	template <typename F>
+	inline void CFArcLength::build(F const& speed, unsigned int const& pieces, float const& tolerance) {
+		clear();
+		m_rates.push_back(0.0f);
+		m_lengths.push_back(0.0f);
+		double head = speed(0.0);
+		m_slopes.push_back(head > 0.0 ? static_cast<float>(1.0 / head) : -1.0f);
+
+		struct SRange {
+			double lo;
+			double hi;
+			double whole;
+			double speeds[2];
+			unsigned int depth;
+		};
+		//	区間を後ろから積み、先頭から順に取り出して表へ追加する
+		std::vector<SRange> stack;
+		unsigned int cnt = pieces > 0U ? pieces : 1U;
+		double tail = speed(1.0);
+		double hi = 1.0;
+		for (unsigned int idx = cnt; idx > 0U; --idx) {
+			double lo = static_cast<double>(idx - 1U) / static_cast<double>(cnt);
+			double low = idx > 1U ? speed(lo) : head;
+			stack.push_back(SRange{ lo, hi, quadrature(speed, lo, hi), { low, tail }, 0U });
+			hi = lo;
+			tail = low;
+		}
+
+		double estimate = 0.0;
+		for (auto const& range : stack) {
+			estimate += range.whole;
+		}
+		double limit = static_cast<double>(tolerance) * estimate;
+		double total = 0.0;
+		while (!stack.empty()) {
+			SRange range = stack.back();
+			stack.pop_back();
+			//	表へ追加する区間そのものを四等分して検査する
+			double step = (range.hi - range.lo) * 0.25;
+			double rates[5] = { range.lo, range.lo + step, range.lo + step * 2.0, range.lo + step * 3.0, range.hi };
+			double speeds[5] = { range.speeds[0], speed(rates[1]), speed(rates[2]), speed(rates[3]), range.speeds[1] };
+			double quarters[4];
+			for (unsigned int idx = 0U; idx < 4U; ++idx) {
+				quarters[idx] = quadrature(speed, rates[idx], rates[idx + 1U]);
+			}
+			if (range.depth >= MAX_DEPTH || accept(rates, speeds, quarters, range.whole, limit)) {
+				total += (quarters[0] + quarters[1]) + (quarters[2] + quarters[3]);
+				append(range.hi, total, speeds[4]);
+				continue;
+			}
+			stack.push_back(SRange{ rates[2], range.hi, quarters[2] + quarters[3], { speeds[2], speeds[4] }, range.depth + 1U });
+			stack.push_back(SRange{ range.lo, rates[2], quarters[0] + quarters[1], { speeds[0], speeds[2] }, range.depth + 1U });
+		}
+	}
+
+	template <typename F>
+	inline double const CFArcLength::quadrature(F const& speed, double const& lo, double const& hi) {
+		static double constexpr NODES[3] = { 0.0, 0.5384693101056831, 0.9061798459386640 };
+		static double constexpr WEIGHTS[3] = { 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+		double center = (lo + hi) * 0.5;
+		double half = (hi - lo) * 0.5;
+		double sum = WEIGHTS[0] * speed(center);
+		for (unsigned int idx = 1U; idx < 3U; ++idx) {
+			sum += WEIGHTS[idx] * (speed(center - half * NODES[idx]) + speed(center + half * NODES[idx]));
+		}
+		return sum * half;
+	}
+}
\ No newline at end of file
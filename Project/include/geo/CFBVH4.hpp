@@ -0,0 +1,216 @@
+﻿/**	@file	CFBVH4.hpp
+ *	@brief	四分木の境界ボリューム階層
+ */
+#pragma once
+#include "geo/CRay.hpp"
+#include "geo/CFAABB3.hpp"
+#include "math/CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@struct	SRayHit
+	 *	@brief	光線の交差結果
+	 */
+	struct SRayHit {
+		//!	@brief	交差した要素の番号 (交差しない場合は CFBVH4::INVALID)
+		unsigned int prim;
+		//!	@brief	交差位置の光線上の媒介変数 (方向ベクトルの長さを単位とする)
+		float t;
+		//!	@brief	三角形上の重心座標 (v1 の重み)
+		float u;
+		//!	@brief	三角形上の重心座標 (v2 の重み)
+		float v;
+	};
+
+	/**	@class	CFBVH4
+	 *	@brief	四分木の境界ボリューム階層
+	 *	@note	ビン分割の SAH で二分木を構築し、子を四つずつ束ねた節点を深さ優先の順に配列へ詰める。
+	 *			節点は四つの子の境界箱を成分毎に並べ、一本の光線は SSE で四つの子を同時に判定する。
+	 *			八本の光線束は AVX2 で各子を同時に判定する。
+	 *			要素数が多い場合、上位の分割と部分木の構築を CJobSystem で並列化する。
+	 *			動的な場面では refit で境界箱のみを更新し、SAH 費用が増えた部分木を rebuild で構築し直す。
+	 *			走査は固定長のスタックで行う為、insert と rebuild は段数が上限を超えると木全体を構築し直す。
+	 */
+	class CFBVH4 final {
+	public	:
+		//!	@brief	節点の子の数
+		static unsigned int constexpr WIDTH = 4U;
+		//!	@brief	光線束の本数
+		static unsigned int constexpr PACKET_CNT = 8U;
+		//!	@brief	無効な番号
+		static unsigned int constexpr INVALID = 0xFFFFFFFFU;
+
+		//!	@brief	ムーブコンストラクタ
+		CFBVH4(CFBVH4&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFBVH4(CFBVH4 const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFBVH4& operator=(CFBVH4&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFBVH4& operator=(CFBVH4 const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFBVH4() noexcept;
+		//!	@brief	デストラクタ
+		~CFBVH4() noexcept = default;
+
+		/**	@brief	三角形群からの構築関数
+		 *	@param[in] vertices 頂点
+		 *	@param[in] indices 三角形毎に三つの頂点番号
+		 *	@param[in] count 三角形数
+		 */
+		void build(CFVector3 const* const vertices, unsigned int const* const indices, size_t const& count);
+		/**	@brief	軸並行境界箱群からの構築関数
+		 *	@note	葉では要素の箱そのものとの交差を報告する。
+		 */
+		void build(CFAABB3 const* const boxes, size_t const& count);
+
+		/**	@brief	三角形群の再適合関数
+		 *	@note	構築時と同じ頂点番号で、移動後の頂点から境界箱を葉から根へ更新する。木の構造は変えない。
+		 */
+		void refit(CFVector3 const* const vertices, unsigned int const* const indices);
+		/**	@brief	軸並行境界箱群の再適合関数
+		 *	@param[in] boxes 要素番号毎の境界箱 (insert で追加した番号を含む)
+		 */
+		void refit(CFAABB3 const* const boxes);
+		/**	@brief	劣化した部分木の再構築関数
+		 *	@param[in] ratio 構築時に対する SAH 費用の増加率の閾値
+		 *	@return 再構築した部分木の数
+		 *	@note	refit の後に定期的に呼ぶ。根から辿り、費用が閾値を超えた最上位の部分木のみを構築し直す。
+		 */
+		size_t const rebuild(float const& ratio);
+		/**	@brief	要素追加関数 (境界箱で構築した場合のみ)
+		 *	@return 要素番号 (三角形で構築した場合は INVALID)
+		 *	@note	祖先の境界箱の拡大を含めた SAH 費用の増加が最小となる置き場所を分枝限定法で探し、
+		 *			既存の葉へ加えるか、子が全て葉の節点へ新たな葉を置く。一杯の節点は B 木と同様に二つへ分割し、
+		 *			親へ順に及ぼす為、段数は根を分割した場合にのみ増える。
+		 */
+		unsigned int const insert(CFAABB3 const&);
+		//!	@brief	要素削除関数
+		void remove(unsigned int const& id);
+
+		//!	@brief	全体の境界箱取得関数
+		CFAABB3 const& bounds() const noexcept;
+		//!	@brief	節点数取得関数
+		size_t const nodes() const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+		/**	@brief	最近交差判定関数
+		 *	@param[in] tmax 判定する媒介変数の上限
+		 *	@param[out] hit 交差結果 (交差しない場合は prim が INVALID)
+		 *	@return 交差の有無
+		 */
+		bool const intersect(CRay<CFVector3> const&, float const& tmax, SRayHit& hit) const noexcept;
+		//!	@brief	遮蔽判定関数 (いずれかと交差すれば真、見通し判定用)
+		bool const occluded(CRay<CFVector3> const&, float const& tmax) const noexcept;
+		/**	@brief	光線束の最近交差判定関数
+		 *	@note	八本ずつ束ねて走査する。同じ方向へ向かう光線を隣接させるほど効率が良い。
+		 */
+		void intersect(CRay<CFVector3> const* const rays, size_t const& count, float const& tmax, SRayHit* const hits) const noexcept;
+		//!	@brief	光線束の遮蔽判定関数
+		void occluded(CRay<CFVector3> const* const rays, size_t const& count, float const& tmax, bool* const results) const noexcept;
+
+	private	:
+		/**	@struct	SNode
+		 *	@brief	節点
+		 *	@note	子の参照は最上位ビットが 0 なら節点番号、1 なら葉 (下位 4 ビットが要素数、残りが先頭要素) を表す。
+		 */
+		struct alignas(16) SNode {
+			//!	@brief	子の境界箱の最小点の各成分
+			float lo[FLT3_CNT][WIDTH];
+			//!	@brief	子の境界箱の最大点の各成分
+			float hi[FLT3_CNT][WIDTH];
+			//!	@brief	子の参照 (空きは INVALID)
+			unsigned int child[WIDTH];
+		};
+
+		/**	@struct	STriangle
+		 *	@brief	交差判定用の三角形 (一頂点と二辺)
+		 */
+		struct STriangle {
+			//!	@brief	頂点
+			float v0[FLT3_CNT];
+			//!	@brief	v1 - v0
+			float e1[FLT3_CNT];
+			//!	@brief	v2 - v0
+			float e2[FLT3_CNT];
+		};
+
+		/**	@brief	要素の境界箱から木を構築する関数
+		 *	@param[in] boxes 要素毎の最小点と最大点 (六成分ずつ)
+		 */
+		void build_tree(std::vector<float> const& boxes);
+		/**	@brief	部分木の構築関数
+		 *	@param[in] base 葉の並びでの先頭位置
+		 *	@param[out] order 葉の並び順での boxes の番号
+		 *	@return 末尾へ追加した部分木の根の節点番号
+		 */
+		unsigned int const assemble(std::vector<float> const& boxes, size_t const& base, unsigned int const& parent, std::vector<unsigned int>& order);
+		//!	@brief	節点 from 以降の葉の要素の所属節点設定関数
+		void adopt(unsigned int const& from) noexcept;
+
+		//!	@brief	要素の境界箱取得関数
+		CFAABB3 const prim_bounds(size_t const& slot) const noexcept;
+		//!	@brief	節点の子の境界箱取得関数
+		CFAABB3 const lane_bounds(unsigned int const& node, unsigned int const& lane) const noexcept;
+		//!	@brief	子の参照先の境界箱取得関数
+		CFAABB3 const ref_bounds(unsigned int const& ref) const noexcept;
+		//!	@brief	節点の子の設定関数
+		void set_lane(unsigned int const& node, unsigned int const& lane, unsigned int const& ref, CFAABB3 const& box) noexcept;
+		//!	@brief	節点の子の取り外し関数 (後続の子を詰める)
+		void detach(unsigned int const& node, unsigned int const& lane) noexcept;
+		//!	@brief	節点から根までの境界箱の更新関数
+		void refit_path(unsigned int const& node) noexcept;
+		//!	@brief	全節点の境界箱の更新関数 (子の節点番号が親より大きいことを利用して逆順に辿る)
+		void refit_all();
+		//!	@brief	節点毎の部分木の SAH 費用 (節点の表面積で正規化) の評価関数
+		void evaluate(std::vector<float>& costs) const;
+		//!	@brief	部分木の要素の位置の収集関数
+		void gather(unsigned int const& node, std::vector<size_t>& slots) const;
+		//!	@brief	要素を葉の並びの末尾へ移す関数 (元の位置は空きとなる)
+		void relocate(size_t const& slot, unsigned int const& owner);
+		//!	@brief	空きと到達不能な節点を取り除き、root から深さ優先の順に詰め直す関数
+		void compact(unsigned int const& root);
+		/**	@brief	部分木の再構築関数
+		 *	@param[in] targets 構築し直す部分木の根 (互いに祖先とならないこと)
+		 *	@note	段数が走査用スタックで辿れる上限を超えた場合は木全体を構築し直す。
+		 */
+		void reconstruct(std::vector<unsigned int> const& targets);
+		//!	@brief	木の段数 (根のみで 1) 取得関数
+		unsigned int const height() const;
+		//!	@brief	空の節点の追加関数
+		unsigned int const spawn(unsigned int const& parent);
+		/**	@brief	一杯の節点の分割関数
+		 *	@param[in] ref 加える子の参照
+		 *	@return 根を分割した場合は真
+		 *	@note	五つの子を二組に分け、一方を新たな節点へ移して親へ加える。親も一杯なら続けて分割する。
+		 */
+		bool const split(unsigned int const& node, unsigned int const& ref, CFAABB3 const& box);
+		//!	@brief	子の参照先の親 (葉は所属節点) の設定関数
+		void settle(unsigned int const& node, unsigned int const& ref) noexcept;
+
+		//!	@brief	節点
+		std::vector<SNode> m_nodes;
+		//!	@brief	節点毎の親 (根は INVALID)
+		std::vector<unsigned int> m_parents;
+		//!	@brief	節点毎の構築時の SAH 費用 (挿入の分割で作った節点は分割元の値を引き継ぐ、未評価は負)
+		std::vector<float> m_costs;
+		//!	@brief	葉の並び順での要素番号 (空きは INVALID)
+		std::vector<unsigned int> m_prims;
+		//!	@brief	葉の並び順での所属節点
+		std::vector<unsigned int> m_owners;
+		//!	@brief	要素番号毎の葉の並びでの位置 (削除済みは INVALID)
+		std::vector<unsigned int> m_slots;
+		//!	@brief	葉の並び順での三角形
+		std::vector<STriangle> m_tris;
+		//!	@brief	葉の並び順での要素の境界箱 (三角形で構築した場合は空)
+		std::vector<CFAABB3> m_boxes;
+		//!	@brief	全体の境界箱
+		CFAABB3 m_bounds;
+		//!	@brief	葉の並びの空きの数
+		size_t m_holes;
+		//!	@brief	子の節点番号が親より大きいか否か (挿入の分割で崩れ、refit と rebuild の前に詰め直す)
+		bool m_ordered;
+	};
+}
\ No newline at end of file
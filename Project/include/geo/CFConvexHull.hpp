@@ -0,0 +1,53 @@
+﻿/**	@file	CFConvexHull.hpp
+ *	@brief	点群の凸包
+ */
+#pragma once
+#include "math/CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFConvexHull
+	 *	@brief	点群の凸包
+	 *	@note	Quickhull で三角形の面からなる凸包を求める。面は三つの半辺を連続して持つ配列で表し、
+	 *			各面の外側の点を点毎の次の番号の配列で連結して管理する。
+	 *			点が多い場合は点群を区間に分けて各区間の凸包を CJobSystem で並列に求め、
+	 *			それらの頂点のみから最終的な凸包を求める (凸包の頂点の凸包は元の凸包と一致する)。
+	 *			面の向きを判定する誤差は座標の大きさに比例させ、それ以内の点は内側として捨てる。
+	 */
+	class CFConvexHull final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFConvexHull(CFConvexHull&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFConvexHull(CFConvexHull const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFConvexHull& operator=(CFConvexHull&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFConvexHull& operator=(CFConvexHull const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFConvexHull() noexcept;
+		//!	@brief	デストラクタ
+		~CFConvexHull() noexcept = default;
+
+		/**	@brief	構築関数
+		 *	@return 体積を持つ凸包を作れた場合は真 (点が四つ未満か全て同一平面上の場合は偽)
+		 */
+		bool const build(CFVector3 const* const points, size_t const& count);
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	頂点取得関数
+		std::vector<CFVector3> const& vertices() const noexcept;
+		//!	@brief	三角形毎に三つの頂点番号取得関数 (外から見て反時計回り)
+		std::vector<unsigned int> const& indices() const noexcept;
+		//!	@brief	三角形数取得関数
+		size_t const triangles() const noexcept;
+
+	private	:
+		//!	@brief	頂点
+		std::vector<CFVector3> m_vertices;
+		//!	@brief	頂点番号
+		std::vector<unsigned int> m_indices;
+	};
+}
\ No newline at end of file
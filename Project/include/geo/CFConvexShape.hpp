@@ -0,0 +1,88 @@
+﻿/**	@file	CFConvexShape.hpp
+ *	@brief	支持写像で表す凸形状
+ */
+#pragma once
+#include "geo/EConvexType.hpp"
+#include "geo/CFOBB3.hpp"
+#include "geo/CFSphere3.hpp"
+#include "geo/CLSeg.hpp"
+#include "math/CFMatrix3x3.hpp"
+#include "math/CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFConvexShape
+	 *	@brief	支持写像で表す凸形状
+	 *	@note	形状は中核 (球は中心点、カプセルは線分) と半径の余白の和で表す。
+	 *			GJK は中核同士で行い、余白は最後に距離から差し引く為、曲面を含む形状でも反復が少ない。
+	 *			有向境界箱と凸包は行を軸とする回転行列と中心で姿勢を表し、place で頂点を写さずに姿勢のみ更新できる。
+	 */
+	class CFConvexShape final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFConvexShape(CFConvexShape&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFConvexShape(CFConvexShape const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFConvexShape& operator=(CFConvexShape&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFConvexShape& operator=(CFConvexShape const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ (原点の点)
+		CFConvexShape() noexcept;
+		//!	@brief	デストラクタ
+		~CFConvexShape() noexcept = default;
+
+		//!	@brief	球からの変換コンストラクタ
+		explicit CFConvexShape(CFSphere3 const&) noexcept;
+		//!	@brief	有向境界箱からの変換コンストラクタ
+		explicit CFConvexShape(CFOBB3 const&) noexcept;
+		//!	@brief	カプセルのコンストラクタ
+		CFConvexShape(CLSeg<CFVector3> const&, float const& rad) noexcept;
+		/**	@brief	凸包のコンストラクタ
+		 *	@param[in] vertices 局所座標の頂点 (凸包の内部の点を含んでも良い)
+		 *	@param[in] pos 中心
+		 *	@param[in] rot 各行を軸とする正規直交行列
+		 */
+		CFConvexShape(CFVector3 const* const vertices, size_t const& count, CFVector3 const& pos, CFMatrix3x3 const& rot);
+
+		//!	@brief	球での初期化関数
+		CFConvexShape& init(CFSphere3 const&) noexcept;
+		//!	@brief	有向境界箱での初期化関数
+		CFConvexShape& init(CFOBB3 const&) noexcept;
+		//!	@brief	カプセルでの初期化関数
+		CFConvexShape& init(CLSeg<CFVector3> const&, float const& rad) noexcept;
+		//!	@brief	凸包での初期化関数
+		CFConvexShape& init(CFVector3 const* const vertices, size_t const& count, CFVector3 const& pos, CFMatrix3x3 const& rot);
+		/**	@brief	姿勢の設定関数
+		 *	@note	有向境界箱と凸包は回転と中心を、球とカプセルは中心のみを置き換える。
+		 */
+		CFConvexShape& place(CFVector3 const& pos, CFMatrix3x3 const& rot) noexcept;
+
+		//!	@brief	種類取得関数
+		EConvexType const& type() const noexcept;
+		//!	@brief	余白 (球とカプセルの半径) 取得関数
+		float const& margin() const noexcept;
+		//!	@brief	形状の内部の一点の取得関数
+		CFVector3 const inner() const noexcept;
+
+		//!	@brief	中核の支持点取得関数 (dir 方向に最も遠い中核上の点)
+		CFVector3 const core(CFVector3 const& dir) const noexcept;
+		//!	@brief	支持点取得関数 (余白を含む)
+		CFVector3 const support(CFVector3 const& dir) const noexcept;
+
+	private	:
+		//!	@brief	種類
+		EConvexType m_type;
+		//!	@brief	中心 (凸包では局所座標の原点)
+		CFVector3 m_center;
+		//!	@brief	各行を軸とする回転行列 (有向境界箱と凸包)
+		CFMatrix3x3 m_axes;
+		//!	@brief	有向境界箱では各軸方向の半径、カプセルでは中心から端点への差
+		CFVector3 m_extent;
+		//!	@brief	凸包の局所座標の頂点
+		std::vector<CFVector3> m_vertices;
+		//!	@brief	余白
+		float m_margin;
+	};
+}
\ No newline at end of file
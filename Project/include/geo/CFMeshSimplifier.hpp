@@ -0,0 +1,120 @@
+﻿/**	@file	CFMeshSimplifier.hpp
+ *	@brief	二次誤差による辺の縮約を用いたメッシュの簡略化
+ */
+#pragma once
+#include "math/CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFMeshSimplifier
+	 *	@brief	二次誤差による辺の縮約を用いたメッシュの簡略化
+	 *	@note	接続関係は三角形 t の半辺を t * 3 + k (k = 0, 1, 2) とする半辺構造で、始点と反対向きの半辺を配列で持つ。
+	 *			頂点毎に面の平面からの二乗距離の面積加重平均を表す二次形式を持ち、縮約後の位置はその和の最小点とする。
+	 *			縮約候補は二分ヒープで費用の小さい順に取り出し、半辺毎の印と一致しない古い候補を捨てる。
+	 *			境界の辺には面に垂直な平面の二次形式を加えて形を保ち、非多様体の辺と頂点は動かさない。
+	 *			縮約は二頂点の共通の隣接頂点が辺の両側の面の頂点のみの場合に限り、面が大きく裏返る縮約は行わない。
+	 *			初期化の平面と二次形式と候補の費用は CJobSystem で並列に求める。
+	 */
+	class CFMeshSimplifier final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFMeshSimplifier(CFMeshSimplifier&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFMeshSimplifier(CFMeshSimplifier const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFMeshSimplifier& operator=(CFMeshSimplifier&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFMeshSimplifier& operator=(CFMeshSimplifier const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFMeshSimplifier() noexcept;
+		//!	@brief	デストラクタ
+		~CFMeshSimplifier() noexcept = default;
+
+		/**	@brief	初期化関数
+		 *	@param[in] vertices 頂点
+		 *	@param[in] vertexCount 頂点数
+		 *	@param[in] indices 三角形毎に三つの頂点番号
+		 *	@param[in] count 三角形数
+		 */
+		void init(CFVector3 const* const vertices, size_t const& vertexCount, unsigned int const* const indices, size_t const& count);
+		/**	@brief	簡略化関数
+		 *	@param[in] target 目標の三角形数
+		 *	@param[in] maxError 縮約を許す誤差 (距離) の上限
+		 *	@return 残った三角形数
+		 */
+		size_t const simplify(size_t const& target, float const& maxError);
+		//!	@brief	残った三角形と参照される頂点の取り出し関数
+		void extract(std::vector<CFVector3>& vertices, std::vector<unsigned int>& indices) const;
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	残った三角形数取得関数
+		size_t const triangles() const noexcept;
+		//!	@brief	行った縮約の誤差 (距離) の最大値取得関数
+		float const error() const noexcept;
+
+	private	:
+		/**	@struct	SQuadric
+		 *	@brief	平面からの二乗距離の和を表す二次形式
+		 */
+		struct SQuadric {
+			//!	@brief	対称行列の上三角 (xx, xy, xz, xw, yy, yz, yw, zz, zw, ww)
+			double q[10U];
+			//!	@brief	加重の和
+			double weight;
+		};
+
+		/**	@struct	SCandidate
+		 *	@brief	縮約候補
+		 */
+		struct SCandidate {
+			//!	@brief	費用 (加重平均の二乗距離)
+			float cost;
+			//!	@brief	縮約する半辺 (始点を残し、終点を消す)
+			unsigned int edge;
+			//!	@brief	追加時の半辺の印
+			unsigned int token;
+		};
+
+		//!	@brief	頂点を始点とする半辺の収集関数
+		void gather(unsigned int const& vertex, std::vector<unsigned int>& ring) const;
+		//!	@brief	縮約後の位置と費用の算出関数
+		float const evaluate(unsigned int const& edge, CFVector3& pos) const noexcept;
+		//!	@brief	縮約できるか判定する関数 (m_ring と m_other に両端の半辺を集める)
+		bool const collapsible(unsigned int const& edge, CFVector3 const& pos);
+		//!	@brief	縮約関数
+		void collapse(unsigned int const& edge, CFVector3 const& pos);
+		//!	@brief	候補の追加関数
+		void push(unsigned int const& edge);
+
+		//!	@brief	頂点位置
+		std::vector<CFVector3> m_positions;
+		//!	@brief	頂点毎の二次形式
+		std::vector<SQuadric> m_quadrics;
+		//!	@brief	頂点毎の境界と固定の旗
+		std::vector<unsigned char> m_flags;
+		//!	@brief	頂点毎の始点とする半辺の一つ
+		std::vector<unsigned int> m_outgoing;
+		//!	@brief	半辺の始点 (消した三角形は無効な番号)
+		std::vector<unsigned int> m_origins;
+		//!	@brief	反対向きの半辺 (境界は無効な番号)
+		std::vector<unsigned int> m_twins;
+		//!	@brief	半辺毎の印 (候補を振り直すか三角形を消す度に進め、古い候補を見分ける)
+		std::vector<unsigned int> m_tokens;
+		//!	@brief	縮約候補の二分ヒープ
+		std::vector<SCandidate> m_heap;
+		//!	@brief	隣接頂点の印
+		std::vector<unsigned int> m_marks;
+		//!	@brief	作業用の半辺
+		std::vector<unsigned int> m_ring;
+		//!	@brief	作業用の半辺
+		std::vector<unsigned int> m_other;
+		//!	@brief	隣接頂点の印に次に振る値
+		unsigned int m_clock;
+		//!	@brief	残った三角形数
+		size_t m_live;
+		//!	@brief	行った縮約の費用の最大値
+		float m_error;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿/**	@file	CFOBB3.hpp
+ *	@brief	三次元有向境界箱
+ */
+#pragma once
+#include "math/EHandSide.hpp"
+#include "math/CFVector3.hpp"
+#include "math/CFMatrix3x3.hpp"
+#include "math/CFMatrix4x4.hpp"
+
+namespace dlav {
+	class CFAABB3;
+
+	/**	@class	CFOBB3
+	 *	@brief	三次元有向境界箱
+	 *	@note	軸は行列の各行に正規直交基底として保持する。
+	 */
+	class CFOBB3 final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFOBB3(CFOBB3&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFOBB3(CFOBB3 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFOBB3& operator=(CFOBB3&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFOBB3& operator=(CFOBB3 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFOBB3() noexcept;
+		//!	@brief	デストラクタ
+		~CFOBB3() noexcept = default;
+
+		/**	@brief	コンストラクタ
+		 *	@param[in] pos 中心
+		 *	@param[in] rot 各行を軸とする正規直交行列
+		 *	@param[in] ext 各軸方向の半径
+		 */
+		CFOBB3(CFVector3 const& pos, CFMatrix3x3 const& rot, CFVector3 const& ext) noexcept;
+		//!	@brief	変換コンストラクタ
+		explicit CFOBB3(CFAABB3 const&) noexcept;
+
+		//!	@brief	初期化関数
+		CFOBB3& init(CFVector3 const& pos, CFMatrix3x3 const& rot, CFVector3 const& ext) noexcept;
+
+		//!	@brief	中心取得関数
+		CFVector3 const& center() const noexcept;
+		//!	@brief	軸取得関数 (各行が軸)
+		CFMatrix3x3 const& axes() const noexcept;
+		//!	@brief	半径取得関数
+		CFVector3 const& extent() const noexcept;
+		//!	@brief	外接する軸並行境界箱取得関数
+		CFAABB3 const bounds() const noexcept;
+
+		/**	@brief	箱を含むよう拡張する関数
+		 *	@note	軸は自身のものを保ち、相手の頂点を軸へ射影した範囲へ広げる。
+		 */
+		CFOBB3& merge(CFOBB3 const&) noexcept;
+
+		/**	@brief	変換関数
+		 *	@note	回転・拡縮・平行移動からなる行列を想定し、拡縮は各軸の長さとして半径へ移す。
+		 */
+		CFOBB3 const transform(EHandSide const&, CFMatrix4x4 const&) const noexcept;
+
+		//!	@brief	点の包含判定関数
+		bool const contains(CFVector3 const&) const noexcept;
+		//!	@brief	箱との交差判定関数 (分離軸判定)
+		bool const overlaps(CFOBB3 const&) const noexcept;
+
+	private	:
+		//!	@brief	中心
+		CFVector3 m_center;
+		//!	@brief	軸
+		CFMatrix3x3 m_axes;
+		//!	@brief	半径
+		CFVector3 m_extent;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+﻿/**	@file	CFOBB3Stream.hpp
+ *	@brief	三次元有向境界箱のストリーム
+ */
+#pragma once
+#include "geo/CFAABB3.hpp"
+#include "geo/CFOBB3.hpp"
+#include "math/EHandSide.hpp"
+#include "math/CFMatrix4x4.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFOBB3Stream
+	 *	@brief	三次元有向境界箱のストリーム
+	 *	@note	中心・軸・半径を成分毎に連続した SoA 形式で保持し、八個ずつ AVX2 で処理する。
+	 */
+	class CFOBB3Stream final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+		//!	@brief	中心の先頭成分
+		static unsigned int constexpr CENTER_COMP = 0U;
+		//!	@brief	軸の先頭成分 (第 i 軸の第 j 成分は AXES_COMP + i * 3 + j)
+		static unsigned int constexpr AXES_COMP = 3U;
+		//!	@brief	半径の先頭成分
+		static unsigned int constexpr EXTENT_COMP = 12U;
+		//!	@brief	成分数
+		static unsigned int constexpr COMP_CNT = 15U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFOBB3Stream(CFOBB3Stream&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFOBB3Stream(CFOBB3Stream const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFOBB3Stream& operator=(CFOBB3Stream&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFOBB3Stream& operator=(CFOBB3Stream const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFOBB3Stream() noexcept;
+		//!	@brief	デストラクタ
+		~CFOBB3Stream() noexcept = default;
+
+		//!	@brief	初期化関数
+		CFOBB3Stream& init(size_t const& count);
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	成分先頭ポインタ取得関数
+		float* const data(unsigned int const&) noexcept;
+		//!	@brief	成分先頭ポインタ取得関数
+		float const* const data(unsigned int const&) const noexcept;
+
+		//!	@brief	設定関数
+		void set(size_t const&, CFOBB3 const&) noexcept;
+		//!	@brief	取得関数
+		CFOBB3 const get(size_t const&) const noexcept;
+
+		/**	@brief	一括変換関数
+		 *	@param[out] dst 変換結果 (要素数が異なる場合は初期化する)
+		 */
+		void transform(EHandSide const&, CFMatrix4x4 const&, CFOBB3Stream& dst) const;
+		//!	@brief	全要素を含む軸並行境界箱の生成関数
+		CFAABB3 const bounds() const noexcept;
+
+		/**	@brief	一括包含判定関数
+		 *	@param[out] hits 点を含む要素の番号 (昇順)
+		 *	@return 該当する要素数
+		 */
+		size_t const contains(CFVector3 const&, std::vector<unsigned int>& hits) const;
+		//!	@brief	箱との一括交差判定関数 (分離軸判定)
+		size_t const overlaps(CFOBB3 const&, std::vector<unsigned int>& hits) const;
+
+	private	:
+		//!	@brief	要素数
+		size_t m_count;
+		//!	@brief	成分毎の要素
+		std::vector<float> m_comps[COMP_CNT];
+	};
+}
\ No newline at end of file
@@ -27,6 +27,13 @@ namespace dlav {
 
 		//! @brief 初期化関数
 		CFPlane3& init(CFVector3 const&, CFVector3 const&, CFVector3 const&) noexcept;
+		/**	@brief	初期化関数
+		 *	@param[in] nor 法線 (正規化されていなくてもよい)
+		 *	@param[in] value Ｄ値 (nor・x + value = 0)
+		 *	@note	法線の長さが零の場合は法線を零とし、符号付き距離は位置に依らず value となる
+		 *			(value が非負なら全空間が法線側、負なら全空間が裏側)。
+		 */
+		CFPlane3& init(CFVector3 const& nor, float const& value) noexcept;
 
 		//! @brief 法線取得関数
 		CFVector3 const normal() const noexcept;
@@ -40,6 +47,9 @@ namespace dlav {
 		//!	@brief	Ｄ値取得関数
 		float const getDValue() const noexcept;
 
+		//!	@brief	符号付き距離計算関数 (法線側が正)
+		float const distance(CFVector3 const&) const noexcept;
+
 	private	:
 		//!	接ベクトル空間行列
 		CFMatrix3x3	m_mtx;
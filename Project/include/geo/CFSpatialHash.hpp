@@ -0,0 +1,103 @@
+﻿/**	@file	CFSpatialHash.hpp
+ *	@brief	一様格子の空間ハッシュ
+ */
+#pragma once
+#include "geo/CFAABB3.hpp"
+#include "geo/CFSphere3.hpp"
+#include "math/CFVector3.hpp"
+#include "math/CFVector3Stream.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFSpatialHash
+	 *	@brief	一様格子の空間ハッシュ
+	 *	@note	点を一辺 cell の立方体の格子で量子化し、格子座標のハッシュで二の冪個のバケットへ振り分ける。
+	 *			構築は二段の計数ソートで、要素の区間毎にバケット番号の上位ビットによる区分けの要素数を数え、
+	 *			(区分け, 区間) の順の累積で各区間の書き込み位置を求めて要素番号を区分け順に並べた後、
+	 *			区分け毎に担当するバケットのみを数えて書き込む。各段の処理量は要素数に比例し、アトミック操作は無く、
+	 *			同じバケット内は要素番号順に並ぶ為、結果は並列度に依らず一致する。
+	 *			位置はバケット順に成分毎の配列へ並べ、判定は AVX で八要素ずつ行う。
+	 *			異なる格子が同じバケットへ衝突しても判定は位置で行う為、結果は正しい。
+	 *			構築後の検索は const で、複数のスレッドから同時に呼び出せる。
+	 */
+	class CFSpatialHash final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFSpatialHash(CFSpatialHash&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFSpatialHash(CFSpatialHash const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFSpatialHash& operator=(CFSpatialHash&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFSpatialHash& operator=(CFSpatialHash const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFSpatialHash() noexcept;
+		//!	@brief	デストラクタ
+		~CFSpatialHash() noexcept = default;
+
+		/**	@brief	点群からの構築関数
+		 *	@param[in] positions 要素番号毎の位置
+		 *	@param[in] count 要素数
+		 *	@param[in] cell 格子の一辺の長さ (正である事、検索半径と同程度が目安)
+		 *	@note	毎フレーム呼び出す事を想定し、配列の容量は次の構築でも使い回す。
+		 */
+		void build(CFVector3 const* const positions, size_t const& count, float const& cell);
+		//!	@brief	成分毎の点群からの構築関数
+		void build(CFVector3Stream const& positions, float const& cell);
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	格子の一辺の長さ取得関数
+		float const& cell() const noexcept;
+		//!	@brief	全体の境界箱取得関数
+		CFAABB3 const& bounds() const noexcept;
+
+		/**	@brief	球内の要素の検索関数
+		 *	@param[out] hits 球の内部 (境界を含む) にある要素番号 (消去してから格納する)
+		 */
+		void query(CFSphere3 const&, std::vector<unsigned int>& hits) const;
+		/**	@brief	軸並行境界箱内の要素の検索関数
+		 *	@param[out] hits 箱の内部 (境界を含む) にある要素番号 (消去してから格納する)
+		 */
+		void query(CFAABB3 const&, std::vector<unsigned int>& hits) const;
+		/**	@brief	最近傍の k 要素の検索関数
+		 *	@param[out] ids 近い順の要素番号 (消去してから格納し、要素数が k 未満ならその数となる)
+		 *	@note	pos を含む格子から外側へ一層ずつ広げ、k 番目の距離が未走査の層までの距離以下になった時点で打ち切る。
+		 */
+		void nearest(CFVector3 const& pos, unsigned int const& k, std::vector<unsigned int>& ids) const;
+
+	private	:
+		//!	@brief	成分毎の位置から構築する関数 (stride は次の要素までの float 数)
+		void build_stride(float const* const xs, float const* const ys, float const* const zs, size_t const& stride, size_t const& count);
+		//!	@brief	格子座標への量子化関数
+		int const quantize(float const& value) const noexcept;
+		//!	@brief	格子座標からバケット番号への変換関数
+		unsigned int const bucket(int const& ix, int const& iy, int const& iz) const noexcept;
+
+		//!	@brief	バケット毎の先頭位置 (バケット数 + 1 個、末尾は要素数)
+		std::vector<unsigned int> m_starts;
+		//!	@brief	要素番号毎のバケット番号 (構築用)
+		std::vector<unsigned int> m_keys;
+		//!	@brief	バケット順の x 成分 (末尾に八要素分の詰め物を置く)
+		std::vector<float> m_xs;
+		//!	@brief	バケット順の y 成分
+		std::vector<float> m_ys;
+		//!	@brief	バケット順の z 成分
+		std::vector<float> m_zs;
+		//!	@brief	バケット順の要素番号
+		std::vector<unsigned int> m_ids;
+		//!	@brief	全体の境界箱
+		CFAABB3 m_bounds;
+		//!	@brief	格子の一辺の長さ
+		float m_cell;
+		//!	@brief	格子の一辺の長さの逆数
+		float m_inv;
+		//!	@brief	バケット番号のマスク (バケット数 - 1)
+		unsigned int m_mask;
+		//!	@brief	要素数
+		size_t m_count;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+﻿/**	@file	CFSphere3.hpp
+ *	@brief	三次元境界球
+ */
+#pragma once
+#include "math/EHandSide.hpp"
+#include "math/CFVector3.hpp"
+#include "math/CFMatrix4x4.hpp"
+
+namespace dlav {
+	class CFAABB3;
+
+	/**	@class	CFSphere3
+	 *	@brief	三次元境界球
+	 *	@note	デフォルトコンストラクタは半径が負の空の球を作り、merge で広げていく。
+	 *			空の球はどの点も含まず、どの球や箱とも交わらない。
+	 */
+	class CFSphere3 final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFSphere3(CFSphere3&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFSphere3(CFSphere3 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFSphere3& operator=(CFSphere3&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFSphere3& operator=(CFSphere3 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ (空の球)
+		CFSphere3() noexcept;
+		//!	@brief	デストラクタ
+		~CFSphere3() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		CFSphere3(CFVector3 const& pos, float const& rad) noexcept;
+
+		//!	@brief	初期化関数
+		CFSphere3& init(CFVector3 const& pos, float const& rad) noexcept;
+
+		//!	@brief	中心取得関数
+		CFVector3 const& center() const noexcept;
+		//!	@brief	半径取得関数
+		float const& radius() const noexcept;
+		//!	@brief	空判定関数
+		bool const empty() const noexcept;
+		//!	@brief	外接する軸並行境界箱取得関数
+		CFAABB3 const bounds() const noexcept;
+
+		//!	@brief	点を含むよう拡張する関数
+		CFSphere3& merge(CFVector3 const&) noexcept;
+		/**	@brief	球を含むよう拡張する関数
+		 *	@note	両方を含む最小の球となる。
+		 */
+		CFSphere3& merge(CFSphere3 const&) noexcept;
+
+		/**	@brief	変換関数
+		 *	@note	半径には線形部分の最大拡大率の上界 (linearScale) を掛ける為、非一様な拡縮や剪断では外接球となる。
+		 *			空の球はそのまま返す。
+		 */
+		CFSphere3 const transform(EHandSide const&, CFMatrix4x4 const&) const noexcept;
+
+		//!	@brief	点の包含判定関数
+		bool const contains(CFVector3 const&) const noexcept;
+		//!	@brief	球との交差判定関数
+		bool const overlaps(CFSphere3 const&) const noexcept;
+		//!	@brief	箱との交差判定関数
+		bool const overlaps(CFAABB3 const&) const noexcept;
+
+	private	:
+		//!	@brief	中心
+		CFVector3 m_center;
+		//!	@brief	半径
+		float m_radius;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿/**	@file	CFSphere3Stream.hpp
+ *	@brief	三次元境界球のストリーム
+ */
+#pragma once
+#include "geo/CFAABB3.hpp"
+#include "geo/CFSphere3.hpp"
+#include "math/EHandSide.hpp"
+#include "math/CFMatrix4x4.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFSphere3Stream
+	 *	@brief	三次元境界球のストリーム
+	 *	@note	中心と半径を成分毎に連続した SoA 形式で保持し、八個ずつ AVX2 で処理する。
+	 *			半径が負の要素は CFSphere3 と同じく空として扱い、判定に該当しない。
+	 *			data で得た各成分はそのまま SBoundingSpheres として CFFrustum::cull へ渡せる。
+	 */
+	class CFSphere3Stream final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+		//!	@brief	成分数 (中心 x, y, z, 半径)
+		static unsigned int constexpr COMP_CNT = 4U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFSphere3Stream(CFSphere3Stream&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFSphere3Stream(CFSphere3Stream const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFSphere3Stream& operator=(CFSphere3Stream&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFSphere3Stream& operator=(CFSphere3Stream const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFSphere3Stream() noexcept;
+		//!	@brief	デストラクタ
+		~CFSphere3Stream() noexcept = default;
+
+		//!	@brief	初期化関数
+		CFSphere3Stream& init(size_t const& count);
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	成分先頭ポインタ取得関数
+		float* const data(unsigned int const&) noexcept;
+		//!	@brief	成分先頭ポインタ取得関数
+		float const* const data(unsigned int const&) const noexcept;
+
+		//!	@brief	設定関数
+		void set(size_t const&, CFSphere3 const&) noexcept;
+		//!	@brief	取得関数
+		CFSphere3 const get(size_t const&) const noexcept;
+
+		/**	@brief	一括変換関数
+		 *	@param[out] dst 変換結果 (要素数が異なる場合は初期化する)
+		 */
+		void transform(EHandSide const&, CFMatrix4x4 const&, CFSphere3Stream& dst) const;
+		//!	@brief	全要素を含む箱の生成関数
+		CFAABB3 const bounds() const noexcept;
+		/**	@brief	全要素を含む球の生成関数
+		 *	@note	bounds の中心を中心とする為、最小の球とは限らない。
+		 */
+		CFSphere3 const merged() const noexcept;
+
+		/**	@brief	一括包含判定関数
+		 *	@param[out] hits 点を含む要素の番号 (昇順)
+		 *	@return 該当する要素数
+		 */
+		size_t const contains(CFVector3 const&, std::vector<unsigned int>& hits) const;
+		//!	@brief	球との一括交差判定関数
+		size_t const overlaps(CFSphere3 const&, std::vector<unsigned int>& hits) const;
+		//!	@brief	箱との一括交差判定関数
+		size_t const overlaps(CFAABB3 const&, std::vector<unsigned int>& hits) const;
+
+	private	:
+		//!	@brief	要素数
+		size_t m_count;
+		//!	@brief	成分毎の要素
+		std::vector<float> m_comps[COMP_CNT];
+	};
+}
\ No newline at end of file
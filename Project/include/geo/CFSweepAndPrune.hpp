@@ -0,0 +1,84 @@
+﻿/**	@file	CFSweepAndPrune.hpp
+ *	@brief	掃引と刈り込みによる衝突候補の検出
+ */
+#pragma once
+#include "geo/CFAABB3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@struct	SCollisionPair
+	 *	@brief	衝突候補の組
+	 */
+	struct SCollisionPair {
+		//!	@brief	小さい方の要素番号
+		unsigned int a;
+		//!	@brief	大きい方の要素番号
+		unsigned int b;
+	};
+
+	/**	@class	CFSweepAndPrune
+	 *	@brief	掃引と刈り込みによる衝突候補の検出
+	 *	@note	中心の分散が最大の軸で境界箱を最小値順に並べ、各箱の最大値までに始まる後続の箱を残りの二軸で判定する。
+	 *			並び順はフレーム間で殆ど変わらない為、前回の順序から挿入ソートで並べ直す。
+	 *			交換回数が上限を超えた場合 (動きが大きい場合) は全体を並べ直す。
+	 *			残りの二軸は並び順に成分毎の配列へ並べて AVX で八個ずつ判定する。
+	 *			掃引は並び順の区間毎に CJobSystem で並列化し、区間順に連結する為、結果は並列度に依らず一致する。
+	 */
+	class CFSweepAndPrune final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFSweepAndPrune(CFSweepAndPrune&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFSweepAndPrune(CFSweepAndPrune const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFSweepAndPrune& operator=(CFSweepAndPrune&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFSweepAndPrune& operator=(CFSweepAndPrune const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFSweepAndPrune() noexcept;
+		//!	@brief	デストラクタ
+		~CFSweepAndPrune() noexcept = default;
+
+		/**	@brief	更新関数
+		 *	@param[in] boxes 要素番号毎の境界箱
+		 *	@param[in] count 要素数 (前回と異なる場合は全体を並べ直す)
+		 *	@note	毎フレーム呼び出す。軸は分散が現在の軸より十分大きい場合のみ切り替え、切り替え時は全体を並べ直す。
+		 */
+		void update(CFAABB3 const* const boxes, size_t const& count);
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	掃引する軸の取得関数 (0: x, 1: y, 2: z)
+		unsigned int const axis() const noexcept;
+		//!	@brief	直前の更新で全体を並べ直したか否かの取得関数
+		bool const resorted() const noexcept;
+
+		/**	@brief	衝突候補の組の取得関数
+		 *	@param[out] dst 境界箱が重なる組 (消去してから格納する、各組は一度のみで a < b)
+		 *	@note	組の順序は掃引順とする。
+		 */
+		void pairs(std::vector<SCollisionPair>& dst) const;
+
+	private	:
+		//!	@brief	並び順の区間 [begin, end) の掃引関数
+		void sweep(size_t const& begin, size_t const& end, std::vector<SCollisionPair>& dst) const;
+
+		//!	@brief	並び順の要素番号
+		std::vector<unsigned int> m_order;
+		//!	@brief	並び順の掃引軸の最小値 (末尾に八要素分の詰め物を置く)
+		std::vector<float> m_mins;
+		//!	@brief	並び順の掃引軸の最大値
+		std::vector<float> m_maxs;
+		//!	@brief	並び順の残りの二軸の最小値
+		std::vector<float> m_lower[2U];
+		//!	@brief	並び順の残りの二軸の最大値
+		std::vector<float> m_upper[2U];
+		//!	@brief	掃引する軸
+		unsigned int m_axis;
+		//!	@brief	直前の更新で全体を並べ直したか否か
+		bool m_resorted;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,653 @@
+﻿/**	@file	CLooseTree.hpp
+ *	@brief	ルーズ木
+ */
+#pragma once
+#include "geo/CFPlane3.hpp"
+#include "geo/CRay.hpp"
+#include "math/CFVector3.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace dlav {
+	/**	@class	CLooseTree<T>
+	 *	@brief	ルーズ木 (CFVector3 で八分木、CFVector2 で四分木)
+	 *	@note	各節点は自身の区画の LOOSENESS 倍に広げた範囲を境界とし、要素は中心を含む区画を辿って
+	 *			境界球の半径が区画の半径以下に収まる既存の最も深い節点へ置く。節点の要素数が SPLIT_CNT を超えると
+	 *			子を作って収まる要素を一段下ろす為、密な所ほど深く、疎な所は浅い木となる。
+	 *			要素は中心が少し動いても同じ節点に留まれる。
+	 *			節点と要素は配列の貯蔵庫から割り当て、空きは再利用する。子は各軸の上下をビットとする Morton 順に並ぶ。
+	 *			根の範囲の外の要素は根に置き、根は常に走査する。検索は境界球での判定で、結果は要素番号の集合とする。
+	 */
+	template <typename T>
+	class CLooseTree final {
+	public	:
+		//!	@brief	次元数
+		static unsigned int constexpr DIM = static_cast<unsigned int>(std::extent<decltype(T::p)>::value);
+		//!	@brief	節点の子の数
+		static unsigned int constexpr CHILD_CNT = 1U << DIM;
+		//!	@brief	深さの上限
+		static unsigned int constexpr MAX_DEPTH = 16U;
+		//!	@brief	無効な番号
+		static unsigned int constexpr INVALID = 0xFFFFFFFFU;
+		//!	@brief	区画に対する節点の境界の倍率
+		static float constexpr LOOSENESS = 2.0f;
+		//!	@brief	節点を分割する要素数
+		static unsigned int constexpr SPLIT_CNT = 8U;
+
+		//!	@brief	ムーブコンストラクタ
+		CLooseTree(CLooseTree<T>&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CLooseTree(CLooseTree<T> const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CLooseTree<T>& operator=(CLooseTree<T>&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CLooseTree<T>& operator=(CLooseTree<T> const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CLooseTree() noexcept;
+		//!	@brief	デストラクタ
+		~CLooseTree() noexcept = default;
+
+		/**	@brief	初期化関数 (全要素を消去する)
+		 *	@param[in] pos 根の区画の中心
+		 *	@param[in] half 根の区画の半径 (各軸の半分の長さ)
+		 *	@param[in] depth 深さの上限 (MAX_DEPTH 以下)
+		 */
+		void init(T const& pos, float const& half, unsigned int const& depth);
+		//!	@brief	消去関数 (根の区画は保つ)
+		void clear() noexcept;
+
+		/**	@brief	要素追加関数
+		 *	@return 要素番号 (削除した要素の番号は再利用する)
+		 */
+		unsigned int const insert(T const& pos, float const& rad);
+		//!	@brief	要素削除関数 (空になった節点は貯蔵庫へ戻す)
+		void remove(unsigned int const& id);
+		/**	@brief	要素移動関数
+		 *	@return 同じ節点に留まった場合は真
+		 *	@note	新たな境界球が現在の節点の境界に収まる間は位置を書き換えるのみで、木を辿らない。
+		 */
+		bool const move(unsigned int const& id, T const& pos, float const& rad);
+		/**	@brief	節点の詰め直し関数
+		 *	@note	空きを除き、根から深さ優先かつ Morton 順に並べ直して走査の局所性を高める。要素番号は変わらない。
+		 */
+		void compact();
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	節点数取得関数
+		size_t const nodes() const noexcept;
+		//!	@brief	使用メモリ量取得関数 (確保済みの容量をバイト単位で返す)
+		size_t const memory() const noexcept;
+		//!	@brief	要素の境界球の中心取得関数
+		T const position(unsigned int const& id) const noexcept;
+		//!	@brief	要素の境界球の半径取得関数
+		float const& radius(unsigned int const& id) const noexcept;
+
+		//!	@brief	球 (四分木では円) と交わる要素の検索関数
+		void query(T const& pos, float const& rad, std::vector<unsigned int>& hits) const;
+		//!	@brief	軸並行境界箱と交わる要素の検索関数
+		void query(T const& lo, T const& hi, std::vector<unsigned int>& hits) const;
+		/**	@brief	凸な平面群の内側と交わる要素の検索関数 (八分木のみ)
+		 *	@param[in] planes 内側を向く平面 (視錐台なら CFFrustum::plane の六平面)
+		 */
+		void query(CFPlane3 const* const planes, unsigned int const& count, std::vector<unsigned int>& hits) const;
+		/**	@brief	光線と交わる要素の検索関数
+		 *	@param[in] tmax 判定する媒介変数の上限 (方向ベクトルの長さを単位とする)
+		 *	@note	結果は光線上の順ではない。
+		 */
+		void intersect(CRay<T> const&, float const& tmax, std::vector<unsigned int>& hits) const;
+
+	private	:
+		//!	@brief	走査用スタックの深さ
+		static unsigned int constexpr STACK_CNT = MAX_DEPTH * (CHILD_CNT - 1U) + 2U;
+
+		/**	@struct	SNode
+		 *	@brief	節点
+		 */
+		struct SNode {
+			//!	@brief	区画の中心
+			float center[DIM];
+			//!	@brief	区画の半径
+			float half;
+			//!	@brief	親 (根は INVALID)
+			unsigned int parent;
+			//!	@brief	Morton 順の子 (無い場合は INVALID)
+			unsigned int child[CHILD_CNT];
+			//!	@brief	先頭の要素 (無い場合は INVALID)
+			unsigned int head;
+			//!	@brief	要素数
+			unsigned int count;
+			//!	@brief	次に分割を試みる要素数 (下ろせない大きな要素が溜まった場合に分割を繰り返さない為)
+			unsigned int limit;
+			//!	@brief	深さ
+			unsigned int level;
+		};
+
+		/**	@struct	SObject
+		 *	@brief	要素
+		 */
+		struct SObject {
+			//!	@brief	境界球の中心
+			float center[DIM];
+			//!	@brief	境界球の半径
+			float radius;
+			//!	@brief	所属節点 (空きは INVALID)
+			unsigned int node;
+			//!	@brief	節点内の前の要素
+			unsigned int prev;
+			//!	@brief	節点内の次の要素
+			unsigned int next;
+		};
+
+		//!	@brief	節点の割り当て関数
+		unsigned int const allocate(unsigned int const& parent, unsigned int const& slot);
+		//!	@brief	要素が区画の大きさと境界に収まるかの判定関数
+		bool const fits(float const* const center, float const& half, SObject const&) const noexcept;
+		//!	@brief	要素の中心を含む子の位置取得関数
+		unsigned int const slot_of(SNode const&, SObject const&) const noexcept;
+		//!	@brief	要素を置くべき節点を辿って繋ぐ関数
+		void link(unsigned int const& id);
+		//!	@brief	要素を節点の先頭へ繋ぐ関数
+		void attach(unsigned int const& id, unsigned int const& node) noexcept;
+		//!	@brief	要素を節点から外す関数
+		void unlink(unsigned int const& id) noexcept;
+		//!	@brief	節点の要素のうち子に収まるものを一段下ろす関数 (子も要素数が超えれば再帰する)
+		void split(unsigned int const& node);
+		//!	@brief	空の葉を根へ向かって貯蔵庫へ戻す関数
+		void prune(unsigned int const& node);
+		/**	@brief	走査関数
+		 *	@param[in] cull 節点の中心と境界の半径を受け取り、交わり得るなら真を返す関数
+		 *	@param[in] test 要素を受け取り、交わるなら真を返す関数
+		 */
+		template<typename FCull, typename FTest>
+		void traverse(FCull const& cull, FTest const& test, std::vector<unsigned int>& hits) const;
+
+		//!	@brief	節点の貯蔵庫 (先頭が根)
+		std::vector<SNode> m_nodes;
+		//!	@brief	要素の貯蔵庫
+		std::vector<SObject> m_objects;
+		//!	@brief	空きの節点
+		std::vector<unsigned int> m_freeNodes;
+		//!	@brief	空きの要素
+		std::vector<unsigned int> m_freeObjects;
+		//!	@brief	根の区画の中心
+		float m_center[DIM];
+		//!	@brief	根の区画の半径
+		float m_half;
+		//!	@brief	深さの上限
+		unsigned int m_depth;
+	};
+
+	/* 実装 */
+
+	template<typename T>
+	inline CLooseTree<T>::CLooseTree() noexcept :
+		m_nodes(),
+		m_objects(),
+		m_freeNodes(),
+		m_freeObjects(),
+		m_center(),
+		m_half(1.0f),
+		m_depth(0U)
+	{}
+
+	template<typename T>
+	inline void CLooseTree<T>::init(T const& pos, float const& half, unsigned int const& depth) {
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			m_center[comp] = pos.p[comp];
+		}
+		m_half = half;
+		m_depth = std::min(depth, MAX_DEPTH);
+		clear();
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::clear() noexcept {
+		m_nodes.clear();
+		m_objects.clear();
+		m_freeNodes.clear();
+		m_freeObjects.clear();
+	}
+
+	template<typename T>
+	inline unsigned int const CLooseTree<T>::insert(T const& pos, float const& rad) {
+		unsigned int id;
+		if (m_freeObjects.empty()) {
+			id = static_cast<unsigned int>(m_objects.size());
+			m_objects.emplace_back();
+		}
+		else {
+			id = m_freeObjects.back();
+			m_freeObjects.pop_back();
+		}
+		SObject& obj = m_objects[id];
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			obj.center[comp] = pos.p[comp];
+		}
+		obj.radius = rad;
+		link(id);
+		return id;
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::remove(unsigned int const& id) {
+		unsigned int node = m_objects[id].node;
+		unlink(id);
+		m_objects[id].node = INVALID;
+		m_freeObjects.push_back(id);
+		prune(node);
+	}
+
+	template<typename T>
+	inline bool const CLooseTree<T>::move(unsigned int const& id, T const& pos, float const& rad) {
+		SObject& obj = m_objects[id];
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			obj.center[comp] = pos.p[comp];
+		}
+		obj.radius = rad;
+		//	根に置いた要素は小さくなれば深く置けるので常に辿り直す
+		unsigned int node = obj.node;
+		if (node != 0U) {
+			SNode const& cur = m_nodes[node];
+			float bound = cur.half * LOOSENESS - rad;
+			bool inside = bound >= 0.0f;
+			for (unsigned int comp = 0U; comp < DIM && inside; ++comp) {
+				inside = std::fabs(pos.p[comp] - cur.center[comp]) <= bound;
+			}
+			if (inside) {
+				return true;
+			}
+		}
+		unlink(id);
+		link(id);
+		if (m_objects[id].node == node) {
+			return true;
+		}
+		prune(node);
+		return false;
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::compact() {
+		if (m_nodes.empty()) {
+			return;
+		}
+		std::vector<SNode> packed;
+		packed.reserve(m_nodes.size() - m_freeNodes.size());
+		std::vector<unsigned int> remap(m_nodes.size(), INVALID);
+		unsigned int stack[STACK_CNT];
+		unsigned int top = 0U;
+		stack[top++] = 0U;
+		while (top > 0U) {
+			unsigned int idx = stack[--top];
+			remap[idx] = static_cast<unsigned int>(packed.size());
+			packed.push_back(m_nodes[idx]);
+			SNode const& node = m_nodes[idx];
+			for (unsigned int slot = CHILD_CNT; slot-- > 0U;) {
+				if (node.child[slot] != INVALID) {
+					stack[top++] = node.child[slot];
+				}
+			}
+		}
+		for (SNode& node : packed) {
+			node.parent = node.parent == INVALID ? INVALID : remap[node.parent];
+			for (unsigned int& sub : node.child) {
+				sub = sub == INVALID ? INVALID : remap[sub];
+			}
+		}
+		for (SObject& obj : m_objects) {
+			if (obj.node != INVALID) {
+				obj.node = remap[obj.node];
+			}
+		}
+		m_nodes.swap(packed);
+		m_freeNodes.clear();
+	}
+
+	template<typename T>
+	inline size_t const CLooseTree<T>::size() const noexcept {
+		return m_objects.size() - m_freeObjects.size();
+	}
+
+	template<typename T>
+	inline size_t const CLooseTree<T>::nodes() const noexcept {
+		return m_nodes.size() - m_freeNodes.size();
+	}
+
+	template<typename T>
+	inline size_t const CLooseTree<T>::memory() const noexcept {
+		return m_nodes.capacity() * sizeof(SNode) + m_objects.capacity() * sizeof(SObject)
+			+ (m_freeNodes.capacity() + m_freeObjects.capacity()) * sizeof(unsigned int);
+	}
+
+	template<typename T>
+	inline T const CLooseTree<T>::position(unsigned int const& id) const noexcept {
+		T result;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			result.p[comp] = m_objects[id].center[comp];
+		}
+		return result;
+	}
+
+	template<typename T>
+	inline float const& CLooseTree<T>::radius(unsigned int const& id) const noexcept {
+		return m_objects[id].radius;
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::query(T const& pos, float const& rad, std::vector<unsigned int>& hits) const {
+		//	中心から箱までの距離の二乗を成分毎の超過量から求める
+		auto cull = [&](float const* const center, float const& bound) {
+			float sum = 0.0f;
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				float gap = std::max(std::fabs(pos.p[comp] - center[comp]) - bound, 0.0f);
+				sum += gap * gap;
+			}
+			return sum <= rad * rad;
+		};
+		auto test = [&](SObject const& obj) {
+			float sum = 0.0f;
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				float diff = pos.p[comp] - obj.center[comp];
+				sum += diff * diff;
+			}
+			float reach = rad + obj.radius;
+			return sum <= reach * reach;
+		};
+		traverse(cull, test, hits);
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::query(T const& lo, T const& hi, std::vector<unsigned int>& hits) const {
+		auto cull = [&](float const* const center, float const& bound) {
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				if (center[comp] - bound > hi.p[comp] || center[comp] + bound < lo.p[comp]) {
+					return false;
+				}
+			}
+			return true;
+		};
+		auto test = [&](SObject const& obj) {
+			float sum = 0.0f;
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				float gap = std::max(std::max(lo.p[comp] - obj.center[comp], obj.center[comp] - hi.p[comp]), 0.0f);
+				sum += gap * gap;
+			}
+			return sum <= obj.radius * obj.radius;
+		};
+		traverse(cull, test, hits);
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::query(CFPlane3 const* const planes, unsigned int const& count, std::vector<unsigned int>& hits) const {
+		static_assert(DIM == FLT3_CNT, "plane query requires an octree");
+		auto cull = [&](float const* const center, float const& bound) {
+			CFVector3 pos(center[0], center[1], center[2]);
+			for (unsigned int idx = 0U; idx < count; ++idx) {
+				CFVector3 nor = planes[idx].normal();
+				float reach = (std::fabs(nor.p[0]) + std::fabs(nor.p[1]) + std::fabs(nor.p[2])) * bound;
+				if (planes[idx].distance(pos) < -reach) {
+					return false;
+				}
+			}
+			return true;
+		};
+		auto test = [&](SObject const& obj) {
+			CFVector3 pos(obj.center[0], obj.center[1], obj.center[2]);
+			for (unsigned int idx = 0U; idx < count; ++idx) {
+				if (planes[idx].distance(pos) < -obj.radius) {
+					return false;
+				}
+			}
+			return true;
+		};
+		traverse(cull, test, hits);
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::intersect(CRay<T> const& ray, float const& tmax, std::vector<unsigned int>& hits) const {
+		T const& org = ray.position;
+		T const& dir = ray.direction;
+		float len2 = 0.0f;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			len2 += dir.p[comp] * dir.p[comp];
+		}
+		//	スラブ法で [0, tmax] と箱の区間が重なるか判定する
+		auto cull = [&](float const* const center, float const& bound) {
+			float tmin = 0.0f;
+			float tend = tmax;
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				float lower = center[comp] - bound - org.p[comp];
+				float upper = center[comp] + bound - org.p[comp];
+				if (dir.p[comp] == 0.0f) {
+					if (lower > 0.0f || upper < 0.0f) {
+						return false;
+					}
+					continue;
+				}
+				float inv = 1.0f / dir.p[comp];
+				float t0 = lower * inv;
+				float t1 = upper * inv;
+				tmin = std::max(tmin, std::min(t0, t1));
+				tend = std::min(tend, std::max(t0, t1));
+				if (tmin > tend) {
+					return false;
+				}
+			}
+			return true;
+		};
+		//	線分上で境界球の中心に最も近い点までの距離で判定する
+		auto test = [&](SObject const& obj) {
+			float proj = 0.0f;
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				proj += (obj.center[comp] - org.p[comp]) * dir.p[comp];
+			}
+			float rate = len2 > 0.0f ? std::min(std::max(proj / len2, 0.0f), tmax) : 0.0f;
+			float sum = 0.0f;
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				float diff = org.p[comp] + dir.p[comp] * rate - obj.center[comp];
+				sum += diff * diff;
+			}
+			return sum <= obj.radius * obj.radius;
+		};
+		traverse(cull, test, hits);
+	}
+
+	template<typename T>
+	inline unsigned int const CLooseTree<T>::allocate(unsigned int const& parent, unsigned int const& slot) {
+		unsigned int idx;
+		if (m_freeNodes.empty()) {
+			idx = static_cast<unsigned int>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+		else {
+			idx = m_freeNodes.back();
+			m_freeNodes.pop_back();
+		}
+		SNode& node = m_nodes[idx];
+		node.parent = parent;
+		node.head = INVALID;
+		node.count = 0U;
+		node.limit = SPLIT_CNT;
+		std::fill(std::begin(node.child), std::end(node.child), INVALID);
+		if (parent == INVALID) {
+			std::copy(std::begin(m_center), std::end(m_center), std::begin(node.center));
+			node.half = m_half;
+			node.level = 0U;
+			return idx;
+		}
+		SNode& owner = m_nodes[parent];
+		node.half = owner.half * 0.5f;
+		node.level = owner.level + 1U;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			node.center[comp] = owner.center[comp] + ((slot >> comp) & 1U ? node.half : -node.half);
+		}
+		owner.child[slot] = idx;
+		return idx;
+	}
+
+	template<typename T>
+	inline bool const CLooseTree<T>::fits(float const* const center, float const& half, SObject const& obj) const noexcept {
+		float bound = half * LOOSENESS - obj.radius;
+		if (obj.radius > half) {
+			return false;
+		}
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			if (std::fabs(obj.center[comp] - center[comp]) > bound) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	inline unsigned int const CLooseTree<T>::slot_of(SNode const& node, SObject const& obj) const noexcept {
+		unsigned int slot = 0U;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			slot |= obj.center[comp] >= node.center[comp] ? 1U << comp : 0U;
+		}
+		return slot;
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::link(unsigned int const& id) {
+		if (m_nodes.empty()) {
+			allocate(INVALID, 0U);
+		}
+		SObject const& obj = m_objects[id];
+		unsigned int node = 0U;
+		for (;;) {
+			unsigned int sub = m_nodes[node].child[slot_of(m_nodes[node], obj)];
+			if (sub == INVALID || !fits(m_nodes[sub].center, m_nodes[sub].half, obj)) {
+				break;
+			}
+			node = sub;
+		}
+		attach(id, node);
+		SNode const& owner = m_nodes[node];
+		if (owner.count > owner.limit && owner.level < m_depth) {
+			split(node);
+		}
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::attach(unsigned int const& id, unsigned int const& node) noexcept {
+		SObject& obj = m_objects[id];
+		SNode& owner = m_nodes[node];
+		obj.node = node;
+		obj.prev = INVALID;
+		obj.next = owner.head;
+		if (owner.head != INVALID) {
+			m_objects[owner.head].prev = id;
+		}
+		owner.head = id;
+		++owner.count;
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::unlink(unsigned int const& id) noexcept {
+		SObject const& obj = m_objects[id];
+		if (obj.prev != INVALID) {
+			m_objects[obj.prev].next = obj.next;
+		}
+		else {
+			m_nodes[obj.node].head = obj.next;
+		}
+		if (obj.next != INVALID) {
+			m_objects[obj.next].prev = obj.prev;
+		}
+		--m_nodes[obj.node].count;
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::split(unsigned int const& node) {
+		unsigned int obj = m_nodes[node].head;
+		while (obj != INVALID) {
+			unsigned int next = m_objects[obj].next;
+			//	子の区画は親の半分なので、収まらない要素は子を作らずに判定する
+			SNode const& cur = m_nodes[node];
+			unsigned int slot = slot_of(cur, m_objects[obj]);
+			unsigned int sub = cur.child[slot];
+			float half = cur.half * 0.5f;
+			float center[DIM];
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				center[comp] = cur.center[comp] + ((slot >> comp) & 1U ? half : -half);
+			}
+			if (fits(center, half, m_objects[obj])) {
+				if (sub == INVALID) {
+					sub = allocate(node, slot);
+				}
+				unlink(obj);
+				attach(obj, sub);
+			}
+			obj = next;
+		}
+		SNode& owner = m_nodes[node];
+		owner.limit = std::max(SPLIT_CNT, owner.count * 2U);
+		for (unsigned int slot = 0U; slot < CHILD_CNT; ++slot) {
+			unsigned int sub = m_nodes[node].child[slot];
+			if (sub != INVALID && m_nodes[sub].count > m_nodes[sub].limit && m_nodes[sub].level < m_depth) {
+				split(sub);
+			}
+		}
+	}
+
+	template<typename T>
+	inline void CLooseTree<T>::prune(unsigned int const& node) {
+		unsigned int idx = node;
+		while (idx != 0U) {
+			SNode& cur = m_nodes[idx];
+			if (cur.head != INVALID) {
+				return;
+			}
+			for (unsigned int const sub : cur.child) {
+				if (sub != INVALID) {
+					return;
+				}
+			}
+			unsigned int parent = cur.parent;
+			SNode& owner = m_nodes[parent];
+			for (unsigned int& sub : owner.child) {
+				if (sub == idx) {
+					sub = INVALID;
+				}
+			}
+			m_freeNodes.push_back(idx);
+			idx = parent;
+		}
+	}
+
+	template<typename T>
+	template<typename FCull, typename FTest>
+	inline void CLooseTree<T>::traverse(FCull const& cull, FTest const& test, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		if (m_nodes.empty()) {
+			return;
+		}
+		unsigned int stack[STACK_CNT];
+		unsigned int top = 0U;
+		stack[top++] = 0U;
+		while (top > 0U) {
+			unsigned int idx = stack[--top];
+			SNode const& node = m_nodes[idx];
+			//	根は範囲外の要素を含み得るので常に走査する
+			if (idx != 0U && !cull(node.center, node.half * LOOSENESS)) {
+				continue;
+			}
+			for (unsigned int obj = node.head; obj != INVALID; obj = m_objects[obj].next) {
+				if (test(m_objects[obj])) {
+					hits.push_back(obj);
+				}
+			}
+			for (unsigned int slot = CHILD_CNT; slot-- > 0U;) {
+				if (node.child[slot] != INVALID) {
+					stack[top++] = node.child[slot];
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
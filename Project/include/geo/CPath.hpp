@@ -0,0 +1,216 @@
+﻿/**	@file	CPath.hpp
+ *	@brief	複合経路
+ */
+#pragma once
+#include "geo/CBezierCurves.hpp"
+#include "geo/CLSeg.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace dlav {
+	/**	@class	CPath<T>
+	 *	@brief	ベジエ曲線と線分を連結した経路
+	 *	@note	始点からの距離で位置を求める。距離を等間隔に進めると経路全体を等速で移動する。
+	 *			区間の累積長は区間を追加か変更した後に最初に参照した時に求め直し、
+	 *			曲線の弧長表は制御点が変わった曲線のみ作り直す。
+	 */
+	template <typename T>
+	class CPath final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CPath(CPath<T>&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CPath(CPath<T> const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CPath<T>& operator=(CPath<T>&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CPath<T>& operator=(CPath<T> const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CPath() noexcept;
+		//!	@brief	デストラクタ
+		~CPath() noexcept = default;
+
+		/**	@brief	曲線の区間追加関数
+		 *	@return 区間番号
+		 */
+		unsigned int const add(CBezierCurves<T> const&);
+		/**	@brief	線分の区間追加関数
+		 *	@return 区間番号
+		 */
+		unsigned int const add(CLSeg<T> const&);
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	区間数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	線分の区間判定関数
+		bool const linear(unsigned int const& segment) const noexcept;
+		/**	@brief	曲線取得関数
+		 *	@note	区間が曲線である事。変更は次に長さか位置を求めた時に反映する。
+		 */
+		CBezierCurves<T>& curve(unsigned int const& segment) noexcept;
+		/**	@brief	線分取得関数
+		 *	@note	区間が線分である事。変更は次に長さか位置を求めた時に反映する。
+		 */
+		CLSeg<T>& line(unsigned int const& segment) noexcept;
+
+		//!	@brief	全長取得関数
+		float const length();
+		/**	@brief	距離から区間と媒介変数への変換関数
+		 *	@note	区間の探索と区間内の変換はいずれも二分探索で O(log n)。距離は [0, length()] に丸める。
+		 */
+		void locate(float const& distance, unsigned int& segment, float& rate);
+		//!	@brief	始点からの距離での位置取得関数
+		T const interpolate(float const& distance);
+
+	private	:
+		/**	@struct	SSegment
+		 *	@brief	区間
+		 */
+		struct SSegment {
+			//!	@brief	線分か否か
+			bool linear;
+			//!	@brief	曲線か線分の番号
+			unsigned int index;
+		};
+
+		//!	@brief	区間の累積長の更新関数
+		void update();
+
+		//!	@brief	曲線
+		std::vector<CBezierCurves<T>> m_curves;
+		//!	@brief	線分
+		std::vector<CLSeg<T>> m_lines;
+		//!	@brief	区間
+		std::vector<SSegment> m_segments;
+		//!	@brief	区間の終端までの累積長
+		std::vector<float> m_lengths;
+		//!	@brief	累積長の再計算が必要である事を示すフラグ
+		bool m_dirty;
+	};
+
+	/* 実装 */
+
+	template<typename T>
+	inline CPath<T>::CPath() noexcept :
+		m_curves(),
+		m_lines(),
+		m_segments(),
+		m_lengths(),
+		m_dirty(false)
+	{}
+
+	template<typename T>
+	inline unsigned int const CPath<T>::add(CBezierCurves<T> const& arg) {
+		m_segments.push_back(SSegment{ false, static_cast<unsigned int>(m_curves.size()) });
+		m_curves.push_back(arg);
+		m_dirty = true;
+		return static_cast<unsigned int>(m_segments.size() - 1U);
+	}
+
+	template<typename T>
+	inline unsigned int const CPath<T>::add(CLSeg<T> const& arg) {
+		m_segments.push_back(SSegment{ true, static_cast<unsigned int>(m_lines.size()) });
+		m_lines.push_back(arg);
+		m_dirty = true;
+		return static_cast<unsigned int>(m_segments.size() - 1U);
+	}
+
+	template<typename T>
+	inline void CPath<T>::clear() noexcept {
+		m_curves.clear();
+		m_lines.clear();
+		m_segments.clear();
+		m_lengths.clear();
+		m_dirty = false;
+	}
+
+	template<typename T>
+	inline size_t const CPath<T>::size() const noexcept {
+		return m_segments.size();
+	}
+
+	template<typename T>
+	inline bool const CPath<T>::linear(unsigned int const& segment) const noexcept {
+		return m_segments[segment].linear;
+	}
+
+	template<typename T>
+	inline CBezierCurves<T>& CPath<T>::curve(unsigned int const& segment) noexcept {
+		m_dirty = true;
+		return m_curves[m_segments[segment].index];
+	}
+
+	template<typename T>
+	inline CLSeg<T>& CPath<T>::line(unsigned int const& segment) noexcept {
+		m_dirty = true;
+		return m_lines[m_segments[segment].index];
+	}
+
+	template<typename T>
+	inline float const CPath<T>::length() {
+		update();
+		return m_lengths.empty() ? 0.0f : m_lengths.back();
+	}
+
+	template<typename T>
+	inline void CPath<T>::locate(float const& distance, unsigned int& segment, float& rate) {
+		update();
+		segment = 0U;
+		rate = 0.0f;
+		if (m_segments.empty()) {
+			return;
+		}
+		size_t idx = static_cast<size_t>(std::upper_bound(m_lengths.begin(), m_lengths.end(), distance) - m_lengths.begin());
+		idx = std::min(idx, m_segments.size() - 1U);
+		float local = distance - (idx > 0U ? m_lengths[idx - 1U] : 0.0f);
+		SSegment const& seg = m_segments[idx];
+		segment = static_cast<unsigned int>(idx);
+		if (!seg.linear) {
+			rate = m_curves[seg.index].locate(local);
+			return;
+		}
+		float span = m_lengths[idx] - (idx > 0U ? m_lengths[idx - 1U] : 0.0f);
+		rate = span > 0.0f ? std::min(std::max(local / span, 0.0f), 1.0f) : 0.0f;
+	}
+
+	template<typename T>
+	inline T const CPath<T>::interpolate(float const& distance) {
+		unsigned int segment;
+		float rate;
+		locate(distance, segment, rate);
+		if (m_segments.empty()) {
+			return T();
+		}
+		SSegment const& seg = m_segments[segment];
+		return seg.linear ? m_lines[seg.index][rate] : m_curves[seg.index].interpolate(rate);
+	}
+
+	template<typename T>
+	inline void CPath<T>::update() {
+		if (!m_dirty) {
+			return;
+		}
+		m_lengths.resize(m_segments.size());
+		float total = 0.0f;
+		for (size_t idx = 0U; idx < m_segments.size(); ++idx) {
+			SSegment const& seg = m_segments[idx];
+			if (seg.linear) {
+				CLSeg<T> const& lseg = m_lines[seg.index];
+				float sum = 0.0f;
+				for (unsigned int comp = 0U; comp < CBezierCurves<T>::DIM; ++comp) {
+					float diff = lseg.end.p[comp] - lseg.begin.p[comp];
+					sum += diff * diff;
+				}
+				total += std::sqrt(sum);
+			}
+			else {
+				total += m_curves[seg.index].length();
+			}
+			m_lengths[idx] = total;
+		}
+		m_dirty = false;
+	}
+}
\ No newline at end of file
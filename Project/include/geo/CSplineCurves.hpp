@@ -0,0 +1,478 @@
+﻿/**	@file	CSplineCurves.hpp
+ *	@brief	三次スプライン曲線
+ */
+#pragma once
+#include "geo/ESplineType.hpp"
+#include "math/CFQuaternion.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace dlav {
+	/**	@class	CSplineCurves<T>
+	 *	@brief	三次スプライン曲線
+	 *	@note	T は成分配列 p を持つ単精度浮動小数点数型ベクトルとする。
+	 *			区間毎に基底行列と四つの幾何ベクトルの積から冪基底の係数を求めて保持し、Horner 法で評価する。
+	 *			係数は制御点か種類が変わった後、最初に評価する時に求め直す。
+	 *			媒介変数 [0, 1] を区間数で等分し、各区間の局所媒介変数 [0, 1] へ割り当てる。
+	 *			Catmull-Rom とエルミートは両端の区間を含めて n - 1 区間、B スプラインは n - 3 区間となる。
+	 *			Catmull-Rom の両端では、端の制御点に対して隣の制御点を折り返した仮想の制御点を用いる。
+	 *			求心的な Catmull-Rom は区間毎に節点の間隔が異なる為、区間の境界では接線の向きのみ連続する。
+	 */
+	template <typename T>
+	class CSplineCurves final {
+	public	:
+		//!	@brief	頂点の成分数
+		static unsigned int constexpr DIM = static_cast<unsigned int>(std::extent<decltype(T::p)>::value);
+
+		/**	@struct	SPoints
+		 *	@brief	成分毎に並べた点列
+		 */
+		struct SPoints final {
+			//!	@brief	成分毎の座標
+			std::vector<float> p[DIM];
+		};
+
+		//!	@brief	ムーブコンストラクタ
+		CSplineCurves(CSplineCurves<T>&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CSplineCurves(CSplineCurves<T> const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CSplineCurves<T>& operator=(CSplineCurves<T>&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CSplineCurves<T>& operator=(CSplineCurves<T> const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ (一様な Catmull-Rom)
+		CSplineCurves() noexcept;
+		//!	@brief	コンストラクタ
+		explicit CSplineCurves(ESplineType const&) noexcept;
+		//!	@brief	デストラクタ
+		~CSplineCurves() noexcept = default;
+
+		//!	@brief	種類設定関数
+		void type(ESplineType const&) noexcept;
+		//!	@brief	種類取得関数
+		ESplineType const& type() const noexcept;
+
+		//!	@brief	制御点追加関数 (接線は零ベクトル)
+		CSplineCurves<T>& add(unsigned int const& index, T const& vertex) noexcept;
+		//!	@brief	制御点追加関数
+		CSplineCurves<T>& add(unsigned int const& index, T const& vertex, T const& direction) noexcept;
+		//!	@brief	制御点除去関数
+		CSplineCurves<T>& remove(unsigned int const& index) noexcept;
+		//!	@brief	制御点設定関数
+		CSplineCurves<T>& set(unsigned int const& index, T const& vertex) noexcept;
+		/**	@brief	制御点設定関数
+		 *	@param[in] direction 局所媒介変数での接線 (エルミートのみ参照する)
+		 */
+		CSplineCurves<T>& set(unsigned int const& index, T const& vertex, T const& direction) noexcept;
+
+		//!	@brief	制御点取得関数
+		T const& point(unsigned int const&) const noexcept;
+		//!	@brief	接線取得関数
+		T const& tangent(unsigned int const&) const noexcept;
+		//!	@brief	制御点数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	区間数取得関数
+		size_t const segments() const noexcept;
+
+		//!	@brief	補間値取得関数
+		T const interpolate(float const&);
+		//!	@brief	媒介変数での微分係数取得関数
+		T const derivative(float const&);
+		/**	@brief	補間値の一括取得関数
+		 *	@param[in] rates 媒介変数
+		 *	@param[out] dst 成分毎の補間値
+		 *	@note	八個ずつ区間番号を求め、係数を集約命令で読み込んで評価する。媒介変数は整列していなくて良い。
+		 */
+		void interpolate(float const* const rates, size_t const& count, SPoints& dst);
+
+	private	:
+		//!	@brief	冪基底の係数の数
+		static unsigned int constexpr COEF_CNT = 4U;
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+		//!	@brief	求心的な節点の間隔の下限
+		static float constexpr KNOT_EPSILON = 1.0e-6f;
+
+		//!	@brief	係数の更新関数
+		void update();
+		//!	@brief	冪基底の係数の設定関数
+		void store(size_t const& segment, unsigned int const& comp, float const& a, float const& b, float const& c, float const& d) noexcept;
+		//!	@brief	区間の係数取得関数
+		float const coef(unsigned int const& order, unsigned int const& comp, size_t const& segment) const noexcept;
+		//!	@brief	区間番号と局所媒介変数の計算関数
+		void locate(float const& rate, size_t& segment, float& local) const noexcept;
+		//!	@brief	仮想の制御点を含む制御点取得関数
+		T const control(ptrdiff_t const& index) const noexcept;
+
+		//!	@brief	制御点
+		std::vector<T> m_points;
+		//!	@brief	接線
+		std::vector<T> m_tangents;
+		/**	@brief	冪基底の係数 (P(t) = a t^3 + b t^2 + c t + d)
+		 *	@note	次数、成分の順に区間数ずつ並べる。
+		 */
+		std::vector<float> m_coeffs;
+		//!	@brief	区間数
+		size_t m_segments;
+		//!	@brief	種類
+		ESplineType m_type;
+		//!	@brief	係数の再計算が必要である事を示すフラグ
+		bool m_dirty;
+	};
+
+	/**	@class	CSplineCurves<CFQuaternion>
+	 *	@brief	四元数のスプライン曲線 (squad)
+	 *	@note	隣り合う回転が同じ半球となるよう符号を揃え、
+	 *			squad(q_i, q_i+1, s_i, s_i+1, t) = slerp(slerp(q_i, q_i+1, t), slerp(s_i, s_i+1, t), 2t(1 - t)) で補間する。
+	 *			中間の回転 s_i = q_i exp(-(log(q_i^-1 q_i+1) + log(q_i^-1 q_i-1)) / 4) は回転が変わった後に求め直す。
+	 *			種類は参照せず、常に全ての回転を通り角速度が連続する。
+	 */
+	template <>
+	class CSplineCurves<CFQuaternion> final {
+	public	:
+		//!	@brief	成分数
+		static unsigned int constexpr DIM = FLT4_CNT;
+
+		/**	@struct	SPoints
+		 *	@brief	成分毎に並べた回転列
+		 */
+		struct SPoints final {
+			//!	@brief	成分毎の値
+			std::vector<float> p[DIM];
+		};
+
+		//!	@brief	ムーブコンストラクタ
+		CSplineCurves(CSplineCurves<CFQuaternion>&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CSplineCurves(CSplineCurves<CFQuaternion> const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CSplineCurves<CFQuaternion>& operator=(CSplineCurves<CFQuaternion>&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CSplineCurves<CFQuaternion>& operator=(CSplineCurves<CFQuaternion> const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CSplineCurves() noexcept;
+		//!	@brief	デストラクタ
+		~CSplineCurves() noexcept = default;
+
+		//!	@brief	回転追加関数
+		CSplineCurves<CFQuaternion>& add(unsigned int const& index, CFQuaternion const& rot) noexcept;
+		//!	@brief	回転除去関数
+		CSplineCurves<CFQuaternion>& remove(unsigned int const& index) noexcept;
+		//!	@brief	回転設定関数
+		CSplineCurves<CFQuaternion>& set(unsigned int const& index, CFQuaternion const& rot) noexcept;
+
+		//!	@brief	回転取得関数
+		CFQuaternion const& point(unsigned int const&) const noexcept;
+		//!	@brief	回転数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	区間数取得関数
+		size_t const segments() const noexcept;
+
+		//!	@brief	補間値取得関数
+		CFQuaternion const interpolate(float const&);
+		/**	@brief	補間値の一括取得関数
+		 *	@note	区間毎の slerp の角度を保持しておき、媒介変数毎には外側の slerp の角度のみ求める。
+		 */
+		void interpolate(float const* const rates, size_t const& count, SPoints& dst);
+
+	private	:
+		/**	@struct	SArc
+		 *	@brief	slerp の定数
+		 */
+		struct SArc {
+			//!	@brief	角度
+			float angle;
+			//!	@brief	角度の正弦の逆数 (角度が小さい場合は 0 とし線形補間する)
+			float inv;
+		};
+
+		//!	@brief	中間の回転の更新関数
+		void update();
+		//!	@brief	区間での補間関数
+		CFQuaternion const evaluate(size_t const& segment, float const& local) const noexcept;
+
+		//!	@brief	回転
+		std::vector<CFQuaternion> m_points;
+		//!	@brief	半球を揃えた回転
+		std::vector<CFQuaternion> m_keys;
+		//!	@brief	中間の回転
+		std::vector<CFQuaternion> m_inners;
+		//!	@brief	区間毎の回転間の slerp の定数
+		std::vector<SArc> m_keyArcs;
+		//!	@brief	区間毎の中間の回転間の slerp の定数
+		std::vector<SArc> m_innerArcs;
+		//!	@brief	中間の回転の再計算が必要である事を示すフラグ
+		bool m_dirty;
+	};
+
+	/* 実装 */
+
+	template<typename T>
+	inline CSplineCurves<T>::CSplineCurves() noexcept :
+		CSplineCurves(ESplineType::CATMULL_ROM)
+	{}
+
+	template<typename T>
+	inline CSplineCurves<T>::CSplineCurves(ESplineType const& arg) noexcept :
+		m_points(),
+		m_tangents(),
+		m_coeffs(),
+		m_segments(0U),
+		m_type(arg),
+		m_dirty(true)
+	{}
+
+	template<typename T>
+	inline void CSplineCurves<T>::type(ESplineType const& arg) noexcept {
+		m_type = arg;
+		m_dirty = true;
+	}
+
+	template<typename T>
+	inline ESplineType const& CSplineCurves<T>::type() const noexcept {
+		return m_type;
+	}
+
+	template<typename T>
+	inline CSplineCurves<T>& CSplineCurves<T>::add(unsigned int const& index, T const& vertex) noexcept {
+		return add(index, vertex, T());
+	}
+
+	template<typename T>
+	inline CSplineCurves<T>& CSplineCurves<T>::add(unsigned int const& index, T const& vertex, T const& direction) noexcept {
+		m_points.insert(m_points.begin() + index, vertex);
+		m_tangents.insert(m_tangents.begin() + index, direction);
+		m_dirty = true;
+		return *this;
+	}
+
+	template<typename T>
+	inline CSplineCurves<T>& CSplineCurves<T>::remove(unsigned int const& index) noexcept {
+		m_points.erase(m_points.begin() + index);
+		m_tangents.erase(m_tangents.begin() + index);
+		m_dirty = true;
+		return *this;
+	}
+
+	template<typename T>
+	inline CSplineCurves<T>& CSplineCurves<T>::set(unsigned int const& index, T const& vertex) noexcept {
+		m_points[index] = vertex;
+		m_dirty = true;
+		return *this;
+	}
+
+	template<typename T>
+	inline CSplineCurves<T>& CSplineCurves<T>::set(unsigned int const& index, T const& vertex, T const& direction) noexcept {
+		m_points[index] = vertex;
+		m_tangents[index] = direction;
+		m_dirty = true;
+		return *this;
+	}
+
+	template<typename T>
+	inline T const& CSplineCurves<T>::point(unsigned int const& idx) const noexcept {
+		return m_points[idx];
+	}
+
+	template<typename T>
+	inline T const& CSplineCurves<T>::tangent(unsigned int const& idx) const noexcept {
+		return m_tangents[idx];
+	}
+
+	template<typename T>
+	inline size_t const CSplineCurves<T>::size() const noexcept {
+		return m_points.size();
+	}
+
+	template<typename T>
+	inline size_t const CSplineCurves<T>::segments() const noexcept {
+		size_t cnt = m_points.size();
+		if (m_type == ESplineType::B_SPLINE) {
+			return cnt > 3U ? cnt - 3U : 0U;
+		}
+		return cnt > 1U ? cnt - 1U : 0U;
+	}
+
+	template<typename T>
+	inline T const CSplineCurves<T>::interpolate(float const& rate) {
+		update();
+		if (m_segments == 0U) {
+			return m_points.empty() ? T() : m_points.front();
+		}
+		size_t segment;
+		float local;
+		locate(rate, segment, local);
+		T result;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			result.p[comp] = ((coef(0U, comp, segment) * local + coef(1U, comp, segment)) * local + coef(2U, comp, segment)) * local + coef(3U, comp, segment);
+		}
+		return result;
+	}
+
+	template<typename T>
+	inline T const CSplineCurves<T>::derivative(float const& rate) {
+		update();
+		T result;
+		if (m_segments == 0U) {
+			return result;
+		}
+		size_t segment;
+		float local;
+		locate(rate, segment, local);
+		//	局所媒介変数の微分に区間数を掛けて全体の媒介変数での微分とする
+		float scale = static_cast<float>(m_segments);
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			result.p[comp] = ((3.0f * coef(0U, comp, segment) * local + 2.0f * coef(1U, comp, segment)) * local + coef(2U, comp, segment)) * scale;
+		}
+		return result;
+	}
+
+	template<typename T>
+	inline void CSplineCurves<T>::interpolate(float const* const rates, size_t const& count, SPoints& dst) {
+		for (auto& comp : dst.p) {
+			comp.resize(count);
+		}
+		update();
+		if (m_segments == 0U) {
+			T fill = m_points.empty() ? T() : m_points.front();
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				std::fill(dst.p[comp].begin(), dst.p[comp].end(), fill.p[comp]);
+			}
+			return;
+		}
+
+		__m256 const zero = _mm256_setzero_ps();
+		__m256 const one = _mm256_set1_ps(1.0f);
+		__m256 const segs = _mm256_set1_ps(static_cast<float>(m_segments));
+		__m256 const last = _mm256_set1_ps(static_cast<float>(m_segments - 1U));
+		for (size_t head = 0U; head < count; head += LANE_CNT) {
+			size_t rest = std::min<size_t>(count - head, LANE_CNT);
+			alignas(32) float buf[LANE_CNT] = {};
+			std::copy(rates + head, rates + head + rest, buf);
+			__m256 pos = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_load_ps(buf), zero), one), segs);
+			__m256 seg = _mm256_min_ps(_mm256_floor_ps(pos), last);
+			__m256 local = _mm256_sub_ps(pos, seg);
+			__m256i idx = _mm256_cvttps_epi32(seg);
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				__m256 val = _mm256_i32gather_ps(&m_coeffs[comp * m_segments], idx, 4);
+				for (unsigned int order = 1U; order < COEF_CNT; ++order) {
+					__m256 cf = _mm256_i32gather_ps(&m_coeffs[(order * DIM + comp) * m_segments], idx, 4);
+					val = _mm256_fmadd_ps(val, local, cf);
+				}
+				if (rest == LANE_CNT) {
+					_mm256_storeu_ps(&dst.p[comp][head], val);
+				}
+				else {
+					_mm256_store_ps(buf, val);
+					std::copy(buf, buf + rest, &dst.p[comp][head]);
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	inline void CSplineCurves<T>::update() {
+		if (!m_dirty) {
+			return;
+		}
+		m_segments = segments();
+		m_coeffs.resize(COEF_CNT * DIM * m_segments);
+		for (size_t seg = 0U; seg < m_segments; ++seg) {
+			if (m_type == ESplineType::B_SPLINE) {
+				//	基底行列 1/6 [[-1, 3, -3, 1], [3, -6, 3, 0], [-3, 0, 3, 0], [1, 4, 1, 0]]
+				T const& p0 = m_points[seg];
+				T const& p1 = m_points[seg + 1U];
+				T const& p2 = m_points[seg + 2U];
+				T const& p3 = m_points[seg + 3U];
+				for (unsigned int comp = 0U; comp < DIM; ++comp) {
+					float g0 = p0.p[comp], g1 = p1.p[comp], g2 = p2.p[comp], g3 = p3.p[comp];
+					store(seg, comp,
+						(-g0 + 3.0f * g1 - 3.0f * g2 + g3) / 6.0f,
+						(3.0f * g0 - 6.0f * g1 + 3.0f * g2) / 6.0f,
+						(-3.0f * g0 + 3.0f * g2) / 6.0f,
+						(g0 + 4.0f * g1 + g2) / 6.0f);
+				}
+				continue;
+			}
+
+			T const& p1 = m_points[seg];
+			T const& p2 = m_points[seg + 1U];
+			T m1 = m_tangents[seg];
+			T m2 = m_tangents[seg + 1U];
+			if (m_type != ESplineType::HERMITE) {
+				//	Catmull-Rom は Barry-Goldman の節点間隔から接線を求めてエルミート形式に帰着させる (一様なら間隔は全て 1)
+				T p0 = control(static_cast<ptrdiff_t>(seg) - 1);
+				T p3 = control(static_cast<ptrdiff_t>(seg) + 2);
+				T const* pts[4] = { &p0, &p1, &p2, &p3 };
+				float knots[3] = { 1.0f, 1.0f, 1.0f };
+				if (m_type == ESplineType::CENTRIPETAL) {
+					for (unsigned int gap = 0U; gap < 3U; ++gap) {
+						float sum = 0.0f;
+						for (unsigned int comp = 0U; comp < DIM; ++comp) {
+							float diff = pts[gap + 1U]->p[comp] - pts[gap]->p[comp];
+							sum += diff * diff;
+						}
+						knots[gap] = std::max(std::sqrt(std::sqrt(sum)), KNOT_EPSILON);
+					}
+				}
+				float d0 = knots[0], d1 = knots[1], d2 = knots[2];
+				for (unsigned int comp = 0U; comp < DIM; ++comp) {
+					float g0 = p0.p[comp], g1 = p1.p[comp], g2 = p2.p[comp], g3 = p3.p[comp];
+					m1.p[comp] = d1 * ((g1 - g0) / d0 - (g2 - g0) / (d0 + d1) + (g2 - g1) / d1);
+					m2.p[comp] = d1 * ((g2 - g1) / d1 - (g3 - g1) / (d1 + d2) + (g3 - g2) / d2);
+				}
+			}
+			//	基底行列 [[2, -2, 1, 1], [-3, 3, -2, -1], [0, 0, 1, 0], [1, 0, 0, 0]]
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				float g1 = p1.p[comp], g2 = p2.p[comp], t1 = m1.p[comp], t2 = m2.p[comp];
+				store(seg, comp,
+					2.0f * g1 - 2.0f * g2 + t1 + t2,
+					-3.0f * g1 + 3.0f * g2 - 2.0f * t1 - t2,
+					t1,
+					g1);
+			}
+		}
+		m_dirty = false;
+	}
+
+	template<typename T>
+	inline void CSplineCurves<T>::store(size_t const& segment, unsigned int const& comp, float const& a, float const& b, float const& c, float const& d) noexcept {
+		float const cf[COEF_CNT] = { a, b, c, d };
+		for (unsigned int order = 0U; order < COEF_CNT; ++order) {
+			m_coeffs[(order * DIM + comp) * m_segments + segment] = cf[order];
+		}
+	}
+
+	template<typename T>
+	inline float const CSplineCurves<T>::coef(unsigned int const& order, unsigned int const& comp, size_t const& segment) const noexcept {
+		return m_coeffs[(order * DIM + comp) * m_segments + segment];
+	}
+
+	template<typename T>
+	inline void CSplineCurves<T>::locate(float const& rate, size_t& segment, float& local) const noexcept {
+		float pos = std::min(std::max(rate, 0.0f), 1.0f) * static_cast<float>(m_segments);
+		segment = std::min(static_cast<size_t>(pos), m_segments - 1U);
+		local = pos - static_cast<float>(segment);
+	}
+
+	template<typename T>
+	inline T const CSplineCurves<T>::control(ptrdiff_t const& index) const noexcept {
+		ptrdiff_t cnt = static_cast<ptrdiff_t>(m_points.size());
+		if (index >= 0 && index < cnt) {
+			return m_points[static_cast<size_t>(index)];
+		}
+		//	端の制御点に対して隣の制御点を折り返す
+		T const& edge = index < 0 ? m_points.front() : m_points.back();
+		T const& next = index < 0 ? m_points[1] : m_points[static_cast<size_t>(cnt - 2)];
+		T result;
+		for (unsigned int comp = 0U; comp < DIM; ++comp) {
+			result.p[comp] = 2.0f * edge.p[comp] - next.p[comp];
+		}
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+﻿/**	@file	EConvexType.hpp
+ *	@brief	凸形状の種類
+ */
+#pragma once
+
+namespace dlav {
+	/**	@enum	EConvexType
+	 *	@brief	凸形状の種類
+	 */
+	enum class EConvexType : unsigned char {
+		//!	@brief	球 (中心点に半径の余白を持たせる)
+		SPHERE,
+		//!	@brief	有向境界箱
+		BOX,
+		//!	@brief	カプセル (線分に半径の余白を持たせる)
+		CAPSULE,
+		//!	@brief	凸包 (局所座標の頂点群と姿勢)
+		HULL
+	};
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+﻿/**	@file	ESplineType.hpp
+ *	@brief	スプライン曲線の種類
+ */
+#pragma once
+
+namespace dlav {
+	/**	@enum	ESplineType
+	 *	@brief	スプライン曲線の種類
+	 */
+	enum class ESplineType : unsigned char {
+		//!	@brief	一様な Catmull-Rom スプライン (全ての制御点を通る)
+		CATMULL_ROM,
+		/**	@brief	求心的な Catmull-Rom スプライン (全ての制御点を通る)
+		 *	@note	制御点間の距離の平方根を節点の間隔とする為、尖点や自己交差が起きない。
+		 */
+		CENTRIPETAL,
+		//!	@brief	一様な三次 B スプライン (制御点を通らないが二階微分まで連続)
+		B_SPLINE,
+		//!	@brief	エルミートスプライン (制御点毎に接線を与える)
+		HERMITE
+	};
+}
\ No newline at end of file
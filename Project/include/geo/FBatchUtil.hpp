@@ -0,0 +1,61 @@
+﻿/**	@file	FBatchUtil.hpp
+ *	@brief	SoA 形式の一括判定の補助関数群
+ */
+#pragma once
+#include <immintrin.h>
+#include <vector>
+
+namespace dlav {
+	//!	@brief	一括判定の処理幅
+	static unsigned int constexpr BATCH_LANE_CNT = 8U;
+
+	/**	@brief	判定結果の収集関数
+	 *	@param[out] hits 真となった要素の番号の追加先
+	 *	@param[in] base 先頭要素の番号
+	 *	@param[in] count 全要素数 (末尾の詰め物を除く為に用いる)
+	 *	@param[in] mask 八要素分の判定結果
+	 */
+	void collectHits(std::vector<unsigned int>& hits, size_t const& base, size_t const& count, __m256 const& mask);
+	//!	@brief	先頭から rest 個 (最大八個) の要素を真とするマスク生成関数
+	__m256 const tailMask(size_t const& rest) noexcept;
+	//!	@brief	要素毎の絶対値関数
+	__m256 const laneAbs(__m256 const&) noexcept;
+	//!	@brief	全要素の最小値関数
+	float const laneMin(__m256 const&) noexcept;
+	//!	@brief	全要素の最大値関数
+	float const laneMax(__m256 const&) noexcept;
+
+	/* 実装 */
+
+	inline void collectHits(std::vector<unsigned int>& hits, size_t const& base, size_t const& count, __m256 const& mask) {
+		unsigned int bits = static_cast<unsigned int>(_mm256_movemask_ps(mask));
+		if (count - base < BATCH_LANE_CNT) {
+			bits &= (1U << (count - base)) - 1U;
+		}
+		while (bits != 0U) {
+			hits.push_back(static_cast<unsigned int>(base) + static_cast<unsigned int>(_tzcnt_u32(bits)));
+			bits &= bits - 1U;
+		}
+	}
+
+	inline __m256 const tailMask(size_t const& rest) noexcept {
+		int lanes = rest < BATCH_LANE_CNT ? static_cast<int>(rest) : static_cast<int>(BATCH_LANE_CNT);
+		return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+	}
+
+	inline __m256 const laneAbs(__m256 const& arg) noexcept {
+		return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), arg);
+	}
+
+	inline float const laneMin(__m256 const& arg) noexcept {
+		__m128 tmp = _mm_min_ps(_mm256_castps256_ps128(arg), _mm256_extractf128_ps(arg, 1));
+		tmp = _mm_min_ps(tmp, _mm_movehl_ps(tmp, tmp));
+		return _mm_cvtss_f32(_mm_min_ss(tmp, _mm_movehdup_ps(tmp)));
+	}
+
+	inline float const laneMax(__m256 const& arg) noexcept {
+		__m128 tmp = _mm_max_ps(_mm256_castps256_ps128(arg), _mm256_extractf128_ps(arg, 1));
+		tmp = _mm_max_ps(tmp, _mm_movehl_ps(tmp, tmp));
+		return _mm_cvtss_f32(_mm_max_ss(tmp, _mm_movehdup_ps(tmp)));
+	}
+}
\ No newline at end of file
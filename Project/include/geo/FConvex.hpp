@@ -0,0 +1,56 @@
+﻿/**	@file	FConvex.hpp
+ *	@brief	凸形状間の距離と貫通の判定関数群
+ */
+#pragma once
+#include "geo/CFConvexShape.hpp"
+#include "math/CFVector3.hpp"
+
+namespace dlav {
+	/**	@struct	SContact
+	 *	@brief	凸形状間の接触情報
+	 */
+	struct SContact {
+		//!	@brief	A から B へ向かう単位法線
+		CFVector3 normal;
+		//!	@brief	A 上の最近点 (貫通時は B へ最も深く入り込んだ点)
+		CFVector3 pointA;
+		//!	@brief	B 上の最近点 (貫通時は A へ最も深く入り込んだ点)
+		CFVector3 pointB;
+		//!	@brief	符号付き距離 (貫通時は負の貫通深さ)
+		float distance;
+		//!	@brief	GJK の反復回数
+		unsigned int iterations;
+		//!	@brief	EPA の展開回数 (EPA を行わない場合は 0)
+		unsigned int expansions;
+	};
+
+	/**	@struct	SSimplexCache
+	 *	@brief	GJK の単体の暖機用の記録
+	 *	@note	単体の各頂点を得た探索方向を保ち、次の呼び出しでは同じ方向の支持点から始める。
+	 *			形状の組毎に保ち、フレーム間で動きが小さいほど反復が減る。
+	 */
+	struct SSimplexCache {
+		//!	@brief	頂点を得た探索方向
+		CFVector3 dirs[4U];
+		//!	@brief	頂点数 (0 なら暖機しない)
+		unsigned int count;
+	};
+
+	/**	@brief	GJK による距離の計算関数
+	 *	@param[out] contact 中核が交わらない場合の接触情報 (余白のみが重なる場合は距離が負)
+	 *	@param[in,out] cache 暖機用の記録 (nullptr なら暖機しない)
+	 *	@return 中核が交わらない場合は真
+	 */
+	bool const gjkDistance(CFConvexShape const& a, CFConvexShape const& b, SContact& contact, SSimplexCache* const cache = nullptr) noexcept;
+	/**	@brief	EPA による貫通の計算関数
+	 *	@param[out] contact 接触情報 (距離は負の貫通深さ)
+	 *	@return 貫通を求められた場合は真 (形状が交わらない場合や退化した場合は偽)
+	 *	@note	余白を含めた形状で GJK を行い、原点を含む四面体から多面体を広げる。
+	 */
+	bool const epaPenetration(CFConvexShape const& a, CFConvexShape const& b, SContact& contact) noexcept;
+	/**	@brief	接触判定関数
+	 *	@return 接するか貫通する場合は真
+	 *	@note	GJK で中核が交わる場合のみ EPA を行う。EPA で貫通を求められない場合は余白を含めた形状の距離で判定する。
+	 */
+	bool const collide(CFConvexShape const& a, CFConvexShape const& b, SContact& contact, SSimplexCache* const cache = nullptr) noexcept;
+}
\ No newline at end of file
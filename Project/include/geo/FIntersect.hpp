@@ -0,0 +1,122 @@
+﻿/**	@file	FIntersect.hpp
+ *	@brief	光線の交差判定関数群
+ */
+#pragma once
+#include "geo/CRay.hpp"
+#include "geo/CFAABB3.hpp"
+#include "geo/CFPlane3.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "math/CFVector3.hpp"
+
+namespace dlav {
+	/**	@struct	SRay8
+	 *	@brief	成分毎に並べた八本の光線
+	 */
+	struct alignas(32) SRay8 {
+		//!	@brief	基準点の各成分
+		float o[FLT3_CNT][BATCH_LANE_CNT];
+		//!	@brief	方向の各成分
+		float d[FLT3_CNT][BATCH_LANE_CNT];
+	};
+
+	/**	@struct	STriangle8
+	 *	@brief	成分毎に並べた八個の三角形
+	 */
+	struct alignas(32) STriangle8 {
+		//!	@brief	頂点 0 の各成分
+		float v0[FLT3_CNT][BATCH_LANE_CNT];
+		//!	@brief	頂点 1 の各成分
+		float v1[FLT3_CNT][BATCH_LANE_CNT];
+		//!	@brief	頂点 2 の各成分
+		float v2[FLT3_CNT][BATCH_LANE_CNT];
+	};
+
+	/**	@struct	SBox8
+	 *	@brief	成分毎に並べた八個の軸並行境界箱
+	 */
+	struct alignas(32) SBox8 {
+		//!	@brief	最小点の各成分
+		float lo[FLT3_CNT][BATCH_LANE_CNT];
+		//!	@brief	最大点の各成分
+		float hi[FLT3_CNT][BATCH_LANE_CNT];
+	};
+
+	/**	@struct	SPlane8
+	 *	@brief	成分毎に並べた八個の平面
+	 */
+	struct alignas(32) SPlane8 {
+		//!	@brief	単位法線の各成分
+		float n[FLT3_CNT][BATCH_LANE_CNT];
+		//!	@brief	Ｄ値
+		float d[BATCH_LANE_CNT];
+	};
+
+	/**	@struct	SHit8
+	 *	@brief	八組の交差結果
+	 *	@note	交差したレーンのみ有効。u と v は三角形の重心座標 (v1 と v2 の重み) で、それ以外では 0 となる。
+	 */
+	struct alignas(32) SHit8 {
+		//!	@brief	交差位置の光線上の媒介変数
+		float t[BATCH_LANE_CNT];
+		//!	@brief	v1 の重み
+		float u[BATCH_LANE_CNT];
+		//!	@brief	v2 の重み
+		float v[BATCH_LANE_CNT];
+	};
+
+	/**	@brief	光線の読み込み関数
+	 *	@return 読み込んだ本数 (最大八本、不足分は NaN で埋めていずれとも交差しないようにする)
+	 */
+	size_t const loadRays(SRay8& dst, CRay<CFVector3> const* const rays, size_t const& count) noexcept;
+	/**	@brief	三角形の読み込み関数
+	 *	@param[in] indices 三角形毎に三つの頂点番号
+	 *	@return 読み込んだ個数 (不足分は NaN で埋める)
+	 */
+	size_t const loadTriangles(STriangle8& dst, CFVector3 const* const vertices, unsigned int const* const indices, size_t const& count) noexcept;
+	//!	@brief	軸並行境界箱の読み込み関数
+	size_t const loadBoxes(SBox8& dst, CFAABB3 const* const boxes, size_t const& count) noexcept;
+	//!	@brief	平面の読み込み関数
+	size_t const loadPlanes(SPlane8& dst, CFPlane3 const* const planes, size_t const& count) noexcept;
+
+	/**	@brief	光線と三角形の交差判定関数 (Möller–Trumbore 法)
+	 *	@param[in] tmax 判定する媒介変数の上限 (0 < t < tmax で交差とする)
+	 *	@param[out] t 交差位置の媒介変数
+	 *	@param[out] u v1 の重み
+	 *	@param[out] v v2 の重み
+	 *	@note	両面を判定する。辺の上では浮動小数点の丸めにより隣接する両方の三角形を外れ得る。
+	 */
+	bool const rayTriangle(CRay<CFVector3> const&, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, float& t, float& u, float& v) noexcept;
+	/**	@brief	光線と三角形の水密な交差判定関数 (Woop らの方法)
+	 *	@note	光線の方向の最大成分を z とする座標系へ剪断してから二次元の辺関数で判定し、
+	 *			辺関数が 0 となる場合は倍精度で計算し直す。辺を共有する三角形の間を光線がすり抜けない。
+	 */
+	bool const rayTriangleWatertight(CRay<CFVector3> const&, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, float& t, float& u, float& v) noexcept;
+	/**	@brief	光線と軸並行境界箱の交差判定関数 (スラブ法)
+	 *	@param[out] t 入射位置の媒介変数 (基準点が内部なら 0)
+	 */
+	bool const rayBox(CRay<CFVector3> const&, CFAABB3 const&, float const& tmax, float& t) noexcept;
+	//!	@brief	光線と平面の交差判定関数 (両面、平行な場合は交差しない)
+	bool const rayPlane(CRay<CFVector3> const&, CFPlane3 const&, float const& tmax, float& t) noexcept;
+
+	/**	@brief	一本の光線と八個の三角形の交差判定関数 (Möller–Trumbore 法)
+	 *	@return 交差したレーンのビット
+	 */
+	unsigned int const rayTriangle(CRay<CFVector3> const&, STriangle8 const&, float const& tmax, SHit8& hit) noexcept;
+	//!	@brief	一本の光線と八個の三角形の水密な交差判定関数
+	unsigned int const rayTriangleWatertight(CRay<CFVector3> const&, STriangle8 const&, float const& tmax, SHit8& hit) noexcept;
+	//!	@brief	一本の光線と八個の軸並行境界箱の交差判定関数
+	unsigned int const rayBox(CRay<CFVector3> const&, SBox8 const&, float const& tmax, SHit8& hit) noexcept;
+	//!	@brief	一本の光線と八個の平面の交差判定関数
+	unsigned int const rayPlane(CRay<CFVector3> const&, SPlane8 const&, float const& tmax, SHit8& hit) noexcept;
+
+	//!	@brief	八本の光線と三角形の交差判定関数 (Möller–Trumbore 法)
+	unsigned int const rayTriangle(SRay8 const&, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, SHit8& hit) noexcept;
+	/**	@brief	八本の光線と三角形の水密な交差判定関数
+	 *	@note	剪断の軸は光線毎に異なる為、成分の選択を混合命令で行う。
+	 */
+	unsigned int const rayTriangleWatertight(SRay8 const&, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, SHit8& hit) noexcept;
+	//!	@brief	八本の光線と軸並行境界箱の交差判定関数
+	unsigned int const rayBox(SRay8 const&, CFAABB3 const&, float const& tmax, SHit8& hit) noexcept;
+	//!	@brief	八本の光線と平面の交差判定関数
+	unsigned int const rayPlane(SRay8 const&, CFPlane3 const&, float const& tmax, SHit8& hit) noexcept;
+}
\ No newline at end of file
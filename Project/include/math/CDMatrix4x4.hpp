@@ -0,0 +1,133 @@
+﻿/**	@file	CDMatrix4x4.hpp
+ *	@brief	倍精度浮動小数点数型四次正方行列
+ */
+#pragma once
+#pragma warning(disable : 4324)
+#include "util/SDouble4.hpp"
+#include "util/SDouble4x4.hpp"
+#include "EHandSide.hpp"
+#include "CDVector3.hpp"
+#include "CFMatrix4x4.hpp"
+#include "Math.hpp"
+#include <initializer_list>
+
+namespace dlav {
+	/**	@class	CDMatrix4x4
+	 *	@brief	倍精度浮動小数点数型四次正方行列
+	 *	@note	各行を一本の __m256d で演算する。
+	 */
+	class alignas(32) CDMatrix4x4 final : public SDouble4x4{
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CDMatrix4x4(CDMatrix4x4&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CDMatrix4x4(CDMatrix4x4 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CDMatrix4x4& operator=(CDMatrix4x4&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CDMatrix4x4& operator=(CDMatrix4x4 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CDMatrix4x4() noexcept;
+		//!	@brief	デストラクタ
+		~CDMatrix4x4() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		constexpr CDMatrix4x4(
+			double const& m00, double const& m01, double const& m02, double const& m03,
+			double const& m10, double const& m11, double const& m12, double const& m13,
+			double const& m20, double const& m21, double const& m22, double const& m23,
+			double const& m30, double const& m31, double const& m32, double const& m33
+		) noexcept :
+			SDouble4x4{
+				m00, m01, m02, m03,
+				m10, m11, m12, m13,
+				m20, m21, m22, m23,
+				m30, m31, m32, m33
+			}
+		{}
+		//!	@brief	コンストラクタ
+		explicit CDMatrix4x4(std::initializer_list<double> const&) noexcept;
+		//!	@brief	変換コンストラクタ
+		explicit CDMatrix4x4(CFMatrix4x4 const&) noexcept;
+
+		//!	@brief	複合加算演算子
+		CDMatrix4x4& operator+=(CDMatrix4x4 const&) noexcept;
+		//!	@brief	複合減算演算子
+		CDMatrix4x4& operator-=(CDMatrix4x4 const&) noexcept;
+		//!	@brief	複合スカラ倍演算子
+		CDMatrix4x4& operator*=(double const&) noexcept;
+		//!	@brief	複合スカラ割演算子
+		CDMatrix4x4& operator/=(double const&) noexcept;
+
+		//!	@brief	余因子行列生成関数
+		CDMatrix4x4 const adj() const noexcept;
+		//!	@brief	逆行列生成関数
+		CDMatrix4x4 const inv() const noexcept;
+		//!	@brief	転置行列生成関数
+		CDMatrix4x4 const transpose() const noexcept;
+		//!	@brief	行列式計算関数
+		double const det() const noexcept;
+
+		//!	@brief	単項加算演算子
+		CDMatrix4x4 const operator+() const noexcept;
+		//!	@brief	単項減算演算子
+		CDMatrix4x4 const operator-() const noexcept;
+	};
+	//!	@brief	加算演算子
+	CDMatrix4x4 const operator+(CDMatrix4x4 const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	減算演算子
+	CDMatrix4x4 const operator-(CDMatrix4x4 const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	乗算演算子
+	CDMatrix4x4 const operator*(CDMatrix4x4 const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CDMatrix4x4 const operator*(CDMatrix4x4 const&, double const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CDMatrix4x4 const operator*(double const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	除算演算子
+	CDMatrix4x4 const operator/(CDMatrix4x4 const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	スカラ割演算子
+	CDMatrix4x4 const operator/(CDMatrix4x4 const&, double const&) noexcept;
+
+	//!	@brief	行列作用演算子 (第四成分を 1 とする点として作用させる)
+	CDVector3 const operator*(CDVector3 const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	行列作用演算子 (第四成分を 1 とする点として作用させる)
+	CDVector3 const operator*(CDMatrix4x4 const&, CDVector3 const&) noexcept;
+
+	//!	@brief	等価比較演算子
+	bool const operator==(CDMatrix4x4 const&, CDMatrix4x4 const&) noexcept;
+	//!	@brief	不等価比較演算子
+	bool const operator!=(CDMatrix4x4 const&, CDMatrix4x4 const&) noexcept;
+
+	//!	@brief	単精度変換関数
+	CFMatrix4x4 const toFlt(CDMatrix4x4 const&) noexcept;
+	/**	@brief	相対座標変換関数
+	 *	@param[in] hs 平行移動成分の配置を決める座標系
+	 *	@param[in] arg 対象の行列
+	 *	@param[in] origin 基準位置 (カメラ位置等)
+	 *	@return 平行移動成分を基準位置からの相対位置とした行列
+	 *	@note	平行移動成分の差分を倍精度のまま取ってから単精度へ丸める。
+	 */
+	CFMatrix4x4 const toFlt(EHandSide const& hs, CDMatrix4x4 const& arg, CDVector3 const& origin) noexcept;
+	//!	@brief	相対座標変換関数 (一括処理)
+	void toFlt(EHandSide const& hs, CFMatrix4x4* const dst, CDMatrix4x4 const* const src, CDVector3 const& origin, size_t const& count) noexcept;
+
+	//!	@brief	倍精度浮動小数点数型の零行列
+	static CDMatrix4x4 constexpr ZERO_DMTX4x4 = CDMatrix4x4(
+		0.0, 0.0, 0.0, 0.0,
+		0.0, 0.0, 0.0, 0.0,
+		0.0, 0.0, 0.0, 0.0,
+		0.0, 0.0, 0.0, 0.0
+	);
+	//!	@brief	倍精度浮動小数点数型の単位行列
+	static CDMatrix4x4 constexpr UNIT_DMTX4x4 = CDMatrix4x4(
+		1.0, 0.0, 0.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+		0.0, 0.0, 1.0, 0.0,
+		0.0, 0.0, 0.0, 1.0
+	);
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CDMatrix4x4.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+﻿/**	@file	CDMatrix4x4.inl
+ *	@brief	倍精度浮動小数点数型四次正方行列
+ */
+#pragma once
+#include "CDMatrix4x4.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+#include <cfloat>
+
+namespace dlav {
+	DLAV_MATH_API CDMatrix4x4::CDMatrix4x4() noexcept :
+		SDouble4x4{}
+	{}
+
+	DLAV_MATH_API CDMatrix4x4::CDMatrix4x4(std::initializer_list<double> const& args) noexcept :
+		SDouble4x4{}
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= DBL4x4_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CDMatrix4x4::CDMatrix4x4(CFMatrix4x4 const& arg) noexcept :
+		SDouble4x4{}
+	{
+		for (unsigned int idx = 0U; idx < DBL4x4_CNT; idx += DBL4_CNT) {
+			_mm256_store_pd(&p[idx], _mm256_cvtps_pd(_mm_load_ps(&arg.p[idx])));
+		}
+	}
+
+	DLAV_MATH_API CDMatrix4x4& CDMatrix4x4::operator+=(CDMatrix4x4 const& rhs) noexcept {
+		for (unsigned int idx = 0U; idx < DBL4x4_CNT; idx += DBL4_CNT) {
+			_mm256_store_pd(&p[idx], _mm256_add_pd(_mm256_load_pd(&p[idx]), _mm256_load_pd(&rhs.p[idx])));
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CDMatrix4x4& CDMatrix4x4::operator-=(CDMatrix4x4 const& rhs) noexcept {
+		for (unsigned int idx = 0U; idx < DBL4x4_CNT; idx += DBL4_CNT) {
+			_mm256_store_pd(&p[idx], _mm256_sub_pd(_mm256_load_pd(&p[idx]), _mm256_load_pd(&rhs.p[idx])));
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CDMatrix4x4& CDMatrix4x4::operator*=(double const& rhs) noexcept {
+		__m256d tmp = _mm256_set1_pd(rhs);
+		for (unsigned int idx = 0U; idx < DBL4x4_CNT; idx += DBL4_CNT) {
+			_mm256_store_pd(&p[idx], _mm256_mul_pd(_mm256_load_pd(&p[idx]), tmp));
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CDMatrix4x4& CDMatrix4x4::operator/=(double const& rhs) noexcept {
+		*this *= 1.0 / rhs;
+		return *this;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const CDMatrix4x4::adj() const noexcept {
+		// 上二行と下二行の二次小行列式から余因子を組み立てる
+		double s0 = p[0] * p[5] - p[4] * p[1];
+		double s1 = p[0] * p[6] - p[4] * p[2];
+		double s2 = p[0] * p[7] - p[4] * p[3];
+		double s3 = p[1] * p[6] - p[5] * p[2];
+		double s4 = p[1] * p[7] - p[5] * p[3];
+		double s5 = p[2] * p[7] - p[6] * p[3];
+		double c0 = p[8] * p[13] - p[12] * p[9];
+		double c1 = p[8] * p[14] - p[12] * p[10];
+		double c2 = p[8] * p[15] - p[12] * p[11];
+		double c3 = p[9] * p[14] - p[13] * p[10];
+		double c4 = p[9] * p[15] - p[13] * p[11];
+		double c5 = p[10] * p[15] - p[14] * p[11];
+		return CDMatrix4x4(
+			 p[5] * c5 - p[6] * c4 + p[7] * c3,
+			-p[1] * c5 + p[2] * c4 - p[3] * c3,
+			 p[13] * s5 - p[14] * s4 + p[15] * s3,
+			-p[9] * s5 + p[10] * s4 - p[11] * s3,
+			-p[4] * c5 + p[6] * c2 - p[7] * c1,
+			 p[0] * c5 - p[2] * c2 + p[3] * c1,
+			-p[12] * s5 + p[14] * s2 - p[15] * s1,
+			 p[8] * s5 - p[10] * s2 + p[11] * s1,
+			 p[4] * c4 - p[5] * c2 + p[7] * c0,
+			-p[0] * c4 + p[1] * c2 - p[3] * c0,
+			 p[12] * s4 - p[13] * s2 + p[15] * s0,
+			-p[8] * s4 + p[9] * s2 - p[11] * s0,
+			-p[4] * c3 + p[5] * c1 - p[6] * c0,
+			 p[0] * c3 - p[1] * c1 + p[2] * c0,
+			-p[12] * s3 + p[13] * s1 - p[14] * s0,
+			 p[8] * s3 - p[9] * s1 + p[10] * s0
+		);
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const CDMatrix4x4::inv() const noexcept {
+		CDMatrix4x4 result = ZERO_DMTX4x4;
+		double det = this->det();
+		if (det >= DBL_EPSILON || det <= -DBL_EPSILON) {
+			result = adj();
+			result /= det;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const CDMatrix4x4::transpose() const noexcept {
+		CDMatrix4x4 result = ZERO_DMTX4x4;
+		__m256d r0 = _mm256_load_pd(&p[0]);
+		__m256d r1 = _mm256_load_pd(&p[4]);
+		__m256d r2 = _mm256_load_pd(&p[8]);
+		__m256d r3 = _mm256_load_pd(&p[12]);
+		// 二行ずつ組み合わせてから 128 bit 単位で入れ替える
+		__m256d t0 = _mm256_unpacklo_pd(r0, r1);
+		__m256d t1 = _mm256_unpackhi_pd(r0, r1);
+		__m256d t2 = _mm256_unpacklo_pd(r2, r3);
+		__m256d t3 = _mm256_unpackhi_pd(r2, r3);
+		_mm256_store_pd(&result.p[0], _mm256_permute2f128_pd(t0, t2, 0x20));
+		_mm256_store_pd(&result.p[4], _mm256_permute2f128_pd(t1, t3, 0x20));
+		_mm256_store_pd(&result.p[8], _mm256_permute2f128_pd(t0, t2, 0x31));
+		_mm256_store_pd(&result.p[12], _mm256_permute2f128_pd(t1, t3, 0x31));
+		return result;
+	}
+
+	DLAV_MATH_API double const CDMatrix4x4::det() const noexcept {
+		return (p[0] * p[5] - p[4] * p[1]) * (p[10] * p[15] - p[14] * p[11])
+			- (p[0] * p[6] - p[4] * p[2]) * (p[9] * p[15] - p[13] * p[11])
+			+ (p[0] * p[7] - p[4] * p[3]) * (p[9] * p[14] - p[13] * p[10])
+			+ (p[1] * p[6] - p[5] * p[2]) * (p[8] * p[15] - p[12] * p[11])
+			- (p[1] * p[7] - p[5] * p[3]) * (p[8] * p[14] - p[12] * p[10])
+			+ (p[2] * p[7] - p[6] * p[3]) * (p[8] * p[13] - p[12] * p[9]);
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const CDMatrix4x4::operator+() const noexcept {
+		return *this;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const CDMatrix4x4::operator-() const noexcept {
+		return *this * -1.0;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator+(CDMatrix4x4 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		CDMatrix4x4 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator-(CDMatrix4x4 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		CDMatrix4x4 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator*(CDMatrix4x4 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		CDMatrix4x4 result = ZERO_DMTX4x4;
+		__m256d r0 = _mm256_load_pd(&rhs.p[0]);
+		__m256d r1 = _mm256_load_pd(&rhs.p[4]);
+		__m256d r2 = _mm256_load_pd(&rhs.p[8]);
+		__m256d r3 = _mm256_load_pd(&rhs.p[12]);
+		// 左辺の各行は右辺の行の線形結合となる
+		for (unsigned int idx = 0U; idx < DBL4x4_CNT; idx += DBL4_CNT) {
+			__m256d tmp = _mm256_mul_pd(_mm256_broadcast_sd(&lhs.p[idx]), r0);
+			tmp = _mm256_fmadd_pd(_mm256_broadcast_sd(&lhs.p[idx + 1U]), r1, tmp);
+			tmp = _mm256_fmadd_pd(_mm256_broadcast_sd(&lhs.p[idx + 2U]), r2, tmp);
+			tmp = _mm256_fmadd_pd(_mm256_broadcast_sd(&lhs.p[idx + 3U]), r3, tmp);
+			_mm256_store_pd(&result.p[idx], tmp);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator*(CDMatrix4x4 const& lhs, double const& rhs) noexcept {
+		CDMatrix4x4 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator*(double const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator/(CDMatrix4x4 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		return lhs * rhs.inv();
+	}
+
+	DLAV_MATH_API CDMatrix4x4 const operator/(CDMatrix4x4 const& lhs, double const& rhs) noexcept {
+		CDMatrix4x4 result = lhs;
+		result /= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDVector3 const operator*(CDVector3 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		CDVector3 result = ZERO_DVT3;
+		__m256d tmp = _mm256_fmadd_pd(_mm256_broadcast_sd(&lhs.p[0]), _mm256_load_pd(&rhs.p[0]), _mm256_load_pd(&rhs.p[12]));
+		tmp = _mm256_fmadd_pd(_mm256_broadcast_sd(&lhs.p[1]), _mm256_load_pd(&rhs.p[4]), tmp);
+		tmp = _mm256_fmadd_pd(_mm256_broadcast_sd(&lhs.p[2]), _mm256_load_pd(&rhs.p[8]), tmp);
+		_mm256_store_pd(result.p, tmp);
+		return result;
+	}
+
+	DLAV_MATH_API CDVector3 const operator*(CDMatrix4x4 const& lhs, CDVector3 const& rhs) noexcept {
+		CDVector3 result = ZERO_DVT3;
+		__m256d vt = _mm256_blend_pd(_mm256_load_pd(rhs.p), _mm256_set1_pd(1.0), 0x8);
+		__m256d t0 = _mm256_mul_pd(_mm256_load_pd(&lhs.p[0]), vt);
+		__m256d t1 = _mm256_mul_pd(_mm256_load_pd(&lhs.p[4]), vt);
+		__m256d t2 = _mm256_mul_pd(_mm256_load_pd(&lhs.p[8]), vt);
+		__m256d t3 = _mm256_mul_pd(_mm256_load_pd(&lhs.p[12]), vt);
+		// 隣接成分の和を取り、128 bit 単位で寄せて各行の総和を並べる
+		__m256d h01 = _mm256_hadd_pd(t0, t1);
+		__m256d h23 = _mm256_hadd_pd(t2, t3);
+		_mm256_store_pd(result.p, _mm256_add_pd(_mm256_permute2f128_pd(h01, h23, 0x20), _mm256_permute2f128_pd(h01, h23, 0x31)));
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator==(CDMatrix4x4 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < DBL4x4_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CDMatrix4x4 const& lhs, CDMatrix4x4 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	DLAV_MATH_API CFMatrix4x4 const toFlt(CDMatrix4x4 const& arg) noexcept {
+		CFMatrix4x4 result = ZERO_FMTX4x4;
+		for (unsigned int idx = 0U; idx < DBL4x4_CNT; idx += DBL4_CNT) {
+			_mm_store_ps(&result.p[idx], _mm256_cvtpd_ps(_mm256_load_pd(&arg.p[idx])));
+		}
+		return result;
+	}
+
+	DLAV_MATH_API CFMatrix4x4 const toFlt(EHandSide const& hs, CDMatrix4x4 const& arg, CDVector3 const& origin) noexcept {
+		CFMatrix4x4 result = ZERO_FMTX4x4;
+		toFlt(hs, &result, &arg, origin, 1U);
+		return result;
+	}
+
+	DLAV_MATH_API void toFlt(EHandSide const& hs, CFMatrix4x4* const dst, CDMatrix4x4 const* const src, CDVector3 const& origin, size_t const& count) noexcept {
+		// 平行移動成分の位置に基準位置を並べた差分を、行毎に用意しておく
+		__m256d base[DBL4_CNT] = {
+			_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()
+		};
+		switch (hs) {
+		case EHandSide::LHS:
+			for (unsigned int i = 0U; i < DBL3_CNT; ++i) {
+				base[i] = _mm256_setr_pd(0.0, 0.0, 0.0, origin.p[i]);
+			}
+			break;
+		case EHandSide::RHS:
+			base[3] = _mm256_setr_pd(origin.p[0], origin.p[1], origin.p[2], 0.0);
+			break;
+		}
+		for (size_t idx = 0U; idx < count; ++idx) {
+			for (unsigned int i = 0U; i < DBL4_CNT; ++i) {
+				__m256d row = _mm256_sub_pd(_mm256_load_pd(&src[idx].p[i * DBL4_CNT]), base[i]);
+				_mm_store_ps(&dst[idx].p[i * FLT4_CNT], _mm256_cvtpd_ps(row));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+﻿/**	@file	CDQuaternion.hpp
+ *	@brief	倍精度浮動小数点数型四元数
+ */
+#pragma once
+#pragma warning(disable : 4324)
+#include "util/SDouble4.hpp"
+#include "CFQuaternion.hpp"
+#include "Math.hpp"
+#include <initializer_list>
+
+namespace dlav {
+	/**	@class	CDQuaternion
+	 *	@brief	倍精度浮動小数点数型四元数
+	 *	@note	32 byte に整列し、一本の __m256d で演算する。
+	 */
+	class alignas(32) CDQuaternion final : public SDouble4{
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CDQuaternion(CDQuaternion&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CDQuaternion(CDQuaternion const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CDQuaternion& operator=(CDQuaternion&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CDQuaternion& operator=(CDQuaternion const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CDQuaternion() noexcept;
+		//!	@brief	デストラクタ
+		~CDQuaternion() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		constexpr CDQuaternion(double const& x, double const& y, double const& z, double const& w) noexcept :
+			SDouble4{ x, y, z, w }
+		{}
+		//!	@brief	コンストラクタ
+		explicit CDQuaternion(std::initializer_list<double> const&) noexcept;
+		//!	@brief	変換コンストラクタ
+		explicit CDQuaternion(CFQuaternion const&) noexcept;
+
+		//!	@brief	複合加算演算子
+		CDQuaternion& operator+=(CDQuaternion const&) noexcept;
+		//!	@brief	複合減算演算子
+		CDQuaternion& operator-=(CDQuaternion const&) noexcept;
+		//!	@brief	複合スカラ倍演算子
+		CDQuaternion& operator*=(double const&) noexcept;
+		//!	@brief	複合スカラ割演算子
+		CDQuaternion& operator/=(double const&) noexcept;
+
+		//!	@brief	正規化関数
+		CDQuaternion const normalize() const noexcept;
+		//!	@brief	共役生成関数
+		CDQuaternion const conj() const noexcept;
+		//!	@brief	逆元生成関数
+		CDQuaternion const inv() const noexcept;
+		//!	@brief	ノルム二乗関数
+		double const sqnorm() const noexcept;
+		//!	@brief	ノルム関数
+		double const norm() const noexcept;
+
+		//!	@brief	単項加算演算子
+		CDQuaternion const operator+() const noexcept;
+		//!	@brief	単項減算演算子
+		CDQuaternion const operator-() const noexcept;
+	};
+	//!	@brief	内積関数
+	double const dot(CDQuaternion const&, CDQuaternion const&) noexcept;
+
+	//!	@brief	加算演算子
+	CDQuaternion const operator+(CDQuaternion const&, CDQuaternion const&) noexcept;
+	//!	@brief	減算演算子
+	CDQuaternion const operator-(CDQuaternion const&, CDQuaternion const&) noexcept;
+	//!	@brief	乗算演算子
+	CDQuaternion const operator*(CDQuaternion const&, CDQuaternion const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CDQuaternion const operator*(CDQuaternion const&, double const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CDQuaternion const operator*(double const&, CDQuaternion const&) noexcept;
+	//!	@brief	除算演算子
+	CDQuaternion const operator/(CDQuaternion const&, CDQuaternion const&) noexcept;
+	//!	@brief	スカラ割演算子
+	CDQuaternion const operator/(CDQuaternion const&, double const&) noexcept;
+
+	//!	@brief	等価比較演算子
+	bool const operator==(CDQuaternion const&, CDQuaternion const&) noexcept;
+	//!	@brief	不等価比較演算子
+	bool const operator!=(CDQuaternion const&, CDQuaternion const&) noexcept;
+
+	//!	@brief	単精度変換関数
+	CFQuaternion const toFlt(CDQuaternion const&) noexcept;
+
+	//!	@brief	倍精度浮動小数点数型の零四元数
+	static CDQuaternion constexpr ZERO_DQT = CDQuaternion(0.0, 0.0, 0.0, 0.0);
+	//!	@brief	倍精度浮動小数点数型の単位四元数
+	static CDQuaternion constexpr UNIT_DQT = CDQuaternion(0.0, 0.0, 0.0, 1.0);
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CDQuaternion.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+﻿/**	@file	CDQuaternion.inl
+ *	@brief	倍精度浮動小数点数型四元数
+ */
+#pragma once
+#include "CDQuaternion.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+#include <cfloat>
+
+namespace dlav {
+	DLAV_MATH_API CDQuaternion::CDQuaternion() noexcept :
+		SDouble4()
+	{}
+
+	DLAV_MATH_API CDQuaternion::CDQuaternion(std::initializer_list<double> const& args) noexcept :
+		SDouble4()
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= DBL4_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CDQuaternion::CDQuaternion(CFQuaternion const& arg) noexcept :
+		SDouble4()
+	{
+		_mm256_store_pd(p, _mm256_cvtps_pd(_mm_load_ps(arg.p)));
+	}
+
+	DLAV_MATH_API CDQuaternion& CDQuaternion::operator+=(CDQuaternion const& rhs) noexcept {
+		_mm256_store_pd(p, _mm256_add_pd(_mm256_load_pd(p), _mm256_load_pd(rhs.p)));
+		return *this;
+	}
+
+	DLAV_MATH_API CDQuaternion& CDQuaternion::operator-=(CDQuaternion const& rhs) noexcept {
+		_mm256_store_pd(p, _mm256_sub_pd(_mm256_load_pd(p), _mm256_load_pd(rhs.p)));
+		return *this;
+	}
+
+	DLAV_MATH_API CDQuaternion& CDQuaternion::operator*=(double const& rhs) noexcept {
+		_mm256_store_pd(p, _mm256_mul_pd(_mm256_load_pd(p), _mm256_set1_pd(rhs)));
+		return *this;
+	}
+
+	DLAV_MATH_API CDQuaternion& CDQuaternion::operator/=(double const& rhs) noexcept {
+		*this *= 1.0 / rhs;
+		return *this;
+	}
+
+	DLAV_MATH_API CDQuaternion const CDQuaternion::normalize() const noexcept {
+		CDQuaternion result;
+		double norm = this->norm();
+		if (compare(norm, 0.0) > 0) {
+			result = *this;
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API CDQuaternion const CDQuaternion::conj() const noexcept {
+		CDQuaternion result = ZERO_DQT;
+		_mm256_store_pd(result.p, _mm256_xor_pd(_mm256_load_pd(p), _mm256_setr_pd(-0.0, -0.0, -0.0, 0.0)));
+		return result;
+	}
+
+	DLAV_MATH_API CDQuaternion const CDQuaternion::inv() const noexcept {
+		CDQuaternion result = ZERO_DQT;
+		double norm = sqnorm();
+		if (norm >= DBL_EPSILON) {
+			result = conj();
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API double const CDQuaternion::sqnorm() const noexcept {
+		return dot(*this, *this);
+	}
+
+	DLAV_MATH_API double const CDQuaternion::norm() const noexcept {
+		return _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(sqnorm())));
+	}
+
+	DLAV_MATH_API CDQuaternion const CDQuaternion::operator+() const noexcept {
+		return *this;
+	}
+
+	DLAV_MATH_API CDQuaternion const CDQuaternion::operator-() const noexcept {
+		CDQuaternion result = ZERO_DQT;
+		_mm256_store_pd(result.p, _mm256_xor_pd(_mm256_load_pd(p), _mm256_set1_pd(-0.0)));
+		return result;
+	}
+
+	DLAV_MATH_API double const dot(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		__m256d tmp = _mm256_mul_pd(_mm256_load_pd(lhs.p), _mm256_load_pd(rhs.p));
+		__m128d sum = _mm_add_pd(_mm256_castpd256_pd128(tmp), _mm256_extractf128_pd(tmp, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+	}
+
+	DLAV_MATH_API CDQuaternion const operator+(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		CDQuaternion result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDQuaternion const operator-(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		CDQuaternion result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDQuaternion const operator*(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		CDQuaternion result = ZERO_DQT;
+		__m256d l = _mm256_load_pd(lhs.p);
+		__m256d r = _mm256_load_pd(rhs.p);
+
+		// 右辺を並べ替えて符号を反転し、左辺の各成分と積和を取る
+		__m256d tmp = _mm256_mul_pd(_mm256_permute4x64_pd(l, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		tmp = _mm256_fmadd_pd(_mm256_permute4x64_pd(l, _MM_SHUFFLE(0, 0, 0, 0)),
+			_mm256_xor_pd(_mm256_permute4x64_pd(r, _MM_SHUFFLE(0, 1, 2, 3)), _mm256_setr_pd(0.0, -0.0, 0.0, -0.0)), tmp);
+		tmp = _mm256_fmadd_pd(_mm256_permute4x64_pd(l, _MM_SHUFFLE(1, 1, 1, 1)),
+			_mm256_xor_pd(_mm256_permute4x64_pd(r, _MM_SHUFFLE(1, 0, 3, 2)), _mm256_setr_pd(0.0, 0.0, -0.0, -0.0)), tmp);
+		tmp = _mm256_fmadd_pd(_mm256_permute4x64_pd(l, _MM_SHUFFLE(2, 2, 2, 2)),
+			_mm256_xor_pd(_mm256_permute4x64_pd(r, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_setr_pd(-0.0, 0.0, 0.0, -0.0)), tmp);
+		_mm256_store_pd(result.p, tmp);
+		return result;
+	}
+
+	DLAV_MATH_API CDQuaternion const operator*(CDQuaternion const& lhs, double const& rhs) noexcept {
+		CDQuaternion result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDQuaternion const operator*(double const& lhs, CDQuaternion const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	DLAV_MATH_API CDQuaternion const operator/(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		return lhs * rhs.inv();
+	}
+
+	DLAV_MATH_API CDQuaternion const operator/(CDQuaternion const& lhs, double const& rhs) noexcept {
+		CDQuaternion result = lhs;
+		result /= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator==(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < DBL4_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CDQuaternion const& lhs, CDQuaternion const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	DLAV_MATH_API CFQuaternion const toFlt(CDQuaternion const& arg) noexcept {
+		CFQuaternion result = ZERO_FQT;
+		_mm_store_ps(result.p, _mm256_cvtpd_ps(_mm256_load_pd(arg.p)));
+		return result;
+	}
+}
\ No newline at end of file
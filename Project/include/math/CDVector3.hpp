@@ -0,0 +1,102 @@
+﻿/**	@file	CDVector3.hpp
+ *	@brief	倍精度浮動小数点数型三次元ベクトル
+ */
+#pragma once
+#pragma warning(disable : 4324)
+#include "util/SDouble3.hpp"
+#include "CFVector3.hpp"
+#include "Math.hpp"
+#include <initializer_list>
+
+namespace dlav {
+	/**	@class	CDVector3
+	 *	@brief	倍精度浮動小数点数型三次元ベクトル
+	 *	@note	原点から遠い位置を保持する為に用いる。
+	 *			32 byte に整列し、第四成分を詰め物として一本の __m256d で演算する。
+	 */
+	class alignas(32) CDVector3 final : public SDouble3{
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CDVector3(CDVector3&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CDVector3(CDVector3 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CDVector3& operator=(CDVector3&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CDVector3& operator=(CDVector3 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CDVector3() noexcept;
+		//!	@brief	デストラクタ
+		~CDVector3() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		constexpr CDVector3(double const& x, double const& y, double const& z) noexcept :
+			SDouble3{ x, y, z }
+		{}
+		//!	@brief	コンストラクタ
+		explicit CDVector3(std::initializer_list<double> const&) noexcept;
+		//!	@brief	変換コンストラクタ
+		explicit CDVector3(CFVector3 const&) noexcept;
+
+		//!	@brief	複合加算演算子
+		CDVector3& operator+=(CDVector3 const&) noexcept;
+		//!	@brief	複合減算演算子
+		CDVector3& operator-=(CDVector3 const&) noexcept;
+		//!	@brief	複合スカラ倍演算子
+		CDVector3& operator*=(double const&) noexcept;
+		//!	@brief	複合スカラ割演算子
+		CDVector3& operator/=(double const&) noexcept;
+
+		//!	@brief	正規化関数
+		CDVector3 const normalize() const noexcept;
+		//!	@brief	ノルム二乗関数
+		double const sqnorm() const noexcept;
+		//!	@brief	ノルム関数
+		double const norm() const noexcept;
+
+		//!	@brief	単項加算演算子
+		CDVector3 const operator+() const noexcept;
+		//!	@brief	単項減算演算子
+		CDVector3 const operator-() const noexcept;
+	};
+	//!	@brief	内積関数
+	double const dot(CDVector3 const&, CDVector3 const&) noexcept;
+	//!	@brief	外積関数
+	CDVector3 const cross(CDVector3 const&, CDVector3 const&) noexcept;
+
+	//!	@brief	加算演算子
+	CDVector3 const operator+(CDVector3 const&, CDVector3 const&) noexcept;
+	//!	@brief	減算演算子
+	CDVector3 const operator-(CDVector3 const&, CDVector3 const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CDVector3 const operator*(CDVector3 const&, double const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CDVector3 const operator*(double const&, CDVector3 const&) noexcept;
+	//!	@brief	スカラ割演算子
+	CDVector3 const operator/(CDVector3 const&, double const&) noexcept;
+
+	//!	@brief	等価比較演算子
+	bool const operator==(CDVector3 const&, CDVector3 const&) noexcept;
+	//!	@brief	不等価比較演算子
+	bool const operator!=(CDVector3 const&, CDVector3 const&) noexcept;
+
+	//!	@brief	単精度変換関数
+	CFVector3 const toFlt(CDVector3 const&) noexcept;
+	/**	@brief	相対座標変換関数
+	 *	@param[in] arg 対象の位置
+	 *	@param[in] origin 基準位置 (カメラ位置等)
+	 *	@return 基準位置からの相対位置
+	 *	@note	差分を倍精度のまま取ってから単精度へ丸める為、原点から遠くても桁落ちしない。
+	 */
+	CFVector3 const toFlt(CDVector3 const& arg, CDVector3 const& origin) noexcept;
+	//!	@brief	相対座標変換関数 (一括処理)
+	void toFlt(CFVector3* const dst, CDVector3 const* const src, CDVector3 const& origin, size_t const& count) noexcept;
+
+	//!	@brief	倍精度浮動小数点数型の三次元ゼロベクトル
+	static CDVector3 constexpr ZERO_DVT3 = CDVector3(0.0, 0.0, 0.0);
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CDVector3.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,159 @@
+﻿/**	@file	CDVector3.inl
+ *	@brief	倍精度浮動小数点数型三次元ベクトル
+ */
+#pragma once
+#include "CDVector3.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+
+namespace dlav {
+	DLAV_MATH_API CDVector3::CDVector3() noexcept :
+		SDouble3()
+	{}
+
+	DLAV_MATH_API CDVector3::CDVector3(std::initializer_list<double> const& args) noexcept :
+		SDouble3()
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= DBL3_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CDVector3::CDVector3(CFVector3 const& arg) noexcept :
+		SDouble3()
+	{
+		_mm256_store_pd(p, _mm256_cvtps_pd(_mm_load_ps(arg.p)));
+	}
+
+	DLAV_MATH_API CDVector3& CDVector3::operator+=(CDVector3 const& rhs) noexcept {
+		_mm256_store_pd(p, _mm256_add_pd(_mm256_load_pd(p), _mm256_load_pd(rhs.p)));
+		return *this;
+	}
+
+	DLAV_MATH_API CDVector3& CDVector3::operator-=(CDVector3 const& rhs) noexcept {
+		_mm256_store_pd(p, _mm256_sub_pd(_mm256_load_pd(p), _mm256_load_pd(rhs.p)));
+		return *this;
+	}
+
+	DLAV_MATH_API CDVector3& CDVector3::operator*=(double const& rhs) noexcept {
+		_mm256_store_pd(p, _mm256_mul_pd(_mm256_load_pd(p), _mm256_set1_pd(rhs)));
+		return *this;
+	}
+
+	DLAV_MATH_API CDVector3& CDVector3::operator/=(double const& rhs) noexcept {
+		*this *= 1.0 / rhs;
+		return *this;
+	}
+
+	DLAV_MATH_API CDVector3 const CDVector3::normalize() const noexcept {
+		CDVector3 result;
+		double norm = this->norm();
+		if (compare(norm, 0.0) > 0) {
+			result = *this;
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API double const CDVector3::sqnorm() const noexcept {
+		return dot(*this, *this);
+	}
+
+	DLAV_MATH_API double const CDVector3::norm() const noexcept {
+		// 近似の sqrt<double> では倍精度の有効桁を保てない為、命令で求める
+		return _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(sqnorm())));
+	}
+
+	DLAV_MATH_API CDVector3 const CDVector3::operator+() const noexcept {
+		return *this;
+	}
+
+	DLAV_MATH_API CDVector3 const CDVector3::operator-() const noexcept {
+		CDVector3 result = ZERO_DVT3;
+		_mm256_store_pd(result.p, _mm256_xor_pd(_mm256_load_pd(p), _mm256_set1_pd(-0.0)));
+		return result;
+	}
+
+	DLAV_MATH_API double const dot(CDVector3 const& lhs, CDVector3 const& rhs) noexcept {
+		// 第四成分は詰め物の為、積和の対象から外す
+		__m256d tmp = _mm256_mul_pd(_mm256_load_pd(lhs.p), _mm256_load_pd(rhs.p));
+		__m128d xy = _mm256_castpd256_pd128(tmp);
+		__m128d zw = _mm256_extractf128_pd(tmp, 1);
+		return _mm_cvtsd_f64(_mm_add_sd(_mm_add_sd(xy, _mm_unpackhi_pd(xy, xy)), zw));
+	}
+
+	DLAV_MATH_API CDVector3 const cross(CDVector3 const& vt1, CDVector3 const& vt2) noexcept {
+		CDVector3 result = ZERO_DVT3;
+		__m256d a = _mm256_load_pd(vt1.p);
+		__m256d b = _mm256_load_pd(vt2.p);
+		__m256d a_yzx = _mm256_permute4x64_pd(a, _MM_SHUFFLE(3, 0, 2, 1));
+		__m256d b_yzx = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 0, 2, 1));
+		__m256d tmp = _mm256_fmsub_pd(a, b_yzx, _mm256_mul_pd(a_yzx, b));
+		_mm256_store_pd(result.p, _mm256_permute4x64_pd(tmp, _MM_SHUFFLE(3, 0, 2, 1)));
+		return result;
+	}
+
+	DLAV_MATH_API CDVector3 const operator+(CDVector3 const& lhs, CDVector3 const& rhs) noexcept {
+		CDVector3 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDVector3 const operator-(CDVector3 const& lhs, CDVector3 const& rhs) noexcept {
+		CDVector3 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDVector3 const operator*(CDVector3 const& lhs, double const& rhs) noexcept {
+		CDVector3 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API CDVector3 const operator*(double const& lhs, CDVector3 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	DLAV_MATH_API CDVector3 const operator/(CDVector3 const& lhs, double const& rhs) noexcept {
+		CDVector3 result = lhs;
+		result /= rhs;
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator==(CDVector3 const& lhs, CDVector3 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < DBL3_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CDVector3 const& lhs, CDVector3 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	DLAV_MATH_API CFVector3 const toFlt(CDVector3 const& arg) noexcept {
+		CFVector3 result = ZERO_FVT3;
+		_mm_store_ps(result.p, _mm256_cvtpd_ps(_mm256_load_pd(arg.p)));
+		return result;
+	}
+
+	DLAV_MATH_API CFVector3 const toFlt(CDVector3 const& arg, CDVector3 const& origin) noexcept {
+		CFVector3 result = ZERO_FVT3;
+		_mm_store_ps(result.p, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_load_pd(arg.p), _mm256_load_pd(origin.p))));
+		return result;
+	}
+
+	DLAV_MATH_API void toFlt(CFVector3* const dst, CDVector3 const* const src, CDVector3 const& origin, size_t const& count) noexcept {
+		__m256d base = _mm256_load_pd(origin.p);
+		for (size_t idx = 0U; idx < count; ++idx) {
+			_mm_store_ps(dst[idx].p, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_load_pd(src[idx].p), base)));
+		}
+	}
+}
\ No newline at end of file
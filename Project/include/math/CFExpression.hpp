@@ -0,0 +1,469 @@
+﻿/**	@file	CFExpression.hpp
+ *	@brief	単精度浮動小数点数型の式テンプレート
+ */
+#pragma once
+#include <immintrin.h>
+#include <cassert>
+#include <type_traits>
+
+namespace dlav {
+	//!	@brief	要素数を持たない (全要素に同じ値が作用する) 式の要素数
+	static size_t constexpr EXPR_ANY_CNT = 0U;
+	//!	@brief	要素数が一致しない被演算子を含む式の要素数
+	static size_t constexpr EXPR_MISMATCH_CNT = ~static_cast<size_t>(0U);
+
+	/**	@struct	SExprLane128
+	 *	@brief	固定長の型の評価に用いる __m128 の演算
+	 *	@note	レジスタ型を直接テンプレート引数にすると属性が落ちる為、演算と型をこの構造体にまとめる。
+	 */
+	struct SExprLane128;
+	/**	@struct	SExprLane256
+	 *	@brief	ストリームの評価に用いる __m256 の演算
+	 */
+	struct SExprLane256;
+
+	/**	@class	CFExpr
+	 *	@brief	式テンプレートの基底クラス
+	 *	@note	派生クラスは template <typename V> typename V::type const eval(size_t const& idx, unsigned int const& comp) と
+	 *			size_t const size() を持つ。size() はストリームの要素数で、固定長の型とスカラは EXPR_ANY_CNT、
+	 *			要素数の異なるストリームを含む場合は EXPR_MISMATCH_CNT を返す。
+	 *			固定長の型 (CFVector3 等) は V = SExprLane128 で、ストリームは V = SExprLane256 で評価される。
+	 */
+	template <typename E>
+	class CFExpr {
+	public	:
+		//!	@brief	派生クラス取得関数
+		E const& self() const noexcept;
+	};
+
+	/**	@class	CFExprLeaf
+	 *	@brief	固定長の型を参照する葉
+	 *	@note	16 byte に整列された四成分以下の型 (CFVector3, CFVector4, CFQuaternion) に限る。
+	 *			参照を保持する為、式は同じ文の中で評価すること。
+	 */
+	template <typename T>
+	class CFExprLeaf final : public CFExpr<CFExprLeaf<T>> {
+	public	:
+		//!	@brief	コンストラクタ
+		explicit CFExprLeaf(T const&) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+	private	:
+		//!	@brief	参照先
+		T const& m_arg;
+	};
+
+	/**	@class	CFStreamLeaf
+	 *	@brief	SoA 形式のストリームを参照する葉
+	 *	@note	成分毎の先頭ポインタを保持し、評価時の成分番号で切り替える。
+	 */
+	class CFStreamLeaf final : public CFExpr<CFStreamLeaf> {
+	public	:
+		//!	@brief	コンストラクタ
+		CFStreamLeaf(float const* const x, float const* const y, float const* const z, size_t const& count) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+	private	:
+		//!	@brief	成分毎の先頭ポインタ
+		float const* m_comps[3U];
+		//!	@brief	要素数
+		size_t m_count;
+	};
+
+	/**	@class	CFExprScalar
+	 *	@brief	スカラ値の葉
+	 */
+	class CFExprScalar final : public CFExpr<CFExprScalar> {
+	public	:
+		//!	@brief	コンストラクタ
+		explicit CFExprScalar(float const&) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+	private	:
+		//!	@brief	値
+		float m_arg;
+	};
+
+	/**	@class	CFExprAdd
+	 *	@brief	加算の節
+	 *	@note	一方が乗算の節であれば積和 (FMA) に融合する。
+	 */
+	template <typename L, typename R>
+	class CFExprAdd final : public CFExpr<CFExprAdd<L, R>> {
+	public	:
+		//!	@brief	コンストラクタ
+		CFExprAdd(L const&, R const&) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+	private	:
+		//!	@brief	左辺
+		L m_lhs;
+		//!	@brief	右辺
+		R m_rhs;
+	};
+
+	/**	@class	CFExprSub
+	 *	@brief	減算の節
+	 *	@note	一方が乗算の節であれば積差 (FMA) に融合する。
+	 */
+	template <typename L, typename R>
+	class CFExprSub final : public CFExpr<CFExprSub<L, R>> {
+	public	:
+		//!	@brief	コンストラクタ
+		CFExprSub(L const&, R const&) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+	private	:
+		//!	@brief	左辺
+		L m_lhs;
+		//!	@brief	右辺
+		R m_rhs;
+	};
+
+	/**	@class	CFExprMul
+	 *	@brief	成分毎の乗算の節
+	 */
+	template <typename L, typename R>
+	class CFExprMul final : public CFExpr<CFExprMul<L, R>> {
+	public	:
+		//!	@brief	コンストラクタ
+		CFExprMul(L const&, R const&) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+		//!	@brief	左辺取得関数
+		L const& lhs() const noexcept;
+		//!	@brief	右辺取得関数
+		R const& rhs() const noexcept;
+
+	private	:
+		//!	@brief	左辺
+		L m_lhs;
+		//!	@brief	右辺
+		R m_rhs;
+	};
+
+	/**	@class	CFExprNeg
+	 *	@brief	符号反転の節
+	 */
+	template <typename E>
+	class CFExprNeg final : public CFExpr<CFExprNeg<E>> {
+	public	:
+		//!	@brief	コンストラクタ
+		explicit CFExprNeg(E const&) noexcept;
+
+		//!	@brief	評価関数
+		template <typename V>
+		typename V::type const eval(size_t const&, unsigned int const&) const noexcept;
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+
+	private	:
+		//!	@brief	対象
+		E m_arg;
+	};
+
+	/**	@struct	SExprOperand
+	 *	@brief	演算子の被演算子を式の節へ変換する特性
+	 *	@note	ストリーム型はそれぞれのヘッダで特殊化する。
+	 */
+	template <typename T, typename = void>
+	struct SExprOperand {
+		//!	@brief	被演算子として扱えるか否か
+		static bool constexpr ENABLED = false;
+	};
+
+	/**	@brief	被演算子の要素数の合成関数
+	 *	@return 一方が EXPR_ANY_CNT なら他方、一致すればその要素数、一致しなければ EXPR_MISMATCH_CNT
+	 */
+	size_t constexpr expr_count(size_t const& lhs, size_t const& rhs) noexcept;
+
+	/**	@brief	固定長の型を式の葉へ変換する関数
+	 *	@note	CFVector3 等は既に即時評価の演算子を持つ為、式として扱う場合は明示的に変換する。
+	 */
+	template <typename T>
+	CFExprLeaf<T> const lazy(T const&) noexcept;
+
+	/**	@brief	式評価関数
+	 *	@return 評価結果を格納した固定長の型
+	 */
+	template <typename T, typename E>
+	T const evaluate(CFExpr<E> const&) noexcept;
+
+	//!	@brief	加算演算子
+	template <typename L, typename R, std::enable_if_t<SExprOperand<L>::ENABLED && SExprOperand<R>::ENABLED, int> = 0>
+	auto const operator+(L const&, R const&) noexcept;
+	//!	@brief	減算演算子
+	template <typename L, typename R, std::enable_if_t<SExprOperand<L>::ENABLED && SExprOperand<R>::ENABLED, int> = 0>
+	auto const operator-(L const&, R const&) noexcept;
+	//!	@brief	乗算演算子
+	template <typename L, typename R, std::enable_if_t<SExprOperand<L>::ENABLED && SExprOperand<R>::ENABLED, int> = 0>
+	auto const operator*(L const&, R const&) noexcept;
+	//!	@brief	スカラ割演算子
+	template <typename L, std::enable_if_t<SExprOperand<L>::ENABLED, int> = 0>
+	auto const operator/(L const&, float const&) noexcept;
+	//!	@brief	単項減算演算子
+	template <typename E, std::enable_if_t<SExprOperand<E>::ENABLED, int> = 0>
+	auto const operator-(E const&) noexcept;
+
+	/* 実装 */
+
+	struct SExprLane128 {
+		using type = __m128;
+		static __m128 const set1(float const& arg) noexcept { return _mm_set1_ps(arg); }
+		static __m128 const add(__m128 const& lhs, __m128 const& rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+		static __m128 const sub(__m128 const& lhs, __m128 const& rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+		static __m128 const mul(__m128 const& lhs, __m128 const& rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+		static __m128 const neg(__m128 const& arg) noexcept { return _mm_xor_ps(arg, _mm_set1_ps(-0.0f)); }
+		static __m128 const fmadd(__m128 const& a, __m128 const& b, __m128 const& c) noexcept { return _mm_fmadd_ps(a, b, c); }
+		static __m128 const fmsub(__m128 const& a, __m128 const& b, __m128 const& c) noexcept { return _mm_fmsub_ps(a, b, c); }
+		static __m128 const fnmadd(__m128 const& a, __m128 const& b, __m128 const& c) noexcept { return _mm_fnmadd_ps(a, b, c); }
+	};
+
+	struct SExprLane256 {
+		using type = __m256;
+		static __m256 const set1(float const& arg) noexcept { return _mm256_set1_ps(arg); }
+		static __m256 const add(__m256 const& lhs, __m256 const& rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+		static __m256 const sub(__m256 const& lhs, __m256 const& rhs) noexcept { return _mm256_sub_ps(lhs, rhs); }
+		static __m256 const mul(__m256 const& lhs, __m256 const& rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+		static __m256 const neg(__m256 const& arg) noexcept { return _mm256_xor_ps(arg, _mm256_set1_ps(-0.0f)); }
+		static __m256 const fmadd(__m256 const& a, __m256 const& b, __m256 const& c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+		static __m256 const fmsub(__m256 const& a, __m256 const& b, __m256 const& c) noexcept { return _mm256_fmsub_ps(a, b, c); }
+		static __m256 const fnmadd(__m256 const& a, __m256 const& b, __m256 const& c) noexcept { return _mm256_fnmadd_ps(a, b, c); }
+	};
+
+	//!	@brief	乗算の節か否かの判定
+	template <typename T>
+	struct SIsExprMul : std::false_type {};
+
+	template <typename L, typename R>
+	struct SIsExprMul<CFExprMul<L, R>> : std::true_type {};
+
+	template <typename E>
+	struct SExprOperand<E, std::enable_if_t<std::is_base_of<CFExpr<E>, E>::value>> {
+		static bool constexpr ENABLED = true;
+		using type = E;
+		static E const& wrap(E const& arg) noexcept { return arg; }
+	};
+
+	template <>
+	struct SExprOperand<float> {
+		static bool constexpr ENABLED = true;
+		using type = CFExprScalar;
+		static CFExprScalar const wrap(float const& arg) noexcept { return CFExprScalar(arg); }
+	};
+
+	inline size_t constexpr expr_count(size_t const& lhs, size_t const& rhs) noexcept {
+		return lhs == EXPR_ANY_CNT ? rhs : rhs == EXPR_ANY_CNT || rhs == lhs ? lhs : EXPR_MISMATCH_CNT;
+	}
+
+	template <typename E>
+	inline E const& CFExpr<E>::self() const noexcept {
+		return static_cast<E const&>(*this);
+	}
+
+	template <typename T>
+	inline CFExprLeaf<T>::CFExprLeaf(T const& arg) noexcept :
+		m_arg(arg)
+	{}
+
+	template <typename T>
+	template <typename V>
+	inline typename V::type const CFExprLeaf<T>::eval(size_t const&, unsigned int const&) const noexcept {
+		static_assert(std::is_same<V, SExprLane128>::value, "fixed-size operands evaluate as SExprLane128");
+		return _mm_load_ps(m_arg.p);
+	}
+
+	template <typename T>
+	inline size_t const CFExprLeaf<T>::size() const noexcept {
+		return EXPR_ANY_CNT;
+	}
+
+	inline CFStreamLeaf::CFStreamLeaf(float const* const x, float const* const y, float const* const z, size_t const& count) noexcept :
+		m_comps{ x, y, z },
+		m_count(count)
+	{}
+
+	template <typename V>
+	inline typename V::type const CFStreamLeaf::eval(size_t const& idx, unsigned int const& comp) const noexcept {
+		static_assert(std::is_same<V, SExprLane256>::value, "stream operands evaluate as SExprLane256");
+		return _mm256_loadu_ps(m_comps[comp] + idx);
+	}
+
+	inline size_t const CFStreamLeaf::size() const noexcept {
+		return m_count;
+	}
+
+	inline CFExprScalar::CFExprScalar(float const& arg) noexcept :
+		m_arg(arg)
+	{}
+
+	template <typename V>
+	inline typename V::type const CFExprScalar::eval(size_t const&, unsigned int const&) const noexcept {
+		return V::set1(m_arg);
+	}
+
+	inline size_t const CFExprScalar::size() const noexcept {
+		return EXPR_ANY_CNT;
+	}
+
+	template <typename L, typename R>
+	inline CFExprAdd<L, R>::CFExprAdd(L const& lhs, R const& rhs) noexcept :
+		m_lhs(lhs),
+		m_rhs(rhs)
+	{}
+
+	template <typename L, typename R>
+	template <typename V>
+	inline typename V::type const CFExprAdd<L, R>::eval(size_t const& idx, unsigned int const& comp) const noexcept {
+		if constexpr (SIsExprMul<L>::value) {
+			return V::fmadd(m_lhs.lhs().template eval<V>(idx, comp), m_lhs.rhs().template eval<V>(idx, comp), m_rhs.template eval<V>(idx, comp));
+		}
+		else if constexpr (SIsExprMul<R>::value) {
+			return V::fmadd(m_rhs.lhs().template eval<V>(idx, comp), m_rhs.rhs().template eval<V>(idx, comp), m_lhs.template eval<V>(idx, comp));
+		}
+		else {
+			return V::add(m_lhs.template eval<V>(idx, comp), m_rhs.template eval<V>(idx, comp));
+		}
+	}
+
+	template <typename L, typename R>
+	inline size_t const CFExprAdd<L, R>::size() const noexcept {
+		return expr_count(m_lhs.size(), m_rhs.size());
+	}
+
+	template <typename L, typename R>
+	inline CFExprSub<L, R>::CFExprSub(L const& lhs, R const& rhs) noexcept :
+		m_lhs(lhs),
+		m_rhs(rhs)
+	{}
+
+	template <typename L, typename R>
+	template <typename V>
+	inline typename V::type const CFExprSub<L, R>::eval(size_t const& idx, unsigned int const& comp) const noexcept {
+		if constexpr (SIsExprMul<L>::value) {
+			return V::fmsub(m_lhs.lhs().template eval<V>(idx, comp), m_lhs.rhs().template eval<V>(idx, comp), m_rhs.template eval<V>(idx, comp));
+		}
+		else if constexpr (SIsExprMul<R>::value) {
+			return V::fnmadd(m_rhs.lhs().template eval<V>(idx, comp), m_rhs.rhs().template eval<V>(idx, comp), m_lhs.template eval<V>(idx, comp));
+		}
+		else {
+			return V::sub(m_lhs.template eval<V>(idx, comp), m_rhs.template eval<V>(idx, comp));
+		}
+	}
+
+	template <typename L, typename R>
+	inline size_t const CFExprSub<L, R>::size() const noexcept {
+		return expr_count(m_lhs.size(), m_rhs.size());
+	}
+
+	template <typename L, typename R>
+	inline CFExprMul<L, R>::CFExprMul(L const& lhs, R const& rhs) noexcept :
+		m_lhs(lhs),
+		m_rhs(rhs)
+	{}
+
+	template <typename L, typename R>
+	template <typename V>
+	inline typename V::type const CFExprMul<L, R>::eval(size_t const& idx, unsigned int const& comp) const noexcept {
+		return V::mul(m_lhs.template eval<V>(idx, comp), m_rhs.template eval<V>(idx, comp));
+	}
+
+	template <typename L, typename R>
+	inline size_t const CFExprMul<L, R>::size() const noexcept {
+		return expr_count(m_lhs.size(), m_rhs.size());
+	}
+
+	template <typename L, typename R>
+	inline L const& CFExprMul<L, R>::lhs() const noexcept {
+		return m_lhs;
+	}
+
+	template <typename L, typename R>
+	inline R const& CFExprMul<L, R>::rhs() const noexcept {
+		return m_rhs;
+	}
+
+	template <typename E>
+	inline CFExprNeg<E>::CFExprNeg(E const& arg) noexcept :
+		m_arg(arg)
+	{}
+
+	template <typename E>
+	template <typename V>
+	inline typename V::type const CFExprNeg<E>::eval(size_t const& idx, unsigned int const& comp) const noexcept {
+		return V::neg(m_arg.template eval<V>(idx, comp));
+	}
+
+	template <typename E>
+	inline size_t const CFExprNeg<E>::size() const noexcept {
+		return m_arg.size();
+	}
+
+	template <typename T>
+	inline CFExprLeaf<T> const lazy(T const& arg) noexcept {
+		static_assert(alignof(T) >= 16U && sizeof(T) == 16U, "lazy() requires a 16-byte aligned four-lane type");
+		return CFExprLeaf<T>(arg);
+	}
+
+	template <typename T, typename E>
+	inline T const evaluate(CFExpr<E> const& arg) noexcept {
+		T result;
+		_mm_store_ps(result.p, arg.self().template eval<SExprLane128>(0U, 0U));
+		return result;
+	}
+
+	template <typename L, typename R, std::enable_if_t<SExprOperand<L>::ENABLED && SExprOperand<R>::ENABLED, int>>
+	inline auto const operator+(L const& lhs, R const& rhs) noexcept {
+		return CFExprAdd<typename SExprOperand<L>::type, typename SExprOperand<R>::type>(SExprOperand<L>::wrap(lhs), SExprOperand<R>::wrap(rhs));
+	}
+
+	template <typename L, typename R, std::enable_if_t<SExprOperand<L>::ENABLED && SExprOperand<R>::ENABLED, int>>
+	inline auto const operator-(L const& lhs, R const& rhs) noexcept {
+		return CFExprSub<typename SExprOperand<L>::type, typename SExprOperand<R>::type>(SExprOperand<L>::wrap(lhs), SExprOperand<R>::wrap(rhs));
+	}
+
+	template <typename L, typename R, std::enable_if_t<SExprOperand<L>::ENABLED && SExprOperand<R>::ENABLED, int>>
+	inline auto const operator*(L const& lhs, R const& rhs) noexcept {
+		return CFExprMul<typename SExprOperand<L>::type, typename SExprOperand<R>::type>(SExprOperand<L>::wrap(lhs), SExprOperand<R>::wrap(rhs));
+	}
+
+	template <typename L, std::enable_if_t<SExprOperand<L>::ENABLED, int>>
+	inline auto const operator/(L const& lhs, float const& rhs) noexcept {
+		return lhs * (1.0f / rhs);
+	}
+
+	template <typename E, std::enable_if_t<SExprOperand<E>::ENABLED, int>>
+	inline auto const operator-(E const& arg) noexcept {
+		return CFExprNeg<typename SExprOperand<E>::type>(SExprOperand<E>::wrap(arg));
+	}
+}
\ No newline at end of file
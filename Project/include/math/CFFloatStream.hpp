@@ -0,0 +1,89 @@
+﻿/**	@file	CFFloatStream.hpp
+ *	@brief	単精度浮動小数点数型のストリーム
+ */
+#pragma once
+#include "CFExpression.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFFloatStream
+	 *	@brief	単精度浮動小数点数型のストリーム
+	 *	@note	SIMD 幅 (LANE_CNT) の倍数まで確保される為、式の評価は末尾の余剰要素まで一括で行う。
+	 *			式を代入すると、要素毎の一時配列を作らず一つのループで評価する。
+	 */
+	class CFFloatStream final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFFloatStream(CFFloatStream&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFFloatStream(CFFloatStream const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFFloatStream& operator=(CFFloatStream&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFFloatStream& operator=(CFFloatStream const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFFloatStream() noexcept;
+		//!	@brief	デストラクタ
+		~CFFloatStream() noexcept = default;
+
+		//!	@brief	初期化関数
+		CFFloatStream& init(size_t const& count, float const& value = 0.0f);
+
+		/**	@brief	式代入演算子
+		 *	@note	式に含まれるストリームの要素数が代入先と一致しない場合は何もしない。
+		 */
+		template <typename E>
+		CFFloatStream& operator=(CFExpr<E> const&) noexcept;
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	先頭ポインタ取得関数
+		float* const data() noexcept;
+		//!	@brief	先頭ポインタ取得関数
+		float const* const data() const noexcept;
+
+		//!	@brief	添え字演算子
+		float& operator[](size_t const&) noexcept;
+		//!	@brief	添え字演算子
+		float const& operator[](size_t const&) const noexcept;
+
+	private	:
+		//!	@brief	要素数
+		size_t m_count;
+		//!	@brief	要素
+		std::vector<float> m_data;
+	};
+
+	/**	@struct	SExprOperand
+	 *	@brief	CFFloatStream を式の葉として扱う特性
+	 */
+	template <>
+	struct SExprOperand<CFFloatStream> {
+		static bool constexpr ENABLED = true;
+		using type = CFStreamLeaf;
+		static CFStreamLeaf const wrap(CFFloatStream const& arg) noexcept {
+			return CFStreamLeaf(arg.data(), arg.data(), arg.data(), arg.size());
+		}
+	};
+
+	/* 実装 */
+
+	template <typename E>
+	inline CFFloatStream& CFFloatStream::operator=(CFExpr<E> const& arg) noexcept {
+		E const& expr = arg.self();
+		// 要素数の異なるストリームを含む式は短い方の確保領域を越えて読む為、評価しない
+		size_t count = expr.size();
+		assert(count == EXPR_ANY_CNT || count == m_count);
+		if (count != EXPR_ANY_CNT && count != m_count) {
+			return *this;
+		}
+		for (size_t idx = 0U; idx < m_data.size(); idx += LANE_CNT) {
+			_mm256_storeu_ps(&m_data[idx], expr.template eval<SExprLane256>(idx, 0U));
+		}
+		return *this;
+	}
+}
\ No newline at end of file
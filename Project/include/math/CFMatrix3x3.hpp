@@ -5,6 +5,8 @@
 #pragma warning(disable : 4324)
 #include "util/SFloat3x3.hpp"
 #include "CFVector3.hpp"
+#include "Math.hpp"
+#include <cfloat>
 #include <initializer_list>
 
 namespace dlav {
@@ -63,59 +65,59 @@ namespace dlav {
 		CFMatrix3x3& column_sop(unsigned int const& from, unsigned int const& to, float const&) noexcept;
 
 		//!	@brief	複合加算演算子
-		CFMatrix3x3& operator+=(CFMatrix3x3 const&) noexcept;
+		constexpr CFMatrix3x3& operator+=(CFMatrix3x3 const&) noexcept;
 		//!	@brief	複合減算演算子
-		CFMatrix3x3& operator-=(CFMatrix3x3 const&) noexcept;
+		constexpr CFMatrix3x3& operator-=(CFMatrix3x3 const&) noexcept;
 		//!	@brief	複合スカラ倍演算子
-		CFMatrix3x3& operator*=(float const&) noexcept;
+		constexpr CFMatrix3x3& operator*=(float const&) noexcept;
 		//!	@brief	複合スカラ割演算子
-		CFMatrix3x3& operator/=(float const&) noexcept;
+		constexpr CFMatrix3x3& operator/=(float const&) noexcept;
 
 		//!	@brief	行成分抽出関数
-		CFVector3 const row(unsigned int const&) const noexcept;
+		constexpr CFVector3 const row(unsigned int const&) const noexcept;
 		//!	@brief	列成分抽出関数
-		CFVector3 const column(unsigned int const&) const noexcept;
+		constexpr CFVector3 const column(unsigned int const&) const noexcept;
 
 		//!	@brief	余因子行列生成関数
-		CFMatrix3x3 const adj() const noexcept;
-		//!	@brief	逆行列生成関数
-		CFMatrix3x3 const inv() const noexcept;
+		constexpr CFMatrix3x3 const adj() const noexcept;
+		//!	@brief	逆行列生成関数 (行列式が行の長さの積の FLT_EPSILON 倍以下なら零行列)
+		constexpr CFMatrix3x3 const inv() const noexcept;
 		//!	@brief	転置行列生成関数
-		CFMatrix3x3 const transpose() const noexcept;
+		constexpr CFMatrix3x3 const transpose() const noexcept;
 		//!	@brief	行列式計算関数
-		float const det() const noexcept;
+		constexpr float const det() const noexcept;
 
 		//!	@brief	単項加算演算子
-		CFMatrix3x3 const operator+() const noexcept;
+		constexpr CFMatrix3x3 const operator+() const noexcept;
 		//!	@brief	単項減算演算子
-		CFMatrix3x3 const operator-() const noexcept;
+		constexpr CFMatrix3x3 const operator-() const noexcept;
 	};
 	//!	@brief	直積関数
-	CFMatrix3x3 const direct(CFVector3 const&, CFVector3 const&) noexcept;
+	constexpr CFMatrix3x3 const direct(CFVector3 const&, CFVector3 const&) noexcept;
 	//!	@brief	楔積関数
-	CFMatrix3x3 const wedge(CFVector3 const&, CFVector3 const&) noexcept;
+	constexpr CFMatrix3x3 const wedge(CFVector3 const&, CFVector3 const&) noexcept;
 
 	//!	@brief	加算演算子
-	CFMatrix3x3 const operator+(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFMatrix3x3 const operator+(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
 	//!	@brief	減算演算子
-	CFMatrix3x3 const operator-(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFMatrix3x3 const operator-(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
 	//!	@brief	乗算演算子
-	CFMatrix3x3 const operator*(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFMatrix3x3 const operator*(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFMatrix3x3 const operator*(CFMatrix3x3 const&, float const&) noexcept;
+	constexpr CFMatrix3x3 const operator*(CFMatrix3x3 const&, float const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFMatrix3x3 const operator*(float const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFMatrix3x3 const operator*(float const&, CFMatrix3x3 const&) noexcept;
 	//!	@brief	除算演算子
-	CFMatrix3x3 const operator/(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFMatrix3x3 const operator/(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFMatrix3x3 const operator/(CFMatrix3x3 const&, float const&) noexcept;
+	constexpr CFMatrix3x3 const operator/(CFMatrix3x3 const&, float const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFMatrix3x3 const operator/(float const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFMatrix3x3 const operator/(float const&, CFMatrix3x3 const&) noexcept;
 
 	//!	@brief	行列作用演算子
-	CFVector3 const operator*(CFVector3 const&, CFMatrix3x3 const&) noexcept;
+	constexpr CFVector3 const operator*(CFVector3 const&, CFMatrix3x3 const&) noexcept;
 	//!	@brief	行列作用演算子
-	CFVector3 const operator*(CFMatrix3x3 const&, CFVector3 const&) noexcept;
+	constexpr CFVector3 const operator*(CFMatrix3x3 const&, CFVector3 const&) noexcept;
 
 	//!	@brief	加算演算子
 	bool const operator==(CFMatrix3x3 const&, CFMatrix3x3 const&) noexcept;
@@ -134,4 +136,207 @@ namespace dlav {
 		0.0f, 1.0f, 0.0f,
 		0.0f, 0.0f, 1.0f
 	);
-}
\ No newline at end of file
+
+	//!	@brief	実行時に用いる SIMD 実装
+	namespace simd {
+		//!	@brief	加算関数
+		void add(CFMatrix3x3&, CFMatrix3x3 const&) noexcept;
+		//!	@brief	スカラ倍関数
+		void scale(CFMatrix3x3&, float const&) noexcept;
+	}
+
+	/* 実装 */
+
+	constexpr CFMatrix3x3& CFMatrix3x3::operator+=(CFMatrix3x3 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT3x3_CNT; ++idx) {
+				p[idx] += rhs.p[idx];
+			}
+		}
+		else {
+			simd::add(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFMatrix3x3& CFMatrix3x3::operator-=(CFMatrix3x3 const& rhs) noexcept {
+		*this += -rhs;
+		return *this;
+	}
+
+	constexpr CFMatrix3x3& CFMatrix3x3::operator*=(float const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT3x3_CNT; ++idx) {
+				p[idx] *= rhs;
+			}
+		}
+		else {
+			simd::scale(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFMatrix3x3& CFMatrix3x3::operator/=(float const& rhs) noexcept {
+		*this *= 1.0f / rhs;
+		return *this;
+	}
+
+	constexpr CFVector3 const CFMatrix3x3::row(unsigned int const& idx) const noexcept {
+		CFVector3 result = ZERO_FVT3;
+		if (idx >= FLT3_CNT) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			result.p[i] = p[idx * FLT3_CNT + i];
+		}
+		return result;
+	}
+
+	constexpr CFVector3 const CFMatrix3x3::column(unsigned int const& idx) const noexcept {
+		CFVector3 result = ZERO_FVT3;
+		if (idx >= FLT3_CNT) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			result.p[i] = p[i * FLT3_CNT + idx];
+		}
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const CFMatrix3x3::adj() const noexcept {
+		// 定数式では共用体の有効メンバ p のみ参照できる為、添字で余因子を展開する
+		return CFMatrix3x3(
+			p[4] * p[8] - p[5] * p[7], p[2] * p[7] - p[1] * p[8], p[1] * p[5] - p[2] * p[4],
+			p[5] * p[6] - p[3] * p[8], p[0] * p[8] - p[2] * p[6], p[2] * p[3] - p[0] * p[5],
+			p[3] * p[7] - p[4] * p[6], p[1] * p[6] - p[0] * p[7], p[0] * p[4] - p[1] * p[3]
+		);
+	}
+
+	constexpr CFMatrix3x3 const CFMatrix3x3::inv() const noexcept {
+		CFMatrix3x3 result = ZERO_FMTX3x3;
+		// 行列式の絶対値は行の長さの積以下 (Hadamard の不等式) の為、その積との比で特異かを判定する
+		// (行列全体の拡大縮小に依らず、行が一次従属に近い場合のみ零行列とする)
+		double bound = 1.0;
+		for (unsigned int row = 0U; row < 3U; ++row) {
+			double len = 0.0;
+			for (unsigned int col = 0U; col < 3U; ++col) {
+				double elem = static_cast<double>(p[row * 3U + col]);
+				len += elem * elem;
+			}
+			bound *= len;
+		}
+		float det = this->det();
+		double sq = static_cast<double>(det) * static_cast<double>(det);
+		if (sq > static_cast<double>(FLT_EPSILON) * static_cast<double>(FLT_EPSILON) * bound) {
+			result = adj();
+			result /= det;
+		}
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const CFMatrix3x3::transpose() const noexcept {
+		return CFMatrix3x3(
+			p[0], p[3], p[6],
+			p[1], p[4], p[7],
+			p[2], p[5], p[8]
+		);
+	}
+
+	constexpr float const CFMatrix3x3::det() const noexcept {
+		return p[0] * (p[4] * p[8] - p[5] * p[7])
+			+ p[1] * (p[5] * p[6] - p[3] * p[8])
+			+ p[2] * (p[3] * p[7] - p[4] * p[6]);
+	}
+
+	constexpr CFMatrix3x3 const CFMatrix3x3::operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr CFMatrix3x3 const CFMatrix3x3::operator-() const noexcept {
+		return *this * -1.0f;
+	}
+
+	constexpr CFMatrix3x3 const direct(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		CFMatrix3x3 result = ZERO_FMTX3x3;
+		for (unsigned int idx = 0U; idx < FLT3x3_CNT; ++idx) {
+			result.p[idx] = lhs.p[idx / FLT3_CNT] * rhs.p[idx % FLT3_CNT];
+		}
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const wedge(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		return direct(lhs, rhs) - direct(rhs, lhs);
+	}
+
+	constexpr CFMatrix3x3 const operator+(CFMatrix3x3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		CFMatrix3x3 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const operator-(CFMatrix3x3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		CFMatrix3x3 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const operator*(CFMatrix3x3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		CFMatrix3x3 result = ZERO_FMTX3x3;
+		for (unsigned int idx = 0U; idx < FLT3x3_CNT; ++idx) {
+			unsigned int dy = idx / FLT3_CNT;
+			unsigned int dx = idx % FLT3_CNT;
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				result.p[idx] += lhs.p[dy * FLT3_CNT + i] * rhs.p[i * FLT3_CNT + dx];
+			}
+		}
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const operator*(CFMatrix3x3 const& lhs, float const& rhs) noexcept {
+		CFMatrix3x3 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const operator*(float const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	constexpr CFMatrix3x3 const operator/(CFMatrix3x3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		return lhs * rhs.inv();
+	}
+
+	constexpr CFMatrix3x3 const operator/(CFMatrix3x3 const& lhs, float const& rhs) noexcept {
+		CFMatrix3x3 result = lhs;
+		result /= rhs;
+		return result;
+	}
+
+	constexpr CFMatrix3x3 const operator/(float const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		return rhs.inv() * lhs;
+	}
+
+	constexpr CFVector3 const operator*(CFVector3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		CFVector3 result = ZERO_FVT3;
+		for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				result.p[idx] += lhs.p[i] * rhs.p[i * FLT3_CNT + idx];
+			}
+		}
+		return result;
+	}
+
+	constexpr CFVector3 const operator*(CFMatrix3x3 const& lhs, CFVector3 const& rhs) noexcept {
+		CFVector3 result = ZERO_FVT3;
+		for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				result.p[idx] += lhs.p[idx * FLT3_CNT + i] * rhs.p[i];
+			}
+		}
+		return result;
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CFMatrix3x3.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,135 @@
+﻿/**	@file	CFMatrix3x3.inl
+ *	@brief	単精度浮動小数点数型三次正方行列
+ */
+#pragma once
+#include "CFMatrix3x3.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+#include <utility>
+
+namespace dlav {
+	DLAV_MATH_API CFMatrix3x3::CFMatrix3x3() noexcept :
+		SFloat3x3{}
+	{}
+
+	DLAV_MATH_API CFMatrix3x3::CFMatrix3x3(std::initializer_list<float> const& args) noexcept :
+		SFloat3x3{}
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= FLT3x3_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::row(unsigned int const& idx, CFVector3 const& arg) noexcept {
+		if (idx >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			p[idx * FLT3_CNT + i] = arg.p[i];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::column(unsigned int const& idx, CFVector3 const& arg) noexcept {
+		if (idx >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			p[i * FLT3_CNT + idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::row_swap(unsigned int const& from, unsigned int const& to) noexcept {
+		if (from == to || from >= FLT3_CNT || to >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			std::swap(p[from * FLT3_CNT + i], p[to * FLT3_CNT + i]);
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::column_swap(unsigned int const& from, unsigned int const& to) noexcept {
+		if (from == to || from >= FLT3_CNT || to >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			std::swap(p[i * FLT3_CNT + from], p[i * FLT3_CNT + to]);
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::row_scale(unsigned int const& idx, float const& amount) noexcept {
+		if (idx >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			p[idx * FLT3_CNT + i] *= amount;
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::column_scale(unsigned int const& idx, float const& amount) noexcept {
+		if (idx >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			p[i * FLT3_CNT + idx] *= amount;
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::row_sop(unsigned int const& from, unsigned int const& to, float const& amount) noexcept {
+		if (from == to || from >= FLT3_CNT || to >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			p[to * FLT3_CNT + i] += amount * p[from * FLT3_CNT + i];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix3x3& CFMatrix3x3::column_sop(unsigned int const& from, unsigned int const& to, float const& amount) noexcept {
+		if (from == to || from >= FLT3_CNT || to >= FLT3_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			p[i * FLT3_CNT + to] += amount * p[i * FLT3_CNT + from];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API bool const operator==(CFMatrix3x3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < FLT3x3_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CFMatrix3x3 const& lhs, CFMatrix3x3 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	namespace simd {
+		DLAV_MATH_API void add(CFMatrix3x3& lhs, CFMatrix3x3 const& rhs) noexcept {
+			// 末尾の三成分は整列用の余白であり、読み書きしても差し支えない
+			for (unsigned int idx = 0U; idx < FLT3x3_CNT; idx += 4U) {
+				_mm_store_ps(&lhs.p[idx], _mm_add_ps(_mm_load_ps(&lhs.p[idx]), _mm_load_ps(&rhs.p[idx])));
+			}
+		}
+
+		DLAV_MATH_API void scale(CFMatrix3x3& lhs, float const& rhs) noexcept {
+			__m128 tmp = _mm_set1_ps(rhs);
+			for (unsigned int idx = 0U; idx < FLT3x3_CNT; idx += 4U) {
+				_mm_store_ps(&lhs.p[idx], _mm_mul_ps(_mm_load_ps(&lhs.p[idx]), tmp));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #pragma warning(disable : 4324)
 #include "util/SFloat4x4.hpp"
 #include "CFVector4.hpp"
+#include "Math.hpp"
+#include <cfloat>
 #include <initializer_list>
 
 namespace dlav {
@@ -65,59 +67,59 @@ namespace dlav {
 		CFMatrix4x4& column_sop(unsigned int const& from, unsigned int const& to, float const&) noexcept;
 
 		//!	@brief	複合加算演算子
-		CFMatrix4x4& operator+=(CFMatrix4x4 const&) noexcept;
+		constexpr CFMatrix4x4& operator+=(CFMatrix4x4 const&) noexcept;
 		//!	@brief	複合減算演算子
-		CFMatrix4x4& operator-=(CFMatrix4x4 const&) noexcept;
+		constexpr CFMatrix4x4& operator-=(CFMatrix4x4 const&) noexcept;
 		//!	@brief	複合スカラ倍演算子
-		CFMatrix4x4& operator*=(float const&) noexcept;
+		constexpr CFMatrix4x4& operator*=(float const&) noexcept;
 		//!	@brief	複合スカラ割演算子
-		CFMatrix4x4& operator/=(float const&) noexcept;
+		constexpr CFMatrix4x4& operator/=(float const&) noexcept;
 
 		//!	@brief	行成分抽出関数
-		CFVector4 const row(unsigned int const&) const noexcept;
+		constexpr CFVector4 const row(unsigned int const&) const noexcept;
 		//!	@brief	列成分抽出関数
-		CFVector4 const column(unsigned int const&) const noexcept;
+		constexpr CFVector4 const column(unsigned int const&) const noexcept;
 
 		//!	@brief	余因子行列生成関数
-		CFMatrix4x4 const adj() const noexcept;
-		//!	@brief	逆行列生成関数
-		CFMatrix4x4 const inv() const noexcept;
+		constexpr CFMatrix4x4 const adj() const noexcept;
+		//!	@brief	逆行列生成関数 (行列式が行の長さの積の FLT_EPSILON 倍以下なら零行列)
+		constexpr CFMatrix4x4 const inv() const noexcept;
 		//!	@brief	転置行列生成関数
-		CFMatrix4x4 const transpose() const noexcept;
+		constexpr CFMatrix4x4 const transpose() const noexcept;
 		//!	@brief	行列式計算関数
-		float const det() const noexcept;
+		constexpr float const det() const noexcept;
 
 		//!	@brief	単項加算演算子
-		CFMatrix4x4 const operator+() const noexcept;
+		constexpr CFMatrix4x4 const operator+() const noexcept;
 		//!	@brief	単項減算演算子
-		CFMatrix4x4 const operator-() const noexcept;
+		constexpr CFMatrix4x4 const operator-() const noexcept;
 	};
 	//!	@brief	直積関数
-	CFMatrix4x4 const direct(CFVector4 const&, CFVector4 const&) noexcept;
+	constexpr CFMatrix4x4 const direct(CFVector4 const&, CFVector4 const&) noexcept;
 	//!	@brief	楔積関数
-	CFMatrix4x4 const wedge(CFVector4 const&, CFVector4 const&) noexcept;
+	constexpr CFMatrix4x4 const wedge(CFVector4 const&, CFVector4 const&) noexcept;
 
 	//!	@brief	加算演算子
-	CFMatrix4x4 const operator+(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFMatrix4x4 const operator+(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
 	//!	@brief	減算演算子
-	CFMatrix4x4 const operator-(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFMatrix4x4 const operator-(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
 	//!	@brief	乗算演算子
-	CFMatrix4x4 const operator*(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFMatrix4x4 const operator*(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFMatrix4x4 const operator*(CFMatrix4x4 const&, float const&) noexcept;
+	constexpr CFMatrix4x4 const operator*(CFMatrix4x4 const&, float const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFMatrix4x4 const operator*(float const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFMatrix4x4 const operator*(float const&, CFMatrix4x4 const&) noexcept;
 	//!	@brief	除算演算子
-	CFMatrix4x4 const operator/(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFMatrix4x4 const operator/(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFMatrix4x4 const operator/(CFMatrix4x4 const&, float const&) noexcept;
+	constexpr CFMatrix4x4 const operator/(CFMatrix4x4 const&, float const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFMatrix4x4 const operator/(float const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFMatrix4x4 const operator/(float const&, CFMatrix4x4 const&) noexcept;
 
 	//!	@brief	行列作用演算子
-	CFVector4 const operator*(CFVector4 const&, CFMatrix4x4 const&) noexcept;
+	constexpr CFVector4 const operator*(CFVector4 const&, CFMatrix4x4 const&) noexcept;
 	//!	@brief	行列作用演算子
-	CFVector4 const operator*(CFMatrix4x4 const&, CFVector4 const&) noexcept;
+	constexpr CFVector4 const operator*(CFMatrix4x4 const&, CFVector4 const&) noexcept;
 
 	//!	@brief	加算演算子
 	bool const operator==(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
@@ -138,4 +140,256 @@ namespace dlav {
 		0.0f, 0.0f, 1.0f, 0.0f,
 		0.0f, 0.0f, 0.0f, 1.0f
 	);
-}
\ No newline at end of file
+
+	//!	@brief	実行時に用いる SIMD 実装
+	namespace simd {
+		//!	@brief	加算関数
+		void add(CFMatrix4x4&, CFMatrix4x4 const&) noexcept;
+		//!	@brief	スカラ倍関数
+		void scale(CFMatrix4x4&, float const&) noexcept;
+		//!	@brief	転置関数
+		CFMatrix4x4 const transpose(CFMatrix4x4 const&) noexcept;
+		//!	@brief	乗算関数
+		CFMatrix4x4 const mul(CFMatrix4x4 const&, CFMatrix4x4 const&) noexcept;
+		//!	@brief	行列作用関数
+		CFVector4 const mul(CFVector4 const&, CFMatrix4x4 const&) noexcept;
+		//!	@brief	行列作用関数
+		CFVector4 const mul(CFMatrix4x4 const&, CFVector4 const&) noexcept;
+	}
+
+	/* 実装 */
+
+	constexpr CFMatrix4x4& CFMatrix4x4::operator+=(CFMatrix4x4 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT4x4_CNT; ++idx) {
+				p[idx] += rhs.p[idx];
+			}
+		}
+		else {
+			simd::add(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFMatrix4x4& CFMatrix4x4::operator-=(CFMatrix4x4 const& rhs) noexcept {
+		*this += -rhs;
+		return *this;
+	}
+
+	constexpr CFMatrix4x4& CFMatrix4x4::operator*=(float const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT4x4_CNT; ++idx) {
+				p[idx] *= rhs;
+			}
+		}
+		else {
+			simd::scale(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFMatrix4x4& CFMatrix4x4::operator/=(float const& rhs) noexcept {
+		*this *= 1.0f / rhs;
+		return *this;
+	}
+
+	constexpr CFVector4 const CFMatrix4x4::row(unsigned int const& idx) const noexcept {
+		CFVector4 result = ZERO_FVT4;
+		if (idx >= FLT4_CNT) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			result.p[i] = p[idx * FLT4_CNT + i];
+		}
+		return result;
+	}
+
+	constexpr CFVector4 const CFMatrix4x4::column(unsigned int const& idx) const noexcept {
+		CFVector4 result = ZERO_FVT4;
+		if (idx >= FLT4_CNT) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			result.p[i] = p[i * FLT4_CNT + idx];
+		}
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const CFMatrix4x4::adj() const noexcept {
+		// 上二行と下二行の二次小行列式から余因子を組み立てる
+		float s0 = p[0] * p[5] - p[4] * p[1];
+		float s1 = p[0] * p[6] - p[4] * p[2];
+		float s2 = p[0] * p[7] - p[4] * p[3];
+		float s3 = p[1] * p[6] - p[5] * p[2];
+		float s4 = p[1] * p[7] - p[5] * p[3];
+		float s5 = p[2] * p[7] - p[6] * p[3];
+		float c0 = p[8] * p[13] - p[12] * p[9];
+		float c1 = p[8] * p[14] - p[12] * p[10];
+		float c2 = p[8] * p[15] - p[12] * p[11];
+		float c3 = p[9] * p[14] - p[13] * p[10];
+		float c4 = p[9] * p[15] - p[13] * p[11];
+		float c5 = p[10] * p[15] - p[14] * p[11];
+		return CFMatrix4x4(
+			 p[5] * c5 - p[6] * c4 + p[7] * c3,
+			-p[1] * c5 + p[2] * c4 - p[3] * c3,
+			 p[13] * s5 - p[14] * s4 + p[15] * s3,
+			-p[9] * s5 + p[10] * s4 - p[11] * s3,
+			-p[4] * c5 + p[6] * c2 - p[7] * c1,
+			 p[0] * c5 - p[2] * c2 + p[3] * c1,
+			-p[12] * s5 + p[14] * s2 - p[15] * s1,
+			 p[8] * s5 - p[10] * s2 + p[11] * s1,
+			 p[4] * c4 - p[5] * c2 + p[7] * c0,
+			-p[0] * c4 + p[1] * c2 - p[3] * c0,
+			 p[12] * s4 - p[13] * s2 + p[15] * s0,
+			-p[8] * s4 + p[9] * s2 - p[11] * s0,
+			-p[4] * c3 + p[5] * c1 - p[6] * c0,
+			 p[0] * c3 - p[1] * c1 + p[2] * c0,
+			-p[12] * s3 + p[13] * s1 - p[14] * s0,
+			 p[8] * s3 - p[9] * s1 + p[10] * s0
+		);
+	}
+
+	constexpr CFMatrix4x4 const CFMatrix4x4::inv() const noexcept {
+		CFMatrix4x4 result = ZERO_FMTX4x4;
+		// 行列式の絶対値は行の長さの積以下 (Hadamard の不等式) の為、その積との比で特異かを判定する
+		// (行列全体の拡大縮小に依らず、行が一次従属に近い場合のみ零行列とする)
+		double bound = 1.0;
+		for (unsigned int row = 0U; row < 4U; ++row) {
+			double len = 0.0;
+			for (unsigned int col = 0U; col < 4U; ++col) {
+				double elem = static_cast<double>(p[row * 4U + col]);
+				len += elem * elem;
+			}
+			bound *= len;
+		}
+		float det = this->det();
+		double sq = static_cast<double>(det) * static_cast<double>(det);
+		if (sq > static_cast<double>(FLT_EPSILON) * static_cast<double>(FLT_EPSILON) * bound) {
+			result = adj();
+			result /= det;
+		}
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const CFMatrix4x4::transpose() const noexcept {
+		if (is_constant_evaluated()) {
+			return CFMatrix4x4(
+				p[0], p[4], p[8], p[12],
+				p[1], p[5], p[9], p[13],
+				p[2], p[6], p[10], p[14],
+				p[3], p[7], p[11], p[15]
+			);
+		}
+		return simd::transpose(*this);
+	}
+
+	constexpr float const CFMatrix4x4::det() const noexcept {
+		return (p[0] * p[5] - p[4] * p[1]) * (p[10] * p[15] - p[14] * p[11])
+			- (p[0] * p[6] - p[4] * p[2]) * (p[9] * p[15] - p[13] * p[11])
+			+ (p[0] * p[7] - p[4] * p[3]) * (p[9] * p[14] - p[13] * p[10])
+			+ (p[1] * p[6] - p[5] * p[2]) * (p[8] * p[15] - p[12] * p[11])
+			- (p[1] * p[7] - p[5] * p[3]) * (p[8] * p[14] - p[12] * p[10])
+			+ (p[2] * p[7] - p[6] * p[3]) * (p[8] * p[13] - p[12] * p[9]);
+	}
+
+	constexpr CFMatrix4x4 const CFMatrix4x4::operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr CFMatrix4x4 const CFMatrix4x4::operator-() const noexcept {
+		return *this * -1.0f;
+	}
+
+	constexpr CFMatrix4x4 const direct(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		CFMatrix4x4 result = ZERO_FMTX4x4;
+		for (unsigned int idx = 0U; idx < FLT4x4_CNT; ++idx) {
+			result.p[idx] = lhs.p[idx / FLT4_CNT] * rhs.p[idx % FLT4_CNT];
+		}
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const wedge(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		return direct(lhs, rhs) - direct(rhs, lhs);
+	}
+
+	constexpr CFMatrix4x4 const operator+(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		CFMatrix4x4 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const operator-(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		CFMatrix4x4 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const operator*(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			CFMatrix4x4 result = ZERO_FMTX4x4;
+			for (unsigned int idx = 0U; idx < FLT4x4_CNT; ++idx) {
+				unsigned int dy = idx / FLT4_CNT;
+				unsigned int dx = idx % FLT4_CNT;
+				for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+					result.p[idx] += lhs.p[dy * FLT4_CNT + i] * rhs.p[i * FLT4_CNT + dx];
+				}
+			}
+			return result;
+		}
+		return simd::mul(lhs, rhs);
+	}
+
+	constexpr CFMatrix4x4 const operator*(CFMatrix4x4 const& lhs, float const& rhs) noexcept {
+		CFMatrix4x4 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const operator*(float const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	constexpr CFMatrix4x4 const operator/(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		return lhs * rhs.inv();
+	}
+
+	constexpr CFMatrix4x4 const operator/(CFMatrix4x4 const& lhs, float const& rhs) noexcept {
+		CFMatrix4x4 result = lhs;
+		result /= rhs;
+		return result;
+	}
+
+	constexpr CFMatrix4x4 const operator/(float const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		return rhs.inv() * lhs;
+	}
+
+	constexpr CFVector4 const operator*(CFVector4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			CFVector4 result = ZERO_FVT4;
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+					result.p[idx] += lhs.p[i] * rhs.p[i * FLT4_CNT + idx];
+				}
+			}
+			return result;
+		}
+		return simd::mul(lhs, rhs);
+	}
+
+	constexpr CFVector4 const operator*(CFMatrix4x4 const& lhs, CFVector4 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			CFVector4 result = ZERO_FVT4;
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+					result.p[idx] += lhs.p[idx * FLT4_CNT + i] * rhs.p[i];
+				}
+			}
+			return result;
+		}
+		return simd::mul(lhs, rhs);
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CFMatrix4x4.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+﻿/**	@file	CFMatrix4x4.inl
+ *	@brief	単精度浮動小数点数型四次正方行列
+ */
+#pragma once
+#include "CFMatrix4x4.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+#include <utility>
+
+namespace dlav {
+	DLAV_MATH_API CFMatrix4x4::CFMatrix4x4() noexcept :
+		SFloat4x4{}
+	{}
+
+	DLAV_MATH_API CFMatrix4x4::CFMatrix4x4(std::initializer_list<float> const& args) noexcept :
+		SFloat4x4{}
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= FLT4x4_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::row(unsigned int const& idx, CFVector4 const& arg) noexcept {
+		if (idx >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			p[idx * FLT4_CNT + i] = arg.p[i];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::column(unsigned int const& idx, CFVector4 const& arg) noexcept {
+		if (idx >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			p[i * FLT4_CNT + idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::row_swap(unsigned int const& from, unsigned int const& to) noexcept {
+		if (from == to || from >= FLT4_CNT || to >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			std::swap(p[from * FLT4_CNT + i], p[to * FLT4_CNT + i]);
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::column_swap(unsigned int const& from, unsigned int const& to) noexcept {
+		if (from == to || from >= FLT4_CNT || to >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			std::swap(p[i * FLT4_CNT + from], p[i * FLT4_CNT + to]);
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::row_scale(unsigned int const& idx, float const& amount) noexcept {
+		if (idx >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			p[idx * FLT4_CNT + i] *= amount;
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::column_scale(unsigned int const& idx, float const& amount) noexcept {
+		if (idx >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			p[i * FLT4_CNT + idx] *= amount;
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::row_sop(unsigned int const& from, unsigned int const& to, float const& amount) noexcept {
+		if (from == to || from >= FLT4_CNT || to >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			p[to * FLT4_CNT + i] += amount * p[from * FLT4_CNT + i];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API CFMatrix4x4& CFMatrix4x4::column_sop(unsigned int const& from, unsigned int const& to, float const& amount) noexcept {
+		if (from == to || from >= FLT4_CNT || to >= FLT4_CNT) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			p[i * FLT4_CNT + to] += amount * p[i * FLT4_CNT + from];
+		}
+		return *this;
+	}
+
+	DLAV_MATH_API bool const operator==(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < FLT4x4_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	namespace simd {
+		DLAV_MATH_API void add(CFMatrix4x4& lhs, CFMatrix4x4 const& rhs) noexcept {
+			for (unsigned int idx = 0U; idx < FLT4x4_CNT; idx += 4U) {
+				_mm_store_ps(&lhs.p[idx], _mm_add_ps(_mm_load_ps(&lhs.p[idx]), _mm_load_ps(&rhs.p[idx])));
+			}
+		}
+
+		DLAV_MATH_API void scale(CFMatrix4x4& lhs, float const& rhs) noexcept {
+			__m128 tmp = _mm_set1_ps(rhs);
+			for (unsigned int idx = 0U; idx < FLT4x4_CNT; idx += 4U) {
+				_mm_store_ps(&lhs.p[idx], _mm_mul_ps(_mm_load_ps(&lhs.p[idx]), tmp));
+			}
+		}
+
+		DLAV_MATH_API CFMatrix4x4 const transpose(CFMatrix4x4 const& arg) noexcept {
+			CFMatrix4x4 result = ZERO_FMTX4x4;
+			__m128 r0 = _mm_load_ps(&arg.p[0]);
+			__m128 r1 = _mm_load_ps(&arg.p[4]);
+			__m128 r2 = _mm_load_ps(&arg.p[8]);
+			__m128 r3 = _mm_load_ps(&arg.p[12]);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_store_ps(&result.p[0], r0);
+			_mm_store_ps(&result.p[4], r1);
+			_mm_store_ps(&result.p[8], r2);
+			_mm_store_ps(&result.p[12], r3);
+			return result;
+		}
+
+		DLAV_MATH_API CFMatrix4x4 const mul(CFMatrix4x4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+			CFMatrix4x4 result = ZERO_FMTX4x4;
+			__m128 r0 = _mm_load_ps(&rhs.p[0]);
+			__m128 r1 = _mm_load_ps(&rhs.p[4]);
+			__m128 r2 = _mm_load_ps(&rhs.p[8]);
+			__m128 r3 = _mm_load_ps(&rhs.p[12]);
+			// 左辺の各行は右辺の行の線形結合となる
+			for (unsigned int idx = 0U; idx < FLT4x4_CNT; idx += 4U) {
+				__m128 tmp = _mm_mul_ps(_mm_set1_ps(lhs.p[idx]), r0);
+				tmp = _mm_fmadd_ps(_mm_set1_ps(lhs.p[idx + 1U]), r1, tmp);
+				tmp = _mm_fmadd_ps(_mm_set1_ps(lhs.p[idx + 2U]), r2, tmp);
+				tmp = _mm_fmadd_ps(_mm_set1_ps(lhs.p[idx + 3U]), r3, tmp);
+				_mm_store_ps(&result.p[idx], tmp);
+			}
+			return result;
+		}
+
+		DLAV_MATH_API CFVector4 const mul(CFVector4 const& lhs, CFMatrix4x4 const& rhs) noexcept {
+			CFVector4 result = ZERO_FVT4;
+			__m128 tmp = _mm_mul_ps(_mm_set1_ps(lhs.p[0]), _mm_load_ps(&rhs.p[0]));
+			tmp = _mm_fmadd_ps(_mm_set1_ps(lhs.p[1]), _mm_load_ps(&rhs.p[4]), tmp);
+			tmp = _mm_fmadd_ps(_mm_set1_ps(lhs.p[2]), _mm_load_ps(&rhs.p[8]), tmp);
+			tmp = _mm_fmadd_ps(_mm_set1_ps(lhs.p[3]), _mm_load_ps(&rhs.p[12]), tmp);
+			_mm_store_ps(result.p, tmp);
+			return result;
+		}
+
+		DLAV_MATH_API CFVector4 const mul(CFMatrix4x4 const& lhs, CFVector4 const& rhs) noexcept {
+			CFVector4 result = ZERO_FVT4;
+			__m128 vt = _mm_load_ps(rhs.p);
+			__m128 tmp = _mm_dp_ps(_mm_load_ps(&lhs.p[0]), vt, 0xF1);
+			tmp = _mm_or_ps(tmp, _mm_dp_ps(_mm_load_ps(&lhs.p[4]), vt, 0xF2));
+			tmp = _mm_or_ps(tmp, _mm_dp_ps(_mm_load_ps(&lhs.p[8]), vt, 0xF4));
+			tmp = _mm_or_ps(tmp, _mm_dp_ps(_mm_load_ps(&lhs.p[12]), vt, 0xF8));
+			_mm_store_ps(result.p, tmp);
+			return result;
+		}
+	}
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #pragma once
 #pragma warning(disable : 4324)
 #include "util/SFloat4.hpp"
+#include "Math.hpp"
+#include <cfloat>
 #include <initializer_list>
 
 namespace dlav {
@@ -34,49 +36,49 @@ namespace dlav {
 		explicit CFQuaternion(std::initializer_list<float> const&) noexcept;
 
 		//!	@brief	複合加算演算子
-		CFQuaternion& operator+=(CFQuaternion const&) noexcept;
+		constexpr CFQuaternion& operator+=(CFQuaternion const&) noexcept;
 		//!	@brief	複合減算演算子
-		CFQuaternion& operator-=(CFQuaternion const&) noexcept;
+		constexpr CFQuaternion& operator-=(CFQuaternion const&) noexcept;
 		//!	@brief	複合スカラ倍演算子
-		CFQuaternion& operator*=(float const&) noexcept;
+		constexpr CFQuaternion& operator*=(float const&) noexcept;
 		//!	@brief	複合スカラ割演算子
-		CFQuaternion& operator/=(float const&) noexcept;
+		constexpr CFQuaternion& operator/=(float const&) noexcept;
 
 		//!	@brief	正規化関数
 		CFQuaternion const normalize() const noexcept;
 		//!	@brief	共役生成関数
-		CFQuaternion const conj() const noexcept;
+		constexpr CFQuaternion const conj() const noexcept;
 		//!	@brief	逆元生成関数
-		CFQuaternion const inv() const noexcept;
+		constexpr CFQuaternion const inv() const noexcept;
 		//!	@brief	ノルム二乗関数
-		float const sqnorm() const noexcept;
+		constexpr float const sqnorm() const noexcept;
 		//!	@brief	ノルム関数
 		float const norm() const noexcept;
 
 		//!	@brief	単項加算演算子
-		CFQuaternion const operator+() const noexcept;
+		constexpr CFQuaternion const operator+() const noexcept;
 		//!	@brief	単項減算演算子
-		CFQuaternion const operator-() const noexcept;
+		constexpr CFQuaternion const operator-() const noexcept;
 	};
 	//!	@brief	内積関数
-	float const dot(CFQuaternion const&, CFQuaternion const&) noexcept;
+	constexpr float const dot(CFQuaternion const&, CFQuaternion const&) noexcept;
 
 	//!	@brief	加算演算子
-	CFQuaternion const operator+(CFQuaternion const&, CFQuaternion const&) noexcept;
+	constexpr CFQuaternion const operator+(CFQuaternion const&, CFQuaternion const&) noexcept;
 	//!	@brief	減算演算子
-	CFQuaternion const operator-(CFQuaternion const&, CFQuaternion const&) noexcept;
+	constexpr CFQuaternion const operator-(CFQuaternion const&, CFQuaternion const&) noexcept;
 	//!	@brief	乗算演算子
-	CFQuaternion const operator*(CFQuaternion const&, CFQuaternion const&) noexcept;
+	constexpr CFQuaternion const operator*(CFQuaternion const&, CFQuaternion const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFQuaternion const operator*(CFQuaternion const&, float const&) noexcept;
+	constexpr CFQuaternion const operator*(CFQuaternion const&, float const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFQuaternion const operator*(float const&, CFQuaternion const&) noexcept;
+	constexpr CFQuaternion const operator*(float const&, CFQuaternion const&) noexcept;
 	//!	@brief	除算演算子
-	CFQuaternion const operator/(CFQuaternion const&, CFQuaternion const&) noexcept;
+	constexpr CFQuaternion const operator/(CFQuaternion const&, CFQuaternion const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFQuaternion const operator/(CFQuaternion const&, float const&) noexcept;
+	constexpr CFQuaternion const operator/(CFQuaternion const&, float const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFQuaternion const operator/(float const&, CFQuaternion const&) noexcept;
+	constexpr CFQuaternion const operator/(float const&, CFQuaternion const&) noexcept;
 
 	//!	@brief	等価比較演算子
 	bool const operator==(CFQuaternion const&, CFQuaternion const&) noexcept;
@@ -87,4 +89,139 @@ namespace dlav {
 	static CFQuaternion constexpr ZERO_FQT = CFQuaternion(0.0f, 0.0f, 0.0f, 0.0f);
 	//!	@brief	単精度浮動小数点数型の単位四元数
 	static CFQuaternion constexpr UNIT_FQT = CFQuaternion(0.0f, 0.0f, 0.0f, 1.0f);
-}
\ No newline at end of file
+
+	//!	@brief	実行時に用いる SIMD 実装
+	namespace simd {
+		//!	@brief	加算関数
+		void add(CFQuaternion&, CFQuaternion const&) noexcept;
+		//!	@brief	スカラ倍関数
+		void scale(CFQuaternion&, float const&) noexcept;
+		//!	@brief	内積関数
+		float const dot(CFQuaternion const&, CFQuaternion const&) noexcept;
+		//!	@brief	乗算関数
+		CFQuaternion const mul(CFQuaternion const&, CFQuaternion const&) noexcept;
+	}
+
+	/* 実装 */
+
+	constexpr CFQuaternion& CFQuaternion::operator+=(CFQuaternion const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				p[idx] += rhs.p[idx];
+			}
+		}
+		else {
+			simd::add(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFQuaternion& CFQuaternion::operator-=(CFQuaternion const& rhs) noexcept {
+		*this += -rhs;
+		return *this;
+	}
+
+	constexpr CFQuaternion& CFQuaternion::operator*=(float const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				p[idx] *= rhs;
+			}
+		}
+		else {
+			simd::scale(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFQuaternion& CFQuaternion::operator/=(float const& rhs) noexcept {
+		*this *= 1.0f / rhs;
+		return *this;
+	}
+
+	constexpr CFQuaternion const CFQuaternion::conj() const noexcept {
+		return CFQuaternion(-p[0], -p[1], -p[2], p[3]);
+	}
+
+	constexpr CFQuaternion const CFQuaternion::inv() const noexcept {
+		CFQuaternion result = ZERO_FQT;
+		float norm = sqnorm();
+		if (norm >= FLT_EPSILON) {
+			result = conj();
+			result /= norm;
+		}
+		return result;
+	}
+
+	constexpr float const CFQuaternion::sqnorm() const noexcept {
+		return dot(*this, *this);
+	}
+
+	constexpr CFQuaternion const CFQuaternion::operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr CFQuaternion const CFQuaternion::operator-() const noexcept {
+		return *this * -1.0f;
+	}
+
+	constexpr float const dot(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			return lhs.p[0] * rhs.p[0] + lhs.p[1] * rhs.p[1] + lhs.p[2] * rhs.p[2] + lhs.p[3] * rhs.p[3];
+		}
+		return simd::dot(lhs, rhs);
+	}
+
+	constexpr CFQuaternion const operator+(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		CFQuaternion result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	constexpr CFQuaternion const operator-(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		CFQuaternion result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	constexpr CFQuaternion const operator*(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			float const* l = lhs.p;
+			float const* r = rhs.p;
+			return CFQuaternion(
+				l[3] * r[0] + l[0] * r[3] + l[1] * r[2] - l[2] * r[1],
+				l[3] * r[1] - l[0] * r[2] + l[1] * r[3] + l[2] * r[0],
+				l[3] * r[2] + l[0] * r[1] - l[1] * r[0] + l[2] * r[3],
+				l[3] * r[3] - l[0] * r[0] - l[1] * r[1] - l[2] * r[2]
+			);
+		}
+		return simd::mul(lhs, rhs);
+	}
+
+	constexpr CFQuaternion const operator*(CFQuaternion const& lhs, float const& rhs) noexcept {
+		CFQuaternion result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	constexpr CFQuaternion const operator*(float const& lhs, CFQuaternion const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	constexpr CFQuaternion const operator/(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		return lhs * rhs.inv();
+	}
+
+	constexpr CFQuaternion const operator/(CFQuaternion const& lhs, float const& rhs) noexcept {
+		CFQuaternion result = lhs;
+		result /= rhs;
+		return result;
+	}
+
+	constexpr CFQuaternion const operator/(float const& lhs, CFQuaternion const& rhs) noexcept {
+		return rhs.inv() * lhs;
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CFQuaternion.inl"
+#endif
\ No newline at end of file
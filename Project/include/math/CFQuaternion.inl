@@ -0,0 +1,83 @@
+﻿/**	@file	CFQuaternion.inl
+ *	@brief	単精度浮動小数点数型四元数
+ */
+#pragma once
+#include "CFQuaternion.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+
+namespace dlav {
+	DLAV_MATH_API CFQuaternion::CFQuaternion() noexcept :
+		SFloat4()
+	{}
+
+	DLAV_MATH_API CFQuaternion::CFQuaternion(std::initializer_list<float> const& args) noexcept :
+		SFloat4()
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= FLT4_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CFQuaternion const CFQuaternion::normalize() const noexcept {
+		CFQuaternion result;
+		float norm = this->norm();
+		if (compare(norm, 0.0f) > 0) {
+			result = *this;
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API float const CFQuaternion::norm() const noexcept {
+		return sqrt(sqnorm());
+	}
+
+	DLAV_MATH_API bool const operator==(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < FLT4_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	namespace simd {
+		DLAV_MATH_API void add(CFQuaternion& lhs, CFQuaternion const& rhs) noexcept {
+			_mm_store_ps(lhs.p, _mm_add_ps(_mm_load_ps(lhs.p), _mm_load_ps(rhs.p)));
+		}
+
+		DLAV_MATH_API void scale(CFQuaternion& lhs, float const& rhs) noexcept {
+			_mm_store_ps(lhs.p, _mm_mul_ps(_mm_load_ps(lhs.p), _mm_set1_ps(rhs)));
+		}
+
+		DLAV_MATH_API float const dot(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+			return _mm_cvtss_f32(_mm_dp_ps(_mm_load_ps(lhs.p), _mm_load_ps(rhs.p), 0xF1));
+		}
+
+		DLAV_MATH_API CFQuaternion const mul(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+			CFQuaternion result = ZERO_FQT;
+			__m128 l = _mm_load_ps(lhs.p);
+			__m128 r = _mm_load_ps(rhs.p);
+
+			// 右辺を並べ替えて符号を反転し、左辺の各成分と積和を取る
+			__m128 tmp = _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r);
+			tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)),
+				_mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f))));
+			tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)),
+				_mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f))));
+			tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)),
+				_mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f))));
+			_mm_store_ps(result.p, tmp);
+			return result;
+		}
+	}
+}
\ No newline at end of file
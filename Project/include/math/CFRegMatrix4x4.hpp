@@ -0,0 +1,167 @@
+﻿/**	@file	CFRegMatrix4x4.hpp
+ *	@brief	レジスタ常駐型の単精度浮動小数点数型四次正方行列
+ */
+#pragma once
+#include "CFMatrix4x4.hpp"
+#include "CFRegVector4.hpp"
+#include <immintrin.h>
+
+namespace dlav {
+	/**	@class	CFRegMatrix4x4
+	 *	@brief	レジスタ常駐型の単精度浮動小数点数型四次正方行列
+	 *	@note	各行を __m128 のまま保持し、演算の度にメモリへ書き戻さない。
+	 *			CFMatrix4x4 とは load / store で明示的に受け渡す。
+	 */
+	class CFRegMatrix4x4 final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFRegMatrix4x4(CFRegMatrix4x4&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFRegMatrix4x4(CFRegMatrix4x4 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFRegMatrix4x4& operator=(CFRegMatrix4x4&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFRegMatrix4x4& operator=(CFRegMatrix4x4 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ (単位行列)
+		CFRegMatrix4x4() noexcept;
+		//!	@brief	デストラクタ
+		~CFRegMatrix4x4() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		CFRegMatrix4x4(CFRegVector4 const& r0, CFRegVector4 const& r1, CFRegVector4 const& r2, CFRegVector4 const& r3) noexcept;
+		//!	@brief	読み込みコンストラクタ
+		explicit CFRegMatrix4x4(CFMatrix4x4 const&) noexcept;
+
+		//!	@brief	書き込み関数
+		void store(CFMatrix4x4&) const noexcept;
+		//!	@brief	行成分取得関数
+		CFRegVector4 const& row(unsigned int const&) const noexcept;
+
+		//!	@brief	複合乗算演算子
+		CFRegMatrix4x4& operator*=(CFRegMatrix4x4 const&) noexcept;
+
+		//!	@brief	転置行列生成関数
+		CFRegMatrix4x4 const transpose() const noexcept;
+
+	private	:
+		//!	@brief	各行の成分
+		CFRegVector4 m_rows[4U];
+	};
+	//!	@brief	加算演算子
+	CFRegMatrix4x4 const operator+(CFRegMatrix4x4 const&, CFRegMatrix4x4 const&) noexcept;
+	//!	@brief	減算演算子
+	CFRegMatrix4x4 const operator-(CFRegMatrix4x4 const&, CFRegMatrix4x4 const&) noexcept;
+	//!	@brief	乗算演算子
+	CFRegMatrix4x4 const operator*(CFRegMatrix4x4 const&, CFRegMatrix4x4 const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CFRegMatrix4x4 const operator*(CFRegMatrix4x4 const&, float const&) noexcept;
+
+	//!	@brief	行列作用演算子
+	CFRegVector4 const operator*(CFRegVector4 const&, CFRegMatrix4x4 const&) noexcept;
+	//!	@brief	行列作用演算子
+	CFRegVector4 const operator*(CFRegMatrix4x4 const&, CFRegVector4 const&) noexcept;
+
+	/* 実装 */
+
+	inline CFRegMatrix4x4::CFRegMatrix4x4() noexcept :
+		m_rows{
+			CFRegVector4(1.0f, 0.0f, 0.0f, 0.0f),
+			CFRegVector4(0.0f, 1.0f, 0.0f, 0.0f),
+			CFRegVector4(0.0f, 0.0f, 1.0f, 0.0f),
+			CFRegVector4(0.0f, 0.0f, 0.0f, 1.0f)
+		}
+	{}
+
+	inline CFRegMatrix4x4::CFRegMatrix4x4(CFRegVector4 const& r0, CFRegVector4 const& r1, CFRegVector4 const& r2, CFRegVector4 const& r3) noexcept :
+		m_rows{ r0, r1, r2, r3 }
+	{}
+
+	inline CFRegMatrix4x4::CFRegMatrix4x4(CFMatrix4x4 const& arg) noexcept :
+		m_rows{
+			CFRegVector4(_mm_load_ps(&arg.p[0])),
+			CFRegVector4(_mm_load_ps(&arg.p[4])),
+			CFRegVector4(_mm_load_ps(&arg.p[8])),
+			CFRegVector4(_mm_load_ps(&arg.p[12]))
+		}
+	{}
+
+	inline void CFRegMatrix4x4::store(CFMatrix4x4& arg) const noexcept {
+		for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+			_mm_store_ps(&arg.p[idx * FLT4_CNT], m_rows[idx].reg());
+		}
+	}
+
+	inline CFRegVector4 const& CFRegMatrix4x4::row(unsigned int const& idx) const noexcept {
+		return m_rows[idx];
+	}
+
+	inline CFRegMatrix4x4& CFRegMatrix4x4::operator*=(CFRegMatrix4x4 const& rhs) noexcept {
+		*this = *this * rhs;
+		return *this;
+	}
+
+	inline CFRegMatrix4x4 const CFRegMatrix4x4::transpose() const noexcept {
+		__m128 r0 = m_rows[0].reg();
+		__m128 r1 = m_rows[1].reg();
+		__m128 r2 = m_rows[2].reg();
+		__m128 r3 = m_rows[3].reg();
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		return CFRegMatrix4x4(CFRegVector4(r0), CFRegVector4(r1), CFRegVector4(r2), CFRegVector4(r3));
+	}
+
+	inline CFRegMatrix4x4 const operator+(CFRegMatrix4x4 const& lhs, CFRegMatrix4x4 const& rhs) noexcept {
+		return CFRegMatrix4x4(
+			lhs.row(0U) + rhs.row(0U),
+			lhs.row(1U) + rhs.row(1U),
+			lhs.row(2U) + rhs.row(2U),
+			lhs.row(3U) + rhs.row(3U)
+		);
+	}
+
+	inline CFRegMatrix4x4 const operator-(CFRegMatrix4x4 const& lhs, CFRegMatrix4x4 const& rhs) noexcept {
+		return CFRegMatrix4x4(
+			lhs.row(0U) - rhs.row(0U),
+			lhs.row(1U) - rhs.row(1U),
+			lhs.row(2U) - rhs.row(2U),
+			lhs.row(3U) - rhs.row(3U)
+		);
+	}
+
+	inline CFRegMatrix4x4 const operator*(CFRegMatrix4x4 const& lhs, CFRegMatrix4x4 const& rhs) noexcept {
+		// 左辺の各行は右辺の行の線形結合となる
+		return CFRegMatrix4x4(
+			lhs.row(0U) * rhs,
+			lhs.row(1U) * rhs,
+			lhs.row(2U) * rhs,
+			lhs.row(3U) * rhs
+		);
+	}
+
+	inline CFRegMatrix4x4 const operator*(CFRegMatrix4x4 const& lhs, float const& rhs) noexcept {
+		return CFRegMatrix4x4(
+			lhs.row(0U) * rhs,
+			lhs.row(1U) * rhs,
+			lhs.row(2U) * rhs,
+			lhs.row(3U) * rhs
+		);
+	}
+
+	inline CFRegVector4 const operator*(CFRegVector4 const& lhs, CFRegMatrix4x4 const& rhs) noexcept {
+		__m128 v = lhs.reg();
+		__m128 tmp = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), rhs.row(0U).reg());
+		tmp = _mm_fmadd_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), rhs.row(1U).reg(), tmp);
+		tmp = _mm_fmadd_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), rhs.row(2U).reg(), tmp);
+		tmp = _mm_fmadd_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), rhs.row(3U).reg(), tmp);
+		return CFRegVector4(tmp);
+	}
+
+	inline CFRegVector4 const operator*(CFRegMatrix4x4 const& lhs, CFRegVector4 const& rhs) noexcept {
+		__m128 v = rhs.reg();
+		__m128 tmp = _mm_dp_ps(lhs.row(0U).reg(), v, 0xF1);
+		tmp = _mm_or_ps(tmp, _mm_dp_ps(lhs.row(1U).reg(), v, 0xF2));
+		tmp = _mm_or_ps(tmp, _mm_dp_ps(lhs.row(2U).reg(), v, 0xF4));
+		tmp = _mm_or_ps(tmp, _mm_dp_ps(lhs.row(3U).reg(), v, 0xF8));
+		return CFRegVector4(tmp);
+	}
+}
\ No newline at end of file
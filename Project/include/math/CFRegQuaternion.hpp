@@ -0,0 +1,160 @@
+﻿/**	@file	CFRegQuaternion.hpp
+ *	@brief	レジスタ常駐型の単精度浮動小数点数型四元数
+ */
+#pragma once
+#include "CFQuaternion.hpp"
+#include "CFRegVector4.hpp"
+#include <immintrin.h>
+#include <cfloat>
+
+namespace dlav {
+	/**	@class	CFRegQuaternion
+	 *	@brief	レジスタ常駐型の単精度浮動小数点数型四元数
+	 *	@note	成分を __m128 のまま保持し、演算の度にメモリへ書き戻さない。
+	 *			CFQuaternion とは load / store で明示的に受け渡す。
+	 */
+	class CFRegQuaternion final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFRegQuaternion(CFRegQuaternion&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFRegQuaternion(CFRegQuaternion const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFRegQuaternion& operator=(CFRegQuaternion&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFRegQuaternion& operator=(CFRegQuaternion const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ (恒等四元数)
+		CFRegQuaternion() noexcept;
+		//!	@brief	デストラクタ
+		~CFRegQuaternion() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		explicit CFRegQuaternion(__m128 const&) noexcept;
+		//!	@brief	コンストラクタ
+		CFRegQuaternion(float const& x, float const& y, float const& z, float const& w) noexcept;
+		//!	@brief	読み込みコンストラクタ
+		explicit CFRegQuaternion(CFQuaternion const&) noexcept;
+
+		//!	@brief	書き込み関数
+		void store(CFQuaternion&) const noexcept;
+		//!	@brief	レジスタ取得関数
+		__m128 const reg() const noexcept;
+
+		//!	@brief	複合乗算演算子
+		CFRegQuaternion& operator*=(CFRegQuaternion const&) noexcept;
+
+		//!	@brief	共役四元数生成関数
+		CFRegQuaternion const conj() const noexcept;
+		//!	@brief	正規化関数
+		CFRegQuaternion const normalize() const noexcept;
+		//!	@brief	ノルム二乗関数
+		float const sqnorm() const noexcept;
+
+		//!	@brief	ベクトル回転関数 (q * v * conj(q)、単位四元数であること)
+		CFRegVector4 const rotate(CFRegVector4 const&) const noexcept;
+
+	private	:
+		//!	@brief	全成分
+		__m128 m_reg;
+	};
+	//!	@brief	内積関数
+	float const dot(CFRegQuaternion const&, CFRegQuaternion const&) noexcept;
+
+	//!	@brief	加算演算子
+	CFRegQuaternion const operator+(CFRegQuaternion const&, CFRegQuaternion const&) noexcept;
+	//!	@brief	減算演算子
+	CFRegQuaternion const operator-(CFRegQuaternion const&, CFRegQuaternion const&) noexcept;
+	//!	@brief	乗算演算子
+	CFRegQuaternion const operator*(CFRegQuaternion const&, CFRegQuaternion const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CFRegQuaternion const operator*(CFRegQuaternion const&, float const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CFRegQuaternion const operator*(float const&, CFRegQuaternion const&) noexcept;
+
+	/* 実装 */
+
+	inline CFRegQuaternion::CFRegQuaternion() noexcept :
+		m_reg(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f))
+	{}
+
+	inline CFRegQuaternion::CFRegQuaternion(__m128 const& arg) noexcept :
+		m_reg(arg)
+	{}
+
+	inline CFRegQuaternion::CFRegQuaternion(float const& x, float const& y, float const& z, float const& w) noexcept :
+		m_reg(_mm_setr_ps(x, y, z, w))
+	{}
+
+	inline CFRegQuaternion::CFRegQuaternion(CFQuaternion const& arg) noexcept :
+		m_reg(_mm_load_ps(arg.p))
+	{}
+
+	inline void CFRegQuaternion::store(CFQuaternion& arg) const noexcept {
+		_mm_store_ps(arg.p, m_reg);
+	}
+
+	inline __m128 const CFRegQuaternion::reg() const noexcept {
+		return m_reg;
+	}
+
+	inline CFRegQuaternion& CFRegQuaternion::operator*=(CFRegQuaternion const& rhs) noexcept {
+		*this = *this * rhs;
+		return *this;
+	}
+
+	inline CFRegQuaternion const CFRegQuaternion::conj() const noexcept {
+		return CFRegQuaternion(_mm_xor_ps(m_reg, _mm_setr_ps(-0.0f, -0.0f, -0.0f, 0.0f)));
+	}
+
+	inline CFRegQuaternion const CFRegQuaternion::normalize() const noexcept {
+		__m128 sq = _mm_dp_ps(m_reg, m_reg, 0xFF);
+		__m128 mask = _mm_cmpge_ps(sq, _mm_set1_ps(FLT_EPSILON));
+		return CFRegQuaternion(_mm_and_ps(_mm_div_ps(m_reg, _mm_sqrt_ps(sq)), mask));
+	}
+
+	inline float const CFRegQuaternion::sqnorm() const noexcept {
+		return _mm_cvtss_f32(_mm_dp_ps(m_reg, m_reg, 0xF1));
+	}
+
+	inline CFRegVector4 const CFRegQuaternion::rotate(CFRegVector4 const& arg) const noexcept {
+		// v' = v + w * t + u × t (u はベクトル部、t = 2 * u × v)
+		CFRegVector4 u(_mm_blend_ps(m_reg, _mm_setzero_ps(), 0x8));
+		CFRegVector4 w(_mm_shuffle_ps(m_reg, m_reg, _MM_SHUFFLE(3, 3, 3, 3)));
+		CFRegVector4 t = cross3(u, arg) * 2.0f;
+		return muladd(w, t, arg) + cross3(u, t);
+	}
+
+	inline float const dot(CFRegQuaternion const& lhs, CFRegQuaternion const& rhs) noexcept {
+		return _mm_cvtss_f32(_mm_dp_ps(lhs.reg(), rhs.reg(), 0xF1));
+	}
+
+	inline CFRegQuaternion const operator+(CFRegQuaternion const& lhs, CFRegQuaternion const& rhs) noexcept {
+		return CFRegQuaternion(_mm_add_ps(lhs.reg(), rhs.reg()));
+	}
+
+	inline CFRegQuaternion const operator-(CFRegQuaternion const& lhs, CFRegQuaternion const& rhs) noexcept {
+		return CFRegQuaternion(_mm_sub_ps(lhs.reg(), rhs.reg()));
+	}
+
+	inline CFRegQuaternion const operator*(CFRegQuaternion const& lhs, CFRegQuaternion const& rhs) noexcept {
+		__m128 l = lhs.reg();
+		__m128 r = rhs.reg();
+		__m128 tmp = _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		tmp = _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)),
+			_mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)), tmp);
+		tmp = _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)),
+			_mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f)), tmp);
+		tmp = _mm_fmadd_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)),
+			_mm_xor_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f)), tmp);
+		return CFRegQuaternion(tmp);
+	}
+
+	inline CFRegQuaternion const operator*(CFRegQuaternion const& lhs, float const& rhs) noexcept {
+		return CFRegQuaternion(_mm_mul_ps(lhs.reg(), _mm_set1_ps(rhs)));
+	}
+
+	inline CFRegQuaternion const operator*(float const& lhs, CFRegQuaternion const& rhs) noexcept {
+		return rhs * lhs;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+﻿/**	@file	CFRegVector4.hpp
+ *	@brief	レジスタ常駐型の単精度浮動小数点数型四次元ベクトル
+ */
+#pragma once
+#include "CFVector3.hpp"
+#include "CFVector4.hpp"
+#include <immintrin.h>
+#include <cfloat>
+
+namespace dlav {
+	/**	@class	CFRegVector4
+	 *	@brief	レジスタ常駐型の単精度浮動小数点数型四次元ベクトル
+	 *	@note	成分を __m128 のまま保持し、演算の度にメモリへ書き戻さない。
+	 *			CFVector4 等の格納用の型とは load / store で明示的に受け渡す。
+	 *			全ての関数はヘッダ内でインライン展開される。
+	 */
+	class CFRegVector4 final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CFRegVector4(CFRegVector4&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFRegVector4(CFRegVector4 const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFRegVector4& operator=(CFRegVector4&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFRegVector4& operator=(CFRegVector4 const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFRegVector4() noexcept;
+		//!	@brief	デストラクタ
+		~CFRegVector4() noexcept = default;
+
+		//!	@brief	コンストラクタ
+		explicit CFRegVector4(__m128 const&) noexcept;
+		//!	@brief	コンストラクタ (全成分に同じ値を設定する)
+		explicit CFRegVector4(float const&) noexcept;
+		//!	@brief	コンストラクタ
+		CFRegVector4(float const& x, float const& y, float const& z, float const& w) noexcept;
+		//!	@brief	読み込みコンストラクタ
+		explicit CFRegVector4(CFVector4 const&) noexcept;
+		//!	@brief	読み込みコンストラクタ
+		CFRegVector4(CFVector3 const&, float const& w) noexcept;
+
+		//!	@brief	書き込み関数
+		void store(CFVector4&) const noexcept;
+		//!	@brief	書き込み関数 (第四成分は破棄する)
+		void store(CFVector3&) const noexcept;
+		//!	@brief	レジスタ取得関数
+		__m128 const reg() const noexcept;
+
+		//!	@brief	複合加算演算子
+		CFRegVector4& operator+=(CFRegVector4 const&) noexcept;
+		//!	@brief	複合減算演算子
+		CFRegVector4& operator-=(CFRegVector4 const&) noexcept;
+		//!	@brief	複合スカラ倍演算子
+		CFRegVector4& operator*=(float const&) noexcept;
+		//!	@brief	複合スカラ割演算子
+		CFRegVector4& operator/=(float const&) noexcept;
+
+		//!	@brief	正規化関数
+		CFRegVector4 const normalize() const noexcept;
+		//!	@brief	ノルム二乗関数
+		float const sqnorm() const noexcept;
+		//!	@brief	ノルム関数
+		float const norm() const noexcept;
+
+		//!	@brief	単項加算演算子
+		CFRegVector4 const operator+() const noexcept;
+		//!	@brief	単項減算演算子
+		CFRegVector4 const operator-() const noexcept;
+
+	private	:
+		//!	@brief	全成分
+		__m128 m_reg;
+	};
+	//!	@brief	内積関数
+	float const dot(CFRegVector4 const&, CFRegVector4 const&) noexcept;
+	//!	@brief	三次元外積関数 (第四成分は 0 とする)
+	CFRegVector4 const cross3(CFRegVector4 const&, CFRegVector4 const&) noexcept;
+	//!	@brief	成分毎の積和関数 (lhs * rhs + add)
+	CFRegVector4 const muladd(CFRegVector4 const& lhs, CFRegVector4 const& rhs, CFRegVector4 const& add) noexcept;
+
+	//!	@brief	加算演算子
+	CFRegVector4 const operator+(CFRegVector4 const&, CFRegVector4 const&) noexcept;
+	//!	@brief	減算演算子
+	CFRegVector4 const operator-(CFRegVector4 const&, CFRegVector4 const&) noexcept;
+	//!	@brief	成分毎の乗算演算子
+	CFRegVector4 const operator*(CFRegVector4 const&, CFRegVector4 const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CFRegVector4 const operator*(CFRegVector4 const&, float const&) noexcept;
+	//!	@brief	スカラ倍演算子
+	CFRegVector4 const operator*(float const&, CFRegVector4 const&) noexcept;
+	//!	@brief	スカラ割演算子
+	CFRegVector4 const operator/(CFRegVector4 const&, float const&) noexcept;
+
+	/* 実装 */
+
+	inline CFRegVector4::CFRegVector4() noexcept :
+		m_reg(_mm_setzero_ps())
+	{}
+
+	inline CFRegVector4::CFRegVector4(__m128 const& arg) noexcept :
+		m_reg(arg)
+	{}
+
+	inline CFRegVector4::CFRegVector4(float const& arg) noexcept :
+		m_reg(_mm_set1_ps(arg))
+	{}
+
+	inline CFRegVector4::CFRegVector4(float const& x, float const& y, float const& z, float const& w) noexcept :
+		m_reg(_mm_setr_ps(x, y, z, w))
+	{}
+
+	inline CFRegVector4::CFRegVector4(CFVector4 const& arg) noexcept :
+		m_reg(_mm_load_ps(arg.p))
+	{}
+
+	inline CFRegVector4::CFRegVector4(CFVector3 const& arg, float const& w) noexcept :
+		m_reg(_mm_insert_ps(_mm_load_ps(arg.p), _mm_set_ss(w), 0x30))
+	{}
+
+	inline void CFRegVector4::store(CFVector4& arg) const noexcept {
+		_mm_store_ps(arg.p, m_reg);
+	}
+
+	inline void CFRegVector4::store(CFVector3& arg) const noexcept {
+		// CFVector3 は 16 byte に整列されており、第四成分は詰め物である
+		_mm_store_ps(arg.p, m_reg);
+	}
+
+	inline __m128 const CFRegVector4::reg() const noexcept {
+		return m_reg;
+	}
+
+	inline CFRegVector4& CFRegVector4::operator+=(CFRegVector4 const& rhs) noexcept {
+		m_reg = _mm_add_ps(m_reg, rhs.m_reg);
+		return *this;
+	}
+
+	inline CFRegVector4& CFRegVector4::operator-=(CFRegVector4 const& rhs) noexcept {
+		m_reg = _mm_sub_ps(m_reg, rhs.m_reg);
+		return *this;
+	}
+
+	inline CFRegVector4& CFRegVector4::operator*=(float const& rhs) noexcept {
+		m_reg = _mm_mul_ps(m_reg, _mm_set1_ps(rhs));
+		return *this;
+	}
+
+	inline CFRegVector4& CFRegVector4::operator/=(float const& rhs) noexcept {
+		m_reg = _mm_div_ps(m_reg, _mm_set1_ps(rhs));
+		return *this;
+	}
+
+	inline CFRegVector4 const CFRegVector4::normalize() const noexcept {
+		__m128 sq = _mm_dp_ps(m_reg, m_reg, 0xFF);
+		__m128 mask = _mm_cmpge_ps(sq, _mm_set1_ps(FLT_EPSILON));
+		return CFRegVector4(_mm_and_ps(_mm_div_ps(m_reg, _mm_sqrt_ps(sq)), mask));
+	}
+
+	inline float const CFRegVector4::sqnorm() const noexcept {
+		return _mm_cvtss_f32(_mm_dp_ps(m_reg, m_reg, 0xF1));
+	}
+
+	inline float const CFRegVector4::norm() const noexcept {
+		return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m_reg, m_reg, 0xF1)));
+	}
+
+	inline CFRegVector4 const CFRegVector4::operator+() const noexcept {
+		return *this;
+	}
+
+	inline CFRegVector4 const CFRegVector4::operator-() const noexcept {
+		return CFRegVector4(_mm_xor_ps(m_reg, _mm_set1_ps(-0.0f)));
+	}
+
+	inline float const dot(CFRegVector4 const& lhs, CFRegVector4 const& rhs) noexcept {
+		return _mm_cvtss_f32(_mm_dp_ps(lhs.reg(), rhs.reg(), 0xF1));
+	}
+
+	inline CFRegVector4 const cross3(CFRegVector4 const& lhs, CFRegVector4 const& rhs) noexcept {
+		__m128 a = lhs.reg();
+		__m128 b = rhs.reg();
+		__m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 tmp = _mm_fmsub_ps(a, b_yzx, _mm_mul_ps(a_yzx, b));
+		return CFRegVector4(_mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(3, 0, 2, 1)));
+	}
+
+	inline CFRegVector4 const muladd(CFRegVector4 const& lhs, CFRegVector4 const& rhs, CFRegVector4 const& add) noexcept {
+		return CFRegVector4(_mm_fmadd_ps(lhs.reg(), rhs.reg(), add.reg()));
+	}
+
+	inline CFRegVector4 const operator+(CFRegVector4 const& lhs, CFRegVector4 const& rhs) noexcept {
+		return CFRegVector4(_mm_add_ps(lhs.reg(), rhs.reg()));
+	}
+
+	inline CFRegVector4 const operator-(CFRegVector4 const& lhs, CFRegVector4 const& rhs) noexcept {
+		return CFRegVector4(_mm_sub_ps(lhs.reg(), rhs.reg()));
+	}
+
+	inline CFRegVector4 const operator*(CFRegVector4 const& lhs, CFRegVector4 const& rhs) noexcept {
+		return CFRegVector4(_mm_mul_ps(lhs.reg(), rhs.reg()));
+	}
+
+	inline CFRegVector4 const operator*(CFRegVector4 const& lhs, float const& rhs) noexcept {
+		return CFRegVector4(_mm_mul_ps(lhs.reg(), _mm_set1_ps(rhs)));
+	}
+
+	inline CFRegVector4 const operator*(float const& lhs, CFRegVector4 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	inline CFRegVector4 const operator/(CFRegVector4 const& lhs, float const& rhs) noexcept {
+		return CFRegVector4(_mm_div_ps(lhs.reg(), _mm_set1_ps(rhs)));
+	}
+}
\ No newline at end of file
@@ -57,6 +57,12 @@ namespace dlav {
 		float const cos() const noexcept;
 		//!	@brief	正接関数
 		float const tan() const noexcept;
+		/**	@brief	正弦・余弦関数
+		 *	@param[out] s 正弦
+		 *	@param[out] c 余弦
+		 *	@note	同じ角度の正弦と余弦を一度の折り返しで求める。
+		 */
+		void sincos(float& s, float& c) const noexcept;
 
 		//!	@brief	角度化関数
 		CFRotation const anglize() const noexcept;
@@ -4,6 +4,7 @@
 #pragma once
 #pragma warning(disable : 4324)
 #include "util/SFloat2.hpp"
+#include "Math.hpp"
 #include <initializer_list>
 
 namespace dlav {
@@ -34,41 +35,41 @@ namespace dlav {
 		explicit CFVector2(std::initializer_list<float> const&) noexcept;
 
 		//!	@brief	複合加算演算子
-		CFVector2& operator+=(CFVector2 const&) noexcept;
+		constexpr CFVector2& operator+=(CFVector2 const&) noexcept;
 		//!	@brief	複合減算演算子
-		CFVector2& operator-=(CFVector2 const&) noexcept;
+		constexpr CFVector2& operator-=(CFVector2 const&) noexcept;
 		//!	@brief	複合スカラ倍演算子
-		CFVector2& operator*=(float const&) noexcept;
+		constexpr CFVector2& operator*=(float const&) noexcept;
 		//!	@brief	複合スカラ割演算子
-		CFVector2& operator/=(float const&) noexcept;
+		constexpr CFVector2& operator/=(float const&) noexcept;
 
 		//!	@brief	正規化関数
 		CFVector2 const normalize() const noexcept;
 		//!	@brief	ノルム二乗関数
-		float const sqnorm() const noexcept;
+		constexpr float const sqnorm() const noexcept;
 		//!	@brief	ノルム関数
 		float const norm() const noexcept;
 
 		//!	@brief	単項加算演算子
-		CFVector2 const operator+() const noexcept;
+		constexpr CFVector2 const operator+() const noexcept;
 		//!	@brief	単項減算演算子
-		CFVector2 const operator-() const noexcept;
+		constexpr CFVector2 const operator-() const noexcept;
 	};
 	//!	@brief	内積関数
-	float const dot(CFVector2 const&, CFVector2 const&) noexcept;
+	constexpr float const dot(CFVector2 const&, CFVector2 const&) noexcept;
 	//!	@brief	外積関数
-	CFVector2 const cross(CFVector2 const&) noexcept;
+	constexpr CFVector2 const cross(CFVector2 const&) noexcept;
 
 	//!	@brief	加算演算子
-	CFVector2 const operator+(CFVector2 const&, CFVector2 const&) noexcept;
+	constexpr CFVector2 const operator+(CFVector2 const&, CFVector2 const&) noexcept;
 	//!	@brief	減算演算子
-	CFVector2 const operator-(CFVector2 const&, CFVector2 const&) noexcept;
+	constexpr CFVector2 const operator-(CFVector2 const&, CFVector2 const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFVector2 const operator*(CFVector2 const&, float const&) noexcept;
+	constexpr CFVector2 const operator*(CFVector2 const&, float const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFVector2 const operator*(float const&, CFVector2 const&) noexcept;
+	constexpr CFVector2 const operator*(float const&, CFVector2 const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFVector2 const operator/(CFVector2 const&, float const&) noexcept;
+	constexpr CFVector2 const operator/(CFVector2 const&, float const&) noexcept;
 
 	//!	@brief	等価比較演算子
 	bool const operator==(CFVector2 const&, CFVector2 const&) noexcept;
@@ -77,4 +78,82 @@ namespace dlav {
 
 	//!	@brief	単精度浮動小数点数型の二次元ゼロベクトル
 	static CFVector2 constexpr ZERO_FVT2 = CFVector2(0.0f, 0.0f);
-}
\ No newline at end of file
+
+	/* 実装 */
+
+	constexpr CFVector2& CFVector2::operator+=(CFVector2 const& rhs) noexcept {
+		for (unsigned int idx = 0U; idx < FLT2_CNT; ++idx) {
+			p[idx] += rhs.p[idx];
+		}
+		return *this;
+	}
+
+	constexpr CFVector2& CFVector2::operator-=(CFVector2 const& rhs) noexcept {
+		*this += -rhs;
+		return *this;
+	}
+
+	constexpr CFVector2& CFVector2::operator*=(float const& rhs) noexcept {
+		for (unsigned int idx = 0U; idx < FLT2_CNT; ++idx) {
+			p[idx] *= rhs;
+		}
+		return *this;
+	}
+
+	constexpr CFVector2& CFVector2::operator/=(float const& rhs) noexcept {
+		*this *= 1.0f / rhs;
+		return *this;
+	}
+
+	constexpr float const CFVector2::sqnorm() const noexcept {
+		return dot(*this, *this);
+	}
+
+	constexpr CFVector2 const CFVector2::operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr CFVector2 const CFVector2::operator-() const noexcept {
+		return *this * -1.0f;
+	}
+
+	constexpr float const dot(CFVector2 const& lhs, CFVector2 const& rhs) noexcept {
+		return lhs.p[0] * rhs.p[0] + lhs.p[1] * rhs.p[1];
+	}
+
+	constexpr CFVector2 const cross(CFVector2 const& vt) noexcept {
+		return CFVector2(vt.p[1], -vt.p[0]);
+	}
+
+	constexpr CFVector2 const operator+(CFVector2 const& lhs, CFVector2 const& rhs) noexcept {
+		CFVector2 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	constexpr CFVector2 const operator-(CFVector2 const& lhs, CFVector2 const& rhs) noexcept {
+		CFVector2 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	constexpr CFVector2 const operator*(CFVector2 const& lhs, float const& rhs) noexcept {
+		CFVector2 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	constexpr CFVector2 const operator*(float const& lhs, CFVector2 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	constexpr CFVector2 const operator/(CFVector2 const& lhs, float const& rhs) noexcept {
+		CFVector2 result = lhs;
+		result /= rhs;
+		return result;
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CFVector2.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+﻿/**	@file	CFVector2.inl
+ *	@brief	単精度浮動小数点数型二次元ベクトル
+ */
+#pragma once
+#include "CFVector2.hpp"
+#include "Math.hpp"
+
+namespace dlav {
+	DLAV_MATH_API CFVector2::CFVector2() noexcept :
+		SFloat2()
+	{}
+
+	DLAV_MATH_API CFVector2::CFVector2(std::initializer_list<float> const& args) noexcept :
+		SFloat2()
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= FLT2_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CFVector2 const CFVector2::normalize() const noexcept {
+		CFVector2 result;
+		float norm = this->norm();
+		if (compare(norm, 0.0f) > 0) {
+			result = *this;
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API float const CFVector2::norm() const noexcept {
+		return sqrt(sqnorm());
+	}
+
+	DLAV_MATH_API bool const operator==(CFVector2 const& lhs, CFVector2 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < FLT2_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CFVector2 const& lhs, CFVector2 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+}
\ No newline at end of file
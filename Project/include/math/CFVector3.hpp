@@ -4,6 +4,7 @@
 #pragma once
 #pragma warning(disable : 4324)
 #include "util/SFloat3.hpp"
+#include "Math.hpp"
 #include <initializer_list>
 
 namespace dlav {
@@ -34,41 +35,41 @@ namespace dlav {
 		explicit CFVector3(std::initializer_list<float> const&) noexcept;
 
 		//!	@brief	複合加算演算子
-		CFVector3& operator+=(CFVector3 const&) noexcept;
+		constexpr CFVector3& operator+=(CFVector3 const&) noexcept;
 		//!	@brief	複合減算演算子
-		CFVector3& operator-=(CFVector3 const&) noexcept;
+		constexpr CFVector3& operator-=(CFVector3 const&) noexcept;
 		//!	@brief	複合スカラ倍演算子
-		CFVector3& operator*=(float const&) noexcept;
+		constexpr CFVector3& operator*=(float const&) noexcept;
 		//!	@brief	複合スカラ割演算子
-		CFVector3& operator/=(float const&) noexcept;
+		constexpr CFVector3& operator/=(float const&) noexcept;
 
 		//!	@brief	正規化関数
 		CFVector3 const normalize() const noexcept;
 		//!	@brief	ノルム二乗関数
-		float const sqnorm() const noexcept;
+		constexpr float const sqnorm() const noexcept;
 		//!	@brief	ノルム関数
 		float const norm() const noexcept;
 
 		//!	@brief	単項加算演算子
-		CFVector3 const operator+() const noexcept;
+		constexpr CFVector3 const operator+() const noexcept;
 		//!	@brief	単項減算演算子
-		CFVector3 const operator-() const noexcept;
+		constexpr CFVector3 const operator-() const noexcept;
 	};
 	//!	@brief	内積関数
-	float const dot(CFVector3 const&, CFVector3 const&) noexcept;
+	constexpr float const dot(CFVector3 const&, CFVector3 const&) noexcept;
 	//!	@brief	外積関数
-	CFVector3 const cross(CFVector3 const&, CFVector3 const&) noexcept;
+	constexpr CFVector3 const cross(CFVector3 const&, CFVector3 const&) noexcept;
 
 	//!	@brief	加算演算子
-	CFVector3 const operator+(CFVector3 const&, CFVector3 const&) noexcept;
+	constexpr CFVector3 const operator+(CFVector3 const&, CFVector3 const&) noexcept;
 	//!	@brief	減算演算子
-	CFVector3 const operator-(CFVector3 const&, CFVector3 const&) noexcept;
+	constexpr CFVector3 const operator-(CFVector3 const&, CFVector3 const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFVector3 const operator*(CFVector3 const&, float const&) noexcept;
+	constexpr CFVector3 const operator*(CFVector3 const&, float const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFVector3 const operator*(float const&, CFVector3 const&) noexcept;
+	constexpr CFVector3 const operator*(float const&, CFVector3 const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFVector3 const operator/(CFVector3 const&, float const&) noexcept;
+	constexpr CFVector3 const operator/(CFVector3 const&, float const&) noexcept;
 
 	//!	@brief	等価比較演算子
 	bool const operator==(CFVector3 const&, CFVector3 const&) noexcept;
@@ -77,4 +78,114 @@ namespace dlav {
 
 	//!	@brief	単精度浮動小数点数型の三次元ゼロベクトル
 	static CFVector3 constexpr ZERO_FVT3 = CFVector3(0.0f, 0.0f, 0.0f);
-}
\ No newline at end of file
+
+	//!	@brief	実行時に用いる SIMD 実装
+	namespace simd {
+		//!	@brief	加算関数
+		void add(CFVector3&, CFVector3 const&) noexcept;
+		//!	@brief	スカラ倍関数
+		void scale(CFVector3&, float const&) noexcept;
+		//!	@brief	内積関数
+		float const dot(CFVector3 const&, CFVector3 const&) noexcept;
+		//!	@brief	外積関数
+		CFVector3 const cross(CFVector3 const&, CFVector3 const&) noexcept;
+	}
+
+	/* 実装 */
+
+	constexpr CFVector3& CFVector3::operator+=(CFVector3 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+				p[idx] += rhs.p[idx];
+			}
+		}
+		else {
+			simd::add(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFVector3& CFVector3::operator-=(CFVector3 const& rhs) noexcept {
+		*this += -rhs;
+		return *this;
+	}
+
+	constexpr CFVector3& CFVector3::operator*=(float const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+				p[idx] *= rhs;
+			}
+		}
+		else {
+			simd::scale(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFVector3& CFVector3::operator/=(float const& rhs) noexcept {
+		*this *= 1.0f / rhs;
+		return *this;
+	}
+
+	constexpr float const CFVector3::sqnorm() const noexcept {
+		return dot(*this, *this);
+	}
+
+	constexpr CFVector3 const CFVector3::operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr CFVector3 const CFVector3::operator-() const noexcept {
+		return *this * -1.0f;
+	}
+
+	constexpr float const dot(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			return lhs.p[0] * rhs.p[0] + lhs.p[1] * rhs.p[1] + lhs.p[2] * rhs.p[2];
+		}
+		return simd::dot(lhs, rhs);
+	}
+
+	constexpr CFVector3 const cross(CFVector3 const& vt1, CFVector3 const& vt2) noexcept {
+		if (is_constant_evaluated()) {
+			return CFVector3(
+				vt1.p[1] * vt2.p[2] - vt1.p[2] * vt2.p[1],
+				vt1.p[2] * vt2.p[0] - vt1.p[0] * vt2.p[2],
+				vt1.p[0] * vt2.p[1] - vt1.p[1] * vt2.p[0]
+			);
+		}
+		return simd::cross(vt1, vt2);
+	}
+
+	constexpr CFVector3 const operator+(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		CFVector3 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	constexpr CFVector3 const operator-(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		CFVector3 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	constexpr CFVector3 const operator*(CFVector3 const& lhs, float const& rhs) noexcept {
+		CFVector3 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	constexpr CFVector3 const operator*(float const& lhs, CFVector3 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	constexpr CFVector3 const operator/(CFVector3 const& lhs, float const& rhs) noexcept {
+		CFVector3 result = lhs;
+		result /= rhs;
+		return result;
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CFVector3.inl"
+#endif
\ No newline at end of file
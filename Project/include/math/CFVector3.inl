@@ -0,0 +1,78 @@
+﻿/**	@file	CFVector3.inl
+ *	@brief	単精度浮動小数点数型三次元ベクトル
+ */
+#pragma once
+#include "CFVector3.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+
+namespace dlav {
+	DLAV_MATH_API CFVector3::CFVector3() noexcept :
+		SFloat3()
+	{}
+
+	DLAV_MATH_API CFVector3::CFVector3(std::initializer_list<float> const& args) noexcept :
+		SFloat3()
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= FLT3_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CFVector3 const CFVector3::normalize() const noexcept {
+		CFVector3 result;
+		float norm = this->norm();
+		if (compare(norm, 0.0f) > 0) {
+			result = *this;
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API float const CFVector3::norm() const noexcept {
+		return sqrt(sqnorm());
+	}
+
+	DLAV_MATH_API bool const operator==(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < FLT3_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	namespace simd {
+		DLAV_MATH_API void add(CFVector3& lhs, CFVector3 const& rhs) noexcept {
+			_mm_store_ps(lhs.p, _mm_add_ps(_mm_load_ps(lhs.p), _mm_load_ps(rhs.p)));
+		}
+
+		DLAV_MATH_API void scale(CFVector3& lhs, float const& rhs) noexcept {
+			_mm_store_ps(lhs.p, _mm_mul_ps(_mm_load_ps(lhs.p), _mm_set1_ps(rhs)));
+		}
+
+		DLAV_MATH_API float const dot(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+			// 第四成分は詰め物の為、積和の対象から外す
+			return _mm_cvtss_f32(_mm_dp_ps(_mm_load_ps(lhs.p), _mm_load_ps(rhs.p), 0x71));
+		}
+
+		DLAV_MATH_API CFVector3 const cross(CFVector3 const& vt1, CFVector3 const& vt2) noexcept {
+			CFVector3 result = ZERO_FVT3;
+			__m128 a = _mm_load_ps(vt1.p);
+			__m128 b = _mm_load_ps(vt2.p);
+			__m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 tmp = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+			_mm_store_ps(result.p, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(3, 0, 2, 1)));
+			return result;
+		}
+	}
+}
\ No newline at end of file
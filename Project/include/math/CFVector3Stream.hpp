@@ -0,0 +1,93 @@
+﻿/**	@file	CFVector3Stream.hpp
+ *	@brief	単精度浮動小数点数型三次元ベクトルのストリーム
+ */
+#pragma once
+#include "CFExpression.hpp"
+#include "CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFVector3Stream
+	 *	@brief	単精度浮動小数点数型三次元ベクトルのストリーム
+	 *	@note	成分毎に連続した SoA 形式で保持する。
+	 *			式を代入すると、一つのループの中で三成分を評価する。
+	 *			CFFloatStream との演算では、CFFloatStream の値が全成分に作用する。
+	 */
+	class CFVector3Stream final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFVector3Stream(CFVector3Stream&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFVector3Stream(CFVector3Stream const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFVector3Stream& operator=(CFVector3Stream&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFVector3Stream& operator=(CFVector3Stream const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFVector3Stream() noexcept;
+		//!	@brief	デストラクタ
+		~CFVector3Stream() noexcept = default;
+
+		//!	@brief	初期化関数
+		CFVector3Stream& init(size_t const& count);
+
+		/**	@brief	式代入演算子
+		 *	@note	式に含まれるストリームの要素数が代入先と一致しない場合は何もしない。
+		 */
+		template <typename E>
+		CFVector3Stream& operator=(CFExpr<E> const&) noexcept;
+
+		//!	@brief	要素数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	成分先頭ポインタ取得関数
+		float* const data(unsigned int const&) noexcept;
+		//!	@brief	成分先頭ポインタ取得関数
+		float const* const data(unsigned int const&) const noexcept;
+
+		//!	@brief	設定関数
+		void set(size_t const&, CFVector3 const&) noexcept;
+		//!	@brief	取得関数
+		CFVector3 const get(size_t const&) const noexcept;
+
+	private	:
+		//!	@brief	要素数
+		size_t m_count;
+		//!	@brief	成分毎の要素
+		std::vector<float> m_comps[FLT3_CNT];
+	};
+
+	/**	@struct	SExprOperand
+	 *	@brief	CFVector3Stream を式の葉として扱う特性
+	 */
+	template <>
+	struct SExprOperand<CFVector3Stream> {
+		static bool constexpr ENABLED = true;
+		using type = CFStreamLeaf;
+		static CFStreamLeaf const wrap(CFVector3Stream const& arg) noexcept {
+			return CFStreamLeaf(arg.data(0U), arg.data(1U), arg.data(2U), arg.size());
+		}
+	};
+
+	/* 実装 */
+
+	template <typename E>
+	inline CFVector3Stream& CFVector3Stream::operator=(CFExpr<E> const& arg) noexcept {
+		E const& expr = arg.self();
+		// 要素数の異なるストリームを含む式は短い方の確保領域を越えて読む為、評価しない
+		size_t count = expr.size();
+		assert(count == EXPR_ANY_CNT || count == m_count);
+		if (count != EXPR_ANY_CNT && count != m_count) {
+			return *this;
+		}
+		for (size_t idx = 0U; idx < m_comps[0].size(); idx += LANE_CNT) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				_mm256_storeu_ps(&m_comps[comp][idx], expr.template eval<SExprLane256>(idx, comp));
+			}
+		}
+		return *this;
+	}
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 #pragma warning(disable : 4324)
 #include "util/SFloat4.hpp"
+#include "Math.hpp"
 #include <initializer_list>
 
 namespace dlav {
@@ -34,41 +35,41 @@ namespace dlav {
 		explicit CFVector4(std::initializer_list<float> const&) noexcept;
 
 		//!	@brief	複合加算演算子
-		CFVector4& operator+=(CFVector4 const&) noexcept;
+		constexpr CFVector4& operator+=(CFVector4 const&) noexcept;
 		//!	@brief	複合減算演算子
-		CFVector4& operator-=(CFVector4 const&) noexcept;
+		constexpr CFVector4& operator-=(CFVector4 const&) noexcept;
 		//!	@brief	複合スカラ倍演算子
-		CFVector4& operator*=(float const&) noexcept;
+		constexpr CFVector4& operator*=(float const&) noexcept;
 		//!	@brief	複合スカラ割演算子
-		CFVector4& operator/=(float const&) noexcept;
+		constexpr CFVector4& operator/=(float const&) noexcept;
 
 		//!	@brief	正規化関数
 		CFVector4 const normalize() const noexcept;
 		//!	@brief	ノルム二乗関数
-		float const sqnorm() const noexcept;
+		constexpr float const sqnorm() const noexcept;
 		//!	@brief	ノルム関数
 		float const norm() const noexcept;
 
 		//!	@brief	単項加算演算子
-		CFVector4 const operator+() const noexcept;
+		constexpr CFVector4 const operator+() const noexcept;
 		//!	@brief	単項減算演算子
-		CFVector4 const operator-() const noexcept;
+		constexpr CFVector4 const operator-() const noexcept;
 	};
 	//!	@brief	内積関数
-	float const dot(CFVector4 const&, CFVector4 const&) noexcept;
+	constexpr float const dot(CFVector4 const&, CFVector4 const&) noexcept;
 	//!	@brief	外積関数
-	CFVector4 const cross(CFVector4 const&, CFVector4 const&, CFVector4 const&) noexcept;
+	constexpr CFVector4 const cross(CFVector4 const&, CFVector4 const&, CFVector4 const&) noexcept;
 
 	//!	@brief	加算演算子
-	CFVector4 const operator+(CFVector4 const&, CFVector4 const&) noexcept;
+	constexpr CFVector4 const operator+(CFVector4 const&, CFVector4 const&) noexcept;
 	//!	@brief	減算演算子
-	CFVector4 const operator-(CFVector4 const&, CFVector4 const&) noexcept;
+	constexpr CFVector4 const operator-(CFVector4 const&, CFVector4 const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFVector4 const operator*(CFVector4 const&, float const&) noexcept;
+	constexpr CFVector4 const operator*(CFVector4 const&, float const&) noexcept;
 	//!	@brief	スカラ倍演算子
-	CFVector4 const operator*(float const&, CFVector4 const&) noexcept;
+	constexpr CFVector4 const operator*(float const&, CFVector4 const&) noexcept;
 	//!	@brief	スカラ割演算子
-	CFVector4 const operator/(CFVector4 const&, float const&) noexcept;
+	constexpr CFVector4 const operator/(CFVector4 const&, float const&) noexcept;
 
 	//!	@brief	等価比較演算子
 	bool const operator==(CFVector4 const&, CFVector4 const&) noexcept;
@@ -77,4 +78,113 @@ namespace dlav {
 
 	//!	@brief	単精度浮動小数点数型の四次元ゼロベクトル
 	static CFVector4 constexpr ZERO_FVT4 = CFVector4(0.0f, 0.0f, 0.0f, 0.0f);
-}
\ No newline at end of file
+
+	//!	@brief	実行時に用いる SIMD 実装
+	namespace simd {
+		//!	@brief	加算関数
+		void add(CFVector4&, CFVector4 const&) noexcept;
+		//!	@brief	スカラ倍関数
+		void scale(CFVector4&, float const&) noexcept;
+		//!	@brief	内積関数
+		float const dot(CFVector4 const&, CFVector4 const&) noexcept;
+	}
+
+	/* 実装 */
+
+	constexpr CFVector4& CFVector4::operator+=(CFVector4 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				p[idx] += rhs.p[idx];
+			}
+		}
+		else {
+			simd::add(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFVector4& CFVector4::operator-=(CFVector4 const& rhs) noexcept {
+		*this += -rhs;
+		return *this;
+	}
+
+	constexpr CFVector4& CFVector4::operator*=(float const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				p[idx] *= rhs;
+			}
+		}
+		else {
+			simd::scale(*this, rhs);
+		}
+		return *this;
+	}
+
+	constexpr CFVector4& CFVector4::operator/=(float const& rhs) noexcept {
+		*this *= 1.0f / rhs;
+		return *this;
+	}
+
+	constexpr float const CFVector4::sqnorm() const noexcept {
+		return dot(*this, *this);
+	}
+
+	constexpr CFVector4 const CFVector4::operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr CFVector4 const CFVector4::operator-() const noexcept {
+		return *this * -1.0f;
+	}
+
+	constexpr float const dot(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		if (is_constant_evaluated()) {
+			return lhs.p[0] * rhs.p[0] + lhs.p[1] * rhs.p[1] + lhs.p[2] * rhs.p[2] + lhs.p[3] * rhs.p[3];
+		}
+		return simd::dot(lhs, rhs);
+	}
+
+	constexpr CFVector4 const cross(CFVector4 const& vt1, CFVector4 const& vt2, CFVector4 const& vt3) noexcept {
+		float const* a = vt1.p;
+		float const* b = vt2.p;
+		float const* c = vt3.p;
+		return CFVector4(
+			a[2] * b[3] * c[1] + a[1] * b[2] * c[3] + a[3] * b[1] * c[2] - a[2] * b[1] * c[3] - a[1] * b[3] * c[2] - a[3] * b[2] * c[1],
+			a[2] * b[0] * c[3] + a[0] * b[3] * c[2] + a[3] * b[2] * c[0] - a[0] * b[2] * c[3] - a[2] * b[3] * c[0] - a[3] * b[0] * c[2],
+			a[1] * b[3] * c[0] + a[0] * b[1] * c[3] + a[3] * b[0] * c[1] - a[1] * b[0] * c[3] - a[0] * b[3] * c[1] - a[3] * b[1] * c[0],
+			a[2] * b[1] * c[0] + a[1] * b[0] * c[2] + a[0] * b[2] * c[1] - a[2] * b[0] * c[1] - a[1] * b[2] * c[0] - a[0] * b[1] * c[2]
+		);
+	}
+
+	constexpr CFVector4 const operator+(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		CFVector4 result = lhs;
+		result += rhs;
+		return result;
+	}
+
+	constexpr CFVector4 const operator-(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		CFVector4 result = lhs;
+		result -= rhs;
+		return result;
+	}
+
+	constexpr CFVector4 const operator*(CFVector4 const& lhs, float const& rhs) noexcept {
+		CFVector4 result = lhs;
+		result *= rhs;
+		return result;
+	}
+
+	constexpr CFVector4 const operator*(float const& lhs, CFVector4 const& rhs) noexcept {
+		return rhs * lhs;
+	}
+
+	constexpr CFVector4 const operator/(CFVector4 const& lhs, float const& rhs) noexcept {
+		CFVector4 result = lhs;
+		result /= rhs;
+		return result;
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "CFVector4.inl"
+#endif
\ No newline at end of file
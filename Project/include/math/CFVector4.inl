@@ -0,0 +1,66 @@
+﻿/**	@file	CFVector4.inl
+ *	@brief	単精度浮動小数点数型四次元ベクトル
+ */
+#pragma once
+#include "CFVector4.hpp"
+#include "Math.hpp"
+#include <immintrin.h>
+
+namespace dlav {
+	DLAV_MATH_API CFVector4::CFVector4() noexcept :
+		SFloat4()
+	{}
+
+	DLAV_MATH_API CFVector4::CFVector4(std::initializer_list<float> const& args) noexcept :
+		SFloat4()
+	{
+		unsigned int idx = 0U;
+		for (auto& arg : args) {
+			if (idx >= FLT4_CNT) {
+				break;
+			}
+			p[idx] = arg;
+			++idx;
+		}
+	}
+
+	DLAV_MATH_API CFVector4 const CFVector4::normalize() const noexcept {
+		CFVector4 result;
+		float norm = this->norm();
+		if (compare(norm, 0.0f) > 0) {
+			result = *this;
+			result /= norm;
+		}
+		return result;
+	}
+
+	DLAV_MATH_API float const CFVector4::norm() const noexcept {
+		return sqrt(sqnorm());
+	}
+
+	DLAV_MATH_API bool const operator==(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		bool result = true;
+		for (unsigned int idx = 0U; result && idx < FLT4_CNT; ++idx) {
+			result = !compare(lhs.p[idx], rhs.p[idx]);
+		}
+		return result;
+	}
+
+	DLAV_MATH_API bool const operator!=(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	namespace simd {
+		DLAV_MATH_API void add(CFVector4& lhs, CFVector4 const& rhs) noexcept {
+			_mm_store_ps(lhs.p, _mm_add_ps(_mm_load_ps(lhs.p), _mm_load_ps(rhs.p)));
+		}
+
+		DLAV_MATH_API void scale(CFVector4& lhs, float const& rhs) noexcept {
+			_mm_store_ps(lhs.p, _mm_mul_ps(_mm_load_ps(lhs.p), _mm_set1_ps(rhs)));
+		}
+
+		DLAV_MATH_API float const dot(CFVector4 const& lhs, CFVector4 const& rhs) noexcept {
+			return _mm_cvtss_f32(_mm_dp_ps(_mm_load_ps(lhs.p), _mm_load_ps(rhs.p), 0xF1));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+﻿/**	@file	EDepthMode.hpp
+ *	@brief	投影変換後の深度の割り当て方
+ */
+#pragma once
+
+namespace dlav {
+	/**	@enum	EDepthMode
+	 *	@brief	投影変換後の深度の割り当て方
+	 */
+	enum class EDepthMode : unsigned char {
+		//!	@brief	前方クリップ面を 0、後方クリップ面を 1 とする
+		STANDARD,
+		/**	@brief	前方クリップ面を 1、後方クリップ面を 0 とする
+		 *	@note	浮動小数点数の指数部が遠方の精度を補う為、Z ファイティングが起き難い。
+		 *			深度比較は GREATER とし、深度バッファは 0 で初期化すること。
+		 */
+		REVERSED
+	};
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+﻿/**	@file	EPrecision.hpp
+ *	@brief	近似計算の精度
+ */
+#pragma once
+
+namespace dlav {
+	/**	@enum	EPrecision
+	 *	@brief	近似計算の精度一覧
+	 */
+	enum class EPrecision : unsigned char {
+		//!	@brief	低精度 (誤差 1e-4 程度以下、高速)
+		FAST,
+		//!	@brief	高精度 (誤差 1e-7 程度以下)
+		PRECISE
+	};
+}
\ No newline at end of file
@@ -6,6 +6,15 @@
 #include "EHandSide.hpp"
 #include "ESkewType.hpp"
 #include "EAngleType.hpp"
+#include "EDepthMode.hpp"
+#include "CFRotation.hpp"
+#include "CFVector2.hpp"
+#include "CFVector3.hpp"
+#include "CFMatrix3x3.hpp"
+#include "CFMatrix4x4.hpp"
+#include "CFQuaternion.hpp"
+#include "CFExpression.hpp"
+#include <type_traits>
 
 namespace dlav {
 	class CFVector2;
@@ -61,7 +70,10 @@ namespace dlav {
 	CFRotation const toRot(CFComplex const&) noexcept;
 	//!	@brief 行列→回転量 変換関数
 	CFRotation const toRot(CFMatrix3x3 const&) noexcept;
-	//!	@brief 四元数→オイラー角 変換関数
+	/**	@brief 四元数→オイラー角 変換関数
+	 *	@note	オイラー角は Rx(pitch) * Ry(yaw) * Rz(roll) の順で合成したものとして扱う。
+	 *			ジンバルロック時はロール角を 0 とする。
+	 */
 	CFEulerRotation const toRot(CFQuaternion const&) noexcept;
 	//!	@brief 行列→オイラー角 変換関数
 	CFEulerRotation const toRot(CFMatrix4x4 const&) noexcept;
@@ -74,18 +86,47 @@ namespace dlav {
 	//!	@brief オイラー角→四元数 変換関数
 	CFQuaternion const toQt(CFEulerRotation const&) noexcept;
 
+	/**	@brief 複素数→行列 一括変換関数
+	 *	@param[out] dst 変換結果の格納先
+	 *	@param[in] src 変換元
+	 *	@param[in] count 要素数
+	 */
+	void toMtx(CFMatrix3x3* const dst, CFComplex const* const src, size_t const& count) noexcept;
+	//!	@brief 回転量→行列 一括変換関数
+	void toMtx(CFMatrix3x3* const dst, CFRotation const* const src, size_t const& count) noexcept;
+	//!	@brief 四元数→行列 一括変換関数 (AVX2 で八要素ずつ処理する)
+	void toMtx(CFMatrix4x4* const dst, CFQuaternion const* const src, size_t const& count) noexcept;
+	//!	@brief オイラー角→行列 一括変換関数
+	void toMtx(CFMatrix4x4* const dst, CFEulerRotation const* const src, size_t const& count) noexcept;
+	//!	@brief 複素数→回転量 一括変換関数
+	void toRot(CFRotation* const dst, CFComplex const* const src, size_t const& count) noexcept;
+	//!	@brief 行列→回転量 一括変換関数
+	void toRot(CFRotation* const dst, CFMatrix3x3 const* const src, size_t const& count) noexcept;
+	//!	@brief 四元数→オイラー角 一括変換関数 (AVX2 で八要素ずつ処理する)
+	void toRot(CFEulerRotation* const dst, CFQuaternion const* const src, size_t const& count) noexcept;
+	//!	@brief 行列→オイラー角 一括変換関数
+	void toRot(CFEulerRotation* const dst, CFMatrix4x4 const* const src, size_t const& count) noexcept;
+	//!	@brief 行列→複素数 一括変換関数
+	void toCmp(CFComplex* const dst, CFMatrix3x3 const* const src, size_t const& count) noexcept;
+	//!	@brief 回転量→複素数 一括変換関数
+	void toCmp(CFComplex* const dst, CFRotation const* const src, size_t const& count) noexcept;
+	//!	@brief 行列→四元数 一括変換関数 (AVX2 で八要素ずつ処理する)
+	void toQt(CFQuaternion* const dst, CFMatrix4x4 const* const src, size_t const& count) noexcept;
+	//!	@brief オイラー角→四元数 一括変換関数
+	void toQt(CFQuaternion* const dst, CFEulerRotation const* const src, size_t const& count) noexcept;
+
 	/**	@brief 移動行列生成関数
 	 *	@return 移動行列
 	 */
-	CFMatrix3x3 const makeTransit(EHandSide const&, CFVector2 const&) noexcept;
+	constexpr CFMatrix3x3 const makeTransit(EHandSide const&, CFVector2 const&) noexcept;
 	/**	@brief 移動行列生成関数
 	 *	@return 移動行列
 	 */
-	CFMatrix4x4 const makeTransit(EHandSide const&, CFVector3 const&) noexcept;
+	constexpr CFMatrix4x4 const makeTransit(EHandSide const&, CFVector3 const&) noexcept;
 	/**	@brief 回転行列生成関数
 	 *	@return 回転行列
 	 */
-	CFMatrix4x4 const makeRotate(EHandSide const&, CFQuaternion const&) noexcept;
+	constexpr CFMatrix4x4 const makeRotate(EHandSide const&, CFQuaternion const&) noexcept;
 	/**	@brief 回転行列生成関数
 	 *	@return 回転行列
 	 */
@@ -97,11 +138,11 @@ namespace dlav {
 	/**	@brief 拡縮行列生成関数
 	 *	@return 拡縮行列
 	 */
-	CFMatrix3x3 const makeScaler(CFVector2 const&) noexcept;
+	constexpr CFMatrix3x3 const makeScaler(CFVector2 const&) noexcept;
 	/**	@brief 拡縮行列生成関数
 	 *	@return 拡縮行列
 	 */
-	CFMatrix4x4 const makeScaler(CFVector3 const&) noexcept;
+	constexpr CFMatrix4x4 const makeScaler(CFVector3 const&) noexcept;
 	/**	@brief 剪断行列生成関数
 	 *	@return 剪断行列
 	 */
@@ -115,9 +156,24 @@ namespace dlav {
 	 */
 	CFMatrix4x4 const makeLookAtMatrix(EHandSide const&, CFVector3 const& eye, CFVector3 const& lookat, CFVector3 const& up) noexcept;
 	/**	@brief 透視投影変換行列生成関数
+	 *	@param[in]	front	前方クリップ位置 (視線方向への距離)
+	 *	@param[in]	back	後方クリップ位置 (視線方向への距離)
+	 *	@param[in]	width	投影位置での投影面の幅
+	 *	@param[in]	height	投影位置での投影面の高さ
+	 *	@param[in]	wndpos	投影位置
 	 *	@return 透視投影変換行列
+	 *	@note	ビュー空間は -z 方向を視線とし (makeLookAtMatrix と同じ)、深度は [0, 1] へ写す。
+	 */
+	CFMatrix4x4 const makePerspectiveMatrix(EHandSide const&, float const& front, float const& back, float const& width, float const& height, float const& wndpos, EDepthMode const& = EDepthMode::STANDARD) noexcept;
+	/**	@brief 後方クリップ面を無限遠とする透視投影変換行列生成関数
+	 *	@return 透視投影変換行列
+	 *	@note	makePerspectiveMatrix の back を無限大とした極限であり、遠方の物体が切り取られない。
+	 */
+	CFMatrix4x4 const makeInfinitePerspectiveMatrix(EHandSide const&, float const& front, float const& width, float const& height, float const& wndpos, EDepthMode const& = EDepthMode::STANDARD) noexcept;
+	/**	@brief 平行投影変換行列生成関数
+	 *	@return 平行投影変換行列
 	 */
-	CFMatrix4x4 const makePerspectiveMatrix(EHandSide const&, float const& near, float const& far, float const& width, float const& height, float const& wndpos) noexcept;
+	CFMatrix4x4 const makeOrthographicMatrix(EHandSide const&, float const& front, float const& back, float const& width, float const& height, EDepthMode const& = EDepthMode::STANDARD) noexcept;
 	/**	@brief Ｘ軸抽出関数
 	 *	@return Ｘ軸を表す正規化済みのベクトル
 	 */
@@ -138,12 +194,39 @@ namespace dlav {
 	 *	@return Ｚ軸を表す正規化済みのベクトル
 	 */
 	CFVector3 const makeNormalizedZAxis(CFQuaternion const&) noexcept;
+	/**	@brief 線形部分抽出関数
+	 *	@return 列ベクトルに作用する形式の左上 3x3 成分 (RHS の行列は転置して返す)
+	 */
+	CFMatrix3x3 const makeLinear(EHandSide const&, CFMatrix4x4 const&) noexcept;
+	/**	@brief 平行移動成分抽出関数
+	 *	@return 平行移動量
+	 */
+	CFVector3 const makeOffset(EHandSide const&, CFMatrix4x4 const&) noexcept;
+	/**	@brief 線形変換の最大拡大率の上界取得関数
+	 *	@return Ｌ^T Ｌ の行の絶対値和の最大値の平方根 (回転と一様拡縮では拡大率に一致する)
+	 *	@note	剪断や回転を挟む非一様拡縮でも、どの方向の長さの拡大率もこれを超えない。
+	 */
+	float const linearScale(CFMatrix3x3 const&) noexcept;
 
 	/* 実装 */
 
+	/**	@struct	SIsFloat4Lane
+	 *	@brief	一本の __m128 で式テンプレートを評価できる型か否かの判定
+	 */
+	template <typename T>
+	struct SIsFloat4Lane : std::bool_constant<
+		(std::is_base_of<SFloat3, T>::value || std::is_base_of<SFloat4, T>::value) && alignof(T) >= 16U && sizeof(T) == 16U
+	> {};
+
 	template <typename T>
 	T const lerp(T const& begin, T const& end, float const& rate) noexcept {
-		return (end - begin) * rate + begin;
+		if constexpr (SIsFloat4Lane<T>::value) {
+			// 差分と積和を一時オブジェクトを介さず一度の FMA で評価する
+			return evaluate<T>((lazy(end) - lazy(begin)) * rate + lazy(begin));
+		}
+		else {
+			return (end - begin) * rate + begin;
+		}
 	}
 
 	template <typename T>
@@ -159,8 +242,13 @@ namespace dlav {
 		T n = nor.normalize();
 		float tmp = rate;
 		if (tmp < -2.0f) tmp = -2.0f;
-		if (tmp < 2.0f) tmp = 2.0f;
-		return dir - tmp * dot(-dir, n) * n;
+		if (tmp > 2.0f) tmp = 2.0f;
+		if constexpr (SIsFloat4Lane<T>::value) {
+			return evaluate<T>(lazy(dir) + lazy(n) * (tmp * dot(dir, n)));
+		}
+		else {
+			return dir - tmp * dot(-dir, n) * n;
+		}
 	}
 
 	template <typename T>
@@ -169,4 +257,65 @@ namespace dlav {
 		result.acos(dot(base.normalize(), tar.normalize()));
 		return result;
 	}
+
+	constexpr CFMatrix3x3 const makeTransit(EHandSide const& hs, CFVector2 const& vt) noexcept {
+		CFMatrix3x3 tmp = UNIT_FMTX3x3;
+		switch (hs) {
+		case EHandSide::LHS:
+			tmp.p[2] = vt.p[0];
+			tmp.p[5] = vt.p[1];
+			break;
+		case EHandSide::RHS:
+			tmp.p[6] = vt.p[0];
+			tmp.p[7] = vt.p[1];
+			break;
+		}
+		return tmp;
+	}
+
+	constexpr CFMatrix4x4 const makeTransit(EHandSide const& hs, CFVector3 const& vt) noexcept {
+		CFMatrix4x4 tmp = UNIT_FMTX4x4;
+		switch (hs) {
+		case EHandSide::LHS:
+			tmp.p[3] = vt.p[0];
+			tmp.p[7] = vt.p[1];
+			tmp.p[11] = vt.p[2];
+			break;
+		case EHandSide::RHS:
+			tmp.p[12] = vt.p[0];
+			tmp.p[13] = vt.p[1];
+			tmp.p[14] = vt.p[2];
+			break;
+		}
+		return tmp;
+	}
+
+	constexpr CFMatrix4x4 const makeRotate(EHandSide const& hs, CFQuaternion const& qt) noexcept {
+		float x = qt.p[0];
+		float y = qt.p[1];
+		float z = qt.p[2];
+		float w = qt.p[3];
+		CFMatrix4x4 result(
+			x * x - y * y - z * z + w * w, 2.0f * (x * y - z * w), 2.0f * (x * z + y * w), 0.0f,
+			2.0f * (x * y + z * w), -x * x + y * y - z * z + w * w, 2.0f * (y * z - x * w), 0.0f,
+			2.0f * (x * z - y * w), 2.0f * (y * z + x * w), -x * x - y * y + z * z + w * w, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+		return hs == EHandSide::LHS ? result.transpose() : result;
+	}
+
+	constexpr CFMatrix3x3 const makeScaler(CFVector2 const& vt) noexcept {
+		CFMatrix3x3 tmp = UNIT_FMTX3x3;
+		tmp.p[0] = vt.p[0];
+		tmp.p[4] = vt.p[1];
+		return tmp;
+	}
+
+	constexpr CFMatrix4x4 const makeScaler(CFVector3 const& vt) noexcept {
+		CFMatrix4x4 tmp = UNIT_FMTX4x4;
+		tmp.p[0] = vt.p[0];
+		tmp.p[5] = vt.p[1];
+		tmp.p[10] = vt.p[2];
+		return tmp;
+	}
 }
\ No newline at end of file
@@ -2,8 +2,21 @@
  *	@brief	数学関数群
  */
 #pragma once
+#include "EPrecision.hpp"
 #include <initializer_list>
 
+/**	@def	DLAV_MATH_API
+ *	@brief	数学モジュールの関数修飾子
+ *	@note	DLAV_MATH_INLINE を定義すると、ベクトル・行列・四元数の実装 (*.inl) を
+ *			ヘッダから取り込み、翻訳単位を跨ぐ関数呼び出しを無くしてインライン展開させる。
+ *			ライブラリと利用側とで定義の有無を揃えること。
+ */
+#if defined(DLAV_MATH_INLINE)
+#	define DLAV_MATH_API inline
+#else
+#	define DLAV_MATH_API
+#endif
+
 namespace dlav {
 	//!	@brief	円周率
 	template <typename T>
@@ -23,6 +36,14 @@ namespace dlav {
 	template <typename T>
 	int const compare(T const& lhs, T const& rhs) noexcept;
 
+	/**	@brief	定数評価判定関数
+	 *	@retval true 定数式として評価されている
+	 *	@retval false 実行時に評価されている
+	 *	@note	std::is_constant_evaluated は C++20 以降の為、処理系の組み込み関数を用いる。
+	 *			constexpr 関数内で実行時のみ SIMD 実装へ切り替える為に用いる。
+	 */
+	constexpr bool const is_constant_evaluated() noexcept;
+
 	/**	@brief	総和関数
 	 *	@param[in] args 対象データ
 	 *	@return 総和結果
@@ -61,10 +82,57 @@ namespace dlav {
 	template <typename T>
 	T const quot(T const& lhs, T const& rhs) noexcept;
 
+	/**	@brief	正弦・余弦関数
+	 *	@param[in] arg 角度 (π を単位とする)
+	 *	@param[out] sin 正弦
+	 *	@param[out] cos 余弦
+	 *	@param[in] prec 近似精度
+	 *	@note	角度を π 単位で受け取ることで、周期の折り返しを誤差なく行う。
+	 */
+	template <typename T>
+	void sincospi(T const& arg, T& sin, T& cos, EPrecision const& prec) noexcept;
+
+	/**	@brief	正弦・余弦関数
+	 *	@param[in] args 角度 (π を単位とする) の先頭ポインタ
+	 *	@param[out] sin 正弦の格納先
+	 *	@param[out] cos 余弦の格納先
+	 *	@param[in] size 対象データの個数
+	 *	@param[in] prec 近似精度
+	 */
+	template <typename T>
+	void sincospi(T const* const args, T* const sin, T* const cos, size_t const& size, EPrecision const& prec) noexcept;
+
+	/**	@brief	逆正接関数
+	 *	@param[in] y 縦成分
+	 *	@param[in] x 横成分
+	 *	@param[in] prec 近似精度
+	 *	@return 角度 (π を単位とする、[-1, +1])
+	 */
+	template <typename T>
+	T const atan2pi(T const& y, T const& x, EPrecision const& prec) noexcept;
+
+	/**	@brief	逆正接関数
+	 *	@param[in] y 縦成分の先頭ポインタ
+	 *	@param[in] x 横成分の先頭ポインタ
+	 *	@param[out] result 角度 (π を単位とする) の格納先
+	 *	@param[in] size 対象データの個数
+	 *	@param[in] prec 近似精度
+	 */
+	template <typename T>
+	void atan2pi(T const* const y, T const* const x, T* const result, size_t const& size, EPrecision const& prec) noexcept;
+
 	/* 実装 */
 
 	template <typename T>
 	inline T const sum(std::initializer_list<T> const& args) noexcept {
 		return sum(args.begin(), args.size());
 	}
-}
\ No newline at end of file
+
+	constexpr bool const is_constant_evaluated() noexcept {
+		return __builtin_is_constant_evaluated();
+	}
+}
+
+#if defined(DLAV_MATH_INLINE)
+#	include "Math.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+﻿/**	@file	CFContactSolver.hpp
+ *	@brief	逐次インパルス法による接触拘束の解決
+ */
+#pragma once
+#include "phys/CFRigidBodySoA.hpp"
+#include "phys/SBodyContact.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFContactSolver
+	 *	@brief	逐次インパルス法による接触拘束の解決
+	 *	@note	接触点を剛体を共有しない組へ貪欲法で彩色し、同じ色の接触点を LANE_CNT 個ずつ一括処理に詰める。
+	 *			同じ色の一括処理は互いに独立な為、並列に解き、色の順に逐次インパルス法の反復を進める。
+	 *			静的な剛体は速度を書き換えない為、彩色では共有を許す。
+	 *			色が COLOR_CNT - 1 個で足りない接触点は最後の色に一つずつ詰めて逐次に解く。
+	 */
+	class CFContactSolver final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = CFRigidBodySoA::LANE_CNT;
+		//!	@brief	色数の上限
+		static unsigned int constexpr COLOR_CNT = 64U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFContactSolver(CFContactSolver&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFContactSolver(CFContactSolver const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFContactSolver& operator=(CFContactSolver&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFContactSolver& operator=(CFContactSolver const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFContactSolver() noexcept;
+		//!	@brief	デストラクタ
+		~CFContactSolver() noexcept = default;
+
+		/**	@brief	準備関数
+		 *	@param[in] dt 時間刻み (めり込みの補正速度と投機的接触の許容速度に用いる)
+		 *	@note	彩色と一括処理への詰め込みを行い、有効質量と接触点からの腕を前計算する。
+		 *			剛体の姿勢は integrateVelocity の後、integratePosition の前のものを渡す。
+		 */
+		void prepare(CFRigidBodySoA const& bodies, SBodyContact const* const contacts, size_t const& count, float const& dt);
+		//!	@brief	反復関数 (剛体の速度と角速度を更新する)
+		void solve(CFRigidBodySoA& bodies, unsigned int const& iterations) noexcept;
+		//!	@brief	消去関数
+		void clear() noexcept;
+
+		//!	@brief	接触点数取得関数
+		size_t const size() const noexcept;
+		//!	@brief	使用した色数取得関数
+		unsigned int const colors() const noexcept;
+		//!	@brief	一括処理数取得関数
+		size_t const batches() const noexcept;
+		//!	@brief	接触点の法線方向の累積インパルス取得関数
+		float const impulse(size_t const&) const noexcept;
+
+	private	:
+		/**	@struct	SRow
+		 *	@brief	拘束の一方向分の前計算値
+		 */
+		struct SRow {
+			//!	@brief	拘束の方向
+			float dir[FLT3_CNT][LANE_CNT];
+			//!	@brief	A の腕と方向の外積
+			float armA[FLT3_CNT][LANE_CNT];
+			//!	@brief	B の腕と方向の外積
+			float armB[FLT3_CNT][LANE_CNT];
+			//!	@brief	A の慣性テンソルの逆行列と armA の積
+			float spinA[FLT3_CNT][LANE_CNT];
+			//!	@brief	B の慣性テンソルの逆行列と armB の積
+			float spinB[FLT3_CNT][LANE_CNT];
+			//!	@brief	有効質量
+			float mass[LANE_CNT];
+			//!	@brief	累積インパルス
+			float impulse[LANE_CNT];
+		};
+
+		/**	@struct	SBatch
+		 *	@brief	一括処理する接触点の組
+		 */
+		struct SBatch {
+			//!	@brief	法線と二つの接線の拘束
+			SRow rows[FLT3_CNT];
+			//!	@brief	A の質量の逆数
+			float invMassA[LANE_CNT];
+			//!	@brief	B の質量の逆数
+			float invMassB[LANE_CNT];
+			//!	@brief	法線方向の相対速度の下限
+			float target[LANE_CNT];
+			//!	@brief	摩擦係数
+			float friction[LANE_CNT];
+			//!	@brief	A の番号
+			int bodyA[LANE_CNT];
+			//!	@brief	B の番号
+			int bodyB[LANE_CNT];
+			//!	@brief	A の速度を書き戻すレーンの集合
+			unsigned int writeA;
+			//!	@brief	B の速度を書き戻すレーンの集合
+			unsigned int writeB;
+		};
+
+		//!	@brief	一括処理の前計算関数 (anchor は接触点の成分毎のレーン)
+		void setup(CFRigidBodySoA const& bodies, SBatch& batch, float const* const anchor) const noexcept;
+		//!	@brief	一括処理の反復関数
+		void iterate(CFRigidBodySoA& bodies, SBatch& batch) const noexcept;
+
+		//!	@brief	一括処理
+		std::vector<SBatch> m_batches;
+		//!	@brief	色毎の一括処理の開始位置 (色数 + 1 個)
+		std::vector<size_t> m_colors;
+		//!	@brief	接触点毎の一括処理内の位置 (一括処理の番号 * LANE_CNT + レーン)
+		std::vector<size_t> m_slots;
+	};
+}
\ No newline at end of file
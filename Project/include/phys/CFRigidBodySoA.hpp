@@ -0,0 +1,103 @@
+﻿/**	@file	CFRigidBodySoA.hpp
+ *	@brief	単精度浮動小数点数型の SoA 形式剛体群
+ */
+#pragma once
+#include "EBodyChannel.hpp"
+#include "math/CFMatrix3x3.hpp"
+#include "math/CFQuaternion.hpp"
+#include "math/CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CFRigidBodySoA
+	 *	@brief	単精度浮動小数点数型の SoA 形式剛体群
+	 *	@note	各チャンネルは SIMD 幅 (LANE_CNT) の倍数まで確保される為、
+	 *			末尾の余剰要素へ書き込んでも安全である (余剰要素は静的な剛体とする)。
+	 *			積分は半陰的オイラー法で、速度の更新 (integrateVelocity) と拘束の解決と
+	 *			位置の更新 (integratePosition) の順に呼び出す。
+	 */
+	class CFRigidBodySoA final {
+	public	:
+		//!	@brief	一括処理幅
+		static unsigned int constexpr LANE_CNT = 8U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFRigidBodySoA(CFRigidBodySoA&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFRigidBodySoA(CFRigidBodySoA const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CFRigidBodySoA& operator=(CFRigidBodySoA&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFRigidBodySoA& operator=(CFRigidBodySoA const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFRigidBodySoA() noexcept;
+		//!	@brief	デストラクタ
+		~CFRigidBodySoA() noexcept = default;
+
+		//!	@brief	初期化関数 (全て原点で静止した静的な剛体とする)
+		CFRigidBodySoA& init(unsigned int const& count);
+
+		//!	@brief	剛体数取得関数
+		unsigned int const size() const noexcept;
+		//!	@brief	確保済み要素数取得関数
+		unsigned int const capacity() const noexcept;
+
+		//!	@brief	チャンネル取得関数
+		float* const channel(EBodyChannel const&) noexcept;
+		//!	@brief	チャンネル取得関数
+		float const* const channel(EBodyChannel const&) const noexcept;
+
+		//!	@brief	位置設定関数
+		CFRigidBodySoA& position(unsigned int const&, CFVector3 const&) noexcept;
+		//!	@brief	回転量設定関数
+		CFRigidBodySoA& rotation(unsigned int const&, CFQuaternion const&) noexcept;
+		//!	@brief	速度設定関数
+		CFRigidBodySoA& linear(unsigned int const&, CFVector3 const&) noexcept;
+		//!	@brief	角速度設定関数
+		CFRigidBodySoA& angular(unsigned int const&, CFVector3 const&) noexcept;
+		/**	@brief	質量設定関数
+		 *	@param[in] amount 質量 (0 以下なら静的な剛体)
+		 *	@param[in] inertia 局所座標の慣性主軸毎の慣性モーメント
+		 *	@note	静的な剛体は力や拘束で速度が変わらないが、設定した速度では動く。
+		 */
+		CFRigidBodySoA& mass(unsigned int const&, float const& amount, CFVector3 const& inertia) noexcept;
+		//!	@brief	力の加算関数 (作用点がずれる分はトルクとして加える)
+		CFRigidBodySoA& apply(unsigned int const&, CFVector3 const& force, CFVector3 const& point) noexcept;
+
+		//!	@brief	位置取得関数
+		CFVector3 const position(unsigned int const&) const noexcept;
+		//!	@brief	回転量取得関数
+		CFQuaternion const rotation(unsigned int const&) const noexcept;
+		//!	@brief	速度取得関数
+		CFVector3 const linear(unsigned int const&) const noexcept;
+		//!	@brief	角速度取得関数
+		CFVector3 const angular(unsigned int const&) const noexcept;
+		//!	@brief	質量の逆数取得関数
+		float const invMass(unsigned int const&) const noexcept;
+		//!	@brief	ワールド座標の慣性テンソルの逆行列取得関数
+		CFMatrix3x3 const invInertia(unsigned int const&) const noexcept;
+		//!	@brief	静的な剛体か否かの判定関数 (拘束で速度が変わらない)
+		bool const fixed(unsigned int const&) const noexcept;
+
+		/**	@brief	速度の積分関数
+		 *	@note	重力と蓄積した力とトルクで速度と角速度を進め、力とトルクを零にする。
+		 */
+		CFRigidBodySoA& integrateVelocity(float const& dt, CFVector3 const& gravity) noexcept;
+		/**	@brief	位置の積分関数
+		 *	@note	回転量は角速度の四元数との積で進めて正規化する。
+		 */
+		CFRigidBodySoA& integratePosition(float const& dt) noexcept;
+
+	private	:
+		//!	@brief	一括処理範囲の速度の積分関数
+		void velocity(size_t const& begin, size_t const& end, float const& dt, CFVector3 const& gravity) noexcept;
+		//!	@brief	一括処理範囲の位置の積分関数
+		void pose(size_t const& begin, size_t const& end, float const& dt) noexcept;
+
+		//!	@brief	剛体数
+		unsigned int m_count;
+		//!	@brief	各チャンネルの成分
+		std::vector<float> m_channels[BODY_CHANNEL_CNT];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+﻿/**	@file	EBodyChannel.hpp
+ *	@brief	剛体の成分チャンネル
+ */
+#pragma once
+
+namespace dlav {
+	/**	@enum	EBodyChannel
+	 *	@brief	剛体の成分チャンネル一覧
+	 */
+	enum class EBodyChannel : unsigned char {
+		//!	@brief	位置の第一成分
+		POS_X,
+		//!	@brief	位置の第二成分
+		POS_Y,
+		//!	@brief	位置の第三成分
+		POS_Z,
+		//!	@brief	回転四元数の第一成分
+		ROT_X,
+		//!	@brief	回転四元数の第二成分
+		ROT_Y,
+		//!	@brief	回転四元数の第三成分
+		ROT_Z,
+		//!	@brief	回転四元数の第四成分
+		ROT_W,
+		//!	@brief	速度の第一成分
+		LIN_X,
+		//!	@brief	速度の第二成分
+		LIN_Y,
+		//!	@brief	速度の第三成分
+		LIN_Z,
+		//!	@brief	角速度 (ワールド座標) の第一成分
+		ANG_X,
+		//!	@brief	角速度 (ワールド座標) の第二成分
+		ANG_Y,
+		//!	@brief	角速度 (ワールド座標) の第三成分
+		ANG_Z,
+		//!	@brief	力の第一成分
+		FRC_X,
+		//!	@brief	力の第二成分
+		FRC_Y,
+		//!	@brief	力の第三成分
+		FRC_Z,
+		//!	@brief	トルクの第一成分
+		TRQ_X,
+		//!	@brief	トルクの第二成分
+		TRQ_Y,
+		//!	@brief	トルクの第三成分
+		TRQ_Z,
+		//!	@brief	質量の逆数 (静的な剛体は 0)
+		INV_MASS,
+		//!	@brief	局所座標の慣性主軸の第一成分の慣性モーメントの逆数
+		INV_INERTIA_X,
+		//!	@brief	局所座標の慣性主軸の第二成分の慣性モーメントの逆数
+		INV_INERTIA_Y,
+		//!	@brief	局所座標の慣性主軸の第三成分の慣性モーメントの逆数
+		INV_INERTIA_Z
+	};
+
+	//!	@brief	チャンネル数
+	static unsigned int constexpr BODY_CHANNEL_CNT = 23U;
+}
\ No newline at end of file
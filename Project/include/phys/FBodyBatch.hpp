@@ -0,0 +1,78 @@
+﻿/**	@file	FBodyBatch.hpp
+ *	@brief	SoA 形式の剛体の一括処理の補助関数群
+ */
+#pragma once
+#include <immintrin.h>
+
+namespace dlav {
+	/**	@brief	単位四元数から回転行列への変換関数
+	 *	@param[in] q 四元数の各成分 (x, y, z, w)
+	 *	@param[out] rot 列ベクトルに掛ける行列の成分 (rot[row * 3 + col])
+	 */
+	void laneRotation(__m256 const (&q)[4U], __m256 (&rot)[9U]) noexcept;
+	/**	@brief	ワールド座標の慣性テンソルの逆行列の積関数
+	 *	@param[in] rot laneRotation で求めた回転行列
+	 *	@param[in] inv 局所座標の慣性主軸毎の慣性モーメントの逆数
+	 *	@param[in] src ワールド座標のベクトル
+	 *	@param[out] dst R diag(inv) R^T src
+	 */
+	void laneInvInertia(__m256 const (&rot)[9U], __m256 const (&inv)[3U], __m256 const (&src)[3U], __m256 (&dst)[3U]) noexcept;
+	//!	@brief	要素毎の外積関数
+	void laneCross(__m256 const (&lhs)[3U], __m256 const (&rhs)[3U], __m256 (&dst)[3U]) noexcept;
+	//!	@brief	要素毎の内積関数
+	__m256 const laneDot(__m256 const (&lhs)[3U], __m256 const (&rhs)[3U]) noexcept;
+
+	/* 実装 */
+
+	inline void laneRotation(__m256 const (&q)[4U], __m256 (&rot)[9U]) noexcept {
+		__m256 two = _mm256_set1_ps(2.0f);
+		__m256 one = _mm256_set1_ps(1.0f);
+		__m256 xx = _mm256_mul_ps(q[0], q[0]);
+		__m256 yy = _mm256_mul_ps(q[1], q[1]);
+		__m256 zz = _mm256_mul_ps(q[2], q[2]);
+		__m256 xy = _mm256_mul_ps(q[0], q[1]);
+		__m256 xz = _mm256_mul_ps(q[0], q[2]);
+		__m256 yz = _mm256_mul_ps(q[1], q[2]);
+		__m256 xw = _mm256_mul_ps(q[0], q[3]);
+		__m256 yw = _mm256_mul_ps(q[1], q[3]);
+		__m256 zw = _mm256_mul_ps(q[2], q[3]);
+		rot[0] = _mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one);
+		rot[1] = _mm256_mul_ps(two, _mm256_sub_ps(xy, zw));
+		rot[2] = _mm256_mul_ps(two, _mm256_add_ps(xz, yw));
+		rot[3] = _mm256_mul_ps(two, _mm256_add_ps(xy, zw));
+		rot[4] = _mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one);
+		rot[5] = _mm256_mul_ps(two, _mm256_sub_ps(yz, xw));
+		rot[6] = _mm256_mul_ps(two, _mm256_sub_ps(xz, yw));
+		rot[7] = _mm256_mul_ps(two, _mm256_add_ps(yz, xw));
+		rot[8] = _mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one);
+	}
+
+	inline void laneInvInertia(__m256 const (&rot)[9U], __m256 const (&inv)[3U], __m256 const (&src)[3U], __m256 (&dst)[3U]) noexcept {
+		//	局所座標へ写して慣性モーメントの逆数を掛け、ワールド座標へ戻す
+		__m256 local[3U];
+		for (unsigned int col = 0U; col < 3U; ++col) {
+			__m256 sum = _mm256_mul_ps(rot[col], src[0]);
+			sum = _mm256_fmadd_ps(rot[3U + col], src[1], sum);
+			sum = _mm256_fmadd_ps(rot[6U + col], src[2], sum);
+			local[col] = _mm256_mul_ps(sum, inv[col]);
+		}
+		for (unsigned int row = 0U; row < 3U; ++row) {
+			__m256 sum = _mm256_mul_ps(rot[row * 3U], local[0]);
+			sum = _mm256_fmadd_ps(rot[row * 3U + 1U], local[1], sum);
+			dst[row] = _mm256_fmadd_ps(rot[row * 3U + 2U], local[2], sum);
+		}
+	}
+
+	inline void laneCross(__m256 const (&lhs)[3U], __m256 const (&rhs)[3U], __m256 (&dst)[3U]) noexcept {
+		__m256 x = _mm256_fmsub_ps(lhs[1], rhs[2], _mm256_mul_ps(lhs[2], rhs[1]));
+		__m256 y = _mm256_fmsub_ps(lhs[2], rhs[0], _mm256_mul_ps(lhs[0], rhs[2]));
+		__m256 z = _mm256_fmsub_ps(lhs[0], rhs[1], _mm256_mul_ps(lhs[1], rhs[0]));
+		dst[0] = x;
+		dst[1] = y;
+		dst[2] = z;
+	}
+
+	inline __m256 const laneDot(__m256 const (&lhs)[3U], __m256 const (&rhs)[3U]) noexcept {
+		return _mm256_fmadd_ps(lhs[0], rhs[0], _mm256_fmadd_ps(lhs[1], rhs[1], _mm256_mul_ps(lhs[2], rhs[2])));
+	}
+}
\ No newline at end of file
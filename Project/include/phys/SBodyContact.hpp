@@ -0,0 +1,26 @@
+﻿/**	@file	SBodyContact.hpp
+ *	@brief	剛体間の接触点
+ */
+#pragma once
+#include "math/CFVector3.hpp"
+
+namespace dlav {
+	/**	@struct	SBodyContact
+	 *	@brief	剛体間の接触点
+	 *	@note	狭域判定の SContact からは normal と distance をそのまま、point は pointA と pointB の中点を渡す。
+	 */
+	struct SBodyContact {
+		//!	@brief	剛体 A の番号
+		unsigned int a;
+		//!	@brief	剛体 B の番号
+		unsigned int b;
+		//!	@brief	A から B へ向かう単位法線
+		CFVector3 normal;
+		//!	@brief	ワールド座標の接触点
+		CFVector3 point;
+		//!	@brief	符号付き距離 (離れている場合は正、貫通時は負)
+		float distance;
+		//!	@brief	摩擦係数
+		float friction;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+﻿/**	@file	CCameraBatch.hpp
+ *	@brief	複数視点の一括カメラ
+ */
+#pragma once
+#include "rend/CDLCamera.hpp"
+#include "rend/CFFrustum.hpp"
+#include "math/EHandSide.hpp"
+#include "math/EDepthMode.hpp"
+#include "math/CFMatrix4x4.hpp"
+#include "math/CFVector4.hpp"
+#include "math/CFQuaternion.hpp"
+#include "math/CDVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@brief	カスケードの分割位置生成関数 (実用分割法)
+	 *	@param[out] dst 分割位置 (count + 1 個、先頭は front、末尾は back)
+	 *	@param[in] count カスケード数
+	 *	@param[in] lambda 対数分割と均等分割の混合比 (1 で対数分割のみ)
+	 *	@note	front が正でない場合、対数分割は front を back の FLT_EPSILON 倍の正の値に丸めて求める。
+	 */
+	void makeCascadeSplits(float* const dst, unsigned int const& count, float const& front, float const& back, float const& lambda) noexcept;
+
+	/**	@class	CCameraBatch
+	 *	@brief	複数視点の一括カメラ
+	 *	@note	シャドウカスケードやキューブマップの各面、画面分割等の視点を成分毎の配列に保持し、
+	 *			update で八視点ずつ AVX2 でビュー・投影・ビュー投影変換行列と視錐台の平面を求める。
+	 *			各行列は CCamera の view_mtx / proj_mtx / viewproj_mtx と同じ規約とする。
+	 */
+	class CCameraBatch final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CCameraBatch(CCameraBatch&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CCameraBatch(CCameraBatch const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CCameraBatch& operator=(CCameraBatch&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CCameraBatch& operator=(CCameraBatch const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CCameraBatch() noexcept;
+		//!	@brief	デストラクタ
+		~CCameraBatch() noexcept = default;
+
+		//!	@brief	領域予約関数
+		void reserve(size_t const&);
+		/**	@brief	視点追加関数
+		 *	@return 視点番号
+		 */
+		size_t const add(CDVector3 const& pos, CFQuaternion const& rot);
+		//!	@brief	視点数取得関数
+		size_t const size() const noexcept;
+
+		//!	@brief	カメラ位置設定関数
+		void eye(size_t const&, CDVector3 const&) noexcept;
+		//!	@brief	カメラ位置取得関数
+		CDVector3 const eye(size_t const&) const noexcept;
+		//!	@brief	姿勢設定関数
+		void posture(size_t const&, CFQuaternion const&) noexcept;
+		//!	@brief	姿勢取得関数
+		CFQuaternion const posture(size_t const&) const noexcept;
+		/**	@brief	透視投影設定関数
+		 *	@note	後方クリップ位置に無限大を与えると無限遠射影となる。
+		 */
+		void perspective(size_t const&, float const& width, float const& height, float const& wndpos, float const& front, float const& back) noexcept;
+		//!	@brief	平行投影設定関数
+		void orthographic(size_t const&, float const& width, float const& height, float const& front, float const& back) noexcept;
+		//!	@brief	深度モード設定関数 (全視点共通)
+		void depth(EDepthMode const&) noexcept;
+
+		/**	@brief	カスケード当て嵌め関数
+		 *	@param[in] view 分割する視点
+		 *	@param[in] light 光源の姿勢
+		 *	@param[in] splits 分割位置 (count + 1 個、makeCascadeSplits の出力)
+		 *	@param[in] first 結果を設定する最初の視点 (first から count 個を平行投影に置き換える)
+		 *	@param[in] backoff 視錐台外の遮蔽物を含める為に光源側へ延長する距離
+		 *	@note	分割した視錐台の頂点を光源空間へ移し、それを囲む最小の軸並行境界箱で投影範囲を決める。
+		 */
+		void fit_cascades(size_t const& view, CFQuaternion const& light, float const* const splits, size_t const& first, size_t const& count, float const& backoff) noexcept;
+
+		//!	@brief	全視点の行列と視錐台の一括更新関数
+		void update(EHandSide const&);
+
+		//!	@brief	ビュー変換行列取得関数
+		CFMatrix4x4 const& view_mtx(size_t const&) const noexcept;
+		//!	@brief	投影変換行列取得関数
+		CFMatrix4x4 const& proj_mtx(size_t const&) const noexcept;
+		//!	@brief	ビュー投影変換行列取得関数
+		CFMatrix4x4 const& viewproj_mtx(size_t const&) const noexcept;
+		/**	@brief	視錐台の平面係数取得関数
+		 *	@return 正規化済みの平面係数 (nx, ny, nz, d) の配列 (CFFrustum::PLANE_CNT 個)
+		 */
+		CFVector4 const* const planes(size_t const&) const noexcept;
+		//!	@brief	視錐台生成関数
+		CFFrustum const frustum(size_t const&) const noexcept;
+
+	private	:
+		/**	@struct	SProjection
+		 *	@brief	投影の設定値
+		 */
+		struct SProjection {
+			//!	@brief	投影モード
+			EProjectiveMode mode;
+			//!	@brief	投影面の幅
+			float width;
+			//!	@brief	投影面の高さ
+			float height;
+			//!	@brief	投影位置
+			float wndpos;
+			//!	@brief	前方クリップ位置
+			float front;
+			//!	@brief	後方クリップ位置
+			float back;
+		};
+
+		//!	@brief	投影変換行列の係数の更新関数
+		void coefficient(size_t const&) noexcept;
+
+		//!	@brief	視点数
+		size_t m_count;
+		//!	@brief	深度モード
+		EDepthMode m_dmode;
+		//!	@brief	投影の設定値
+		std::vector<SProjection> m_projs;
+		//!	@brief	カメラ位置の各成分 (八視点単位に詰め物をする)
+		std::vector<double> m_ex, m_ey, m_ez;
+		//!	@brief	姿勢の各成分
+		std::vector<float> m_qx, m_qy, m_qz, m_qw;
+		/**	@brief	投影変換行列の係数
+		 *	@note	列ベクトル形式で m00 = sx, m11 = sy, m22 = pa, m23 = pb, m32 = pc, m33 = pd 以外は 0 となる。
+		 */
+		std::vector<float> m_sx, m_sy, m_pa, m_pb, m_pc, m_pd;
+		//!	@brief	ビュー変換行列
+		std::vector<CFMatrix4x4> m_views;
+		//!	@brief	投影変換行列
+		std::vector<CFMatrix4x4> m_projections;
+		//!	@brief	ビュー投影変換行列
+		std::vector<CFMatrix4x4> m_viewprojs;
+		//!	@brief	視錐台の平面係数 (一視点につき CFFrustum::PLANE_CNT 個)
+		std::vector<CFVector4> m_planes;
+	};
+}
\ No newline at end of file
@@ -3,12 +3,14 @@
  */
 #pragma once
 #include "math/EHandSide.hpp"
+#include "math/EDepthMode.hpp"
 #include "math/EAxisType.hpp"
 #include "math/CFRotation.hpp"
 #include "math/CFMatrix4x4.hpp"
 #include "math/CFVector4.hpp"
 #include "math/CFVector3.hpp"
 #include "math/CFQuaternion.hpp"
+#include "math/CDVector3.hpp"
 
 namespace dlav {
 	/**	@class	EProjectiveMode
@@ -40,16 +42,6 @@ namespace dlav {
 	public	:
 		//!	@brief	注視位置
 		CFVector3 m_lookat;
-		//!	@brief	垂直画角 (x)
-		float m_height;
-		//!	@brief	水平画角 (y)
-		float m_width;
-		//!	@brief	前方クリップ位置 (z_min)
-		float m_near;
-		//!	@brief	後方クリップ位置 (z_max)
-		float m_far;
-		//!	@brief	投影位置 (d)
-		float m_wndpos;
 
 		//!	@brief	ムーブコンストラクタ
 		CCamera(CCamera&&) noexcept = default;
@@ -65,17 +57,94 @@ namespace dlav {
 		//!	@brief	デストラクタ
 		~CCamera() noexcept = default;
 
+		//!	@brief	カメラ位置設定関数
+		void eye(CDVector3 const&) noexcept;
+		//!	@brief	カメラ位置取得関数
+		CDVector3 const& eye() const noexcept;
+		//!	@brief	姿勢設定関数
+		void posture(CFQuaternion const&) noexcept;
+		//!	@brief	姿勢取得関数
+		CFQuaternion const& posture() const noexcept;
+		/**	@brief	投影面設定関数
+		 *	@param[in]	width	投影位置での投影面の幅
+		 *	@param[in]	height	投影位置での投影面の高さ
+		 *	@param[in]	wndpos	投影位置
+		 */
+		void screen(float const& width, float const& height, float const& wndpos) noexcept;
+		/**	@brief	クリップ位置設定関数
+		 *	@note	後方クリップ位置に無限大を与えると、透視投影では無限遠射影となる。
+		 */
+		void clip(float const& front, float const& back) noexcept;
+		//!	@brief	投影モード設定関数
+		void projective(EProjectiveMode const&) noexcept;
+		//!	@brief	投影モード取得関数
+		EProjectiveMode const& projective() const noexcept;
+		//!	@brief	深度モード設定関数
+		void depth(EDepthMode const&) noexcept;
+		//!	@brief	深度モード取得関数
+		EDepthMode const& depth() const noexcept;
+
 		//!	@brief	ワールド変換行列を生成する関数
 		CFMatrix4x4 world_mtx(EHandSide const&) noexcept;
+		/**	@brief	カメラ相対のワールド変換行列を生成する関数
+		 *	@note	カメラ位置を原点とする空間での行列の為、平行移動成分を持たない。
+		 *			物体側は CLargeWorld::rebase で同じ空間へ移す。
+		 */
+		CFMatrix4x4 relative_world_mtx(EHandSide const&) noexcept;
+		/**	@brief	ビュー変換行列取得関数
+		 *	@note	以下の行列は設定関数で変更が入った時のみ再計算し、それ以外は保持している値を返す。
+		 *			ワールド変換行列の逆行列で、姿勢は単位四元数とする。
+		 */
+		CFMatrix4x4 const& view_mtx(EHandSide const&) noexcept;
+		//!	@brief	投影変換行列取得関数
+		CFMatrix4x4 const& proj_mtx(EHandSide const&) noexcept;
+		//!	@brief	ビュー投影変換行列取得関数
+		CFMatrix4x4 const& viewproj_mtx(EHandSide const&) noexcept;
 
 	private	:
-		//!	@brief	カメラ位置
-		CFVector3 m_eye;
+		//!	@brief	ビュー変換行列の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_VIEW = 0x1U;
+		//!	@brief	投影変換行列の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_PROJ = 0x2U;
+		//!	@brief	ビュー投影変換行列の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_VIEWPROJ = 0x4U;
+		//!	@brief	全ての行列の再計算が必要である事を示すフラグ
+		static unsigned char constexpr DIRTY_ALL = DIRTY_VIEW | DIRTY_PROJ | DIRTY_VIEWPROJ;
+
+		//!	@brief	保持している行列の座標系を合わせる関数
+		void handside(EHandSide const&) noexcept;
+
+		/**	@brief	カメラ位置
+		 *	@note	原点から遠く離れても桁落ちしないよう倍精度で保持する。
+		 */
+		CDVector3 m_eye;
 		//!	@brief	姿勢
 		CFQuaternion m_posture;
+		//!	@brief	ビュー変換行列
+		CFMatrix4x4 m_view;
+		//!	@brief	投影変換行列
+		CFMatrix4x4 m_proj;
+		//!	@brief	ビュー投影変換行列
+		CFMatrix4x4 m_viewproj;
+		//!	@brief	垂直画角 (x)
+		float m_height;
+		//!	@brief	水平画角 (y)
+		float m_width;
+		//!	@brief	前方クリップ位置 (z_min)
+		float m_near;
+		//!	@brief	後方クリップ位置 (z_max)
+		float m_far;
+		//!	@brief	投影位置 (d)
+		float m_wndpos;
 		//!	@brief	投影モード
 		EProjectiveMode m_pmode;
 		//!	@brief	追従モード
 		EFollowMode m_fmode;
+		//!	@brief	深度モード
+		EDepthMode m_dmode;
+		//!	@brief	保持している行列の座標系
+		EHandSide m_hs;
+		//!	@brief	再計算が必要な行列を示すフラグ
+		unsigned char m_dirty;
 	};
 }
\ No newline at end of file
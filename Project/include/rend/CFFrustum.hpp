@@ -0,0 +1,105 @@
+﻿/**	@file	CFFrustum.hpp
+ *	@brief	視錐台
+ */
+#pragma once
+#include "geo/CFPlane3.hpp"
+#include "math/EHandSide.hpp"
+#include "math/CFMatrix4x4.hpp"
+#include "math/CFVector4.hpp"
+#include "math/CFVector3.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@struct	SBoundingSpheres
+	 *	@brief	SoA 形式の境界球群の参照
+	 */
+	struct SBoundingSpheres {
+		//!	@brief	中心の x 成分
+		float const* x;
+		//!	@brief	中心の y 成分
+		float const* y;
+		//!	@brief	中心の z 成分
+		float const* z;
+		//!	@brief	半径
+		float const* radius;
+		//!	@brief	個数
+		size_t count;
+	};
+
+	/**	@struct	SBoundingBoxes
+	 *	@brief	SoA 形式の軸並行境界箱群の参照 (中心と半径)
+	 */
+	struct SBoundingBoxes {
+		//!	@brief	中心の x 成分
+		float const* x;
+		//!	@brief	中心の y 成分
+		float const* y;
+		//!	@brief	中心の z 成分
+		float const* z;
+		//!	@brief	x 方向の半径
+		float const* ex;
+		//!	@brief	y 方向の半径
+		float const* ey;
+		//!	@brief	z 方向の半径
+		float const* ez;
+		//!	@brief	個数
+		size_t count;
+	};
+
+	/**	@class	CFFrustum
+	 *	@brief	視錐台
+	 *	@note	各平面の法線は内側を向く。深度の範囲は Direct3D と同じ [0, w] とする。
+	 *			無限遠の射影の後方平面は係数の法線が零かつＤ値が正となり、全ての点を内側とする。
+	 */
+	class CFFrustum final {
+	public	:
+		//!	@brief	平面数 (左, 右, 下, 上, 前方, 後方)
+		static unsigned int constexpr PLANE_CNT = 6U;
+
+		//!	@brief	ムーブコンストラクタ
+		CFFrustum(CFFrustum&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CFFrustum(CFFrustum const&) noexcept = default;
+		//!	@brief	ムーブ代入演算子
+		CFFrustum& operator=(CFFrustum&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CFFrustum& operator=(CFFrustum const&) noexcept = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CFFrustum() noexcept;
+		//!	@brief	デストラクタ
+		~CFFrustum() noexcept = default;
+
+		/**	@brief	初期化関数
+		 *	@param[in] hs 行列の座標系 (RHS は行ベクトル、LHS は列ベクトルに作用する)
+		 *	@param[in] viewproj ビュー射影行列
+		 */
+		CFFrustum& init(EHandSide const& hs, CFMatrix4x4 const& viewproj) noexcept;
+		/**	@brief	初期化関数
+		 *	@param[in] planes 平面係数 (nx, ny, nz, d) の配列 (PLANE_CNT 個、法線は内側向き)
+		 */
+		CFFrustum& init(CFVector4 const* const planes) noexcept;
+
+		//!	@brief	平面取得関数
+		CFPlane3 const& plane(unsigned int const&) const noexcept;
+
+		//!	@brief	球の包含判定関数 (一部でも内側にあれば真)
+		bool const contains(CFVector3 const& center, float const& radius) const noexcept;
+		//!	@brief	軸並行境界箱の包含判定関数 (一部でも内側にあれば真)
+		bool const contains(CFVector3 const& center, CFVector3 const& extent) const noexcept;
+
+		/**	@brief	一括視錐台カリング関数
+		 *	@param[in] spheres 境界球群
+		 *	@param[out] visible 可視の番号 (昇順)
+		 *	@return 可視の個数
+		 *	@note	八個ずつ AVX2 で判定し、CJobSystem で区間毎に並列化する。
+		 */
+		size_t const cull(SBoundingSpheres const& spheres, std::vector<unsigned int>& visible) const;
+		//!	@brief	一括視錐台カリング関数
+		size_t const cull(SBoundingBoxes const& boxes, std::vector<unsigned int>& visible) const;
+
+	private	:
+		//!	@brief	平面
+		CFPlane3 m_planes[PLANE_CNT];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+﻿/**	@file	CLargeWorld.hpp
+ *	@brief	広大な空間に配置された物体群
+ */
+#pragma once
+#include "math/EHandSide.hpp"
+#include "math/CDVector3.hpp"
+#include "math/CFMatrix4x4.hpp"
+#include <vector>
+
+namespace dlav {
+	/**	@class	CLargeWorld
+	 *	@brief	広大な空間に配置された物体群
+	 *	@note	物体の位置は倍精度で、回転・拡縮は単精度で成分毎の配列に保持する。
+	 *			毎フレーム rebase でカメラ位置を原点とする単精度のワールド変換行列を一括生成し、
+	 *			描画側はカメラの relative_world_mtx と組み合わせて用いる。
+	 */
+	class CLargeWorld final {
+	public	:
+		//!	@brief	ムーブコンストラクタ
+		CLargeWorld(CLargeWorld&&) noexcept = default;
+		//!	@brief	コピーコンストラクタ
+		CLargeWorld(CLargeWorld const&) = default;
+		//!	@brief	ムーブ代入演算子
+		CLargeWorld& operator=(CLargeWorld&&) noexcept = default;
+		//!	@brief	コピー代入演算子
+		CLargeWorld& operator=(CLargeWorld const&) = default;
+
+		//!	@brief	デフォルトコンストラクタ
+		CLargeWorld() noexcept;
+		//!	@brief	デストラクタ
+		~CLargeWorld() noexcept = default;
+
+		//!	@brief	領域予約関数
+		void reserve(size_t const&);
+		/**	@brief	物体追加関数
+		 *	@param[in] pos 位置
+		 *	@param[in] basis 回転・拡縮行列 (平行移動成分は無視する)
+		 *	@return 物体番号
+		 */
+		size_t const add(CDVector3 const& pos, CFMatrix4x4 const& basis);
+
+		//!	@brief	位置設定関数
+		void position(size_t const&, CDVector3 const&) noexcept;
+		//!	@brief	位置取得関数
+		CDVector3 const& position(size_t const&) const noexcept;
+		//!	@brief	回転・拡縮行列設定関数
+		void basis(size_t const&, CFMatrix4x4 const&) noexcept;
+		//!	@brief	回転・拡縮行列取得関数
+		CFMatrix4x4 const& basis(size_t const&) const noexcept;
+
+		//!	@brief	物体数取得関数
+		size_t const size() const noexcept;
+
+		/**	@brief	基準位置変更関数
+		 *	@param[in] hs 平行移動成分の配置を決める座標系
+		 *	@param[in] origin 基準位置 (カメラ位置)
+		 *	@note	全物体を一度の走査で処理し、結果は relative で取得する。
+		 */
+		void rebase(EHandSide const& hs, CDVector3 const& origin) noexcept;
+		//!	@brief	基準位置からの相対ワールド変換行列取得関数
+		CFMatrix4x4 const* const relative() const noexcept;
+
+	private	:
+		//!	@brief	位置
+		std::vector<CDVector3> m_positions;
+		//!	@brief	回転・拡縮行列
+		std::vector<CFMatrix4x4> m_bases;
+		//!	@brief	基準位置からの相対ワールド変換行列
+		std::vector<CFMatrix4x4> m_relatives;
+	};
+}
\ No newline at end of file
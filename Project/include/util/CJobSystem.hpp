@@ -0,0 +1,84 @@
+﻿/**	@file	CJobSystem.hpp
+ *	@brief	並列処理用のジョブシステム
+ */
+#pragma once
+#include "ISingleton.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dlav {
+	/**	@class	CJobSystem
+	 *	@brief	並列処理用のジョブシステム
+	 *	@note	常駐するワーカースレッドに区間を分配する最小限の parallel_for のみを提供する。
+	 *			init を呼ばない場合は呼び出し元のスレッドで逐次処理する。
+	 */
+	class CJobSystem final :
+		public ISingleton<CJobSystem>
+	{
+	public	:
+		/**	@brief	区間処理関数型
+		 *	@param[in] begin 区間の先頭番号
+		 *	@param[in] end 区間の末尾番号 (含まない)
+		 */
+		using FRange = std::function<void(size_t const& begin, size_t const& end)>;
+
+		//!	@brief	デフォルトコンストラクタ
+		CJobSystem() noexcept;
+		//!	@brief	デストラクタ
+		~CJobSystem() noexcept;
+
+		/**	@brief	初期化関数
+		 *	@param[in] count ワーカースレッド数 (0 の場合は論理コア数 - 1)
+		 */
+		bool const init(unsigned int const& count = 0U) noexcept;
+		//!	@brief	終了関数
+		void uninit() noexcept;
+
+		//!	@brief	並列度取得関数 (呼び出し元のスレッドを含む)
+		unsigned int const concurrency() const noexcept;
+
+		/**	@brief	並列反復関数
+		 *	@param[in] count 要素数
+		 *	@param[in] grain 一度に処理する要素数
+		 *	@param[in] func 区間処理関数
+		 *	@note	呼び出し元のスレッドも処理に加わり、全区間の完了まで戻らない。
+		 *			区間処理関数の中から呼ばれた場合 (入れ子) は、そのスレッドで全区間を逐次処理する。
+		 */
+		void parallel_for(size_t const& count, size_t const& grain, FRange const& func) noexcept;
+
+	private	:
+		//!	@brief	ワーカースレッドの処理関数
+		void work() noexcept;
+		//!	@brief	区間消化関数
+		void drain() noexcept;
+
+		//!	@brief	ワーカースレッド
+		std::vector<std::thread> m_threads;
+		//!	@brief	呼び出し元の直列化用排他
+		std::mutex m_dispatch;
+		//!	@brief	状態の排他
+		std::mutex m_mutex;
+		//!	@brief	起床通知
+		std::condition_variable m_wake;
+		//!	@brief	完了通知
+		std::condition_variable m_done;
+		//!	@brief	区間処理関数
+		FRange const* m_func;
+		//!	@brief	要素数
+		size_t m_count;
+		//!	@brief	一度に処理する要素数
+		size_t m_grain;
+		//!	@brief	次に処理する区間の先頭番号
+		std::atomic<size_t> m_next;
+		//!	@brief	処理中のワーカースレッド数
+		unsigned int m_active;
+		//!	@brief	ジョブの世代
+		unsigned long long m_generation;
+		//!	@brief	終了要求
+		bool m_quit;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+﻿/**	@file	SDouble3.hpp
+ *	@brief	三つの倍精度浮動小数点数を束ねた構造体
+ */
+#pragma once
+#pragma warning(disable : 4201)
+
+namespace dlav {
+	//!	@brief	成分数
+	static unsigned int constexpr DBL3_CNT = 3U;
+
+	/**	@struct SDouble3
+	 *	@brief	三つの倍精度浮動小数点数を束ねた構造体
+	 */
+	struct SDouble3 {
+		union {
+			//!	@brief	全成分
+			double p[3U];
+			struct {
+				//!	@brief	第一成分
+				double x;
+				//!	@brief	第二成分
+				double y;
+				//!	@brief	第三成分
+				double z;
+			};
+		};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+﻿/**	@file	SDouble4.hpp
+ *	@brief	四つの倍精度浮動小数点数を束ねた構造体
+ */
+#pragma once
+#pragma warning(disable : 4201)
+
+namespace dlav {
+	//!	@brief	成分数
+	static unsigned int constexpr DBL4_CNT = 4U;
+
+	/**	@struct SDouble4
+	 *	@brief	四つの倍精度浮動小数点数を束ねた構造体
+	 */
+	struct SDouble4 {
+		union {
+			//!	@brief	全成分
+			double p[4U];
+			struct {
+				//!	@brief	第一成分
+				double x;
+				//!	@brief	第二成分
+				double y;
+				//!	@brief	第三成分
+				double z;
+				//!	@brief	第四成分
+				double w;
+			};
+		};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+﻿/**	@file	SDouble4x4.hpp
+ *	@brief	十余り六つの倍精度浮動小数点数を束ねた構造体
+ */
+#pragma once
+#pragma warning(disable : 4201)
+
+namespace dlav {
+	//!	@brief	成分数
+	static unsigned int constexpr DBL4x4_CNT = 16U;
+
+	/**	@struct	SDouble4x4
+	 *	@brief	十余り六つの倍精度浮動小数点数を束ねた構造体
+	 */
+	struct SDouble4x4 {
+		union {
+			//!	@brief	全成分
+			double p[16U];
+			struct {
+				//!	@brief	一行一列目の成分
+				double m00;
+				//!	@brief	一行二列目の成分
+				double m01;
+				//!	@brief	一行三列目の成分
+				double m02;
+				//!	@brief	一行四列目の成分
+				double m03;
+				//!	@brief	二行一列目の成分
+				double m10;
+				//!	@brief	二行二列目の成分
+				double m11;
+				//!	@brief	二行三列目の成分
+				double m12;
+				//!	@brief	二行四列目の成分
+				double m13;
+				//!	@brief	三行一列目の成分
+				double m20;
+				//!	@brief	三行二列目の成分
+				double m21;
+				//!	@brief	三行三列目の成分
+				double m22;
+				//!	@brief	三行四列目の成分
+				double m23;
+				//!	@brief	四行一列目の成分
+				double m30;
+				//!	@brief	四行二列目の成分
+				double m31;
+				//!	@brief	四行三列目の成分
+				double m32;
+				//!	@brief	四行四列目の成分
+				double m33;
+			};
+		};
+	};
+}
\ No newline at end of file
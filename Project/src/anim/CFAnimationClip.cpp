@@ -0,0 +1,62 @@
+﻿/**	@file	CFAnimationClip.cpp
+ *	@brief	等間隔標本化されたアニメーションクリップ
+ */
+#include "anim/CFAnimationClip.hpp"
+
+namespace dlav {
+	CFAnimationClip::CFAnimationClip() noexcept :
+		m_trackCount(0U),
+		m_frameCount(0U),
+		m_frameRate(0.0f),
+		m_rotations(),
+		m_translations()
+	{}
+
+	CFAnimationClip& CFAnimationClip::init(unsigned int const& trackCount, unsigned int const& frameCount, float const& frameRate) {
+		m_trackCount = trackCount;
+		m_frameCount = frameCount;
+		m_frameRate = frameRate;
+		m_rotations.assign(static_cast<size_t>(trackCount) * frameCount, UNIT_FQT);
+		m_translations.assign(static_cast<size_t>(trackCount) * frameCount, ZERO_FVT3);
+		return *this;
+	}
+
+	CFQuaternion& CFAnimationClip::rotation(unsigned int const& track, unsigned int const& frame) noexcept {
+		return m_rotations[static_cast<size_t>(track) * m_frameCount + frame];
+	}
+
+	CFQuaternion const& CFAnimationClip::rotation(unsigned int const& track, unsigned int const& frame) const noexcept {
+		return m_rotations[static_cast<size_t>(track) * m_frameCount + frame];
+	}
+
+	CFVector3& CFAnimationClip::translation(unsigned int const& track, unsigned int const& frame) noexcept {
+		return m_translations[static_cast<size_t>(track) * m_frameCount + frame];
+	}
+
+	CFVector3 const& CFAnimationClip::translation(unsigned int const& track, unsigned int const& frame) const noexcept {
+		return m_translations[static_cast<size_t>(track) * m_frameCount + frame];
+	}
+
+	unsigned int const CFAnimationClip::trackCount() const noexcept {
+		return m_trackCount;
+	}
+
+	unsigned int const CFAnimationClip::frameCount() const noexcept {
+		return m_frameCount;
+	}
+
+	float const CFAnimationClip::frameRate() const noexcept {
+		return m_frameRate;
+	}
+
+	float const CFAnimationClip::duration() const noexcept {
+		if (m_frameCount == 0U || m_frameRate <= 0.0f) {
+			return 0.0f;
+		}
+		return static_cast<float>(m_frameCount - 1U) / m_frameRate;
+	}
+
+	size_t const CFAnimationClip::byteSize() const noexcept {
+		return static_cast<size_t>(m_trackCount) * m_frameCount * sizeof(float) * (FLT4_CNT + FLT3_CNT);
+	}
+}
\ No newline at end of file
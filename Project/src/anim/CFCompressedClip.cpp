@@ -0,0 +1,447 @@
+﻿/**	@file	CFCompressedClip.cpp
+ *	@brief	圧縮済みアニメーションクリップ
+ */
+#include "anim/CFCompressedClip.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	最大成分を除いた四元数成分の取り得る範囲 (1/√2)
+		float constexpr QT_RANGE = 0.707106781186547524f;
+		//!	@brief	四元数成分の量子化段階数 (15 bit)
+		float constexpr QT_STEPS = 32767.0f;
+		//!	@brief	移動量成分の量子化段階数 (16 bit)
+		float constexpr POS_STEPS = 65535.0f;
+
+		//!	@brief	四元数の最小三成分圧縮関数
+		SQuantized3 const encodeRotation(CFQuaternion const& arg) noexcept {
+			SQuantized3 result = {};
+			CFQuaternion qt = arg.normalize();
+			unsigned int big = 0U;
+			for (unsigned int idx = 1U; idx < FLT4_CNT; ++idx) {
+				if (fabsf(qt.p[idx]) > fabsf(qt.p[big])) {
+					big = idx;
+				}
+			}
+			if (qt.p[big] < 0.0f) {
+				qt *= -1.0f;
+			}
+
+			unsigned int dst = 0U;
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				if (idx == big) {
+					continue;
+				}
+				float tmp = std::clamp(qt.p[idx] / QT_RANGE, -1.0f, 1.0f) * 0.5f + 0.5f;
+				result.p[dst] = static_cast<unsigned short>(lroundf(tmp * QT_STEPS));
+				++dst;
+			}
+			result.p[0U] = static_cast<unsigned short>(result.p[0U] | ((big >> 1U) << 15U));
+			result.p[1U] = static_cast<unsigned short>(result.p[1U] | ((big & 1U) << 15U));
+			return result;
+		}
+
+		//!	@brief	四元数の最小三成分展開関数
+		CFQuaternion const decodeRotation(SQuantized3 const& arg) noexcept {
+			CFQuaternion result;
+			unsigned int big = ((arg.p[0U] >> 15U) << 1U) | (arg.p[1U] >> 15U);
+			float tmp[3U];
+			float sq = 0.0f;
+			for (unsigned int idx = 0U; idx < 3U; ++idx) {
+				tmp[idx] = static_cast<float>(arg.p[idx] & 0x7FFFU) * (2.0f * QT_RANGE / QT_STEPS) - QT_RANGE;
+				sq += tmp[idx] * tmp[idx];
+			}
+
+			unsigned int src = 0U;
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				if (idx == big) {
+					result.p[idx] = std::sqrt(std::max(0.0f, 1.0f - sq));
+					continue;
+				}
+				result.p[idx] = tmp[src];
+				++src;
+			}
+			return result;
+		}
+
+		//!	@brief	移動量の量子化関数
+		SQuantized3 const encodePosition(CFVector3 const& arg, float const* const min, float const* const scale) noexcept {
+			SQuantized3 result = {};
+			for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+				if (scale[idx] > 0.0f) {
+					float tmp = std::clamp((arg.p[idx] - min[idx]) / scale[idx], 0.0f, POS_STEPS);
+					result.p[idx] = static_cast<unsigned short>(lroundf(tmp));
+				}
+			}
+			return result;
+		}
+
+		//!	@brief	移動量の逆量子化関数
+		CFVector3 const decodePosition(SQuantized3 const& arg, float const* const min, float const* const scale) noexcept {
+			CFVector3 result;
+			for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+				result.p[idx] = min[idx] + static_cast<float>(arg.p[idx]) * scale[idx];
+			}
+			return result;
+		}
+
+		//!	@brief	正規化線形補間関数 (最短経路)
+		CFQuaternion const nlerp(CFQuaternion const& begin, CFQuaternion const& end, float const& rate) noexcept {
+			CFQuaternion tmp = end;
+			if (begin.x * end.x + begin.y * end.y + begin.z * end.z + begin.w * end.w < 0.0f) {
+				tmp *= -1.0f;
+			}
+			return ((tmp - begin) * rate + begin).normalize();
+		}
+
+		//!	@brief	線形補間関数
+		CFVector3 const lerp(CFVector3 const& begin, CFVector3 const& end, float const& rate) noexcept {
+			return (end - begin) * rate + begin;
+		}
+
+		/**	@brief	回転量誤差計算関数 (弧度法)
+		 *	@note	微小角で精度が落ちる acos を避け、弦長 |a - b| = 2sin(θ/4) から求める。
+		 */
+		float const rotationError(CFQuaternion const& lhs, CFQuaternion const& rhs) noexcept {
+			CFQuaternion a = lhs.normalize();
+			CFQuaternion b = rhs.normalize();
+			if (a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f) {
+				b *= -1.0f;
+			}
+			CFQuaternion tmp = a - b;
+			float chord = std::sqrt(tmp.x * tmp.x + tmp.y * tmp.y + tmp.z * tmp.z + tmp.w * tmp.w);
+			return 4.0f * asinf(std::min(chord * 0.5f, 1.0f));
+		}
+
+		//!	@brief	移動量誤差計算関数
+		float const positionError(CFVector3 const& lhs, CFVector3 const& rhs) noexcept {
+			CFVector3 tmp = lhs - rhs;
+			return std::sqrt(tmp.x * tmp.x + tmp.y * tmp.y + tmp.z * tmp.z);
+		}
+
+		/**	@brief	キー間引き関数
+		 *	@note	始点から誤差が許容範囲に収まる終点を倍々に延ばして探し、最後に収まった終点と最初に外れた終点の間を二分探索する。
+		 *			一区間の判定は区間長に比例する為、キー数 L に対して O(L log L) で済む。
+		 *			補間は量子化後の値で行う為、量子化誤差も許容誤差に含まれる。
+		 */
+		template <typename T, typename Lerp, typename Error>
+		void reduce(std::vector<unsigned short>& keys, T const* const raw, T const* const quantized, unsigned int const& count, float const& tolerance, Lerp const& interp, Error const& error) {
+			keys.push_back(0U);
+			unsigned int begin = 0U;
+			auto fits = [&](unsigned int const& next) {
+				for (unsigned int idx = begin + 1U; idx < next; ++idx) {
+					float rate = static_cast<float>(idx - begin) / static_cast<float>(next - begin);
+					if (error(interp(quantized[begin], quantized[next], rate), raw[idx]) > tolerance) {
+						return false;
+					}
+				}
+				return true;
+			};
+			while (begin + 1U < count) {
+				unsigned int end = begin + 1U;
+				unsigned int step = 1U;
+				while (end + step < count && fits(end + step)) {
+					end += step;
+					step <<= 1U;
+				}
+				unsigned int fail = std::min(end + step, count);
+				while (fail - end > 1U) {
+					unsigned int mid = end + (fail - end) / 2U;
+					if (fits(mid)) {
+						end = mid;
+					}
+					else {
+						fail = mid;
+					}
+				}
+				keys.push_back(static_cast<unsigned short>(end));
+				begin = end;
+			}
+		}
+
+		//!	@brief	キー検索関数
+		void locate(unsigned short const* const frames, unsigned int const& count, float const& frame, unsigned int& key0, unsigned int& key1, float& rate) noexcept {
+			unsigned short const* it = std::upper_bound(frames, frames + count, frame, [](float const& lhs, unsigned short const& rhs) {
+				return lhs < static_cast<float>(rhs);
+			});
+			key1 = static_cast<unsigned int>(it - frames);
+			if (key1 >= count) {
+				key0 = key1 = count - 1U;
+				rate = 0.0f;
+				return;
+			}
+			key0 = key1 - 1U;
+			rate = (frame - static_cast<float>(frames[key0])) / static_cast<float>(frames[key1] - frames[key0]);
+		}
+
+		//!	@brief	最小三成分圧縮された四元数の一括展開関数
+		void decodeRotation8(int const* const src, __m256 dst[4U]) noexcept {
+			__m256i x = _mm256_load_si256(reinterpret_cast<__m256i const*>(src));
+			__m256i y = _mm256_load_si256(reinterpret_cast<__m256i const*>(src + 8U));
+			__m256i z = _mm256_load_si256(reinterpret_cast<__m256i const*>(src + 16U));
+			__m256i mask = _mm256_set1_epi32(0x7FFF);
+			__m256i big = _mm256_or_si256(_mm256_slli_epi32(_mm256_srli_epi32(x, 15), 1), _mm256_srli_epi32(y, 15));
+
+			__m256 scale = _mm256_set1_ps(2.0f * QT_RANGE / QT_STEPS);
+			__m256 bias = _mm256_set1_ps(-QT_RANGE);
+			__m256 a = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_and_si256(x, mask)), scale, bias);
+			__m256 b = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_and_si256(y, mask)), scale, bias);
+			__m256 c = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_and_si256(z, mask)), scale, bias);
+			__m256 sq = _mm256_fmadd_ps(a, a, _mm256_fmadd_ps(b, b, _mm256_mul_ps(c, c)));
+			__m256 d = _mm256_sqrt_ps(_mm256_max_ps(_mm256_setzero_ps(), _mm256_sub_ps(_mm256_set1_ps(1.0f), sq)));
+
+			__m256 m0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(big, _mm256_set1_epi32(0)));
+			__m256 m1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(big, _mm256_set1_epi32(1)));
+			__m256 m2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(big, _mm256_set1_epi32(2)));
+			__m256 m3 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(big, _mm256_set1_epi32(3)));
+
+			dst[0U] = _mm256_blendv_ps(a, d, m0);
+			dst[1U] = _mm256_blendv_ps(_mm256_blendv_ps(b, d, m1), a, m0);
+			dst[2U] = _mm256_blendv_ps(_mm256_blendv_ps(c, d, m2), b, _mm256_or_ps(m0, m1));
+			dst[3U] = _mm256_blendv_ps(c, d, m3);
+		}
+
+		/**	@brief	一括展開用の作業領域
+		 *	@note	各配列は成分毎に 8 要素ずつ並ぶ (SoA)。
+		 */
+		struct alignas(32) SDecodeStage final {
+			//!	@brief	補間始点の回転キー
+			int rot0[3U * CFPoseSoA::LANE_CNT];
+			//!	@brief	補間終点の回転キー
+			int rot1[3U * CFPoseSoA::LANE_CNT];
+			//!	@brief	補間始点の移動キー
+			int pos0[3U * CFPoseSoA::LANE_CNT];
+			//!	@brief	補間終点の移動キー
+			int pos1[3U * CFPoseSoA::LANE_CNT];
+			//!	@brief	移動量の最小値
+			float min[3U * CFPoseSoA::LANE_CNT];
+			//!	@brief	移動量の量子化幅
+			float scale[3U * CFPoseSoA::LANE_CNT];
+			//!	@brief	回転量の補間率
+			float rotRate[CFPoseSoA::LANE_CNT];
+			//!	@brief	移動量の補間率
+			float posRate[CFPoseSoA::LANE_CNT];
+		};
+	}
+
+	CFCompressedClip::CFCompressedClip() noexcept :
+		m_trackCount(0U),
+		m_frameCount(0U),
+		m_frameRate(0.0f),
+		m_rotOffsets(),
+		m_rotFrames(),
+		m_rotKeys(),
+		m_posOffsets(),
+		m_posFrames(),
+		m_posKeys(),
+		m_posMin(),
+		m_posScale()
+	{}
+
+	CFCompressedClip& CFCompressedClip::compress(CFAnimationClip const& clip, float const& rotTolerance, float const& posTolerance) {
+		m_trackCount = clip.trackCount();
+		m_frameCount = std::min(clip.frameCount(), 65536U);
+		m_frameRate = clip.frameRate();
+
+		m_rotOffsets.assign(1U, 0U);
+		m_posOffsets.assign(1U, 0U);
+		m_rotFrames.clear();
+		m_rotKeys.clear();
+		m_posFrames.clear();
+		m_posKeys.clear();
+		m_posMin.assign(static_cast<size_t>(m_trackCount) * FLT3_CNT, 0.0f);
+		m_posScale.assign(static_cast<size_t>(m_trackCount) * FLT3_CNT, 0.0f);
+		if (m_frameCount == 0U) {
+			m_rotOffsets.assign(m_trackCount + 1U, 0U);
+			m_posOffsets.assign(m_trackCount + 1U, 0U);
+			return *this;
+		}
+
+		std::vector<CFQuaternion> rotRaw(m_frameCount), rotQuantized(m_frameCount);
+		std::vector<CFVector3> posRaw(m_frameCount), posQuantized(m_frameCount);
+		std::vector<SQuantized3> rotCodes(m_frameCount), posCodes(m_frameCount);
+		std::vector<unsigned short> keys;
+
+		for (unsigned int track = 0U; track < m_trackCount; ++track) {
+			//	回転量を量子化し、量子化後の値を基準にキーを間引く。
+			for (unsigned int frame = 0U; frame < m_frameCount; ++frame) {
+				rotRaw[frame] = clip.rotation(track, frame);
+				rotCodes[frame] = encodeRotation(rotRaw[frame]);
+				rotQuantized[frame] = decodeRotation(rotCodes[frame]);
+			}
+			keys.clear();
+			reduce(keys, rotRaw.data(), rotQuantized.data(), m_frameCount, rotTolerance, nlerp, rotationError);
+			for (unsigned short const& key : keys) {
+				m_rotFrames.push_back(key);
+				m_rotKeys.push_back(rotCodes[key]);
+			}
+			m_rotOffsets.push_back(static_cast<unsigned int>(m_rotKeys.size()));
+
+			//	移動量はトラック毎の値域で正規化してから量子化する。
+			float* min = &m_posMin[static_cast<size_t>(track) * FLT3_CNT];
+			float* scale = &m_posScale[static_cast<size_t>(track) * FLT3_CNT];
+			CFVector3 lo = clip.translation(track, 0U), hi = lo;
+			for (unsigned int frame = 0U; frame < m_frameCount; ++frame) {
+				posRaw[frame] = clip.translation(track, frame);
+				for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+					lo.p[idx] = std::min(lo.p[idx], posRaw[frame].p[idx]);
+					hi.p[idx] = std::max(hi.p[idx], posRaw[frame].p[idx]);
+				}
+			}
+			for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+				min[idx] = lo.p[idx];
+				scale[idx] = (hi.p[idx] - lo.p[idx]) / POS_STEPS;
+			}
+			for (unsigned int frame = 0U; frame < m_frameCount; ++frame) {
+				posCodes[frame] = encodePosition(posRaw[frame], min, scale);
+				posQuantized[frame] = decodePosition(posCodes[frame], min, scale);
+			}
+			keys.clear();
+			reduce(keys, posRaw.data(), posQuantized.data(), m_frameCount, posTolerance, lerp, positionError);
+			for (unsigned short const& key : keys) {
+				m_posFrames.push_back(key);
+				m_posKeys.push_back(posCodes[key]);
+			}
+			m_posOffsets.push_back(static_cast<unsigned int>(m_posKeys.size()));
+		}
+
+		return *this;
+	}
+
+	void CFCompressedClip::sample(float const& time, CFPoseSoA& pose) const noexcept {
+		if (m_trackCount == 0U || m_frameCount == 0U || pose.size() < m_trackCount) {
+			return;
+		}
+
+		float frame = std::clamp(time * m_frameRate, 0.0f, static_cast<float>(m_frameCount - 1U));
+		float* rot[FLT4_CNT] = {
+			pose.channel(EPoseChannel::ROT_X),
+			pose.channel(EPoseChannel::ROT_Y),
+			pose.channel(EPoseChannel::ROT_Z),
+			pose.channel(EPoseChannel::ROT_W)
+		};
+		float* pos[FLT3_CNT] = {
+			pose.channel(EPoseChannel::POS_X),
+			pose.channel(EPoseChannel::POS_Y),
+			pose.channel(EPoseChannel::POS_Z)
+		};
+
+		SDecodeStage stage = {};
+		unsigned int const lanes = CFPoseSoA::LANE_CNT;
+		for (unsigned int base = 0U; base < m_trackCount; base += lanes) {
+			//	キーの検索のみスカラで行い、展開と補間は 8 トラック単位で行う。
+			for (unsigned int lane = 0U; lane < lanes; ++lane) {
+				unsigned int track = base + lane;
+				if (track >= m_trackCount) {
+					stage.rotRate[lane] = stage.posRate[lane] = 0.0f;
+					continue;
+				}
+
+				unsigned int key0, key1;
+				unsigned int begin = m_rotOffsets[track];
+				locate(&m_rotFrames[begin], m_rotOffsets[track + 1U] - begin, frame, key0, key1, stage.rotRate[lane]);
+				for (unsigned int idx = 0U; idx < 3U; ++idx) {
+					stage.rot0[idx * lanes + lane] = m_rotKeys[begin + key0].p[idx];
+					stage.rot1[idx * lanes + lane] = m_rotKeys[begin + key1].p[idx];
+				}
+
+				begin = m_posOffsets[track];
+				locate(&m_posFrames[begin], m_posOffsets[track + 1U] - begin, frame, key0, key1, stage.posRate[lane]);
+				for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+					stage.pos0[idx * lanes + lane] = m_posKeys[begin + key0].p[idx];
+					stage.pos1[idx * lanes + lane] = m_posKeys[begin + key1].p[idx];
+					stage.min[idx * lanes + lane] = m_posMin[track * FLT3_CNT + idx];
+					stage.scale[idx * lanes + lane] = m_posScale[track * FLT3_CNT + idx];
+				}
+			}
+
+			//	最後の組はトラック数を超えるレーンを書き込まない (姿勢の後続の関節を上書きしない為)
+			unsigned int live = std::min(m_trackCount - base, lanes);
+			__m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(live)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+			auto store = [&](float* const dst, __m256 const& value) {
+				if (live == lanes) {
+					_mm256_storeu_ps(dst, value);
+				}
+				else {
+					_mm256_maskstore_ps(dst, mask, value);
+				}
+			};
+
+			//	回転量 : 展開 → 最短経路の正規化線形補間
+			__m256 q0[FLT4_CNT], q1[FLT4_CNT];
+			decodeRotation8(stage.rot0, q0);
+			decodeRotation8(stage.rot1, q1);
+			__m256 rate = _mm256_load_ps(stage.rotRate);
+			__m256 dot = _mm256_mul_ps(q0[0U], q1[0U]);
+			for (unsigned int idx = 1U; idx < FLT4_CNT; ++idx) {
+				dot = _mm256_fmadd_ps(q0[idx], q1[idx], dot);
+			}
+			__m256 sign = _mm256_and_ps(dot, _mm256_set1_ps(-0.0f));
+			__m256 sq = _mm256_setzero_ps();
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				__m256 end = _mm256_xor_ps(q1[idx], sign);
+				q0[idx] = _mm256_fmadd_ps(_mm256_sub_ps(end, q0[idx]), rate, q0[idx]);
+				sq = _mm256_fmadd_ps(q0[idx], q0[idx], sq);
+			}
+			__m256 inorm = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(sq));
+			for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+				store(rot[idx] + base, _mm256_mul_ps(q0[idx], inorm));
+			}
+
+			//	移動量 : 逆量子化 → 線形補間
+			rate = _mm256_load_ps(stage.posRate);
+			for (unsigned int idx = 0U; idx < FLT3_CNT; ++idx) {
+				__m256 min = _mm256_load_ps(&stage.min[idx * lanes]);
+				__m256 scale = _mm256_load_ps(&stage.scale[idx * lanes]);
+				__m256 v0 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<__m256i const*>(&stage.pos0[idx * lanes]))), scale, min);
+				__m256 v1 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<__m256i const*>(&stage.pos1[idx * lanes]))), scale, min);
+				store(pos[idx] + base, _mm256_fmadd_ps(_mm256_sub_ps(v1, v0), rate, v0));
+			}
+		}
+	}
+
+	SClipCompressionReport const CFCompressedClip::report(CFAnimationClip const& clip) const {
+		SClipCompressionReport result = {};
+		result.rawBytes = clip.byteSize();
+		result.compressedBytes = byteSize();
+		result.ratio = result.compressedBytes > 0U ? static_cast<float>(result.rawBytes) / static_cast<float>(result.compressedBytes) : 0.0f;
+		result.rotationKeys = static_cast<unsigned int>(m_rotKeys.size());
+		result.translationKeys = static_cast<unsigned int>(m_posKeys.size());
+		if (m_trackCount != clip.trackCount() || m_frameRate <= 0.0f) {
+			return result;
+		}
+
+		CFPoseSoA pose;
+		pose.init(m_trackCount);
+		unsigned int frames = std::min(m_frameCount, clip.frameCount());
+		for (unsigned int frame = 0U; frame < frames; ++frame) {
+			sample(static_cast<float>(frame) / m_frameRate, pose);
+			for (unsigned int track = 0U; track < m_trackCount; ++track) {
+				result.maxRotationError = std::max(result.maxRotationError, rotationError(pose.rotation(track), clip.rotation(track, frame)));
+				result.maxTranslationError = std::max(result.maxTranslationError, positionError(pose.translation(track), clip.translation(track, frame)));
+			}
+		}
+		return result;
+	}
+
+	unsigned int const CFCompressedClip::trackCount() const noexcept {
+		return m_trackCount;
+	}
+
+	unsigned int const CFCompressedClip::frameCount() const noexcept {
+		return m_frameCount;
+	}
+
+	float const CFCompressedClip::frameRate() const noexcept {
+		return m_frameRate;
+	}
+
+	size_t const CFCompressedClip::byteSize() const noexcept {
+		return sizeof(unsigned int) * (m_rotOffsets.size() + m_posOffsets.size())
+			+ sizeof(unsigned short) * (m_rotFrames.size() + m_posFrames.size())
+			+ sizeof(SQuantized3) * (m_rotKeys.size() + m_posKeys.size())
+			+ sizeof(float) * (m_posMin.size() + m_posScale.size());
+	}
+}
\ No newline at end of file
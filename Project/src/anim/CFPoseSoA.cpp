@@ -0,0 +1,80 @@
+﻿/**	@file	CFPoseSoA.cpp
+ *	@brief	単精度浮動小数点数型の SoA 形式姿勢
+ */
+#include "anim/CFPoseSoA.hpp"
+#include <algorithm>
+
+namespace dlav {
+	CFPoseSoA::CFPoseSoA() noexcept :
+		m_count(0U),
+		m_channels()
+	{}
+
+	CFPoseSoA& CFPoseSoA::init(unsigned int const& count) {
+		unsigned int capacity = (count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT;
+		m_count = count;
+		for (unsigned int idx = 0U; idx < POSE_CHANNEL_CNT; ++idx) {
+			m_channels[idx].assign(capacity, 0.0f);
+		}
+		std::fill(m_channels[static_cast<unsigned int>(EPoseChannel::ROT_W)].begin(), m_channels[static_cast<unsigned int>(EPoseChannel::ROT_W)].end(), 1.0f);
+		return *this;
+	}
+
+	unsigned int const CFPoseSoA::size() const noexcept {
+		return m_count;
+	}
+
+	unsigned int const CFPoseSoA::capacity() const noexcept {
+		return static_cast<unsigned int>(m_channels[0U].size());
+	}
+
+	float* const CFPoseSoA::channel(EPoseChannel const& ch) noexcept {
+		return m_channels[static_cast<unsigned int>(ch)].data();
+	}
+
+	float const* const CFPoseSoA::channel(EPoseChannel const& ch) const noexcept {
+		return m_channels[static_cast<unsigned int>(ch)].data();
+	}
+
+	CFPoseSoA& CFPoseSoA::rotation(unsigned int const& idx, CFQuaternion const& arg) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			m_channels[static_cast<unsigned int>(EPoseChannel::ROT_X) + i][idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	CFPoseSoA& CFPoseSoA::translation(unsigned int const& idx, CFVector3 const& arg) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			m_channels[static_cast<unsigned int>(EPoseChannel::POS_X) + i][idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	CFQuaternion const CFPoseSoA::rotation(unsigned int const& idx) const noexcept {
+		CFQuaternion result = UNIT_FQT;
+		if (idx >= m_count) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			result.p[i] = m_channels[static_cast<unsigned int>(EPoseChannel::ROT_X) + i][idx];
+		}
+		return result;
+	}
+
+	CFVector3 const CFPoseSoA::translation(unsigned int const& idx) const noexcept {
+		CFVector3 result = ZERO_FVT3;
+		if (idx >= m_count) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			result.p[i] = m_channels[static_cast<unsigned int>(EPoseChannel::POS_X) + i][idx];
+		}
+		return result;
+	}
+}
\ No newline at end of file
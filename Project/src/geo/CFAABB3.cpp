@@ -0,0 +1,115 @@
+﻿/**	@file	CFAABB3.cpp
+ *	@brief	三次元軸並行境界箱
+ */
+#include "geo/CFAABB3.hpp"
+#include "geo/CFSphere3.hpp"
+#include "math/FMathUtil.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	CFAABB3::CFAABB3() noexcept :
+		m_lower(FLT_MAX, FLT_MAX, FLT_MAX),
+		m_upper(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+	{}
+
+	CFAABB3::CFAABB3(CFVector3 const& lo, CFVector3 const& hi) noexcept :
+		m_lower(lo),
+		m_upper(hi)
+	{}
+
+	CFAABB3& CFAABB3::init(CFVector3 const& lo, CFVector3 const& hi) noexcept {
+		m_lower = lo;
+		m_upper = hi;
+		return *this;
+	}
+
+	CFVector3 const& CFAABB3::lower() const noexcept {
+		return m_lower;
+	}
+
+	CFVector3 const& CFAABB3::upper() const noexcept {
+		return m_upper;
+	}
+
+	CFVector3 const CFAABB3::center() const noexcept {
+		return (m_lower + m_upper) * 0.5f;
+	}
+
+	CFVector3 const CFAABB3::extent() const noexcept {
+		return (m_upper - m_lower) * 0.5f;
+	}
+
+	bool const CFAABB3::empty() const noexcept {
+		return m_lower.x > m_upper.x || m_lower.y > m_upper.y || m_lower.z > m_upper.z;
+	}
+
+	CFAABB3& CFAABB3::merge(CFVector3 const& pt) noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			m_lower.p[comp] = std::min(m_lower.p[comp], pt.p[comp]);
+			m_upper.p[comp] = std::max(m_upper.p[comp], pt.p[comp]);
+		}
+		return *this;
+	}
+
+	CFAABB3& CFAABB3::merge(CFAABB3 const& box) noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			m_lower.p[comp] = std::min(m_lower.p[comp], box.m_lower.p[comp]);
+			m_upper.p[comp] = std::max(m_upper.p[comp], box.m_upper.p[comp]);
+		}
+		return *this;
+	}
+
+	CFAABB3 const CFAABB3::transform(EHandSide const& hs, CFMatrix4x4 const& mtx) const noexcept {
+		// 空の箱は上下端の差が溢れて半径が -inf となり、行列の零成分と掛けると NaN になる為、そのまま返す
+		if (empty()) {
+			return *this;
+		}
+		CFMatrix3x3 linear = makeLinear(hs, mtx);
+		CFVector3 c = center();
+		CFVector3 e = extent();
+		CFVector3 nc = makeOffset(hs, mtx);
+		CFVector3 ne = ZERO_FVT3;
+		for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+			for (unsigned int col = 0U; col < FLT3_CNT; ++col) {
+				float elem = linear.p[row * FLT3_CNT + col];
+				nc.p[row] += elem * c.p[col];
+				ne.p[row] += fabsf(elem) * e.p[col];
+			}
+		}
+		return CFAABB3(nc - ne, nc + ne);
+	}
+
+	bool const CFAABB3::contains(CFVector3 const& pt) const noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			if (pt.p[comp] < m_lower.p[comp] || m_upper.p[comp] < pt.p[comp]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool const CFAABB3::overlaps(CFAABB3 const& box) const noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			if (box.m_upper.p[comp] < m_lower.p[comp] || m_upper.p[comp] < box.m_lower.p[comp]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool const CFAABB3::overlaps(CFSphere3 const& sphere) const noexcept {
+		if (sphere.empty()) {
+			return false;
+		}
+		// 球の中心から箱への最近点までの距離の二乗を半径の二乗と比べる
+		float sq = 0.0f;
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			float v = sphere.center().p[comp];
+			float d = std::max(m_lower.p[comp] - v, 0.0f) + std::max(v - m_upper.p[comp], 0.0f);
+			sq += d * d;
+		}
+		return sq <= sphere.radius() * sphere.radius();
+	}
+}
\ No newline at end of file
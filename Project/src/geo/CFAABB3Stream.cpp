@@ -0,0 +1,158 @@
+﻿/**	@file	CFAABB3Stream.cpp
+ *	@brief	三次元軸並行境界箱のストリーム
+ */
+#include "geo/CFAABB3Stream.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "math/FMathUtil.hpp"
+#include <immintrin.h>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	CFAABB3Stream::CFAABB3Stream() noexcept :
+		m_count(0U),
+		m_comps()
+	{}
+
+	CFAABB3Stream& CFAABB3Stream::init(size_t const& count) {
+		m_count = count;
+		for (auto& comp : m_comps) {
+			comp.assign((count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT, 0.0f);
+		}
+		return *this;
+	}
+
+	size_t const CFAABB3Stream::size() const noexcept {
+		return m_count;
+	}
+
+	float* const CFAABB3Stream::data(unsigned int const& comp) noexcept {
+		return m_comps[comp].data();
+	}
+
+	float const* const CFAABB3Stream::data(unsigned int const& comp) const noexcept {
+		return m_comps[comp].data();
+	}
+
+	void CFAABB3Stream::set(size_t const& idx, CFAABB3 const& arg) noexcept {
+		CFVector3 c = arg.center();
+		CFVector3 e = arg.extent();
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			m_comps[comp][idx] = c.p[comp];
+			m_comps[FLT3_CNT + comp][idx] = e.p[comp];
+		}
+	}
+
+	CFAABB3 const CFAABB3Stream::get(size_t const& idx) const noexcept {
+		CFVector3 c(m_comps[0][idx], m_comps[1][idx], m_comps[2][idx]);
+		CFVector3 e(m_comps[3][idx], m_comps[4][idx], m_comps[5][idx]);
+		return CFAABB3(c - e, c + e);
+	}
+
+	void CFAABB3Stream::transform(EHandSide const& hs, CFMatrix4x4 const& mtx, CFAABB3Stream& dst) const {
+		if (dst.m_count != m_count) {
+			dst.init(m_count);
+		}
+
+		CFMatrix3x3 linear = makeLinear(hs, mtx);
+		CFVector3 offset = makeOffset(hs, mtx);
+		__m256 l[FLT3x3_CNT];
+		__m256 a[FLT3x3_CNT];
+		for (unsigned int elem = 0U; elem < FLT3x3_CNT; ++elem) {
+			l[elem] = _mm256_set1_ps(linear.p[elem]);
+			a[elem] = laneAbs(l[elem]);
+		}
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 c[FLT3_CNT];
+			__m256 e[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				c[comp] = _mm256_loadu_ps(&m_comps[comp][idx]);
+				e[comp] = _mm256_loadu_ps(&m_comps[FLT3_CNT + comp][idx]);
+			}
+			for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+				__m256 const* lr = &l[row * FLT3_CNT];
+				__m256 const* ar = &a[row * FLT3_CNT];
+				__m256 nc = _mm256_fmadd_ps(lr[0], c[0], _mm256_fmadd_ps(lr[1], c[1], _mm256_fmadd_ps(lr[2], c[2], _mm256_set1_ps(offset.p[row]))));
+				__m256 ne = _mm256_fmadd_ps(ar[0], e[0], _mm256_fmadd_ps(ar[1], e[1], _mm256_mul_ps(ar[2], e[2])));
+				_mm256_storeu_ps(&dst.m_comps[row][idx], nc);
+				_mm256_storeu_ps(&dst.m_comps[FLT3_CNT + row][idx], ne);
+			}
+		}
+	}
+
+	CFAABB3 const CFAABB3Stream::merged() const noexcept {
+		__m256 lo[FLT3_CNT];
+		__m256 hi[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			lo[comp] = _mm256_set1_ps(FLT_MAX);
+			hi[comp] = _mm256_set1_ps(-FLT_MAX);
+		}
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			// 末尾の詰め物は最小値・最大値に寄与させない
+			__m256 valid = tailMask(m_count - idx);
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 c = _mm256_loadu_ps(&m_comps[comp][idx]);
+				__m256 e = _mm256_loadu_ps(&m_comps[FLT3_CNT + comp][idx]);
+				lo[comp] = _mm256_blendv_ps(lo[comp], _mm256_min_ps(lo[comp], _mm256_sub_ps(c, e)), valid);
+				hi[comp] = _mm256_blendv_ps(hi[comp], _mm256_max_ps(hi[comp], _mm256_add_ps(c, e)), valid);
+			}
+		}
+
+		return CFAABB3(
+			CFVector3(laneMin(lo[0]), laneMin(lo[1]), laneMin(lo[2])),
+			CFVector3(laneMax(hi[0]), laneMax(hi[1]), laneMax(hi[2]))
+		);
+	}
+
+	size_t const CFAABB3Stream::contains(CFVector3 const& pt, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		__m256 p[FLT3_CNT] = { _mm256_set1_ps(pt.x), _mm256_set1_ps(pt.y), _mm256_set1_ps(pt.z) };
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 d = laneAbs(_mm256_sub_ps(p[comp], _mm256_loadu_ps(&m_comps[comp][idx])));
+				mask = _mm256_and_ps(mask, _mm256_cmp_ps(d, _mm256_loadu_ps(&m_comps[FLT3_CNT + comp][idx]), _CMP_LE_OQ));
+			}
+			collectHits(hits, idx, m_count, mask);
+		}
+		return hits.size();
+	}
+
+	size_t const CFAABB3Stream::overlaps(CFAABB3 const& box, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		CFVector3 bc = box.center();
+		CFVector3 be = box.extent();
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 d = laneAbs(_mm256_sub_ps(_mm256_set1_ps(bc.p[comp]), _mm256_loadu_ps(&m_comps[comp][idx])));
+				__m256 r = _mm256_add_ps(_mm256_set1_ps(be.p[comp]), _mm256_loadu_ps(&m_comps[FLT3_CNT + comp][idx]));
+				mask = _mm256_and_ps(mask, _mm256_cmp_ps(d, r, _CMP_LE_OQ));
+			}
+			collectHits(hits, idx, m_count, mask);
+		}
+		return hits.size();
+	}
+
+	size_t const CFAABB3Stream::overlaps(CFSphere3 const& sphere, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		if (sphere.empty()) {
+			return 0U;
+		}
+		CFVector3 const& sc = sphere.center();
+		__m256 sq_rad = _mm256_set1_ps(sphere.radius() * sphere.radius());
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			// 球の中心から箱までの各軸の距離は max(|s - c| - e, 0)
+			__m256 sq = _mm256_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 d = laneAbs(_mm256_sub_ps(_mm256_set1_ps(sc.p[comp]), _mm256_loadu_ps(&m_comps[comp][idx])));
+				d = _mm256_max_ps(_mm256_sub_ps(d, _mm256_loadu_ps(&m_comps[FLT3_CNT + comp][idx])), _mm256_setzero_ps());
+				sq = _mm256_fmadd_ps(d, d, sq);
+			}
+			collectHits(hits, idx, m_count, _mm256_cmp_ps(sq, sq_rad, _CMP_LE_OQ));
+		}
+		return hits.size();
+	}
+}
\ No newline at end of file
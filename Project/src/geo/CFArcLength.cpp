@@ -0,0 +1,94 @@
+﻿/**	@file	CFArcLength.cpp
+ *	@brief	曲線の弧長表
+ */
+#include "geo/CFArcLength.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	逆関数の誤差に対する許容誤差の割合 (分点の間では分点より誤差が大きくなり得るため)
+		double constexpr PROBE_RATIO = 0.5;
+
+		/**	@brief	三次エルミート補間による逆関数の近似関数
+		 *	@param[in] pos 区間内の位置 [0, 1]
+		 *	@param[in] span 区間の弧長
+		 *	@note	速さが 0 の端では割線の傾きを用いる。
+		 */
+		double const hermite(double const& pos, double const& span, double const& lo, double const& hi, double const& slope0, double const& slope1) noexcept {
+			double secant = span > 0.0 ? (hi - lo) / span : 0.0;
+			double m0 = (slope0 >= 0.0 ? slope0 : secant) * span;
+			double m1 = (slope1 >= 0.0 ? slope1 : secant) * span;
+			double pos2 = pos * pos;
+			double pos3 = pos2 * pos;
+			double result = (2.0 * pos3 - 3.0 * pos2 + 1.0) * lo
+				+ (pos3 - 2.0 * pos2 + pos) * m0
+				+ (-2.0 * pos3 + 3.0 * pos2) * hi
+				+ (pos3 - pos2) * m1;
+			return std::min(std::max(result, lo), hi);
+		}
+	}
+
+	CFArcLength::CFArcLength() noexcept :
+		m_rates(),
+		m_lengths(),
+		m_slopes()
+	{}
+
+	void CFArcLength::clear() noexcept {
+		m_rates.clear();
+		m_lengths.clear();
+		m_slopes.clear();
+	}
+
+	bool const CFArcLength::empty() const noexcept {
+		return m_rates.empty();
+	}
+
+	size_t const CFArcLength::size() const noexcept {
+		return m_rates.empty() ? 0U : m_rates.size() - 1U;
+	}
+
+	float const CFArcLength::length() const noexcept {
+		return m_lengths.empty() ? 0.0f : m_lengths.back();
+	}
+
+	float const CFArcLength::rate(float const& distance) const noexcept {
+		if (m_rates.size() < 2U || distance <= 0.0f) {
+			return 0.0f;
+		}
+		if (distance >= m_lengths.back()) {
+			return 1.0f;
+		}
+		size_t idx = static_cast<size_t>(std::upper_bound(m_lengths.begin(), m_lengths.end(), distance) - m_lengths.begin()) - 1U;
+		double span = static_cast<double>(m_lengths[idx + 1U]) - static_cast<double>(m_lengths[idx]);
+		double pos = span > 0.0 ? (static_cast<double>(distance) - static_cast<double>(m_lengths[idx])) / span : 0.0;
+		return static_cast<float>(hermite(pos, span, m_rates[idx], m_rates[idx + 1U], m_slopes[idx], m_slopes[idx + 1U]));
+	}
+
+	void CFArcLength::append(double const& rate, double const& distance, double const& speed) {
+		m_rates.push_back(static_cast<float>(rate));
+		m_lengths.push_back(static_cast<float>(distance));
+		m_slopes.push_back(speed > 0.0 ? static_cast<float>(1.0 / speed) : -1.0f);
+	}
+
+	bool const CFArcLength::accept(double const (&rates)[5], double const (&speeds)[5], double const (&quarters)[4], double const& whole, double const& limit) noexcept {
+		double sum = (quarters[0] + quarters[1]) + (quarters[2] + quarters[3]);
+		if (std::fabs(sum - whole) > limit) {
+			return false;
+		}
+		//	分点の弧長から逆関数で戻した媒介変数が分点に一致するか
+		double slope0 = speeds[0] > 0.0 ? 1.0 / speeds[0] : -1.0;
+		double slope4 = speeds[4] > 0.0 ? 1.0 / speeds[4] : -1.0;
+		double distance = 0.0;
+		for (unsigned int idx = 1U; idx < 4U; ++idx) {
+			distance += quarters[idx - 1U];
+			double pos = sum > 0.0 ? distance / sum : 0.25 * static_cast<double>(idx);
+			double approx = hermite(pos, sum, rates[0], rates[4], slope0, slope4);
+			if (std::fabs(approx - rates[idx]) * speeds[idx] > limit * PROBE_RATIO) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,1525 @@
+﻿/**	@file	CFBVH4.cpp
+ *	@brief	四分木の境界ボリューム階層
+ */
+#include "geo/CFBVH4.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "util/CJobSystem.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	SAH のビン数
+		unsigned int constexpr BIN_CNT = 16U;
+		//!	@brief	これ以下の要素数は常に葉とする
+		size_t constexpr LEAF_MIN = 2U;
+		//!	@brief	葉の要素数の上限
+		size_t constexpr LEAF_MAX = 8U;
+		//!	@brief	要素の判定に対する節点の走査の相対費用
+		float constexpr TRAVERSAL_COST = 1.0f;
+		//!	@brief	SAH での分割を諦めて中央で分ける深さ
+		unsigned int constexpr MEDIAN_DEPTH = 64U;
+		//!	@brief	ビン分けを並列化する要素数の下限
+		size_t constexpr PARALLEL_MIN = 65536U;
+		//!	@brief	一つのジョブで処理する要素数
+		size_t constexpr GRAIN = 16384U;
+		//!	@brief	部分木の構築を別のジョブへ回す要素数の上限
+		size_t constexpr TASK_MAX = 16384U;
+		//!	@brief	葉を表す参照のビット
+		unsigned int constexpr LEAF_FLAG = 0x80000000U;
+		//!	@brief	葉の参照で要素数に用いるビット数
+		unsigned int constexpr LEAF_SHIFT = 4U;
+		//!	@brief	走査用スタックの深さ
+		unsigned int constexpr STACK_CNT = 512U;
+		//!	@brief	節点の段数の上限 (各段で兄弟を WIDTH - 1 個ずつ積んでも走査用スタックが溢れない段数)
+		unsigned int constexpr DEPTH_MAX = (STACK_CNT - CFBVH4::WIDTH) / (CFBVH4::WIDTH - 1U) + 1U;
+		//!	@brief	方向成分が零の場合に代わりに用いる値
+		float constexpr DIR_EPSILON = 1.0e-20f;
+		//!	@brief	光線と三角形が平行と見做す行列式の閾値
+		float constexpr DET_EPSILON = 1.0e-12f;
+
+		/**	@struct	SBox
+		 *	@brief	構築用の境界箱
+		 */
+		struct SBox {
+			float lo[FLT3_CNT];
+			float hi[FLT3_CNT];
+		};
+
+		/**	@struct	SBin
+		 *	@brief	SAH のビン
+		 */
+		struct SBin {
+			SBox box;
+			size_t count;
+		};
+
+		/**	@struct	SBuildNode
+		 *	@brief	構築用の二分木の節点 (left が INVALID なら葉)
+		 */
+		struct SBuildNode {
+			SBox box;
+			unsigned int left;
+			unsigned int right;
+			size_t first;
+			size_t count;
+		};
+
+		/**	@struct	STask
+		 *	@brief	別のジョブで構築する部分木
+		 */
+		struct STask {
+			unsigned int node;
+			size_t begin;
+			size_t end;
+		};
+
+		/**	@struct	SBuilder
+		 *	@brief	構築中の共有データ
+		 */
+		struct SBuilder {
+			//!	@brief	要素毎の最小点と最大点
+			float const* boxes;
+			//!	@brief	要素毎の重心
+			std::vector<float> centroids;
+			//!	@brief	要素の並び順
+			std::vector<unsigned int> order;
+		};
+
+		/**	@struct	SProbe
+		 *	@brief	挿入先の探索候補
+		 */
+		struct SProbe {
+			//!	@brief	部分木のいずれかへ置いた場合の費用の下限
+			float bound;
+			//!	@brief	祖先の境界箱の拡大による費用
+			float induced;
+			//!	@brief	節点番号
+			unsigned int node;
+		};
+
+		/**	@struct	SEntry
+		 *	@brief	走査用スタックの要素
+		 */
+		struct SEntry {
+			unsigned int ref;
+			float tnear;
+		};
+
+		//!	@brief	空の境界箱生成関数
+		SBox const empty_box() noexcept {
+			return SBox{ { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+		}
+
+		//!	@brief	境界箱の拡張関数
+		void grow(SBox& dst, SBox const& src) noexcept {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst.lo[comp] = std::min(dst.lo[comp], src.lo[comp]);
+				dst.hi[comp] = std::max(dst.hi[comp], src.hi[comp]);
+			}
+		}
+
+		//!	@brief	表面積の半分を求める関数
+		float const half_area(SBox const& box) noexcept {
+			float dx = std::max(box.hi[0] - box.lo[0], 0.0f);
+			float dy = std::max(box.hi[1] - box.lo[1], 0.0f);
+			float dz = std::max(box.hi[2] - box.lo[2], 0.0f);
+			return dx * dy + dy * dz + dz * dx;
+		}
+
+		//!	@brief	表面積の半分を求める関数
+		float const half_area(CFAABB3 const& box) noexcept {
+			if (box.empty()) {
+				return 0.0f;
+			}
+			CFVector3 size = box.upper() - box.lower();
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+
+		//!	@brief	要素の境界箱取得関数
+		SBox const prim_box(SBuilder const& ctx, unsigned int const& prim) noexcept {
+			float const* src = &ctx.boxes[prim * 6U];
+			return SBox{ { src[0], src[1], src[2] }, { src[3], src[4], src[5] } };
+		}
+
+		//!	@brief	区間の境界箱と重心の境界箱を求める関数
+		SBox const range_bounds(SBuilder const& ctx, size_t const& begin, size_t const& end, SBox& cbox, bool const& parallel) {
+			size_t chunks = parallel ? (end - begin + GRAIN - 1U) / GRAIN : 1U;
+			std::vector<SBox> boxes(chunks, empty_box());
+			std::vector<SBox> cboxes(chunks, empty_box());
+			auto func = [&](size_t const& from, size_t const& to) {
+				size_t chunk = parallel ? from / GRAIN : 0U;
+				SBox box = empty_box();
+				SBox cen = empty_box();
+				for (size_t idx = begin + from; idx < begin + to; ++idx) {
+					unsigned int prim = ctx.order[idx];
+					grow(box, prim_box(ctx, prim));
+					float const* c = &ctx.centroids[prim * FLT3_CNT];
+					grow(cen, SBox{ { c[0], c[1], c[2] }, { c[0], c[1], c[2] } });
+				}
+				boxes[chunk] = box;
+				cboxes[chunk] = cen;
+			};
+			if (parallel) {
+				CJobSystem::getInstance().parallel_for(end - begin, GRAIN, func);
+			}
+			else {
+				func(0U, end - begin);
+			}
+
+			SBox result = empty_box();
+			cbox = empty_box();
+			for (size_t chunk = 0U; chunk < chunks; ++chunk) {
+				grow(result, boxes[chunk]);
+				grow(cbox, cboxes[chunk]);
+			}
+			return result;
+		}
+
+		//!	@brief	重心のビン番号を求める関数
+		unsigned int const bin_index(float const& centroid, float const& lo, float const& scale) noexcept {
+			int bin = static_cast<int>((centroid - lo) * scale);
+			return static_cast<unsigned int>(std::min(std::max(bin, 0), static_cast<int>(BIN_CNT) - 1));
+		}
+
+		//!	@brief	区間の要素を三軸それぞれのビンに分ける関数
+		void range_bins(SBuilder const& ctx, size_t const& begin, size_t const& end, SBox const& cbox, float const (&scale)[FLT3_CNT], SBin (&bins)[FLT3_CNT][BIN_CNT], bool const& parallel) {
+			size_t chunks = parallel ? (end - begin + GRAIN - 1U) / GRAIN : 1U;
+			std::vector<SBin> local(chunks * FLT3_CNT * BIN_CNT, SBin{ empty_box(), 0U });
+			auto func = [&](size_t const& from, size_t const& to) {
+				SBin* dst = &local[(parallel ? from / GRAIN : 0U) * FLT3_CNT * BIN_CNT];
+				for (size_t idx = begin + from; idx < begin + to; ++idx) {
+					unsigned int prim = ctx.order[idx];
+					SBox box = prim_box(ctx, prim);
+					float const* c = &ctx.centroids[prim * FLT3_CNT];
+					for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+						SBin& bin = dst[axis * BIN_CNT + bin_index(c[axis], cbox.lo[axis], scale[axis])];
+						grow(bin.box, box);
+						++bin.count;
+					}
+				}
+			};
+			if (parallel) {
+				CJobSystem::getInstance().parallel_for(end - begin, GRAIN, func);
+			}
+			else {
+				func(0U, end - begin);
+			}
+
+			for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+				for (unsigned int bin = 0U; bin < BIN_CNT; ++bin) {
+					bins[axis][bin] = SBin{ empty_box(), 0U };
+					for (size_t chunk = 0U; chunk < chunks; ++chunk) {
+						SBin const& src = local[(chunk * FLT3_CNT + axis) * BIN_CNT + bin];
+						grow(bins[axis][bin].box, src.box);
+						bins[axis][bin].count += src.count;
+					}
+				}
+			}
+		}
+
+		/**	@brief	二分木の節点を分割する関数
+		 *	@param[in,out] deferred 別のジョブへ回す部分木の追加先 (nullptr なら全て再帰で構築する)
+		 *	@return 作成した節点の番号
+		 */
+		unsigned int const split_node(SBuilder& ctx, std::vector<SBuildNode>& tree, size_t const& begin, size_t const& end, unsigned int const& depth, std::vector<STask>* const deferred) {
+			size_t count = end - begin;
+			bool parallel = deferred != nullptr && count >= PARALLEL_MIN;
+			SBox cbox = empty_box();
+			SBox box = range_bounds(ctx, begin, end, cbox, parallel);
+			unsigned int idx = static_cast<unsigned int>(tree.size());
+			tree.push_back(SBuildNode{ box, CFBVH4::INVALID, CFBVH4::INVALID, begin, count });
+			if (count <= LEAF_MIN) {
+				return idx;
+			}
+
+			// ビン境界での分割の費用を三軸それぞれで評価する
+			unsigned int best_axis = CFBVH4::INVALID;
+			unsigned int best_split = 0U;
+			float best_cost = FLT_MAX;
+			float scale[FLT3_CNT] = {};
+			for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+				float extent = cbox.hi[axis] - cbox.lo[axis];
+				scale[axis] = extent > 0.0f ? static_cast<float>(BIN_CNT) / extent : 0.0f;
+			}
+			if (depth < MEDIAN_DEPTH) {
+				SBin bins[FLT3_CNT][BIN_CNT];
+				range_bins(ctx, begin, end, cbox, scale, bins, parallel);
+				float parent = std::max(half_area(box), FLT_MIN);
+				for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+					if (scale[axis] <= 0.0f) {
+						continue;
+					}
+					float right_area[BIN_CNT] = {};
+					size_t right_count[BIN_CNT] = {};
+					SBox acc = empty_box();
+					size_t num = 0U;
+					for (unsigned int bin = BIN_CNT - 1U; bin > 0U; --bin) {
+						grow(acc, bins[axis][bin].box);
+						num += bins[axis][bin].count;
+						right_area[bin] = half_area(acc);
+						right_count[bin] = num;
+					}
+					acc = empty_box();
+					num = 0U;
+					for (unsigned int split = 1U; split < BIN_CNT; ++split) {
+						grow(acc, bins[axis][split - 1U].box);
+						num += bins[axis][split - 1U].count;
+						if (num == 0U || right_count[split] == 0U) {
+							continue;
+						}
+						float cost = TRAVERSAL_COST + (half_area(acc) * static_cast<float>(num) + right_area[split] * static_cast<float>(right_count[split])) / parent;
+						if (cost < best_cost) {
+							best_cost = cost;
+							best_axis = axis;
+							best_split = split;
+						}
+					}
+				}
+			}
+
+			size_t mid = begin + count / 2U;
+			if (best_axis != CFBVH4::INVALID) {
+				if (best_cost >= static_cast<float>(count) && count <= LEAF_MAX) {
+					return idx;
+				}
+				auto first = ctx.order.begin() + static_cast<std::ptrdiff_t>(begin);
+				auto last = ctx.order.begin() + static_cast<std::ptrdiff_t>(end);
+				float lo = cbox.lo[best_axis];
+				float sc = scale[best_axis];
+				auto pivot = std::partition(first, last, [&](unsigned int const& prim) {
+					return bin_index(ctx.centroids[prim * FLT3_CNT + best_axis], lo, sc) < best_split;
+				});
+				mid = begin + static_cast<size_t>(pivot - first);
+			}
+			else if (count <= LEAF_MAX) {
+				return idx;
+			}
+			if (mid == begin || mid == end) {
+				mid = begin + count / 2U;
+			}
+
+			// 小さな部分木は後で並列に構築する
+			unsigned int children[2] = { CFBVH4::INVALID, CFBVH4::INVALID };
+			size_t ranges[2][2] = { { begin, mid }, { mid, end } };
+			for (unsigned int side = 0U; side < 2U; ++side) {
+				if (deferred != nullptr && ranges[side][1] - ranges[side][0] <= TASK_MAX) {
+					children[side] = static_cast<unsigned int>(tree.size());
+					tree.push_back(SBuildNode{ empty_box(), CFBVH4::INVALID, CFBVH4::INVALID, 0U, 0U });
+					deferred->push_back(STask{ children[side], ranges[side][0], ranges[side][1] });
+				}
+				else {
+					children[side] = split_node(ctx, tree, ranges[side][0], ranges[side][1], depth + 1U, deferred);
+				}
+			}
+			tree[idx].left = children[0];
+			tree[idx].right = children[1];
+			return idx;
+		}
+
+		/**	@brief	二分木の構築関数
+		 *	@param[in] boxes 要素毎の最小点と最大点 (六成分ずつ)
+		 *	@param[out] order 葉の並び順での要素の番号
+		 */
+		void build_binary(std::vector<float> const& boxes, std::vector<SBuildNode>& tree, std::vector<unsigned int>& order) {
+			size_t count = boxes.size() / 6U;
+			SBuilder ctx{ boxes.data(), std::vector<float>(count * FLT3_CNT), std::vector<unsigned int>(count) };
+			for (size_t prim = 0U; prim < count; ++prim) {
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					ctx.centroids[prim * FLT3_CNT + comp] = (boxes[prim * 6U + comp] + boxes[prim * 6U + 3U + comp]) * 0.5f;
+				}
+				ctx.order[prim] = static_cast<unsigned int>(prim);
+			}
+
+			// 上位の分割はビン分けを並列に行い、小さくなった部分木は一つずつのジョブで構築する
+			tree.reserve(count * 2U / LEAF_MIN);
+			std::vector<STask> tasks;
+			bool parallel = CJobSystem::getInstance().concurrency() > 1U && count > TASK_MAX;
+			split_node(ctx, tree, 0U, count, 0U, parallel ? &tasks : nullptr);
+
+			std::vector<std::vector<SBuildNode>> subtrees(tasks.size());
+			CJobSystem::getInstance().parallel_for(tasks.size(), 1U, [&](size_t const& from, size_t const& to) {
+				for (size_t task = from; task < to; ++task) {
+					split_node(ctx, subtrees[task], tasks[task].begin, tasks[task].end, 0U, nullptr);
+				}
+			});
+			for (size_t task = 0U; task < tasks.size(); ++task) {
+				// 部分木の根は予約済みの節点へ置き、残りは末尾へ繋げる
+				unsigned int base = static_cast<unsigned int>(tree.size()) - 1U;
+				for (auto& node : subtrees[task]) {
+					if (node.left != CFBVH4::INVALID) {
+						node.left += base;
+						node.right += base;
+					}
+				}
+				tree[tasks[task].node] = subtrees[task][0];
+				tree.insert(tree.end(), subtrees[task].begin() + 1, subtrees[task].end());
+			}
+			order.swap(ctx.order);
+		}
+
+		/**	@struct	SPacket
+		 *	@brief	成分毎に並べた八本の光線
+		 */
+		struct SPacket {
+			__m256 o[FLT3_CNT];
+			__m256 d[FLT3_CNT];
+			__m256 inv[FLT3_CNT];
+		};
+
+		//!	@brief	光線の前処理 (方向の零成分を置き換えて逆数を求める)
+		void prepare(CRay<CFVector3> const& ray, float (&o)[FLT3_CNT], float (&d)[FLT3_CNT], float (&inv)[FLT3_CNT]) noexcept {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				o[comp] = ray.position.p[comp];
+				d[comp] = ray.direction.p[comp];
+				inv[comp] = 1.0f / (d[comp] != 0.0f ? d[comp] : DIR_EPSILON);
+			}
+		}
+
+		/**	@brief	光線束の読み込み関数
+		 *	@return 有効な光線の数 (不足分は原点から +x へ向かう光線で埋める)
+		 */
+		size_t const load_packet(CRay<CFVector3> const* const rays, size_t const& base, size_t const& count, SPacket& dst) noexcept {
+			size_t lanes = std::min<size_t>(CFBVH4::PACKET_CNT, count - base);
+			alignas(32) float soa[3U][FLT3_CNT][CFBVH4::PACKET_CNT] = {};
+			for (size_t lane = 0U; lane < CFBVH4::PACKET_CNT; ++lane) {
+				soa[1U][0U][lane] = 1.0f;
+				soa[2U][0U][lane] = 1.0f;
+				soa[2U][1U][lane] = 1.0f / DIR_EPSILON;
+				soa[2U][2U][lane] = 1.0f / DIR_EPSILON;
+			}
+			for (size_t lane = 0U; lane < lanes; ++lane) {
+				float o[FLT3_CNT], d[FLT3_CNT], inv[FLT3_CNT];
+				prepare(rays[base + lane], o, d, inv);
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					soa[0U][comp][lane] = o[comp];
+					soa[1U][comp][lane] = d[comp];
+					soa[2U][comp][lane] = inv[comp];
+				}
+			}
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst.o[comp] = _mm256_load_ps(soa[0U][comp]);
+				dst.d[comp] = _mm256_load_ps(soa[1U][comp]);
+				dst.inv[comp] = _mm256_load_ps(soa[2U][comp]);
+			}
+			return lanes;
+		}
+
+		//!	@brief	葉の参照生成関数
+		unsigned int const leaf_ref(size_t const& first, size_t const& count) noexcept {
+			return LEAF_FLAG | static_cast<unsigned int>(first << LEAF_SHIFT) | static_cast<unsigned int>(count);
+		}
+
+		//!	@brief	葉の要素の区間取得関数
+		void leaf_range(unsigned int const& ref, size_t& first, size_t& last) noexcept {
+			first = (ref & ~LEAF_FLAG) >> LEAF_SHIFT;
+			last = first + (ref & ((1U << LEAF_SHIFT) - 1U));
+		}
+
+		/**	@brief	光線と三角形の交差判定関数 (Möller–Trumbore 法)
+		 *	@param[in,out] t 判定する媒介変数の上限 (交差した場合は交差位置)
+		 */
+		bool const ray_triangle(float const (&o)[FLT3_CNT], float const (&d)[FLT3_CNT], float const* const v0, float const* const e1, float const* const e2, float& t, float& u, float& v) noexcept {
+			float pv[FLT3_CNT] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+			float det = e1[0] * pv[0] + e1[1] * pv[1] + e1[2] * pv[2];
+			if (fabsf(det) < DET_EPSILON) {
+				return false;
+			}
+			float idet = 1.0f / det;
+			float s[FLT3_CNT] = { o[0] - v0[0], o[1] - v0[1], o[2] - v0[2] };
+			float bu = (s[0] * pv[0] + s[1] * pv[1] + s[2] * pv[2]) * idet;
+			if (bu < 0.0f || bu > 1.0f) {
+				return false;
+			}
+			float q[FLT3_CNT] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+			float bv = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * idet;
+			if (bv < 0.0f || bu + bv > 1.0f) {
+				return false;
+			}
+			float dist = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * idet;
+			if (dist <= 0.0f || dist >= t) {
+				return false;
+			}
+			t = dist;
+			u = bu;
+			v = bv;
+			return true;
+		}
+
+		/**	@brief	光線と軸並行境界箱の交差判定関数 (スラブ法)
+		 *	@param[in,out] t 判定する媒介変数の上限 (交差した場合は入射位置、始点が内部なら 0)
+		 */
+		bool const ray_box(float const (&o)[FLT3_CNT], float const (&inv)[FLT3_CNT], CFAABB3 const& box, float& t) noexcept {
+			float tn = 0.0f;
+			float tf = t;
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				float t0 = (box.lower().p[comp] - o[comp]) * inv[comp];
+				float t1 = (box.upper().p[comp] - o[comp]) * inv[comp];
+				tn = std::max(tn, std::min(t0, t1));
+				tf = std::min(tf, std::max(t0, t1));
+			}
+			if (tn > tf || tn >= t) {
+				return false;
+			}
+			t = tn;
+			return true;
+		}
+
+		/**	@brief	光線束と三角形の交差判定関数
+		 *	@return 交差した光線のマスク (上限の判定は呼び出し側で行う)
+		 */
+		__m256 const packet_triangle(SPacket const& ray, float const* const v0, float const* const e1, float const* const e2, __m256& t, __m256& u, __m256& v) noexcept {
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 const one = _mm256_set1_ps(1.0f);
+			__m256 a[FLT3_CNT] = { _mm256_set1_ps(e1[0]), _mm256_set1_ps(e1[1]), _mm256_set1_ps(e1[2]) };
+			__m256 b[FLT3_CNT] = { _mm256_set1_ps(e2[0]), _mm256_set1_ps(e2[1]), _mm256_set1_ps(e2[2]) };
+			__m256 pv[FLT3_CNT] = {
+				_mm256_fmsub_ps(ray.d[1], b[2], _mm256_mul_ps(ray.d[2], b[1])),
+				_mm256_fmsub_ps(ray.d[2], b[0], _mm256_mul_ps(ray.d[0], b[2])),
+				_mm256_fmsub_ps(ray.d[0], b[1], _mm256_mul_ps(ray.d[1], b[0]))
+			};
+			__m256 det = _mm256_fmadd_ps(a[0], pv[0], _mm256_fmadd_ps(a[1], pv[1], _mm256_mul_ps(a[2], pv[2])));
+			__m256 idet = _mm256_div_ps(one, det);
+			__m256 s[FLT3_CNT] = {
+				_mm256_sub_ps(ray.o[0], _mm256_set1_ps(v0[0])),
+				_mm256_sub_ps(ray.o[1], _mm256_set1_ps(v0[1])),
+				_mm256_sub_ps(ray.o[2], _mm256_set1_ps(v0[2]))
+			};
+			u = _mm256_mul_ps(_mm256_fmadd_ps(s[0], pv[0], _mm256_fmadd_ps(s[1], pv[1], _mm256_mul_ps(s[2], pv[2]))), idet);
+			__m256 q[FLT3_CNT] = {
+				_mm256_fmsub_ps(s[1], a[2], _mm256_mul_ps(s[2], a[1])),
+				_mm256_fmsub_ps(s[2], a[0], _mm256_mul_ps(s[0], a[2])),
+				_mm256_fmsub_ps(s[0], a[1], _mm256_mul_ps(s[1], a[0]))
+			};
+			v = _mm256_mul_ps(_mm256_fmadd_ps(ray.d[0], q[0], _mm256_fmadd_ps(ray.d[1], q[1], _mm256_mul_ps(ray.d[2], q[2]))), idet);
+			t = _mm256_mul_ps(_mm256_fmadd_ps(b[0], q[0], _mm256_fmadd_ps(b[1], q[1], _mm256_mul_ps(b[2], q[2]))), idet);
+			__m256 mask = _mm256_cmp_ps(laneAbs(det), _mm256_set1_ps(DET_EPSILON), _CMP_GE_OQ);
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+			return _mm256_and_ps(mask, _mm256_cmp_ps(t, zero, _CMP_GT_OQ));
+		}
+
+		/**	@brief	光線束と軸並行境界箱の交差判定関数
+		 *	@param[out] tn 入射位置 (始点が内部なら 0)
+		 *	@return 上限 tmax までに交差した光線のマスク
+		 */
+		__m256 const packet_box(SPacket const& ray, float const (&lo)[FLT3_CNT], float const (&hi)[FLT3_CNT], __m256 const& tmax, __m256& tn) noexcept {
+			__m256 tf = tmax;
+			tn = _mm256_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(lo[comp]), ray.o[comp]), ray.inv[comp]);
+				__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(hi[comp]), ray.o[comp]), ray.inv[comp]);
+				tn = _mm256_max_ps(tn, _mm256_min_ps(t0, t1));
+				tf = _mm256_min_ps(tf, _mm256_max_ps(t0, t1));
+			}
+			return _mm256_cmp_ps(tn, tf, _CMP_LE_OQ);
+		}
+
+		/**	@brief	一本の光線と四つの子の交差判定関数
+		 *	@return 交差した子のビット
+		 */
+		unsigned int const slab4(float const (&lo)[FLT3_CNT][CFBVH4::WIDTH], float const (&hi)[FLT3_CNT][CFBVH4::WIDTH], unsigned int const* const child, __m128 const (&o)[FLT3_CNT], __m128 const (&inv)[FLT3_CNT], float const& tmax, __m128& tn) noexcept {
+			__m128 tf = _mm_set1_ps(tmax);
+			tn = _mm_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(lo[comp]), o[comp]), inv[comp]);
+				__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(hi[comp]), o[comp]), inv[comp]);
+				tn = _mm_max_ps(tn, _mm_min_ps(t0, t1));
+				tf = _mm_min_ps(tf, _mm_max_ps(t0, t1));
+			}
+			// 空きの子は境界箱が空でも無限大同士の比較で通り得る為、参照で除外する
+			__m128i empty = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<__m128i const*>(child)), _mm_set1_epi32(-1));
+			return static_cast<unsigned int>(_mm_movemask_ps(_mm_andnot_ps(_mm_castsi128_ps(empty), _mm_cmple_ps(tn, tf))));
+		}
+
+		//!	@brief	走査順に子をスタックへ積む関数 (近い子が先に取り出されるよう遠い順に積む)
+		void push_sorted(SEntry* const stack, unsigned int& sp, SEntry (&found)[CFBVH4::WIDTH], unsigned int const& num) noexcept {
+			assert(sp + num <= STACK_CNT);
+			for (unsigned int idx = 1U; idx < num; ++idx) {
+				SEntry tmp = found[idx];
+				unsigned int pos = idx;
+				for (; pos > 0U && found[pos - 1U].tnear < tmp.tnear; --pos) {
+					found[pos] = found[pos - 1U];
+				}
+				found[pos] = tmp;
+			}
+			for (unsigned int idx = 0U; idx < num; ++idx) {
+				stack[sp++] = found[idx];
+			}
+		}
+	}
+
+	CFBVH4::CFBVH4() noexcept :
+		m_nodes(),
+		m_parents(),
+		m_costs(),
+		m_prims(),
+		m_owners(),
+		m_slots(),
+		m_tris(),
+		m_boxes(),
+		m_bounds(),
+		m_holes(0U),
+		m_ordered(true)
+	{}
+
+	void CFBVH4::build(CFVector3 const* const vertices, unsigned int const* const indices, size_t const& count) {
+		std::vector<float> boxes(count * 6U);
+		for (size_t tri = 0U; tri < count; ++tri) {
+			CFVector3 const& v0 = vertices[indices[tri * 3U + 0U]];
+			CFVector3 const& v1 = vertices[indices[tri * 3U + 1U]];
+			CFVector3 const& v2 = vertices[indices[tri * 3U + 2U]];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				boxes[tri * 6U + comp] = std::min(std::min(v0.p[comp], v1.p[comp]), v2.p[comp]);
+				boxes[tri * 6U + 3U + comp] = std::max(std::max(v0.p[comp], v1.p[comp]), v2.p[comp]);
+			}
+		}
+		build_tree(boxes);
+
+		m_boxes.clear();
+		m_tris.resize(count);
+		refit(vertices, indices);
+	}
+
+	void CFBVH4::build(CFAABB3 const* const boxes, size_t const& count) {
+		std::vector<float> flat(count * 6U);
+		for (size_t idx = 0U; idx < count; ++idx) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				flat[idx * 6U + comp] = boxes[idx].lower().p[comp];
+				flat[idx * 6U + 3U + comp] = boxes[idx].upper().p[comp];
+			}
+		}
+		build_tree(flat);
+
+		m_tris.clear();
+		m_boxes.resize(count);
+		refit(boxes);
+	}
+
+	void CFBVH4::refit(CFVector3 const* const vertices, unsigned int const* const indices) {
+		if (m_tris.empty()) {
+			return;
+		}
+		for (size_t slot = 0U; slot < m_prims.size(); ++slot) {
+			size_t tri = m_prims[slot];
+			if (tri == INVALID) {
+				continue;
+			}
+			CFVector3 const& v0 = vertices[indices[tri * 3U + 0U]];
+			CFVector3 const& v1 = vertices[indices[tri * 3U + 1U]];
+			CFVector3 const& v2 = vertices[indices[tri * 3U + 2U]];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				m_tris[slot].v0[comp] = v0.p[comp];
+				m_tris[slot].e1[comp] = v1.p[comp] - v0.p[comp];
+				m_tris[slot].e2[comp] = v2.p[comp] - v0.p[comp];
+			}
+		}
+		refit_all();
+	}
+
+	void CFBVH4::refit(CFAABB3 const* const boxes) {
+		if (!m_tris.empty()) {
+			return;
+		}
+		for (size_t slot = 0U; slot < m_prims.size(); ++slot) {
+			if (m_prims[slot] != INVALID) {
+				m_boxes[slot] = boxes[m_prims[slot]];
+			}
+		}
+		refit_all();
+	}
+
+	size_t const CFBVH4::rebuild(float const& ratio) {
+		if (m_nodes.empty()) {
+			return 0U;
+		}
+
+		// 挿入の分割で並びが崩れている場合は費用の評価の前に詰め直す
+		if (!m_ordered) {
+			compact(0U);
+		}
+		std::vector<float> current;
+		evaluate(current);
+
+		std::vector<unsigned int> targets;
+		std::vector<unsigned int> stack(1U, 0U);
+		while (!stack.empty()) {
+			unsigned int node = stack.back();
+			stack.pop_back();
+			if (current[node] > m_costs[node] * ratio) {
+				targets.push_back(node);
+				continue;
+			}
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[node].child[lane] != INVALID; ++lane) {
+				if ((m_nodes[node].child[lane] & LEAF_FLAG) == 0U) {
+					stack.push_back(m_nodes[node].child[lane]);
+				}
+			}
+		}
+		if (targets.empty()) {
+			return 0U;
+		}
+
+		reconstruct(targets);
+		return targets.size();
+	}
+
+	unsigned int const CFBVH4::insert(CFAABB3 const& box) {
+		if (!m_tris.empty()) {
+			return INVALID;
+		}
+
+		unsigned int id = static_cast<unsigned int>(m_slots.size());
+		m_slots.push_back(INVALID);
+		auto append = [&](unsigned int const& owner) {
+			m_slots[id] = static_cast<unsigned int>(m_prims.size());
+			m_prims.push_back(id);
+			m_boxes.push_back(box);
+			m_owners.push_back(owner);
+		};
+		if (m_nodes.empty()) {
+			spawn(INVALID);
+			set_lane(0U, 0U, leaf_ref(m_prims.size(), 1U), box);
+			append(0U);
+			evaluate(m_costs);
+			m_bounds = box;
+			return id;
+		}
+
+		// 既存の葉へ加えるか、子が全て葉の節点へ新たな葉を置く候補の費用 (祖先の境界箱の拡大を含む) を分枝限定法で比べる
+		float area = half_area(box);
+		float best = FLT_MAX;
+		unsigned int target = INVALID;
+		unsigned int pick = INVALID;
+		auto later = [](SProbe const& lhs, SProbe const& rhs) {
+			return lhs.bound > rhs.bound;
+		};
+		std::vector<SProbe> heap(1U, SProbe{ area, 0.0f, 0U });
+		while (!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end(), later);
+			SProbe probe = heap.back();
+			heap.pop_back();
+			if (probe.bound >= best) {
+				break;
+			}
+
+			unsigned int node = probe.node;
+			bool bottom = true;
+			unsigned int num = 0U;
+			for (; num < WIDTH && m_nodes[node].child[num] != INVALID; ++num) {
+				unsigned int ref = m_nodes[node].child[num];
+				CFAABB3 merged = lane_bounds(node, num);
+				float before = half_area(merged);
+				float after = half_area(merged.merge(box));
+				if ((ref & LEAF_FLAG) != 0U) {
+					size_t first, last;
+					leaf_range(ref, first, last);
+					float count = static_cast<float>(last - first);
+					float cost = probe.induced + after * (count + 1.0f) - before * count;
+					if (last - first < LEAF_MAX && cost < best) {
+						best = cost;
+						target = node;
+						pick = num;
+					}
+					continue;
+				}
+				bottom = false;
+				float induced = probe.induced + after - before;
+				if (induced + area < best) {
+					heap.push_back(SProbe{ induced + area, induced, ref });
+					std::push_heap(heap.begin(), heap.end(), later);
+				}
+			}
+			// 新たな葉は子が全て葉の節点にのみ置き、一杯なら分割する (段数は分割が根まで及んだ場合にのみ増える)
+			if (bottom) {
+				float cost = probe.induced + area;
+				if (cost < best) {
+					best = cost;
+					target = node;
+					pick = num;
+				}
+			}
+		}
+		m_bounds.merge(box);
+
+		bool deep = false;
+		if (pick == WIDTH) {
+			append(INVALID);
+			deep = split(target, leaf_ref(m_slots[id], 1U), box);
+		}
+		else if (m_nodes[target].child[pick] == INVALID) {
+			set_lane(target, pick, leaf_ref(m_prims.size(), 1U), box);
+			append(target);
+		}
+		else {
+			size_t first, last;
+			leaf_range(m_nodes[target].child[pick], first, last);
+			// 葉の要素は連続させる必要がある為、末尾にない葉は末尾へ移してから加える
+			if (last != m_prims.size()) {
+				for (size_t slot = first; slot < last; ++slot) {
+					relocate(slot, target);
+				}
+				first = m_prims.size() - (last - first);
+			}
+			m_nodes[target].child[pick] = leaf_ref(first, m_prims.size() - first + 1U);
+			append(target);
+		}
+		refit_path(target);
+
+		// 根の分割で段数が走査用スタックの上限を超えた場合は全体を構築し直す
+		if (deep && height() > DEPTH_MAX) {
+			reconstruct(std::vector<unsigned int>(1U, 0U));
+		}
+		else if (m_holes > size()) {
+			compact(0U);
+		}
+		return id;
+	}
+
+	void CFBVH4::remove(unsigned int const& id) {
+		if (id >= m_slots.size() || m_slots[id] == INVALID) {
+			return;
+		}
+
+		size_t slot = m_slots[id];
+		unsigned int node = m_owners[slot];
+		unsigned int lane = 0U;
+		size_t first = 0U, last = 0U;
+		for (; lane < WIDTH; ++lane) {
+			unsigned int ref = m_nodes[node].child[lane];
+			if (ref != INVALID && (ref & LEAF_FLAG) != 0U) {
+				leaf_range(ref, first, last);
+				if (first <= slot && slot < last) {
+					break;
+				}
+			}
+		}
+
+		// 葉の末尾の要素で埋めて葉を縮める
+		size_t tail = last - 1U;
+		if (slot != tail) {
+			m_prims[slot] = m_prims[tail];
+			if (m_tris.empty()) {
+				m_boxes[slot] = m_boxes[tail];
+			}
+			else {
+				m_tris[slot] = m_tris[tail];
+			}
+			m_slots[m_prims[slot]] = static_cast<unsigned int>(slot);
+		}
+		m_prims[tail] = INVALID;
+		m_slots[id] = INVALID;
+		++m_holes;
+
+		if (tail > first) {
+			m_nodes[node].child[lane] = leaf_ref(first, tail - first);
+		}
+		else {
+			// 空になった節点は親から外す
+			detach(node, lane);
+			while (node != 0U && m_nodes[node].child[0] == INVALID) {
+				unsigned int parent = m_parents[node];
+				for (unsigned int idx = 0U; idx < WIDTH; ++idx) {
+					if (m_nodes[parent].child[idx] == node) {
+						detach(parent, idx);
+						break;
+					}
+				}
+				node = parent;
+			}
+		}
+		refit_path(node);
+
+		if (m_holes > size()) {
+			compact(0U);
+		}
+	}
+
+	CFAABB3 const& CFBVH4::bounds() const noexcept {
+		return m_bounds;
+	}
+
+	size_t const CFBVH4::nodes() const noexcept {
+		return m_nodes.size();
+	}
+
+	size_t const CFBVH4::size() const noexcept {
+		return m_prims.size() - m_holes;
+	}
+
+	void CFBVH4::build_tree(std::vector<float> const& boxes) {
+		size_t count = boxes.size() / 6U;
+		m_nodes.clear();
+		m_parents.clear();
+		m_costs.clear();
+		m_prims.clear();
+		m_owners.clear();
+		m_slots.clear();
+		m_holes = 0U;
+		m_ordered = true;
+		m_bounds = CFAABB3();
+		if (count == 0U) {
+			return;
+		}
+
+		assemble(boxes, 0U, INVALID, m_prims);
+		m_owners.resize(count);
+		adopt(0U);
+		m_slots.resize(count);
+		for (size_t slot = 0U; slot < count; ++slot) {
+			m_slots[m_prims[slot]] = static_cast<unsigned int>(slot);
+		}
+		evaluate(m_costs);
+		m_bounds = ref_bounds(0U);
+	}
+
+	unsigned int const CFBVH4::assemble(std::vector<float> const& boxes, size_t const& base, unsigned int const& parent, std::vector<unsigned int>& order) {
+		std::vector<SBuildNode> tree;
+		build_binary(boxes, tree, order);
+
+		// 二分木の子と孫から表面積の大きい節点を展開して四つの子に束ねる
+		m_nodes.reserve(m_nodes.size() + tree.size() / 2U + 1U);
+		auto collapse = [&](auto const& self, unsigned int const& src, unsigned int const& up) -> unsigned int {
+			unsigned int dst = static_cast<unsigned int>(m_nodes.size());
+			m_nodes.emplace_back();
+			m_parents.push_back(up);
+			m_costs.push_back(-1.0f);
+			unsigned int kids[WIDTH] = { INVALID, INVALID, INVALID, INVALID };
+			unsigned int num = 0U;
+			if (tree[src].left == INVALID) {
+				kids[num++] = src;
+			}
+			else {
+				kids[num++] = tree[src].left;
+				kids[num++] = tree[src].right;
+			}
+			while (num < WIDTH) {
+				unsigned int pick = INVALID;
+				float area = -1.0f;
+				for (unsigned int idx = 0U; idx < num; ++idx) {
+					if (tree[kids[idx]].left != INVALID && half_area(tree[kids[idx]].box) > area) {
+						area = half_area(tree[kids[idx]].box);
+						pick = idx;
+					}
+				}
+				if (pick == INVALID) {
+					break;
+				}
+				unsigned int expand = kids[pick];
+				kids[pick] = tree[expand].left;
+				kids[num++] = tree[expand].right;
+			}
+
+			unsigned int refs[WIDTH] = { INVALID, INVALID, INVALID, INVALID };
+			for (unsigned int idx = 0U; idx < num; ++idx) {
+				SBuildNode const& kid = tree[kids[idx]];
+				refs[idx] = kid.left == INVALID ? leaf_ref(base + kid.first, kid.count) : self(self, kids[idx], dst);
+			}
+			SNode& node = m_nodes[dst];
+			for (unsigned int idx = 0U; idx < WIDTH; ++idx) {
+				SBox box = idx < num ? tree[kids[idx]].box : empty_box();
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					node.lo[comp][idx] = box.lo[comp];
+					node.hi[comp][idx] = box.hi[comp];
+				}
+				node.child[idx] = refs[idx];
+			}
+			return dst;
+		};
+		return collapse(collapse, 0U, parent);
+	}
+
+	void CFBVH4::reconstruct(std::vector<unsigned int> const& targets) {
+		// 部分木を末尾へ構築し直して親から付け替え、古い節点と要素は最後に詰めて捨てる
+		unsigned int root = 0U;
+		std::vector<float> current;
+		for (auto const& target : targets) {
+			std::vector<size_t> slots;
+			gather(target, slots);
+			if (slots.empty()) {
+				continue;
+			}
+			std::vector<float> flat(slots.size() * 6U);
+			for (size_t idx = 0U; idx < slots.size(); ++idx) {
+				CFAABB3 box = prim_bounds(slots[idx]);
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					flat[idx * 6U + comp] = box.lower().p[comp];
+					flat[idx * 6U + 3U + comp] = box.upper().p[comp];
+				}
+			}
+
+			unsigned int parent = m_parents[target];
+			unsigned int first = static_cast<unsigned int>(m_nodes.size());
+			std::vector<unsigned int> order;
+			unsigned int top = assemble(flat, m_prims.size(), parent, order);
+			for (auto const& idx : order) {
+				relocate(slots[idx], INVALID);
+			}
+			adopt(first);
+			if (parent == INVALID) {
+				root = top;
+				continue;
+			}
+			for (unsigned int lane = 0U; lane < WIDTH; ++lane) {
+				if (m_nodes[parent].child[lane] == target) {
+					m_nodes[parent].child[lane] = top;
+				}
+			}
+		}
+		compact(root);
+
+		evaluate(current);
+		for (size_t node = 0U; node < m_nodes.size(); ++node) {
+			if (m_costs[node] < 0.0f) {
+				m_costs[node] = current[node];
+			}
+		}
+
+		// 深い節点の下へ構築した部分木で段数が上限を超えた場合は全体を構築し直す
+		if (targets.front() != 0U && height() > DEPTH_MAX) {
+			reconstruct(std::vector<unsigned int>(1U, 0U));
+		}
+	}
+
+	unsigned int const CFBVH4::height() const {
+		if (m_nodes.empty()) {
+			return 0U;
+		}
+		unsigned int result = 0U;
+		std::vector<unsigned int> depths(m_nodes.size(), 0U);
+		std::vector<unsigned int> stack(1U, 0U);
+		depths[0] = 1U;
+		while (!stack.empty()) {
+			unsigned int cur = stack.back();
+			stack.pop_back();
+			result = std::max(result, depths[cur]);
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[cur].child[lane] != INVALID; ++lane) {
+				unsigned int ref = m_nodes[cur].child[lane];
+				if ((ref & LEAF_FLAG) == 0U) {
+					depths[ref] = depths[cur] + 1U;
+					stack.push_back(ref);
+				}
+			}
+		}
+		return result;
+	}
+
+	unsigned int const CFBVH4::spawn(unsigned int const& parent) {
+		unsigned int node = static_cast<unsigned int>(m_nodes.size());
+		m_nodes.emplace_back();
+		m_parents.push_back(parent);
+		m_costs.push_back(-1.0f);
+		for (unsigned int lane = 0U; lane < WIDTH; ++lane) {
+			set_lane(node, lane, INVALID, CFAABB3());
+		}
+		return node;
+	}
+
+	bool const CFBVH4::split(unsigned int const& node, unsigned int const& ref, CFAABB3 const& box) {
+		// 四つの子と加える子を、表面積の和が最小となる二つと三つの組に分ける (先頭の子は常に一方の組に置く)
+		unsigned int refs[WIDTH + 1U];
+		CFAABB3 boxes[WIDTH + 1U];
+		for (unsigned int lane = 0U; lane < WIDTH; ++lane) {
+			refs[lane] = m_nodes[node].child[lane];
+			boxes[lane] = lane_bounds(node, lane);
+		}
+		refs[WIDTH] = ref;
+		boxes[WIDTH] = box;
+		unsigned int best_mask = 0U;
+		float best_area = FLT_MAX;
+		for (unsigned int mask = 1U; mask < (1U << (WIDTH + 1U)); mask += 2U) {
+			unsigned int num = 0U;
+			for (unsigned int bits = mask; bits != 0U; bits &= bits - 1U) {
+				++num;
+			}
+			if (num != 2U && num != 3U) {
+				continue;
+			}
+			CFAABB3 groups[2];
+			for (unsigned int idx = 0U; idx <= WIDTH; ++idx) {
+				groups[(mask >> idx) & 1U].merge(boxes[idx]);
+			}
+			float sum = half_area(groups[0]) + half_area(groups[1]);
+			if (sum < best_area) {
+				best_area = sum;
+				best_mask = mask;
+			}
+		}
+
+		// 根は番号 0 のまま残す為、二組とも新たな節点へ移して根の子とする
+		unsigned int parent = m_parents[node];
+		bool root = parent == INVALID;
+		unsigned int homes[2] = { root ? spawn(node) : node, spawn(root ? node : parent) };
+		for (unsigned int lane = 0U; lane < WIDTH; ++lane) {
+			set_lane(node, lane, INVALID, CFAABB3());
+		}
+		unsigned int fill[2] = { 0U, 0U };
+		for (unsigned int idx = 0U; idx <= WIDTH; ++idx) {
+			unsigned int side = ((best_mask >> idx) & 1U) != 0U ? 0U : 1U;
+			set_lane(homes[side], fill[side]++, refs[idx], boxes[idx]);
+			settle(homes[side], refs[idx]);
+		}
+		// 新たな節点は分割元の構築時の費用を基準とし、挿入で劣化した部分木を rebuild で検出できるようにする
+		for (auto const& home : homes) {
+			m_costs[home] = m_costs[node];
+		}
+		m_ordered = false;
+
+		if (root) {
+			set_lane(node, 0U, homes[0], ref_bounds(homes[0]));
+			set_lane(node, 1U, homes[1], ref_bounds(homes[1]));
+			return true;
+		}
+		// 親に空きがなければ親も分割する
+		unsigned int num = 0U;
+		while (num < WIDTH && m_nodes[parent].child[num] != INVALID) {
+			++num;
+		}
+		if (num < WIDTH) {
+			set_lane(parent, num, homes[1], ref_bounds(homes[1]));
+			return false;
+		}
+		return split(parent, homes[1], ref_bounds(homes[1]));
+	}
+
+	void CFBVH4::settle(unsigned int const& node, unsigned int const& ref) noexcept {
+		if ((ref & LEAF_FLAG) == 0U) {
+			m_parents[ref] = node;
+			return;
+		}
+		size_t first, last;
+		leaf_range(ref, first, last);
+		std::fill(m_owners.begin() + static_cast<std::ptrdiff_t>(first), m_owners.begin() + static_cast<std::ptrdiff_t>(last), node);
+	}
+
+	void CFBVH4::adopt(unsigned int const& from) noexcept {
+		for (size_t node = from; node < m_nodes.size(); ++node) {
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[node].child[lane] != INVALID; ++lane) {
+				if ((m_nodes[node].child[lane] & LEAF_FLAG) != 0U) {
+					size_t first, last;
+					leaf_range(m_nodes[node].child[lane], first, last);
+					std::fill(m_owners.begin() + static_cast<std::ptrdiff_t>(first), m_owners.begin() + static_cast<std::ptrdiff_t>(last), static_cast<unsigned int>(node));
+				}
+			}
+		}
+	}
+
+	CFAABB3 const CFBVH4::prim_bounds(size_t const& slot) const noexcept {
+		if (m_tris.empty()) {
+			return m_boxes[slot];
+		}
+		STriangle const& tri = m_tris[slot];
+		CFVector3 v0(tri.v0[0], tri.v0[1], tri.v0[2]);
+		CFAABB3 box(v0, v0);
+		box.merge(CFVector3(v0.x + tri.e1[0], v0.y + tri.e1[1], v0.z + tri.e1[2]));
+		box.merge(CFVector3(v0.x + tri.e2[0], v0.y + tri.e2[1], v0.z + tri.e2[2]));
+		return box;
+	}
+
+	CFAABB3 const CFBVH4::lane_bounds(unsigned int const& node, unsigned int const& lane) const noexcept {
+		SNode const& src = m_nodes[node];
+		return CFAABB3(
+			CFVector3(src.lo[0][lane], src.lo[1][lane], src.lo[2][lane]),
+			CFVector3(src.hi[0][lane], src.hi[1][lane], src.hi[2][lane])
+		);
+	}
+
+	CFAABB3 const CFBVH4::ref_bounds(unsigned int const& ref) const noexcept {
+		CFAABB3 box;
+		if ((ref & LEAF_FLAG) != 0U) {
+			size_t first, last;
+			leaf_range(ref, first, last);
+			for (size_t slot = first; slot < last; ++slot) {
+				box.merge(prim_bounds(slot));
+			}
+		}
+		else {
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[ref].child[lane] != INVALID; ++lane) {
+				box.merge(lane_bounds(ref, lane));
+			}
+		}
+		return box;
+	}
+
+	void CFBVH4::set_lane(unsigned int const& node, unsigned int const& lane, unsigned int const& ref, CFAABB3 const& box) noexcept {
+		SNode& dst = m_nodes[node];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			dst.lo[comp][lane] = box.lower().p[comp];
+			dst.hi[comp][lane] = box.upper().p[comp];
+		}
+		dst.child[lane] = ref;
+	}
+
+	void CFBVH4::detach(unsigned int const& node, unsigned int const& lane) noexcept {
+		for (unsigned int idx = lane; idx + 1U < WIDTH; ++idx) {
+			set_lane(node, idx, m_nodes[node].child[idx + 1U], lane_bounds(node, idx + 1U));
+		}
+		set_lane(node, WIDTH - 1U, INVALID, CFAABB3());
+	}
+
+	void CFBVH4::refit_path(unsigned int const& node) noexcept {
+		for (unsigned int cur = node; cur != INVALID; cur = m_parents[cur]) {
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[cur].child[lane] != INVALID; ++lane) {
+				set_lane(cur, lane, m_nodes[cur].child[lane], ref_bounds(m_nodes[cur].child[lane]));
+			}
+		}
+		m_bounds = ref_bounds(0U);
+	}
+
+	void CFBVH4::refit_all() {
+		if (m_nodes.empty()) {
+			return;
+		}
+		if (!m_ordered) {
+			compact(0U);
+		}
+		for (size_t node = m_nodes.size(); node-- > 0U;) {
+			unsigned int cur = static_cast<unsigned int>(node);
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[cur].child[lane] != INVALID; ++lane) {
+				set_lane(cur, lane, m_nodes[cur].child[lane], ref_bounds(m_nodes[cur].child[lane]));
+			}
+		}
+		m_bounds = ref_bounds(0U);
+	}
+
+	void CFBVH4::evaluate(std::vector<float>& costs) const {
+		// 節点の表面積に走査費用、葉の表面積に要素数を掛けて部分木毎に合計する
+		std::vector<float> raw(m_nodes.size(), 0.0f);
+		costs.assign(m_nodes.size(), 0.0f);
+		for (size_t node = m_nodes.size(); node-- > 0U;) {
+			CFAABB3 whole;
+			float sum = 0.0f;
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[node].child[lane] != INVALID; ++lane) {
+				unsigned int ref = m_nodes[node].child[lane];
+				CFAABB3 box = lane_bounds(static_cast<unsigned int>(node), lane);
+				whole.merge(box);
+				if ((ref & LEAF_FLAG) != 0U) {
+					size_t first, last;
+					leaf_range(ref, first, last);
+					sum += half_area(box) * static_cast<float>(last - first);
+				}
+				else {
+					sum += raw[ref];
+				}
+			}
+			float area = std::max(half_area(whole), FLT_MIN);
+			raw[node] = area * TRAVERSAL_COST + sum;
+			costs[node] = raw[node] / area;
+		}
+	}
+
+	void CFBVH4::gather(unsigned int const& node, std::vector<size_t>& slots) const {
+		std::vector<unsigned int> stack(1U, node);
+		while (!stack.empty()) {
+			unsigned int cur = stack.back();
+			stack.pop_back();
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[cur].child[lane] != INVALID; ++lane) {
+				unsigned int ref = m_nodes[cur].child[lane];
+				if ((ref & LEAF_FLAG) == 0U) {
+					stack.push_back(ref);
+					continue;
+				}
+				size_t first, last;
+				leaf_range(ref, first, last);
+				for (size_t slot = first; slot < last; ++slot) {
+					slots.push_back(slot);
+				}
+			}
+		}
+	}
+
+	void CFBVH4::relocate(size_t const& slot, unsigned int const& owner) {
+		unsigned int id = m_prims[slot];
+		m_slots[id] = static_cast<unsigned int>(m_prims.size());
+		m_prims.push_back(id);
+		m_owners.push_back(owner);
+		if (m_tris.empty()) {
+			CFAABB3 box = m_boxes[slot];
+			m_boxes.push_back(box);
+		}
+		else {
+			STriangle tri = m_tris[slot];
+			m_tris.push_back(tri);
+		}
+		m_prims[slot] = INVALID;
+		++m_holes;
+	}
+
+	void CFBVH4::compact(unsigned int const& root) {
+		std::vector<SNode> packed;
+		std::vector<unsigned int> parents, prims, owners;
+		std::vector<float> costs;
+		std::vector<STriangle> tris;
+		std::vector<CFAABB3> boxes;
+		packed.reserve(m_nodes.size());
+		prims.reserve(size());
+		auto emit = [&](auto const& self, unsigned int const& src, unsigned int const& up) -> unsigned int {
+			unsigned int dst = static_cast<unsigned int>(packed.size());
+			packed.push_back(m_nodes[src]);
+			parents.push_back(up);
+			costs.push_back(m_costs[src]);
+			for (unsigned int lane = 0U; lane < WIDTH && m_nodes[src].child[lane] != INVALID; ++lane) {
+				unsigned int ref = m_nodes[src].child[lane];
+				if ((ref & LEAF_FLAG) == 0U) {
+					ref = self(self, ref, dst);
+				}
+				else {
+					size_t first, last;
+					leaf_range(ref, first, last);
+					ref = leaf_ref(prims.size(), last - first);
+					for (size_t slot = first; slot < last; ++slot) {
+						m_slots[m_prims[slot]] = static_cast<unsigned int>(prims.size());
+						prims.push_back(m_prims[slot]);
+						owners.push_back(dst);
+						if (m_tris.empty()) {
+							boxes.push_back(m_boxes[slot]);
+						}
+						else {
+							tris.push_back(m_tris[slot]);
+						}
+					}
+				}
+				packed[dst].child[lane] = ref;
+			}
+			return dst;
+		};
+		emit(emit, root, INVALID);
+
+		m_nodes.swap(packed);
+		m_parents.swap(parents);
+		m_costs.swap(costs);
+		m_prims.swap(prims);
+		m_owners.swap(owners);
+		m_tris.swap(tris);
+		m_boxes.swap(boxes);
+		m_holes = 0U;
+		m_ordered = true;
+		m_bounds = ref_bounds(0U);
+	}
+
+	bool const CFBVH4::intersect(CRay<CFVector3> const& ray, float const& tmax, SRayHit& hit) const noexcept {
+		hit = SRayHit{ INVALID, tmax, 0.0f, 0.0f };
+		if (m_nodes.empty()) {
+			return false;
+		}
+
+		float o[FLT3_CNT], d[FLT3_CNT], inv[FLT3_CNT];
+		prepare(ray, o, d, inv);
+		__m128 const ro[FLT3_CNT] = { _mm_set1_ps(o[0]), _mm_set1_ps(o[1]), _mm_set1_ps(o[2]) };
+		__m128 const ri[FLT3_CNT] = { _mm_set1_ps(inv[0]), _mm_set1_ps(inv[1]), _mm_set1_ps(inv[2]) };
+
+		SEntry stack[STACK_CNT];
+		unsigned int sp = 0U;
+		stack[sp++] = SEntry{ 0U, 0.0f };
+		while (sp > 0U) {
+			SEntry entry = stack[--sp];
+			if (entry.tnear > hit.t) {
+				continue;
+			}
+
+			if ((entry.ref & LEAF_FLAG) != 0U) {
+				size_t first, last;
+				leaf_range(entry.ref, first, last);
+				for (size_t idx = first; idx < last; ++idx) {
+					bool found = m_tris.empty() ?
+						ray_box(o, inv, m_boxes[idx], hit.t) :
+						ray_triangle(o, d, m_tris[idx].v0, m_tris[idx].e1, m_tris[idx].e2, hit.t, hit.u, hit.v);
+					if (found) {
+						hit.prim = m_prims[idx];
+					}
+				}
+				continue;
+			}
+
+			SNode const& node = m_nodes[entry.ref];
+			__m128 tn;
+			unsigned int bits = slab4(node.lo, node.hi, node.child, ro, ri, hit.t, tn);
+			if (bits == 0U) {
+				continue;
+			}
+			alignas(16) float tns[WIDTH];
+			_mm_store_ps(tns, tn);
+			SEntry found[WIDTH];
+			unsigned int num = 0U;
+			for (; bits != 0U; bits &= bits - 1U) {
+				unsigned int idx = _tzcnt_u32(bits);
+				found[num++] = SEntry{ node.child[idx], tns[idx] };
+			}
+			push_sorted(stack, sp, found, num);
+		}
+		return hit.prim != INVALID;
+	}
+
+	bool const CFBVH4::occluded(CRay<CFVector3> const& ray, float const& tmax) const noexcept {
+		if (m_nodes.empty()) {
+			return false;
+		}
+
+		float o[FLT3_CNT], d[FLT3_CNT], inv[FLT3_CNT];
+		prepare(ray, o, d, inv);
+		__m128 const ro[FLT3_CNT] = { _mm_set1_ps(o[0]), _mm_set1_ps(o[1]), _mm_set1_ps(o[2]) };
+		__m128 const ri[FLT3_CNT] = { _mm_set1_ps(inv[0]), _mm_set1_ps(inv[1]), _mm_set1_ps(inv[2]) };
+
+		// 最初に見つかった交差で終える為、子の順序付けは行わない
+		unsigned int stack[STACK_CNT];
+		unsigned int sp = 0U;
+		stack[sp++] = 0U;
+		while (sp > 0U) {
+			unsigned int ref = stack[--sp];
+			if ((ref & LEAF_FLAG) != 0U) {
+				size_t first, last;
+				leaf_range(ref, first, last);
+				for (size_t idx = first; idx < last; ++idx) {
+					float t = tmax, u, v;
+					bool found = m_tris.empty() ?
+						ray_box(o, inv, m_boxes[idx], t) :
+						ray_triangle(o, d, m_tris[idx].v0, m_tris[idx].e1, m_tris[idx].e2, t, u, v);
+					if (found) {
+						return true;
+					}
+				}
+				continue;
+			}
+
+			SNode const& node = m_nodes[ref];
+			__m128 tn;
+			for (unsigned int bits = slab4(node.lo, node.hi, node.child, ro, ri, tmax, tn); bits != 0U; bits &= bits - 1U) {
+				assert(sp < STACK_CNT);
+				stack[sp++] = node.child[_tzcnt_u32(bits)];
+			}
+		}
+		return false;
+	}
+
+	void CFBVH4::intersect(CRay<CFVector3> const* const rays, size_t const& count, float const& tmax, SRayHit* const hits) const noexcept {
+		for (size_t base = 0U; base < count; base += PACKET_CNT) {
+			SPacket ray;
+			size_t lanes = load_packet(rays, base, count, ray);
+			__m256 active = tailMask(lanes);
+			__m256 tcur = _mm256_set1_ps(tmax);
+			__m256 hu = _mm256_setzero_ps();
+			__m256 hv = _mm256_setzero_ps();
+			__m256 prim = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			SEntry stack[STACK_CNT];
+			unsigned int sp = 0U;
+			if (!m_nodes.empty()) {
+				stack[sp++] = SEntry{ 0U, 0.0f };
+			}
+			while (sp > 0U) {
+				SEntry entry = stack[--sp];
+				if (entry.tnear > laneMax(_mm256_and_ps(tcur, active))) {
+					continue;
+				}
+
+				if ((entry.ref & LEAF_FLAG) != 0U) {
+					size_t first, last;
+					leaf_range(entry.ref, first, last);
+					for (size_t idx = first; idx < last; ++idx) {
+						__m256 t, u, v, mask;
+						if (m_tris.empty()) {
+							CFAABB3 const& box = m_boxes[idx];
+							float lo[FLT3_CNT] = { box.lower().p[0], box.lower().p[1], box.lower().p[2] };
+							float hi[FLT3_CNT] = { box.upper().p[0], box.upper().p[1], box.upper().p[2] };
+							mask = packet_box(ray, lo, hi, tcur, t);
+							u = _mm256_setzero_ps();
+							v = _mm256_setzero_ps();
+						}
+						else {
+							mask = packet_triangle(ray, m_tris[idx].v0, m_tris[idx].e1, m_tris[idx].e2, t, u, v);
+						}
+						mask = _mm256_and_ps(_mm256_and_ps(mask, active), _mm256_cmp_ps(t, tcur, _CMP_LT_OQ));
+						tcur = _mm256_blendv_ps(tcur, t, mask);
+						hu = _mm256_blendv_ps(hu, u, mask);
+						hv = _mm256_blendv_ps(hv, v, mask);
+						prim = _mm256_blendv_ps(prim, _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(m_prims[idx]))), mask);
+					}
+					continue;
+				}
+
+				// 子毎に八本の光線を同時に判定し、いずれかが交差すれば最小の入射位置で積む
+				SNode const& node = m_nodes[entry.ref];
+				SEntry found[WIDTH];
+				unsigned int num = 0U;
+				for (unsigned int idx = 0U; idx < WIDTH && node.child[idx] != INVALID; ++idx) {
+					float lo[FLT3_CNT] = { node.lo[0][idx], node.lo[1][idx], node.lo[2][idx] };
+					float hi[FLT3_CNT] = { node.hi[0][idx], node.hi[1][idx], node.hi[2][idx] };
+					__m256 tn;
+					__m256 mask = _mm256_and_ps(packet_box(ray, lo, hi, tcur, tn), active);
+					if (_mm256_movemask_ps(mask) != 0) {
+						found[num++] = SEntry{ node.child[idx], laneMin(_mm256_blendv_ps(_mm256_set1_ps(FLT_MAX), tn, mask)) };
+					}
+				}
+				push_sorted(stack, sp, found, num);
+			}
+
+			alignas(32) float ts[PACKET_CNT], us[PACKET_CNT], vs[PACKET_CNT];
+			alignas(32) unsigned int ids[PACKET_CNT];
+			_mm256_store_ps(ts, tcur);
+			_mm256_store_ps(us, hu);
+			_mm256_store_ps(vs, hv);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(ids), _mm256_castps_si256(prim));
+			for (size_t lane = 0U; lane < lanes; ++lane) {
+				hits[base + lane] = SRayHit{ ids[lane], ts[lane], us[lane], vs[lane] };
+			}
+		}
+	}
+
+	void CFBVH4::occluded(CRay<CFVector3> const* const rays, size_t const& count, float const& tmax, bool* const results) const noexcept {
+		__m256 const limit = _mm256_set1_ps(tmax);
+		for (size_t base = 0U; base < count; base += PACKET_CNT) {
+			SPacket ray;
+			size_t lanes = load_packet(rays, base, count, ray);
+			__m256 active = tailMask(lanes);
+
+			// 遮蔽が見つかった光線は走査から外し、全て外れた時点で終える
+			unsigned int stack[STACK_CNT];
+			unsigned int sp = 0U;
+			if (!m_nodes.empty()) {
+				stack[sp++] = 0U;
+			}
+			while (sp > 0U && _mm256_movemask_ps(active) != 0) {
+				unsigned int ref = stack[--sp];
+				if ((ref & LEAF_FLAG) != 0U) {
+					size_t first, last;
+					leaf_range(ref, first, last);
+					for (size_t idx = first; idx < last; ++idx) {
+						__m256 t, u, v, mask;
+						if (m_tris.empty()) {
+							CFAABB3 const& box = m_boxes[idx];
+							float lo[FLT3_CNT] = { box.lower().p[0], box.lower().p[1], box.lower().p[2] };
+							float hi[FLT3_CNT] = { box.upper().p[0], box.upper().p[1], box.upper().p[2] };
+							mask = packet_box(ray, lo, hi, limit, t);
+						}
+						else {
+							mask = packet_triangle(ray, m_tris[idx].v0, m_tris[idx].e1, m_tris[idx].e2, t, u, v);
+							mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, limit, _CMP_LT_OQ));
+						}
+						active = _mm256_andnot_ps(mask, active);
+					}
+					continue;
+				}
+
+				SNode const& node = m_nodes[ref];
+				for (unsigned int idx = 0U; idx < WIDTH && node.child[idx] != INVALID; ++idx) {
+					float lo[FLT3_CNT] = { node.lo[0][idx], node.lo[1][idx], node.lo[2][idx] };
+					float hi[FLT3_CNT] = { node.hi[0][idx], node.hi[1][idx], node.hi[2][idx] };
+					__m256 tn;
+					if (_mm256_movemask_ps(_mm256_and_ps(packet_box(ray, lo, hi, limit, tn), active)) != 0) {
+						assert(sp < STACK_CNT);
+						stack[sp++] = node.child[idx];
+					}
+				}
+			}
+
+			unsigned int bits = static_cast<unsigned int>(_mm256_movemask_ps(active));
+			for (size_t lane = 0U; lane < lanes; ++lane) {
+				results[base + lane] = (bits & (1U << lane)) == 0U;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,460 @@
+﻿/**	@file	CFConvexHull.cpp
+ *	@brief	点群の凸包
+ */
+#include "geo/CFConvexHull.hpp"
+#include "util/CJobSystem.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	無効な番号
+		unsigned int constexpr INVALID = 0xFFFFFFFFU;
+		//!	@brief	点群を区間に分けて並列化する点数の下限
+		size_t constexpr PARALLEL_MIN = 65536U;
+
+		/**	@struct	SFace
+		 *	@brief	凸包の三角形の面
+		 */
+		struct SFace {
+			//!	@brief	外向きの単位法線
+			double normal[FLT3_CNT];
+			//!	@brief	原点からの距離
+			double offset;
+			//!	@brief	外側の点で最も遠い点までの距離
+			double topDist;
+			//!	@brief	外側の点の連結リストの先頭
+			unsigned int head;
+			//!	@brief	外側の点で最も遠い点
+			unsigned int top;
+			//!	@brief	凸包の面として残っているか
+			bool live;
+		};
+
+		/**	@struct	SFrame
+		 *	@brief	見える面の深さ優先探索の状態
+		 */
+		struct SFrame {
+			//!	@brief	面
+			unsigned int face;
+			//!	@brief	次に調べる辺の面内の位置
+			unsigned int corner;
+			//!	@brief	残りの辺数
+			unsigned int remain;
+		};
+
+		/**	@struct	SHull
+		 *	@brief	Quickhull の作業領域
+		 *	@note	面 f の半辺は f * 3 + k (k = 0, 1, 2) で、始点が corners、反対向きの半辺が twins に入る。
+		 */
+		struct SHull {
+			//!	@brief	点群
+			CFVector3 const* points;
+			//!	@brief	面
+			std::vector<SFace> faces;
+			//!	@brief	半辺の始点
+			std::vector<unsigned int> corners;
+			//!	@brief	反対向きの半辺
+			std::vector<unsigned int> twins;
+			//!	@brief	点毎の外側の点の連結リストの次の点
+			std::vector<unsigned int> links;
+			//!	@brief	面毎の探索済みの印
+			std::vector<unsigned int> marks;
+			//!	@brief	面の表裏を判定する誤差
+			double eps;
+		};
+
+		//!	@brief	平面からの符号付き距離取得関数
+		double plane_distance(SFace const& face, CFVector3 const& pos) noexcept {
+			return face.normal[0] * pos.p[0] + face.normal[1] * pos.p[1] + face.normal[2] * pos.p[2] - face.offset;
+		}
+
+		//!	@brief	面の追加関数 (a, b, c は外から見て反時計回り)
+		unsigned int add_face(SHull& hull, unsigned int const& a, unsigned int const& b, unsigned int const& c) {
+			CFVector3 const& pa = hull.points[a];
+			CFVector3 const& pb = hull.points[b];
+			CFVector3 const& pc = hull.points[c];
+			double ab[FLT3_CNT];
+			double ac[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				ab[comp] = static_cast<double>(pb.p[comp]) - pa.p[comp];
+				ac[comp] = static_cast<double>(pc.p[comp]) - pa.p[comp];
+			}
+			SFace face;
+			face.normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+			face.normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+			face.normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+			double len = std::sqrt(face.normal[0] * face.normal[0] + face.normal[1] * face.normal[1] + face.normal[2] * face.normal[2]);
+			double inv = len > 0.0 ? 1.0 / len : 0.0;
+			face.offset = 0.0;
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				face.normal[comp] *= inv;
+				face.offset += face.normal[comp] * ((static_cast<double>(pa.p[comp]) + pb.p[comp] + pc.p[comp]) / 3.0);
+			}
+			face.topDist = 0.0;
+			face.head = INVALID;
+			face.top = INVALID;
+			face.live = true;
+			hull.faces.push_back(face);
+			hull.corners.push_back(a);
+			hull.corners.push_back(b);
+			hull.corners.push_back(c);
+			hull.twins.insert(hull.twins.end(), 3U, INVALID);
+			hull.marks.push_back(0U);
+			return static_cast<unsigned int>(hull.faces.size() - 1U);
+		}
+
+		//!	@brief	点を最も遠い外側の面の連結リストへ加える関数 (どの面の外側でもなければ捨てる)
+		void assign(SHull& hull, unsigned int const& idx, unsigned int const* const faces, size_t const& count) noexcept {
+			CFVector3 const& pos = hull.points[idx];
+			unsigned int best = INVALID;
+			double bestDist = hull.eps;
+			for (size_t slot = 0U; slot < count; ++slot) {
+				double dist = plane_distance(hull.faces[faces[slot]], pos);
+				if (dist > bestDist) {
+					best = faces[slot];
+					bestDist = dist;
+				}
+			}
+			if (best != INVALID) {
+				SFace& face = hull.faces[best];
+				hull.links[idx] = face.head;
+				face.head = idx;
+				if (bestDist > face.topDist) {
+					face.top = idx;
+					face.topDist = bestDist;
+				}
+			}
+		}
+
+		/**	@brief	地平線の辺と点を結ぶ面が隣の面と凹の稜を作るか判定する関数
+		 *	@param[in] edge 見える面の辺
+		 *	@param[in] twin 隣の面の反対向きの辺
+		 *	@note	点が隣の面とほぼ同一平面上にある場合、細い面ができて誤差の範囲を越えて凹むことがある為、
+		 *			そのような隣の面も見える面に含めて置き換える。
+		 */
+		bool is_concave(SHull const& hull, unsigned int const& edge, unsigned int const& twin, unsigned int const& eye) noexcept {
+			CFVector3 const& pa = hull.points[hull.corners[edge]];
+			CFVector3 const& pb = hull.points[hull.corners[edge / 3U * 3U + (edge + 1U) % 3U]];
+			CFVector3 const& pe = hull.points[eye];
+			CFVector3 const& opp = hull.points[hull.corners[twin / 3U * 3U + (twin + 2U) % 3U]];
+			double ab[FLT3_CNT];
+			double ae[FLT3_CNT];
+			double ao[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				ab[comp] = static_cast<double>(pb.p[comp]) - pa.p[comp];
+				ae[comp] = static_cast<double>(pe.p[comp]) - pa.p[comp];
+				ao[comp] = static_cast<double>(opp.p[comp]) - pa.p[comp];
+			}
+			double normal[FLT3_CNT] = {
+				ab[1] * ae[2] - ab[2] * ae[1],
+				ab[2] * ae[0] - ab[0] * ae[2],
+				ab[0] * ae[1] - ab[1] * ae[0]
+			};
+			double len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			return normal[0] * ao[0] + normal[1] * ao[1] + normal[2] * ao[2] > hull.eps * len;
+		}
+
+		/**	@brief	初期四面体の頂点の選択関数
+		 *	@return 体積を持つ四面体を選べた場合は真
+		 *	@note	誤差も座標の大きさから求める。
+		 */
+		bool pick_simplex(SHull& hull, size_t const& count, unsigned int (&simplex)[4U]) noexcept {
+			CFVector3 const* const points = hull.points;
+			unsigned int lo[FLT3_CNT] = { 0U, 0U, 0U };
+			unsigned int hi[FLT3_CNT] = { 0U, 0U, 0U };
+			double scale[FLT3_CNT] = { 0.0, 0.0, 0.0 };
+			for (size_t idx = 0U; idx < count; ++idx) {
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					float value = points[idx].p[comp];
+					if (value < points[lo[comp]].p[comp]) {
+						lo[comp] = static_cast<unsigned int>(idx);
+					}
+					if (value > points[hi[comp]].p[comp]) {
+						hi[comp] = static_cast<unsigned int>(idx);
+					}
+					scale[comp] = std::max(scale[comp], static_cast<double>(std::fabs(value)));
+				}
+			}
+			hull.eps = 3.0 * FLT_EPSILON * (scale[0] + scale[1] + scale[2]);
+
+			//	最も広がった軸の両端
+			unsigned int axis = 0U;
+			double extent = -1.0;
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				double span = static_cast<double>(points[hi[comp]].p[comp]) - points[lo[comp]].p[comp];
+				if (span > extent) {
+					axis = comp;
+					extent = span;
+				}
+			}
+			if (extent <= hull.eps) {
+				return false;
+			}
+			simplex[0] = lo[axis];
+			simplex[1] = hi[axis];
+
+			//	二点を通る直線から最も遠い点
+			CFVector3 const& p0 = points[simplex[0]];
+			double dir[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dir[comp] = static_cast<double>(points[simplex[1]].p[comp]) - p0.p[comp];
+			}
+			double best = 0.0;
+			simplex[2] = INVALID;
+			for (size_t idx = 0U; idx < count; ++idx) {
+				double rel[FLT3_CNT];
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					rel[comp] = static_cast<double>(points[idx].p[comp]) - p0.p[comp];
+				}
+				double cx = dir[1] * rel[2] - dir[2] * rel[1];
+				double cy = dir[2] * rel[0] - dir[0] * rel[2];
+				double cz = dir[0] * rel[1] - dir[1] * rel[0];
+				double dist = cx * cx + cy * cy + cz * cz;
+				if (dist > best) {
+					best = dist;
+					simplex[2] = static_cast<unsigned int>(idx);
+				}
+			}
+			if (simplex[2] == INVALID || std::sqrt(best) / extent <= hull.eps) {
+				return false;
+			}
+
+			//	三点を通る平面から最も遠い点
+			double side[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				side[comp] = static_cast<double>(points[simplex[2]].p[comp]) - p0.p[comp];
+			}
+			double normal[FLT3_CNT] = {
+				dir[1] * side[2] - dir[2] * side[1],
+				dir[2] * side[0] - dir[0] * side[2],
+				dir[0] * side[1] - dir[1] * side[0]
+			};
+			double len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			best = 0.0;
+			double height = 0.0;
+			simplex[3] = INVALID;
+			for (size_t idx = 0U; idx < count; ++idx) {
+				double dist = 0.0;
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					dist += normal[comp] / len * (static_cast<double>(points[idx].p[comp]) - p0.p[comp]);
+				}
+				if (std::fabs(dist) > best) {
+					best = std::fabs(dist);
+					height = dist;
+					simplex[3] = static_cast<unsigned int>(idx);
+				}
+			}
+			if (simplex[3] == INVALID || best <= hull.eps) {
+				return false;
+			}
+
+			//	底面の法線が四点目と反対を向くよう並べる
+			if (height > 0.0) {
+				std::swap(simplex[1], simplex[2]);
+			}
+			return true;
+		}
+
+		/**	@brief	Quickhull の実行関数
+		 *	@return 体積を持つ凸包を作れた場合は真
+		 *	@note	外側に点を持つ面を追加順に取り出し、最も遠い点から見える面を深さ優先で探して地平線の辺を反時計回りに集め、
+		 *			地平線の辺と点を結ぶ面で置き換える。置き換えた面の外側の点は新しい面へ振り分け直す。
+		 */
+		bool run_hull(SHull& hull, size_t const& count) {
+			unsigned int simplex[4U];
+			if (count < 4U || !pick_simplex(hull, count, simplex)) {
+				return false;
+			}
+			hull.links.assign(count, INVALID);
+			add_face(hull, simplex[0], simplex[1], simplex[2]);
+			add_face(hull, simplex[1], simplex[0], simplex[3]);
+			add_face(hull, simplex[2], simplex[1], simplex[3]);
+			add_face(hull, simplex[0], simplex[2], simplex[3]);
+			for (unsigned int edge = 0U; edge < 12U; ++edge) {
+				unsigned int from = hull.corners[edge];
+				unsigned int to = hull.corners[edge / 3U * 3U + (edge + 1U) % 3U];
+				for (unsigned int other = 0U; other < 12U; ++other) {
+					if (hull.corners[other] == to && hull.corners[other / 3U * 3U + (other + 1U) % 3U] == from) {
+						hull.twins[edge] = other;
+					}
+				}
+			}
+			unsigned int const initial[4U] = { 0U, 1U, 2U, 3U };
+			for (size_t idx = 0U; idx < count; ++idx) {
+				assign(hull, static_cast<unsigned int>(idx), initial, 4U);
+			}
+
+			std::vector<SFrame> stack;
+			std::vector<unsigned int> visible;
+			std::vector<unsigned int> horizon;
+			std::vector<unsigned int> created;
+			unsigned int stamp = 0U;
+			for (unsigned int face = 0U; face < hull.faces.size(); ++face) {
+				if (!hull.faces[face].live || hull.faces[face].head == INVALID) {
+					continue;
+				}
+				unsigned int eye = hull.faces[face].top;
+				CFVector3 const& pos = hull.points[eye];
+
+				//	見える面と地平線の辺
+				++stamp;
+				visible.clear();
+				horizon.clear();
+				hull.marks[face] = stamp;
+				visible.push_back(face);
+				stack.push_back({ face, 0U, 3U });
+				while (!stack.empty()) {
+					SFrame& frame = stack.back();
+					if (frame.remain == 0U) {
+						stack.pop_back();
+						continue;
+					}
+					unsigned int edge = frame.face * 3U + frame.corner;
+					frame.corner = (frame.corner + 1U) % 3U;
+					--frame.remain;
+					unsigned int twin = hull.twins[edge];
+					unsigned int other = twin / 3U;
+					if (hull.marks[other] == stamp) {
+						continue;
+					}
+					double dist = plane_distance(hull.faces[other], pos);
+					if (dist > hull.eps || (dist > -hull.eps && is_concave(hull, edge, twin, eye))) {
+						//	入ってきた辺を除く二辺を続けて調べる
+						hull.marks[other] = stamp;
+						visible.push_back(other);
+						stack.push_back({ other, (twin % 3U + 1U) % 3U, 2U });
+					}
+					else {
+						horizon.push_back(edge);
+					}
+				}
+
+				//	地平線の辺と点を結ぶ面
+				created.clear();
+				for (unsigned int edge : horizon) {
+					unsigned int from = hull.corners[edge];
+					unsigned int to = hull.corners[edge / 3U * 3U + (edge + 1U) % 3U];
+					unsigned int added = add_face(hull, from, to, eye);
+					unsigned int twin = hull.twins[edge];
+					hull.twins[added * 3U] = twin;
+					hull.twins[twin] = added * 3U;
+					created.push_back(added);
+				}
+				for (size_t slot = 0U; slot < created.size(); ++slot) {
+					unsigned int cur = created[slot];
+					unsigned int next = created[(slot + 1U) % created.size()];
+					hull.twins[cur * 3U + 1U] = next * 3U + 2U;
+					hull.twins[next * 3U + 2U] = cur * 3U + 1U;
+				}
+
+				//	見える面を外し、外側の点を振り分け直す
+				for (unsigned int removed : visible) {
+					SFace& dead = hull.faces[removed];
+					dead.live = false;
+					unsigned int idx = dead.head;
+					dead.head = INVALID;
+					while (idx != INVALID) {
+						unsigned int next = hull.links[idx];
+						if (idx != eye) {
+							assign(hull, idx, created.data(), created.size());
+						}
+						idx = next;
+					}
+				}
+			}
+			return true;
+		}
+	}
+
+	CFConvexHull::CFConvexHull() noexcept :
+		m_vertices(),
+		m_indices()
+	{
+	}
+
+	bool const CFConvexHull::build(CFVector3 const* const points, size_t const& count) {
+		clear();
+		CJobSystem& jobs = CJobSystem::getInstance();
+		bool parallel = jobs.concurrency() > 1U && count >= PARALLEL_MIN;
+
+		//	区間毎の凸包の頂点を集める
+		std::vector<CFVector3> merged;
+		if (parallel) {
+			size_t ranges = jobs.concurrency();
+			std::vector<std::vector<CFVector3>> parts(ranges);
+			auto partial = [&](size_t const& from, size_t const& to) {
+				for (size_t range = from; range < to; ++range) {
+					size_t begin = count * range / ranges;
+					size_t span = count * (range + 1U) / ranges - begin;
+					SHull hull;
+					hull.points = points + begin;
+					std::vector<CFVector3>& part = parts[range];
+					if (!run_hull(hull, span)) {
+						part.assign(points + begin, points + begin + span);
+						continue;
+					}
+					std::vector<bool> used(span, false);
+					for (size_t face = 0U; face < hull.faces.size(); ++face) {
+						if (hull.faces[face].live) {
+							for (unsigned int corner = 0U; corner < 3U; ++corner) {
+								used[hull.corners[face * 3U + corner]] = true;
+							}
+						}
+					}
+					for (size_t idx = 0U; idx < span; ++idx) {
+						if (used[idx]) {
+							part.push_back(points[begin + idx]);
+						}
+					}
+				}
+			};
+			jobs.parallel_for(ranges, 1U, partial);
+			for (std::vector<CFVector3> const& part : parts) {
+				merged.insert(merged.end(), part.begin(), part.end());
+			}
+		}
+
+		SHull hull;
+		hull.points = parallel ? merged.data() : points;
+		size_t total = parallel ? merged.size() : count;
+		if (!run_hull(hull, total)) {
+			return false;
+		}
+
+		//	残った面の頂点を詰める
+		std::vector<unsigned int> remap(total, INVALID);
+		for (size_t face = 0U; face < hull.faces.size(); ++face) {
+			if (!hull.faces[face].live) {
+				continue;
+			}
+			for (unsigned int corner = 0U; corner < 3U; ++corner) {
+				unsigned int idx = hull.corners[face * 3U + corner];
+				if (remap[idx] == INVALID) {
+					remap[idx] = static_cast<unsigned int>(m_vertices.size());
+					m_vertices.push_back(hull.points[idx]);
+				}
+				m_indices.push_back(remap[idx]);
+			}
+		}
+		return true;
+	}
+
+	void CFConvexHull::clear() noexcept {
+		m_vertices.clear();
+		m_indices.clear();
+	}
+
+	std::vector<CFVector3> const& CFConvexHull::vertices() const noexcept {
+		return m_vertices;
+	}
+
+	std::vector<unsigned int> const& CFConvexHull::indices() const noexcept {
+		return m_indices;
+	}
+
+	size_t const CFConvexHull::triangles() const noexcept {
+		return m_indices.size() / 3U;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+﻿/**	@file	CFConvexShape.cpp
+ *	@brief	支持写像で表す凸形状
+ */
+#include "geo/CFConvexShape.hpp"
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	CFConvexShape::CFConvexShape() noexcept :
+		m_type(EConvexType::SPHERE),
+		m_center(ZERO_FVT3),
+		m_axes(UNIT_FMTX3x3),
+		m_extent(ZERO_FVT3),
+		m_vertices(),
+		m_margin(0.0f)
+	{}
+
+	CFConvexShape::CFConvexShape(CFSphere3 const& sphere) noexcept :
+		CFConvexShape()
+	{
+		init(sphere);
+	}
+
+	CFConvexShape::CFConvexShape(CFOBB3 const& box) noexcept :
+		CFConvexShape()
+	{
+		init(box);
+	}
+
+	CFConvexShape::CFConvexShape(CLSeg<CFVector3> const& seg, float const& rad) noexcept :
+		CFConvexShape()
+	{
+		init(seg, rad);
+	}
+
+	CFConvexShape::CFConvexShape(CFVector3 const* const vertices, size_t const& count, CFVector3 const& pos, CFMatrix3x3 const& rot) :
+		CFConvexShape()
+	{
+		init(vertices, count, pos, rot);
+	}
+
+	CFConvexShape& CFConvexShape::init(CFSphere3 const& sphere) noexcept {
+		m_type = EConvexType::SPHERE;
+		m_center = sphere.center();
+		m_margin = sphere.radius();
+		return *this;
+	}
+
+	CFConvexShape& CFConvexShape::init(CFOBB3 const& box) noexcept {
+		m_type = EConvexType::BOX;
+		m_center = box.center();
+		m_axes = box.axes();
+		m_extent = box.extent();
+		m_margin = 0.0f;
+		return *this;
+	}
+
+	CFConvexShape& CFConvexShape::init(CLSeg<CFVector3> const& seg, float const& rad) noexcept {
+		m_type = EConvexType::CAPSULE;
+		m_center = (seg.begin + seg.end) * 0.5f;
+		m_extent = (seg.end - seg.begin) * 0.5f;
+		m_margin = rad;
+		return *this;
+	}
+
+	CFConvexShape& CFConvexShape::init(CFVector3 const* const vertices, size_t const& count, CFVector3 const& pos, CFMatrix3x3 const& rot) {
+		m_type = EConvexType::HULL;
+		m_vertices.assign(vertices, vertices + count);
+		m_center = pos;
+		m_axes = rot;
+		m_margin = 0.0f;
+		return *this;
+	}
+
+	CFConvexShape& CFConvexShape::place(CFVector3 const& pos, CFMatrix3x3 const& rot) noexcept {
+		m_center = pos;
+		if (m_type == EConvexType::BOX || m_type == EConvexType::HULL) {
+			m_axes = rot;
+		}
+		return *this;
+	}
+
+	EConvexType const& CFConvexShape::type() const noexcept {
+		return m_type;
+	}
+
+	float const& CFConvexShape::margin() const noexcept {
+		return m_margin;
+	}
+
+	CFVector3 const CFConvexShape::inner() const noexcept {
+		if (m_type != EConvexType::HULL || m_vertices.empty()) {
+			return m_center;
+		}
+		CFVector3 const& local = m_vertices.front();
+		return m_center + m_axes.row(0U) * local.x + m_axes.row(1U) * local.y + m_axes.row(2U) * local.z;
+	}
+
+	CFVector3 const CFConvexShape::core(CFVector3 const& dir) const noexcept {
+		switch (m_type) {
+		case EConvexType::BOX:
+		{
+			CFVector3 result = m_center;
+			for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+				CFVector3 row = m_axes.row(axis);
+				result += row * (dot(row, dir) >= 0.0f ? m_extent.p[axis] : -m_extent.p[axis]);
+			}
+			return result;
+		}
+		case EConvexType::CAPSULE:
+			return dot(m_extent, dir) >= 0.0f ? m_center + m_extent : m_center - m_extent;
+		case EConvexType::HULL:
+		{
+			//	方向を局所座標へ写して頂点を線形に探す
+			CFVector3 local(dot(m_axes.row(0U), dir), dot(m_axes.row(1U), dir), dot(m_axes.row(2U), dir));
+			float best = -FLT_MAX;
+			size_t found = 0U;
+			for (size_t idx = 0U; idx < m_vertices.size(); ++idx) {
+				float proj = dot(m_vertices[idx], local);
+				if (proj > best) {
+					best = proj;
+					found = idx;
+				}
+			}
+			if (m_vertices.empty()) {
+				return m_center;
+			}
+			CFVector3 const& pt = m_vertices[found];
+			return m_center + m_axes.row(0U) * pt.x + m_axes.row(1U) * pt.y + m_axes.row(2U) * pt.z;
+		}
+		default:
+			return m_center;
+		}
+	}
+
+	CFVector3 const CFConvexShape::support(CFVector3 const& dir) const noexcept {
+		CFVector3 result = core(dir);
+		float len = dir.norm();
+		if (m_margin > 0.0f && len > 0.0f) {
+			result += dir * (m_margin / len);
+		}
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,596 @@
+﻿/**	@file	CFMeshSimplifier.cpp
+ *	@brief	二次誤差による辺の縮約を用いたメッシュの簡略化
+ */
+#include "geo/CFMeshSimplifier.hpp"
+#include "util/CJobSystem.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace dlav {
+	namespace {
+		//!	@brief	無効な番号
+		unsigned int constexpr INVALID = 0xFFFFFFFFU;
+		//!	@brief	初期化を並列化する要素数の下限
+		size_t constexpr PARALLEL_MIN = 16384U;
+		//!	@brief	一つのジョブで処理する要素数
+		size_t constexpr GRAIN = 4096U;
+		//!	@brief	ヒープを作り直す候補数の三角形数に対する比
+		size_t constexpr COMPACT_RATIO = 3U;
+		//!	@brief	ヒープを作り直す候補数の下限
+		size_t constexpr COMPACT_MIN = 1024U;
+		//!	@brief	境界の頂点の旗
+		unsigned char constexpr BORDER = 1U;
+		//!	@brief	固定する頂点の旗
+		unsigned char constexpr LOCKED = 2U;
+		//!	@brief	境界の辺に垂直な平面の加重 (辺の長さの二乗に掛ける)
+		double constexpr BORDER_WEIGHT = 10.0;
+		//!	@brief	縮約前後の面の法線の成す角の余弦の下限
+		float constexpr FLIP_COS = 0.25f;
+		//!	@brief	最小点を解く行列式の下限 (対角和の三乗に対する比)
+		double constexpr SINGULAR = 1.0e-9;
+
+		/**	@struct	SPlane
+		 *	@brief	三角形の平面
+		 */
+		struct SPlane {
+			//!	@brief	単位法線
+			double normal[FLT3_CNT];
+			//!	@brief	原点からの距離
+			double offset;
+			//!	@brief	面積
+			double area;
+		};
+
+		//!	@brief	三角形内の次の半辺取得関数
+		unsigned int next_edge(unsigned int const& edge) noexcept {
+			return edge / 3U * 3U + (edge + 1U) % 3U;
+		}
+
+		//!	@brief	三角形内の前の半辺取得関数
+		unsigned int prev_edge(unsigned int const& edge) noexcept {
+			return edge / 3U * 3U + (edge + 2U) % 3U;
+		}
+
+		//!	@brief	二次形式への平面の加算関数
+		void add_plane(double (&q)[10U], double const (&normal)[FLT3_CNT], double const& offset, double const& weight) noexcept {
+			double const plane[4U] = { normal[0], normal[1], normal[2], -offset };
+			unsigned int slot = 0U;
+			for (unsigned int row = 0U; row < 4U; ++row) {
+				for (unsigned int col = row; col < 4U; ++col) {
+					q[slot++] += weight * plane[row] * plane[col];
+				}
+			}
+		}
+
+		//!	@brief	三角形 (pv, pb, pc) の pv を pos へ動かした時に法線が大きく変わるか判定する関数
+		bool flipped(CFVector3 const& pv, CFVector3 const& pb, CFVector3 const& pc, CFVector3 const& pos) noexcept {
+			float before[FLT3_CNT];
+			float after[FLT3_CNT];
+			float ub[FLT3_CNT] = { pb.p[0] - pv.p[0], pb.p[1] - pv.p[1], pb.p[2] - pv.p[2] };
+			float uc[FLT3_CNT] = { pc.p[0] - pv.p[0], pc.p[1] - pv.p[1], pc.p[2] - pv.p[2] };
+			float wb[FLT3_CNT] = { pb.p[0] - pos.p[0], pb.p[1] - pos.p[1], pb.p[2] - pos.p[2] };
+			float wc[FLT3_CNT] = { pc.p[0] - pos.p[0], pc.p[1] - pos.p[1], pc.p[2] - pos.p[2] };
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				unsigned int c1 = (comp + 1U) % FLT3_CNT;
+				unsigned int c2 = (comp + 2U) % FLT3_CNT;
+				before[comp] = ub[c1] * uc[c2] - ub[c2] * uc[c1];
+				after[comp] = wb[c1] * wc[c2] - wb[c2] * wc[c1];
+			}
+			float dp = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+			float lb = before[0] * before[0] + before[1] * before[1] + before[2] * before[2];
+			float la = after[0] * after[0] + after[1] * after[1] + after[2] * after[2];
+			return dp <= FLIP_COS * std::sqrt(lb * la);
+		}
+
+		//!	@brief	二次形式の値取得関数
+		double quadric_error(double const (&q)[10U], CFVector3 const& pos) noexcept {
+			double x = pos.p[0];
+			double y = pos.p[1];
+			double z = pos.p[2];
+			return q[0] * x * x + q[4] * y * y + q[7] * z * z
+				+ 2.0 * (q[1] * x * y + q[2] * x * z + q[5] * y * z)
+				+ 2.0 * (q[3] * x + q[6] * y + q[8] * z) + q[9];
+		}
+	}
+
+	CFMeshSimplifier::CFMeshSimplifier() noexcept :
+		m_positions(),
+		m_quadrics(),
+		m_flags(),
+		m_outgoing(),
+		m_origins(),
+		m_twins(),
+		m_tokens(),
+		m_heap(),
+		m_marks(),
+		m_ring(),
+		m_other(),
+		m_clock(0U),
+		m_live(0U),
+		m_error(0.0f)
+	{
+	}
+
+	void CFMeshSimplifier::init(CFVector3 const* const vertices, size_t const& vertexCount, unsigned int const* const indices, size_t const& count) {
+		clear();
+		m_positions.assign(vertices, vertices + vertexCount);
+		m_origins.assign(indices, indices + count * 3U);
+		m_twins.assign(count * 3U, INVALID);
+		for (size_t tri = 0U; tri < count; ++tri) {
+			unsigned int* corner = &m_origins[tri * 3U];
+			if (corner[0] == corner[1] || corner[1] == corner[2] || corner[2] == corner[0]
+				|| corner[0] >= vertexCount || corner[1] >= vertexCount || corner[2] >= vertexCount) {
+				std::fill(corner, corner + 3U, INVALID);
+				continue;
+			}
+			++m_live;
+		}
+
+		//	両端の頂点番号で整列して反対向きの半辺を対にする (三つ以上共有する辺や向きの揃った辺は両端を固定する)
+		m_flags.assign(vertexCount, 0U);
+		std::vector<std::pair<unsigned long long, unsigned int>> keys;
+		keys.reserve(m_live * 3U);
+		for (unsigned int edge = 0U; edge < m_origins.size(); ++edge) {
+			if (m_origins[edge] != INVALID) {
+				unsigned long long from = m_origins[edge];
+				unsigned long long to = m_origins[next_edge(edge)];
+				keys.emplace_back(std::min(from, to) << 32U | std::max(from, to), edge);
+			}
+		}
+		std::sort(keys.begin(), keys.end());
+		for (size_t begin = 0U, end = 0U; begin < keys.size(); begin = end) {
+			while (end < keys.size() && keys[end].first == keys[begin].first) {
+				++end;
+			}
+			unsigned int first = keys[begin].second;
+			if (end - begin == 2U && m_origins[first] != m_origins[keys[begin + 1U].second]) {
+				unsigned int second = keys[begin + 1U].second;
+				m_twins[first] = second;
+				m_twins[second] = first;
+			}
+			else if (end - begin >= 2U) {
+				m_flags[m_origins[first]] |= LOCKED;
+				m_flags[m_origins[next_edge(first)]] |= LOCKED;
+			}
+		}
+		m_outgoing.assign(vertexCount, INVALID);
+		std::vector<unsigned int> degrees(vertexCount, 0U);
+		for (unsigned int edge = 0U; edge < m_origins.size(); ++edge) {
+			if (m_origins[edge] != INVALID) {
+				m_outgoing[m_origins[edge]] = edge;
+				++degrees[m_origins[edge]];
+			}
+		}
+
+		CJobSystem& jobs = CJobSystem::getInstance();
+		bool parallel = jobs.concurrency() > 1U && count >= PARALLEL_MIN;
+		auto dispatch = [&](size_t const& total, auto const& func) {
+			if (parallel) {
+				jobs.parallel_for(total, GRAIN, func);
+			}
+			else {
+				func(0U, total);
+			}
+		};
+
+		//	三角形の平面
+		std::vector<SPlane> planes(count);
+		dispatch(count, [&](size_t const& from, size_t const& to) {
+			for (size_t tri = from; tri < to; ++tri) {
+				if (m_origins[tri * 3U] == INVALID) {
+					continue;
+				}
+				CFVector3 const& pa = m_positions[m_origins[tri * 3U]];
+				CFVector3 const& pb = m_positions[m_origins[tri * 3U + 1U]];
+				CFVector3 const& pc = m_positions[m_origins[tri * 3U + 2U]];
+				double ab[FLT3_CNT];
+				double ac[FLT3_CNT];
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					ab[comp] = static_cast<double>(pb.p[comp]) - pa.p[comp];
+					ac[comp] = static_cast<double>(pc.p[comp]) - pa.p[comp];
+				}
+				SPlane& plane = planes[tri];
+				plane.normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+				plane.normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+				plane.normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+				double len = std::sqrt(plane.normal[0] * plane.normal[0] + plane.normal[1] * plane.normal[1] + plane.normal[2] * plane.normal[2]);
+				double inv = len > 0.0 ? 1.0 / len : 0.0;
+				plane.offset = 0.0;
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					plane.normal[comp] *= inv;
+					plane.offset += plane.normal[comp] * pa.p[comp];
+				}
+				plane.area = len * 0.5;
+			}
+		});
+
+		//	頂点毎に周囲の面と境界の辺から二次形式を集める (周囲の面を辿れない非多様体の頂点は固定する)
+		m_quadrics.resize(vertexCount);
+		dispatch(vertexCount, [&](size_t const& from, size_t const& to) {
+			std::vector<unsigned int> ring;
+			for (size_t vtx = from; vtx < to; ++vtx) {
+				SQuadric& quadric = m_quadrics[vtx];
+				std::fill(quadric.q, quadric.q + 10U, 0.0);
+				quadric.weight = 0.0;
+				gather(static_cast<unsigned int>(vtx), ring);
+				if (ring.size() != degrees[vtx]) {
+					m_flags[vtx] |= LOCKED;
+				}
+				for (unsigned int edge : ring) {
+					SPlane const& plane = planes[edge / 3U];
+					add_plane(quadric.q, plane.normal, plane.offset, plane.area);
+					quadric.weight += plane.area;
+					unsigned int const sides[2U] = { edge, prev_edge(edge) };
+					for (unsigned int side : sides) {
+						if (m_twins[side] != INVALID) {
+							continue;
+						}
+						m_flags[vtx] |= BORDER;
+						CFVector3 const& pa = m_positions[m_origins[side]];
+						CFVector3 const& pb = m_positions[m_origins[next_edge(side)]];
+						double dir[FLT3_CNT];
+						for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+							dir[comp] = static_cast<double>(pb.p[comp]) - pa.p[comp];
+						}
+						double normal[FLT3_CNT] = {
+							dir[1] * plane.normal[2] - dir[2] * plane.normal[1],
+							dir[2] * plane.normal[0] - dir[0] * plane.normal[2],
+							dir[0] * plane.normal[1] - dir[1] * plane.normal[0]
+						};
+						double len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+						if (len <= 0.0) {
+							continue;
+						}
+						double offset = 0.0;
+						for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+							normal[comp] /= len;
+							offset += normal[comp] * pa.p[comp];
+						}
+						double weight = BORDER_WEIGHT * len * len;
+						add_plane(quadric.q, normal, offset, weight);
+						quadric.weight += weight;
+					}
+				}
+			}
+		});
+
+		m_tokens.assign(m_origins.size(), 0U);
+		m_marks.assign(vertexCount, 0U);
+
+		//	辺毎に一つの半辺を候補とする
+		std::vector<SCandidate> candidates(m_origins.size());
+		dispatch(m_origins.size(), [&](size_t const& from, size_t const& to) {
+			for (size_t idx = from; idx < to; ++idx) {
+				unsigned int edge = static_cast<unsigned int>(idx);
+				SCandidate& candidate = candidates[idx];
+				candidate.edge = INVALID;
+				if (m_origins[edge] == INVALID || (m_twins[edge] != INVALID && m_twins[edge] < edge)) {
+					continue;
+				}
+				unsigned int head = m_origins[edge];
+				unsigned int tail = m_origins[next_edge(edge)];
+				if (((m_flags[head] | m_flags[tail]) & LOCKED) != 0U) {
+					continue;
+				}
+				CFVector3 pos;
+				candidate.cost = evaluate(edge, pos);
+				candidate.edge = edge;
+				candidate.token = 0U;
+			}
+		});
+		for (SCandidate const& candidate : candidates) {
+			if (candidate.edge != INVALID) {
+				m_heap.push_back(candidate);
+			}
+		}
+		std::make_heap(m_heap.begin(), m_heap.end(), [](SCandidate const& lhs, SCandidate const& rhs) {
+			return lhs.cost > rhs.cost;
+		});
+	}
+
+	size_t const CFMeshSimplifier::simplify(size_t const& target, float const& maxError) {
+		auto later = [](SCandidate const& lhs, SCandidate const& rhs) {
+			return lhs.cost > rhs.cost;
+		};
+		float limit = maxError * maxError;
+		while (m_live > target && !m_heap.empty()) {
+			if (m_heap.front().cost > limit) {
+				break;
+			}
+			std::pop_heap(m_heap.begin(), m_heap.end(), later);
+			SCandidate candidate = m_heap.back();
+			m_heap.pop_back();
+
+			//	消えた三角形の半辺や、追加後に振り直された辺の候補は捨てる
+			unsigned int edge = candidate.edge;
+			if (m_tokens[edge] != candidate.token) {
+				continue;
+			}
+			CFVector3 pos;
+			evaluate(edge, pos);
+			if (!collapsible(edge, pos)) {
+				continue;
+			}
+			collapse(edge, pos);
+			m_error = std::max(m_error, candidate.cost);
+
+			//	古い候補が溜まったらまとめて除き、ヒープを作り直す
+			if (m_heap.size() > m_live * COMPACT_RATIO + COMPACT_MIN) {
+				auto stale = [this](SCandidate const& entry) {
+					return m_tokens[entry.edge] != entry.token;
+				};
+				m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(), stale), m_heap.end());
+				std::make_heap(m_heap.begin(), m_heap.end(), later);
+			}
+		}
+		return m_live;
+	}
+
+	void CFMeshSimplifier::extract(std::vector<CFVector3>& vertices, std::vector<unsigned int>& indices) const {
+		vertices.clear();
+		indices.clear();
+		indices.reserve(m_live * 3U);
+		std::vector<unsigned int> remap(m_positions.size(), INVALID);
+		for (unsigned int origin : m_origins) {
+			if (origin == INVALID) {
+				continue;
+			}
+			if (remap[origin] == INVALID) {
+				remap[origin] = static_cast<unsigned int>(vertices.size());
+				vertices.push_back(m_positions[origin]);
+			}
+			indices.push_back(remap[origin]);
+		}
+	}
+
+	void CFMeshSimplifier::clear() noexcept {
+		m_positions.clear();
+		m_quadrics.clear();
+		m_flags.clear();
+		m_outgoing.clear();
+		m_origins.clear();
+		m_twins.clear();
+		m_tokens.clear();
+		m_heap.clear();
+		m_marks.clear();
+		m_clock = 0U;
+		m_live = 0U;
+		m_error = 0.0f;
+	}
+
+	size_t const CFMeshSimplifier::triangles() const noexcept {
+		return m_live;
+	}
+
+	float const CFMeshSimplifier::error() const noexcept {
+		return std::sqrt(m_error);
+	}
+
+	void CFMeshSimplifier::gather(unsigned int const& vertex, std::vector<unsigned int>& ring) const {
+		//	一方向に回り、境界に当たれば始めの半辺から逆方向にも回る
+		ring.clear();
+		unsigned int start = m_outgoing[vertex];
+		if (start == INVALID) {
+			return;
+		}
+		unsigned int edge = start;
+		do {
+			ring.push_back(edge);
+			edge = m_twins[prev_edge(edge)];
+		} while (edge != INVALID && edge != start);
+		if (edge == INVALID) {
+			edge = start;
+			while (m_twins[edge] != INVALID) {
+				edge = next_edge(m_twins[edge]);
+				ring.push_back(edge);
+			}
+		}
+	}
+
+	float const CFMeshSimplifier::evaluate(unsigned int const& edge, CFVector3& pos) const noexcept {
+		unsigned int from = m_origins[edge];
+		unsigned int to = m_origins[next_edge(edge)];
+		SQuadric const& qa = m_quadrics[from];
+		SQuadric const& qb = m_quadrics[to];
+		double q[10U];
+		for (unsigned int slot = 0U; slot < 10U; ++slot) {
+			q[slot] = qa.q[slot] + qb.q[slot];
+		}
+		double weight = qa.weight + qb.weight;
+		CFVector3 const& pa = m_positions[from];
+		CFVector3 const& pb = m_positions[to];
+		bool borderA = (m_flags[from] & BORDER) != 0U;
+		bool borderB = (m_flags[to] & BORDER) != 0U;
+
+		if (borderA != borderB) {
+			//	境界を内側へ崩さないよう境界の頂点へ寄せる
+			pos = borderA ? pa : pb;
+		}
+		else {
+			//	二次形式の最小点 (行列が退化しているか、辺から離れ過ぎる場合は両端と中点から選ぶ)
+			double c00 = q[4] * q[7] - q[5] * q[5];
+			double c01 = q[2] * q[5] - q[1] * q[7];
+			double c02 = q[1] * q[5] - q[2] * q[4];
+			double det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+			double trace = q[0] + q[4] + q[7];
+			bool solved = false;
+			if (std::fabs(det) > SINGULAR * trace * trace * trace) {
+				double c11 = q[0] * q[7] - q[2] * q[2];
+				double c12 = q[1] * q[2] - q[0] * q[5];
+				double c22 = q[0] * q[4] - q[1] * q[1];
+				double inv = -1.0 / det;
+				CFVector3 opt(
+					static_cast<float>(inv * (c00 * q[3] + c01 * q[6] + c02 * q[8])),
+					static_cast<float>(inv * (c01 * q[3] + c11 * q[6] + c12 * q[8])),
+					static_cast<float>(inv * (c02 * q[3] + c12 * q[6] + c22 * q[8]))
+				);
+				if ((opt - (pa + pb) * 0.5f).sqnorm() <= (pb - pa).sqnorm()) {
+					pos = opt;
+					solved = true;
+				}
+			}
+			if (!solved) {
+				CFVector3 const options[3U] = { pa, pb, (pa + pb) * 0.5f };
+				double best = DBL_MAX;
+				for (CFVector3 const& option : options) {
+					double value = quadric_error(q, option);
+					if (value < best) {
+						best = value;
+						pos = option;
+					}
+				}
+			}
+		}
+		double cost = std::max(quadric_error(q, pos), 0.0) / std::max(weight, DBL_MIN);
+		return static_cast<float>(cost);
+	}
+
+	bool const CFMeshSimplifier::collapsible(unsigned int const& edge, CFVector3 const& pos) {
+		unsigned int from = m_origins[edge];
+		unsigned int to = m_origins[next_edge(edge)];
+		unsigned int opposite = m_twins[edge];
+		if (((m_flags[from] | m_flags[to]) & LOCKED) != 0U) {
+			return false;
+		}
+		if ((m_flags[from] & m_flags[to] & BORDER) != 0U && opposite != INVALID) {
+			//	境界を結ぶ内部の辺は縮約すると境界が閉じる
+			return false;
+		}
+		unsigned int const sides[2U] = { edge, opposite };
+		for (unsigned int side : sides) {
+			if (side != INVALID && (m_flags[m_origins[prev_edge(side)]] & LOCKED) != 0U) {
+				return false;
+			}
+		}
+
+		//	共通の隣接頂点は辺の両側の面の頂点のみに限る
+		gather(from, m_ring);
+		gather(to, m_other);
+		unsigned int mark = ++m_clock;
+		for (unsigned int ring_edge : m_ring) {
+			m_marks[m_origins[next_edge(ring_edge)]] = mark;
+			m_marks[m_origins[prev_edge(ring_edge)]] = mark;
+		}
+		unsigned int seen = ++m_clock;
+		unsigned int shared = 0U;
+		for (unsigned int ring_edge : m_other) {
+			unsigned int const neighbors[2U] = { m_origins[next_edge(ring_edge)], m_origins[prev_edge(ring_edge)] };
+			for (unsigned int neighbor : neighbors) {
+				if (m_marks[neighbor] == mark) {
+					m_marks[neighbor] = seen;
+					++shared;
+				}
+			}
+		}
+		if (shared != (opposite == INVALID ? 1U : 2U)) {
+			return false;
+		}
+
+		//	残る面の法線が大きく変わる縮約は行わない
+		std::pair<std::vector<unsigned int> const*, unsigned int> const fans[2U] = { { &m_ring, to }, { &m_other, from } };
+		for (auto const& fan : fans) {
+			for (unsigned int ring_edge : *fan.first) {
+				unsigned int vb = m_origins[next_edge(ring_edge)];
+				unsigned int vc = m_origins[prev_edge(ring_edge)];
+				if (vb == fan.second || vc == fan.second) {
+					continue;
+				}
+				if (flipped(m_positions[m_origins[ring_edge]], m_positions[vb], m_positions[vc], pos)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void CFMeshSimplifier::collapse(unsigned int const& edge, CFVector3 const& pos) {
+		unsigned int from = m_origins[edge];
+		unsigned int to = m_origins[next_edge(edge)];
+
+		//	辺の両側の面を消し、残る二辺を対にする
+		unsigned int const sides[2U] = { edge, m_twins[edge] };
+		for (unsigned int side : sides) {
+			if (side == INVALID) {
+				continue;
+			}
+			unsigned int after = m_twins[next_edge(side)];
+			unsigned int before = m_twins[prev_edge(side)];
+			unsigned int apex = m_origins[prev_edge(side)];
+			if (after != INVALID) {
+				m_twins[after] = before;
+			}
+			if (before != INVALID) {
+				m_twins[before] = after;
+			}
+			if ((after == INVALID) != (before == INVALID)) {
+				m_flags[apex] |= BORDER;
+				m_flags[from] |= BORDER;
+			}
+			if (m_outgoing[apex] / 3U == side / 3U) {
+				m_outgoing[apex] = after != INVALID ? after : (before != INVALID ? next_edge(before) : INVALID);
+			}
+			for (unsigned int slot = side / 3U * 3U; slot < side / 3U * 3U + 3U; ++slot) {
+				m_origins[slot] = INVALID;
+				++m_tokens[slot];
+			}
+			--m_live;
+		}
+
+		//	消す頂点を始点とする半辺を残す頂点へ付け替える
+		for (unsigned int ring_edge : m_other) {
+			if (m_origins[ring_edge] != INVALID) {
+				m_origins[ring_edge] = from;
+			}
+		}
+		m_outgoing[from] = INVALID;
+		std::vector<unsigned int> const* const fans[2U] = { &m_ring, &m_other };
+		for (std::vector<unsigned int> const* fan : fans) {
+			for (unsigned int ring_edge : *fan) {
+				if (m_outgoing[from] == INVALID && m_origins[ring_edge] != INVALID) {
+					m_outgoing[from] = ring_edge;
+				}
+			}
+		}
+		m_outgoing[to] = INVALID;
+		m_positions[from] = pos;
+		SQuadric& quadric = m_quadrics[from];
+		for (unsigned int slot = 0U; slot < 10U; ++slot) {
+			quadric.q[slot] += m_quadrics[to].q[slot];
+		}
+		quadric.weight += m_quadrics[to].weight;
+		m_flags[from] |= m_flags[to];
+
+		//	残る頂点の周りの辺を振り直す (境界では入ってくる半辺も加える)
+		gather(from, m_ring);
+		for (unsigned int ring_edge : m_ring) {
+			push(ring_edge);
+			unsigned int incoming = prev_edge(ring_edge);
+			if (m_twins[incoming] == INVALID) {
+				push(incoming);
+			}
+		}
+	}
+
+	void CFMeshSimplifier::push(unsigned int const& edge) {
+		unsigned int from = m_origins[edge];
+		unsigned int to = m_origins[next_edge(edge)];
+		if (((m_flags[from] | m_flags[to]) & LOCKED) != 0U) {
+			return;
+		}
+		//	反対向きの半辺で追加した候補も捨てる
+		if (m_twins[edge] != INVALID) {
+			++m_tokens[m_twins[edge]];
+		}
+		CFVector3 pos;
+		SCandidate candidate;
+		candidate.cost = evaluate(edge, pos);
+		candidate.edge = edge;
+		candidate.token = ++m_tokens[edge];
+		m_heap.push_back(candidate);
+		std::push_heap(m_heap.begin(), m_heap.end(), [](SCandidate const& lhs, SCandidate const& rhs) {
+			return lhs.cost > rhs.cost;
+		});
+	}
+}
\ No newline at end of file
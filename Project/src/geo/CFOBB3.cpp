@@ -0,0 +1,158 @@
+﻿/**	@file	CFOBB3.cpp
+ *	@brief	三次元有向境界箱
+ */
+#include "geo/CFOBB3.hpp"
+#include "geo/CFAABB3.hpp"
+#include "math/FMathUtil.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	平行な軸の外積が零になる事への余裕
+		float constexpr PARALLEL_EPSILON = 1.0e-6f;
+	}
+
+	CFOBB3::CFOBB3() noexcept :
+		m_center(ZERO_FVT3),
+		m_axes(UNIT_FMTX3x3),
+		m_extent(ZERO_FVT3)
+	{}
+
+	CFOBB3::CFOBB3(CFVector3 const& pos, CFMatrix3x3 const& rot, CFVector3 const& ext) noexcept :
+		m_center(pos),
+		m_axes(rot),
+		m_extent(ext)
+	{}
+
+	CFOBB3::CFOBB3(CFAABB3 const& box) noexcept :
+		m_center(box.center()),
+		m_axes(UNIT_FMTX3x3),
+		m_extent(box.extent())
+	{}
+
+	CFOBB3& CFOBB3::init(CFVector3 const& pos, CFMatrix3x3 const& rot, CFVector3 const& ext) noexcept {
+		m_center = pos;
+		m_axes = rot;
+		m_extent = ext;
+		return *this;
+	}
+
+	CFVector3 const& CFOBB3::center() const noexcept {
+		return m_center;
+	}
+
+	CFMatrix3x3 const& CFOBB3::axes() const noexcept {
+		return m_axes;
+	}
+
+	CFVector3 const& CFOBB3::extent() const noexcept {
+		return m_extent;
+	}
+
+	CFAABB3 const CFOBB3::bounds() const noexcept {
+		// 世界軸方向の半径は各軸の成分の絶対値と半径の積和
+		CFVector3 ext = ZERO_FVT3;
+		for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				ext.p[comp] += fabsf(m_axes.p[axis * FLT3_CNT + comp]) * m_extent.p[axis];
+			}
+		}
+		return CFAABB3(m_center - ext, m_center + ext);
+	}
+
+	CFOBB3& CFOBB3::merge(CFOBB3 const& box) noexcept {
+		float lo[FLT3_CNT] = {};
+		float hi[FLT3_CNT] = {};
+		CFVector3 d = box.m_center - m_center;
+		for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+			CFVector3 dir = m_axes.row(axis);
+			float c = dot(dir, d);
+			float r = 0.0f;
+			for (unsigned int other = 0U; other < FLT3_CNT; ++other) {
+				r += fabsf(dot(dir, box.m_axes.row(other))) * box.m_extent.p[other];
+			}
+			lo[axis] = std::min(-m_extent.p[axis], c - r);
+			hi[axis] = std::max(m_extent.p[axis], c + r);
+		}
+		for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+			m_center += m_axes.row(axis) * ((lo[axis] + hi[axis]) * 0.5f);
+			m_extent.p[axis] = (hi[axis] - lo[axis]) * 0.5f;
+		}
+		return *this;
+	}
+
+	CFOBB3 const CFOBB3::transform(EHandSide const& hs, CFMatrix4x4 const& mtx) const noexcept {
+		CFMatrix3x3 linear = makeLinear(hs, mtx);
+		CFVector3 pos = makeOffset(hs, mtx);
+		CFMatrix3x3 rot = m_axes;
+		CFVector3 ext = m_extent;
+		for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+			CFVector3 src = m_axes.row(axis);
+			CFVector3 dst = ZERO_FVT3;
+			for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+				dst.p[row] = dot(linear.row(row), src);
+				pos.p[row] += linear.p[row * FLT3_CNT + axis] * m_center.p[axis];
+			}
+			float len = sqrtf(dst.sqnorm());
+			rot.row(axis, len > FLT_EPSILON ? dst / len : src);
+			ext.p[axis] *= len;
+		}
+		return CFOBB3(pos, rot, ext);
+	}
+
+	bool const CFOBB3::contains(CFVector3 const& pt) const noexcept {
+		CFVector3 d = pt - m_center;
+		for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+			if (fabsf(dot(m_axes.row(axis), d)) > m_extent.p[axis]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool const CFOBB3::overlaps(CFOBB3 const& box) const noexcept {
+		// 自身の軸を基底とした空間で相手の軸 r[i][j] と中心差 t を表し、十五の分離軸を調べる
+		float r[FLT3_CNT][FLT3_CNT];
+		float ar[FLT3_CNT][FLT3_CNT];
+		float t[FLT3_CNT];
+		CFVector3 d = box.m_center - m_center;
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			CFVector3 axis = m_axes.row(i);
+			for (unsigned int j = 0U; j < FLT3_CNT; ++j) {
+				r[i][j] = dot(axis, box.m_axes.row(j));
+				ar[i][j] = fabsf(r[i][j]) + PARALLEL_EPSILON;
+			}
+			t[i] = dot(axis, d);
+		}
+
+		float const* ea = m_extent.p;
+		float const* eb = box.m_extent.p;
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			if (fabsf(t[i]) > ea[i] + eb[0] * ar[i][0] + eb[1] * ar[i][1] + eb[2] * ar[i][2]) {
+				return false;
+			}
+		}
+		for (unsigned int j = 0U; j < FLT3_CNT; ++j) {
+			float dist = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+			if (fabsf(dist) > ea[0] * ar[0][j] + ea[1] * ar[1][j] + ea[2] * ar[2][j] + eb[j]) {
+				return false;
+			}
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			unsigned int i1 = (i + 1U) % FLT3_CNT;
+			unsigned int i2 = (i + 2U) % FLT3_CNT;
+			for (unsigned int j = 0U; j < FLT3_CNT; ++j) {
+				unsigned int j1 = (j + 1U) % FLT3_CNT;
+				unsigned int j2 = (j + 2U) % FLT3_CNT;
+				float dist = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+				float rad = ea[i1] * ar[i2][j] + ea[i2] * ar[i1][j] + eb[j1] * ar[i][j2] + eb[j2] * ar[i][j1];
+				if (fabsf(dist) > rad) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
\ No newline at end of file
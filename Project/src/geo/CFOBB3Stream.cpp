@@ -0,0 +1,225 @@
+﻿/**	@file	CFOBB3Stream.cpp
+ *	@brief	三次元有向境界箱のストリーム
+ */
+#include "geo/CFOBB3Stream.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "math/FMathUtil.hpp"
+#include <immintrin.h>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	平行な軸の外積が零になる事への余裕
+		float constexpr PARALLEL_EPSILON = 1.0e-6f;
+	}
+
+	CFOBB3Stream::CFOBB3Stream() noexcept :
+		m_count(0U),
+		m_comps()
+	{}
+
+	CFOBB3Stream& CFOBB3Stream::init(size_t const& count) {
+		m_count = count;
+		for (auto& comp : m_comps) {
+			comp.assign((count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT, 0.0f);
+		}
+		return *this;
+	}
+
+	size_t const CFOBB3Stream::size() const noexcept {
+		return m_count;
+	}
+
+	float* const CFOBB3Stream::data(unsigned int const& comp) noexcept {
+		return m_comps[comp].data();
+	}
+
+	float const* const CFOBB3Stream::data(unsigned int const& comp) const noexcept {
+		return m_comps[comp].data();
+	}
+
+	void CFOBB3Stream::set(size_t const& idx, CFOBB3 const& arg) noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			m_comps[CENTER_COMP + comp][idx] = arg.center().p[comp];
+			m_comps[EXTENT_COMP + comp][idx] = arg.extent().p[comp];
+		}
+		for (unsigned int elem = 0U; elem < FLT3x3_CNT; ++elem) {
+			m_comps[AXES_COMP + elem][idx] = arg.axes().p[elem];
+		}
+	}
+
+	CFOBB3 const CFOBB3Stream::get(size_t const& idx) const noexcept {
+		CFMatrix3x3 rot = UNIT_FMTX3x3;
+		for (unsigned int elem = 0U; elem < FLT3x3_CNT; ++elem) {
+			rot.p[elem] = m_comps[AXES_COMP + elem][idx];
+		}
+		return CFOBB3(
+			CFVector3(m_comps[CENTER_COMP][idx], m_comps[CENTER_COMP + 1U][idx], m_comps[CENTER_COMP + 2U][idx]),
+			rot,
+			CFVector3(m_comps[EXTENT_COMP][idx], m_comps[EXTENT_COMP + 1U][idx], m_comps[EXTENT_COMP + 2U][idx])
+		);
+	}
+
+	void CFOBB3Stream::transform(EHandSide const& hs, CFMatrix4x4 const& mtx, CFOBB3Stream& dst) const {
+		if (dst.m_count != m_count) {
+			dst.init(m_count);
+		}
+
+		CFMatrix3x3 linear = makeLinear(hs, mtx);
+		CFVector3 offset = makeOffset(hs, mtx);
+		__m256 l[FLT3x3_CNT];
+		for (unsigned int elem = 0U; elem < FLT3x3_CNT; ++elem) {
+			l[elem] = _mm256_set1_ps(linear.p[elem]);
+		}
+		__m256 const one = _mm256_set1_ps(1.0f);
+		__m256 const eps = _mm256_set1_ps(FLT_EPSILON);
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 c[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				c[comp] = _mm256_loadu_ps(&m_comps[CENTER_COMP + comp][idx]);
+			}
+			for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+				__m256 const* lr = &l[row * FLT3_CNT];
+				__m256 nc = _mm256_fmadd_ps(lr[0], c[0], _mm256_fmadd_ps(lr[1], c[1], _mm256_fmadd_ps(lr[2], c[2], _mm256_set1_ps(offset.p[row]))));
+				_mm256_storeu_ps(&dst.m_comps[CENTER_COMP + row][idx], nc);
+			}
+
+			// 各軸を変換し、その長さを半径へ移して正規化する
+			for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+				__m256 src[FLT3_CNT];
+				__m256 vec[FLT3_CNT];
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					src[comp] = _mm256_loadu_ps(&m_comps[AXES_COMP + axis * FLT3_CNT + comp][idx]);
+				}
+				for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+					__m256 const* lr = &l[row * FLT3_CNT];
+					vec[row] = _mm256_fmadd_ps(lr[0], src[0], _mm256_fmadd_ps(lr[1], src[1], _mm256_mul_ps(lr[2], src[2])));
+				}
+				__m256 len = _mm256_sqrt_ps(_mm256_fmadd_ps(vec[0], vec[0], _mm256_fmadd_ps(vec[1], vec[1], _mm256_mul_ps(vec[2], vec[2]))));
+				__m256 valid = _mm256_cmp_ps(len, eps, _CMP_GT_OQ);
+				__m256 inv = _mm256_div_ps(one, _mm256_blendv_ps(one, len, valid));
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					_mm256_storeu_ps(&dst.m_comps[AXES_COMP + axis * FLT3_CNT + comp][idx], _mm256_blendv_ps(src[comp], _mm256_mul_ps(vec[comp], inv), valid));
+				}
+				_mm256_storeu_ps(&dst.m_comps[EXTENT_COMP + axis][idx], _mm256_mul_ps(_mm256_loadu_ps(&m_comps[EXTENT_COMP + axis][idx]), len));
+			}
+		}
+	}
+
+	CFAABB3 const CFOBB3Stream::bounds() const noexcept {
+		__m256 lo[FLT3_CNT];
+		__m256 hi[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			lo[comp] = _mm256_set1_ps(FLT_MAX);
+			hi[comp] = _mm256_set1_ps(-FLT_MAX);
+		}
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 valid = tailMask(m_count - idx);
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				// 世界軸方向の半径は各軸の成分の絶対値と半径の積和
+				__m256 ext = _mm256_setzero_ps();
+				for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+					__m256 a = laneAbs(_mm256_loadu_ps(&m_comps[AXES_COMP + axis * FLT3_CNT + comp][idx]));
+					ext = _mm256_fmadd_ps(a, _mm256_loadu_ps(&m_comps[EXTENT_COMP + axis][idx]), ext);
+				}
+				__m256 c = _mm256_loadu_ps(&m_comps[CENTER_COMP + comp][idx]);
+				lo[comp] = _mm256_blendv_ps(lo[comp], _mm256_min_ps(lo[comp], _mm256_sub_ps(c, ext)), valid);
+				hi[comp] = _mm256_blendv_ps(hi[comp], _mm256_max_ps(hi[comp], _mm256_add_ps(c, ext)), valid);
+			}
+		}
+
+		return CFAABB3(
+			CFVector3(laneMin(lo[0]), laneMin(lo[1]), laneMin(lo[2])),
+			CFVector3(laneMax(hi[0]), laneMax(hi[1]), laneMax(hi[2]))
+		);
+	}
+
+	size_t const CFOBB3Stream::contains(CFVector3 const& pt, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		__m256 p[FLT3_CNT] = { _mm256_set1_ps(pt.x), _mm256_set1_ps(pt.y), _mm256_set1_ps(pt.z) };
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 d[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				d[comp] = _mm256_sub_ps(p[comp], _mm256_loadu_ps(&m_comps[CENTER_COMP + comp][idx]));
+			}
+			__m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+				__m256 proj = _mm256_mul_ps(_mm256_loadu_ps(&m_comps[AXES_COMP + axis * FLT3_CNT][idx]), d[0]);
+				proj = _mm256_fmadd_ps(_mm256_loadu_ps(&m_comps[AXES_COMP + axis * FLT3_CNT + 1U][idx]), d[1], proj);
+				proj = _mm256_fmadd_ps(_mm256_loadu_ps(&m_comps[AXES_COMP + axis * FLT3_CNT + 2U][idx]), d[2], proj);
+				mask = _mm256_and_ps(mask, _mm256_cmp_ps(laneAbs(proj), _mm256_loadu_ps(&m_comps[EXTENT_COMP + axis][idx]), _CMP_LE_OQ));
+			}
+			collectHits(hits, idx, m_count, mask);
+		}
+		return hits.size();
+	}
+
+	size_t const CFOBB3Stream::overlaps(CFOBB3 const& box, std::vector<unsigned int>& hits) const {
+		// 各要素 A の軸を基底として、問い合わせる箱 B の軸 r[i][j] と中心差 t を表し十五の分離軸を調べる
+		hits.clear();
+		__m256 bc[FLT3_CNT];
+		__m256 bx[FLT3_CNT][FLT3_CNT];
+		__m256 eb[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			bc[comp] = _mm256_set1_ps(box.center().p[comp]);
+			eb[comp] = _mm256_set1_ps(box.extent().p[comp]);
+			for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+				bx[axis][comp] = _mm256_set1_ps(box.axes().p[axis * FLT3_CNT + comp]);
+			}
+		}
+		__m256 const eps = _mm256_set1_ps(PARALLEL_EPSILON);
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 ax[FLT3_CNT][FLT3_CNT];
+			__m256 ea[FLT3_CNT];
+			__m256 d[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				d[comp] = _mm256_sub_ps(bc[comp], _mm256_loadu_ps(&m_comps[CENTER_COMP + comp][idx]));
+				ea[comp] = _mm256_loadu_ps(&m_comps[EXTENT_COMP + comp][idx]);
+				for (unsigned int axis = 0U; axis < FLT3_CNT; ++axis) {
+					ax[axis][comp] = _mm256_loadu_ps(&m_comps[AXES_COMP + axis * FLT3_CNT + comp][idx]);
+				}
+			}
+
+			__m256 r[FLT3_CNT][FLT3_CNT];
+			__m256 ar[FLT3_CNT][FLT3_CNT];
+			__m256 t[FLT3_CNT];
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				for (unsigned int j = 0U; j < FLT3_CNT; ++j) {
+					r[i][j] = _mm256_fmadd_ps(ax[i][0], bx[j][0], _mm256_fmadd_ps(ax[i][1], bx[j][1], _mm256_mul_ps(ax[i][2], bx[j][2])));
+					ar[i][j] = _mm256_add_ps(laneAbs(r[i][j]), eps);
+				}
+				t[i] = _mm256_fmadd_ps(ax[i][0], d[0], _mm256_fmadd_ps(ax[i][1], d[1], _mm256_mul_ps(ax[i][2], d[2])));
+			}
+
+			// 分離軸が一つでも見つかれば交差しない
+			__m256 sep = _mm256_setzero_ps();
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				__m256 rad = _mm256_fmadd_ps(eb[0], ar[i][0], _mm256_fmadd_ps(eb[1], ar[i][1], _mm256_fmadd_ps(eb[2], ar[i][2], ea[i])));
+				sep = _mm256_or_ps(sep, _mm256_cmp_ps(laneAbs(t[i]), rad, _CMP_GT_OQ));
+			}
+			for (unsigned int j = 0U; j < FLT3_CNT; ++j) {
+				__m256 dist = _mm256_fmadd_ps(t[0], r[0][j], _mm256_fmadd_ps(t[1], r[1][j], _mm256_mul_ps(t[2], r[2][j])));
+				__m256 rad = _mm256_fmadd_ps(ea[0], ar[0][j], _mm256_fmadd_ps(ea[1], ar[1][j], _mm256_fmadd_ps(ea[2], ar[2][j], eb[j])));
+				sep = _mm256_or_ps(sep, _mm256_cmp_ps(laneAbs(dist), rad, _CMP_GT_OQ));
+			}
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				unsigned int i1 = (i + 1U) % FLT3_CNT;
+				unsigned int i2 = (i + 2U) % FLT3_CNT;
+				for (unsigned int j = 0U; j < FLT3_CNT; ++j) {
+					unsigned int j1 = (j + 1U) % FLT3_CNT;
+					unsigned int j2 = (j + 2U) % FLT3_CNT;
+					__m256 dist = _mm256_fmsub_ps(t[i2], r[i1][j], _mm256_mul_ps(t[i1], r[i2][j]));
+					__m256 rad = _mm256_fmadd_ps(ea[i1], ar[i2][j], _mm256_fmadd_ps(ea[i2], ar[i1][j],
+						_mm256_fmadd_ps(eb[j1], ar[i][j2], _mm256_mul_ps(eb[j2], ar[i][j1]))));
+					sep = _mm256_or_ps(sep, _mm256_cmp_ps(laneAbs(dist), rad, _CMP_GT_OQ));
+				}
+			}
+			collectHits(hits, idx, m_count, _mm256_xor_ps(sep, _mm256_castsi256_ps(_mm256_set1_epi32(-1))));
+		}
+		return hits.size();
+	}
+}
\ No newline at end of file
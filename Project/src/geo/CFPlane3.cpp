@@ -2,6 +2,7 @@
  *	@brief	三次元平面方程式
  */
 #include "geo/CFPlane3.hpp"
+#include <cmath>
 #include <memory>
 
 namespace dlav {
@@ -16,11 +17,37 @@ namespace dlav {
 		vt21 = pt1 - pt2;
 		vt23 = pt3 - pt2;
 
-		n = cross(vt21, vt23);
-		t = (vt21 + vt23);
+		n = cross(vt21, vt23).normalize();
+		t = (vt21 + vt23).normalize();
 		b = cross(n, t);
 
-		m_value = -n.norm();
+		m_value = -dot(n, pt2);
+
+		m_mtx.row(0U, t);
+		m_mtx.row(1U, b);
+		m_mtx.row(2U, n);
+
+		return *this;
+	}
+
+	CFPlane3& CFPlane3::init(CFVector3 const& nor, float const& value) noexcept {
+		float norm = nor.norm();
+		if (!(norm > 0.0f)) {
+			// 法線が無い平面 (無限遠の後方平面など) は距離が常に value となる
+			m_mtx.row(0U, CFVector3(1.0f, 0.0f, 0.0f));
+			m_mtx.row(1U, CFVector3(0.0f, 1.0f, 0.0f));
+			m_mtx.row(2U, ZERO_FVT3);
+			m_value = value;
+			return *this;
+		}
+		CFVector3 n = nor / norm;
+
+		// 法線と最も直交に近い軸から接ベクトルを作る
+		CFVector3 axis = fabsf(n.x) < 0.5f ? CFVector3(1.0f, 0.0f, 0.0f) : CFVector3(0.0f, 1.0f, 0.0f);
+		CFVector3 b = cross(n, axis).normalize();
+		CFVector3 t = cross(b, n);
+
+		m_value = value / norm;
 
 		m_mtx.row(0U, t);
 		m_mtx.row(1U, b);
@@ -55,4 +82,8 @@ namespace dlav {
     float const CFPlane3::getDValue() const noexcept {
 		return m_value;
 	}
+
+	float const CFPlane3::distance(CFVector3 const& pt) const noexcept {
+		return dot(normal(), pt) + m_value;
+	}
 }
\ No newline at end of file
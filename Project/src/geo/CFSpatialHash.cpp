@@ -0,0 +1,457 @@
+﻿/**	@file	CFSpatialHash.cpp
+ *	@brief	一様格子の空間ハッシュ
+ */
+#include "geo/CFSpatialHash.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "util/CJobSystem.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace dlav {
+	namespace {
+		//!	@brief	バケット数の下限
+		size_t constexpr BUCKET_MIN = 16U;
+		//!	@brief	構築を並列化する要素数の下限
+		size_t constexpr PARALLEL_MIN = 65536U;
+		//!	@brief	一つのジョブで処理する要素数
+		size_t constexpr GRAIN = 16384U;
+		//!	@brief	並列構築でバケットを分ける区分けの数の上限
+		size_t constexpr PART_CNT = 1024U;
+		//!	@brief	重複を除くバケット番号をスタックに置く格子数の上限
+		size_t constexpr CELL_STACK = 64U;
+		//!	@brief	格子座標の絶対値の上限 (桁溢れを防ぐ)
+		float constexpr QUANT_LIMIT = 1073741824.0f;
+		//!	@brief	格子座標の x 成分に掛ける素数
+		unsigned int constexpr PRIME_X = 73856093U;
+		//!	@brief	格子座標の y 成分に掛ける素数
+		unsigned int constexpr PRIME_Y = 19349663U;
+		//!	@brief	格子座標の z 成分に掛ける素数
+		unsigned int constexpr PRIME_Z = 83492791U;
+
+		//!	@brief	マスクの立った要素の番号の追加関数
+		void push_ids(std::vector<unsigned int>& hits, unsigned int const* const ids, __m256 const& mask) {
+			unsigned int bits = static_cast<unsigned int>(_mm256_movemask_ps(mask));
+			while (bits != 0U) {
+				hits.push_back(ids[_tzcnt_u32(bits)]);
+				bits &= bits - 1U;
+			}
+		}
+
+		/**	@brief	格子の範囲に含まれるバケットの走査関数
+		 *	@param[in] hash 格子座標からバケット番号への変換
+		 *	@param[in] func バケット順の配列上の範囲 [begin, end) を受け取る関数
+		 *	@note	衝突で同じバケットを二度走査しないよう、バケット番号を整列して重複を除く。
+		 *			格子数がバケット数以上なら全要素を一度に渡す。
+		 */
+		template<typename H, typename F>
+		void visit_cells(int const (&lo)[FLT3_CNT], int const (&hi)[FLT3_CNT], std::vector<unsigned int> const& starts, H const& hash, F const& func) {
+			size_t buckets = starts.size() - 1U;
+			long long cells = 1;
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				cells *= static_cast<long long>(hi[comp]) - static_cast<long long>(lo[comp]) + 1;
+				if (cells >= static_cast<long long>(buckets)) {
+					func(0U, starts.back());
+					return;
+				}
+			}
+			unsigned int stack[CELL_STACK];
+			std::vector<unsigned int> heap;
+			unsigned int* ids = stack;
+			if (static_cast<size_t>(cells) > CELL_STACK) {
+				heap.resize(static_cast<size_t>(cells));
+				ids = heap.data();
+			}
+			unsigned int* last = ids;
+			for (int ix = lo[0]; ix <= hi[0]; ++ix) {
+				for (int iy = lo[1]; iy <= hi[1]; ++iy) {
+					for (int iz = lo[2]; iz <= hi[2]; ++iz) {
+						*last++ = hash(ix, iy, iz);
+					}
+				}
+			}
+			std::sort(ids, last);
+			last = std::unique(ids, last);
+			for (unsigned int const* it = ids; it != last; ++it) {
+				if (starts[*it] != starts[*it + 1U]) {
+					func(starts[*it], starts[*it + 1U]);
+				}
+			}
+		}
+	}
+
+	CFSpatialHash::CFSpatialHash() noexcept :
+		m_starts(),
+		m_keys(),
+		m_xs(),
+		m_ys(),
+		m_zs(),
+		m_ids(),
+		m_bounds(),
+		m_cell(1.0f),
+		m_inv(1.0f),
+		m_mask(0U),
+		m_count(0U)
+	{}
+
+	void CFSpatialHash::build(CFVector3 const* const positions, size_t const& count, float const& cell) {
+		m_cell = cell;
+		m_inv = 1.0f / cell;
+		if (count == 0U) {
+			clear();
+			return;
+		}
+		//	整列の為に CFVector3 は成分数より大きい
+		float const* base = positions[0].p;
+		build_stride(base, base + 1, base + 2, sizeof(CFVector3) / sizeof(float), count);
+	}
+
+	void CFSpatialHash::build(CFVector3Stream const& positions, float const& cell) {
+		m_cell = cell;
+		m_inv = 1.0f / cell;
+		build_stride(positions.data(0U), positions.data(1U), positions.data(2U), 1U, positions.size());
+	}
+
+	void CFSpatialHash::clear() noexcept {
+		m_starts.clear();
+		m_keys.clear();
+		m_xs.clear();
+		m_ys.clear();
+		m_zs.clear();
+		m_ids.clear();
+		m_bounds = CFAABB3();
+		m_mask = 0U;
+		m_count = 0U;
+	}
+
+	size_t const CFSpatialHash::size() const noexcept {
+		return m_count;
+	}
+
+	float const& CFSpatialHash::cell() const noexcept {
+		return m_cell;
+	}
+
+	CFAABB3 const& CFSpatialHash::bounds() const noexcept {
+		return m_bounds;
+	}
+
+	void CFSpatialHash::query(CFSphere3 const& sphere, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		if (m_count == 0U || sphere.empty()) {
+			return;
+		}
+		CFVector3 const& center = sphere.center();
+		float rad = sphere.radius();
+		int lo[FLT3_CNT];
+		int hi[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			lo[comp] = std::max(quantize(center.p[comp] - rad), quantize(m_bounds.lower().p[comp]));
+			hi[comp] = std::min(quantize(center.p[comp] + rad), quantize(m_bounds.upper().p[comp]));
+			if (lo[comp] > hi[comp]) {
+				return;
+			}
+		}
+		__m256 cx = _mm256_set1_ps(center.p[0]);
+		__m256 cy = _mm256_set1_ps(center.p[1]);
+		__m256 cz = _mm256_set1_ps(center.p[2]);
+		__m256 r2 = _mm256_set1_ps(rad * rad);
+		auto hash = [this](int const& ix, int const& iy, int const& iz) { return bucket(ix, iy, iz); };
+		visit_cells(lo, hi, m_starts, hash, [&](size_t const& begin, size_t const& end) {
+			for (size_t off = begin; off < end; off += BATCH_LANE_CNT) {
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&m_xs[off]), cx);
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&m_ys[off]), cy);
+				__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&m_zs[off]), cz);
+				__m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+				push_ids(hits, &m_ids[off], _mm256_and_ps(_mm256_cmp_ps(d2, r2, _CMP_LE_OQ), tailMask(end - off)));
+			}
+		});
+	}
+
+	void CFSpatialHash::query(CFAABB3 const& box, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		if (m_count == 0U || box.empty()) {
+			return;
+		}
+		int lo[FLT3_CNT];
+		int hi[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			lo[comp] = std::max(quantize(box.lower().p[comp]), quantize(m_bounds.lower().p[comp]));
+			hi[comp] = std::min(quantize(box.upper().p[comp]), quantize(m_bounds.upper().p[comp]));
+			if (lo[comp] > hi[comp]) {
+				return;
+			}
+		}
+		__m256 lx = _mm256_set1_ps(box.lower().p[0]);
+		__m256 ly = _mm256_set1_ps(box.lower().p[1]);
+		__m256 lz = _mm256_set1_ps(box.lower().p[2]);
+		__m256 ux = _mm256_set1_ps(box.upper().p[0]);
+		__m256 uy = _mm256_set1_ps(box.upper().p[1]);
+		__m256 uz = _mm256_set1_ps(box.upper().p[2]);
+		auto hash = [this](int const& ix, int const& iy, int const& iz) { return bucket(ix, iy, iz); };
+		visit_cells(lo, hi, m_starts, hash, [&](size_t const& begin, size_t const& end) {
+			for (size_t off = begin; off < end; off += BATCH_LANE_CNT) {
+				__m256 x = _mm256_loadu_ps(&m_xs[off]);
+				__m256 y = _mm256_loadu_ps(&m_ys[off]);
+				__m256 z = _mm256_loadu_ps(&m_zs[off]);
+				__m256 mask = _mm256_and_ps(_mm256_cmp_ps(x, lx, _CMP_GE_OQ), _mm256_cmp_ps(x, ux, _CMP_LE_OQ));
+				mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(y, ly, _CMP_GE_OQ), _mm256_cmp_ps(y, uy, _CMP_LE_OQ)));
+				mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(z, lz, _CMP_GE_OQ), _mm256_cmp_ps(z, uz, _CMP_LE_OQ)));
+				push_ids(hits, &m_ids[off], _mm256_and_ps(mask, tailMask(end - off)));
+			}
+		});
+	}
+
+	void CFSpatialHash::nearest(CFVector3 const& pos, unsigned int const& k, std::vector<unsigned int>& ids) const {
+		ids.clear();
+		if (m_count == 0U || k == 0U) {
+			return;
+		}
+		int center[FLT3_CNT];
+		int lo[FLT3_CNT];
+		int hi[FLT3_CNT];
+		int rings = 0;
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			center[comp] = quantize(pos.p[comp]);
+			lo[comp] = quantize(m_bounds.lower().p[comp]);
+			hi[comp] = quantize(m_bounds.upper().p[comp]);
+			rings = std::max(rings, std::max(center[comp] - lo[comp], hi[comp] - center[comp]));
+		}
+
+		//	距離の二乗と要素番号の組の最大ヒープ (同距離は番号の小さい方を優先する)
+		using SCandidate = std::pair<float, unsigned int>;
+		std::vector<SCandidate> best;
+		best.reserve(k);
+		float bound = FLT_MAX;
+		__m256 px = _mm256_set1_ps(pos.p[0]);
+		__m256 py = _mm256_set1_ps(pos.p[1]);
+		__m256 pz = _mm256_set1_ps(pos.p[2]);
+		auto scan = [&](size_t const& begin, size_t const& end) {
+			alignas(32) float dists[BATCH_LANE_CNT];
+			for (size_t off = begin; off < end; off += BATCH_LANE_CNT) {
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&m_xs[off]), px);
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&m_ys[off]), py);
+				__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&m_zs[off]), pz);
+				__m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+				__m256 mask = _mm256_and_ps(_mm256_cmp_ps(d2, _mm256_set1_ps(bound), _CMP_LE_OQ), tailMask(end - off));
+				unsigned int bits = static_cast<unsigned int>(_mm256_movemask_ps(mask));
+				if (bits == 0U) {
+					continue;
+				}
+				_mm256_store_ps(dists, d2);
+				while (bits != 0U) {
+					unsigned int lane = _tzcnt_u32(bits);
+					bits &= bits - 1U;
+					SCandidate cand(dists[lane], m_ids[off + lane]);
+					if (best.size() == k && !(cand < best.front())) {
+						continue;
+					}
+					//	衝突で同じ要素を再び走査した場合は既に候補にある
+					if (std::find(best.begin(), best.end(), cand) != best.end()) {
+						continue;
+					}
+					if (best.size() == k) {
+						std::pop_heap(best.begin(), best.end());
+						best.pop_back();
+					}
+					best.push_back(cand);
+					std::push_heap(best.begin(), best.end());
+					if (best.size() == k) {
+						bound = best.front().first;
+					}
+				}
+			}
+		};
+
+		size_t buckets = m_starts.size() - 1U;
+		for (int ring = 0; ring <= rings; ++ring) {
+			long long shell = 24LL * ring * ring + 2LL;
+			if (ring == 0 || shell < static_cast<long long>(buckets)) {
+				int from[FLT3_CNT];
+				int to[FLT3_CNT];
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					from[comp] = std::max(center[comp] - ring, lo[comp]);
+					to[comp] = std::min(center[comp] + ring, hi[comp]);
+				}
+				for (int ix = from[0]; ix <= to[0]; ++ix) {
+					for (int iy = from[1]; iy <= to[1]; ++iy) {
+						//	外殻上の格子のみを走査する (x, y が内側なら z は両端のみ)
+						bool edge = std::abs(ix - center[0]) == ring || std::abs(iy - center[1]) == ring;
+						int step = edge || ring == 0 ? 1 : 2 * ring;
+						for (int iz = center[2] - ring; iz <= center[2] + ring; iz += step) {
+							if (iz < from[2] || iz > to[2]) {
+								continue;
+							}
+							unsigned int idx = bucket(ix, iy, iz);
+							if (m_starts[idx] != m_starts[idx + 1U]) {
+								scan(m_starts[idx], m_starts[idx + 1U]);
+							}
+						}
+					}
+				}
+			}
+			else {
+				//	外殻の格子数がバケット数を超えたら残りを全要素の走査で済ませる
+				scan(0U, m_count);
+				break;
+			}
+			if (best.size() == k) {
+				//	走査済みの格子の立方体の外にある要素までの距離の下限
+				float gap = FLT_MAX;
+				for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+					float lower = static_cast<float>(center[comp] - ring) * m_cell;
+					float upper = static_cast<float>(center[comp] + ring + 1) * m_cell;
+					gap = std::min(gap, std::min(pos.p[comp] - lower, upper - pos.p[comp]));
+				}
+				if (gap > 0.0f && gap * gap >= bound) {
+					break;
+				}
+			}
+		}
+		std::sort_heap(best.begin(), best.end());
+		ids.reserve(best.size());
+		for (SCandidate const& cand : best) {
+			ids.push_back(cand.second);
+		}
+	}
+
+	void CFSpatialHash::build_stride(float const* const xs, float const* const ys, float const* const zs, size_t const& stride, size_t const& count) {
+		m_count = count;
+		size_t buckets = BUCKET_MIN;
+		while (buckets < count) {
+			buckets <<= 1U;
+		}
+		m_mask = static_cast<unsigned int>(buckets - 1U);
+		m_starts.resize(buckets + 1U);
+		m_starts[0] = 0U;
+		m_keys.resize(count);
+		m_xs.resize(count + BATCH_LANE_CNT);
+		m_ys.resize(count + BATCH_LANE_CNT);
+		m_zs.resize(count + BATCH_LANE_CNT);
+		m_ids.resize(count + BATCH_LANE_CNT);
+
+		CJobSystem& jobs = CJobSystem::getInstance();
+		bool parallel = jobs.concurrency() > 1U && count >= PARALLEL_MIN;
+
+		//	バケットを上位ビットで区分けする (区分け毎のバケットは連続し、m_starts の重ならない範囲を使う)
+		size_t chunks = parallel ? (count + GRAIN - 1U) / GRAIN : 1U;
+		size_t parts = parallel ? std::min(buckets, PART_CNT) : 1U;
+		unsigned int shift = 0U;
+		while ((parts << shift) < buckets) {
+			++shift;
+		}
+		unsigned int span = 1U << shift;
+
+		//	バケット番号と境界箱と区分け毎の要素数を要素の区間毎に求める
+		std::vector<CFAABB3> boxes(chunks);
+		std::vector<unsigned int> tallies(parallel ? chunks * parts : 0U, 0U);
+		auto keys = [&](size_t const& from, size_t const& to) {
+			size_t chunk = parallel ? from / GRAIN : 0U;
+			unsigned int* tally = parallel ? &tallies[chunk * parts] : nullptr;
+			CFAABB3 box;
+			for (size_t idx = from; idx < to; ++idx) {
+				CFVector3 pos(xs[idx * stride], ys[idx * stride], zs[idx * stride]);
+				unsigned int key = bucket(quantize(pos.p[0]), quantize(pos.p[1]), quantize(pos.p[2]));
+				m_keys[idx] = key;
+				if (tally != nullptr) {
+					++tally[key >> shift];
+				}
+				box.merge(pos);
+			}
+			boxes[chunk] = box;
+		};
+		if (parallel) {
+			jobs.parallel_for(count, GRAIN, keys);
+		}
+		else {
+			keys(0U, count);
+		}
+		m_bounds = CFAABB3();
+		for (CFAABB3 const& box : boxes) {
+			m_bounds.merge(box);
+		}
+
+		//	(区分け, 区間) の順に累積して区分けの先頭位置と区間毎の書き込み位置を求め、要素番号を区分け順に並べる
+		//	(同じ区分け内は区間順かつ区間内は要素番号順となる)
+		std::vector<unsigned int> heads(parts + 1U);
+		std::vector<unsigned int> order;
+		if (parallel) {
+			unsigned int sum = 0U;
+			for (size_t part = 0U; part < parts; ++part) {
+				heads[part] = sum;
+				for (size_t chunk = 0U; chunk < chunks; ++chunk) {
+					unsigned int num = tallies[chunk * parts + part];
+					tallies[chunk * parts + part] = sum;
+					sum += num;
+				}
+			}
+			heads[parts] = sum;
+			order.resize(count);
+			jobs.parallel_for(count, GRAIN, [&](size_t const& from, size_t const& to) {
+				unsigned int* cursor = &tallies[from / GRAIN * parts];
+				for (size_t idx = from; idx < to; ++idx) {
+					order[cursor[m_keys[idx] >> shift]++] = static_cast<unsigned int>(idx);
+				}
+			});
+		}
+		else {
+			heads[0] = 0U;
+			heads[1] = static_cast<unsigned int>(count);
+		}
+
+		//	区分け毎にバケットを数えて先頭位置を求め、要素番号順に位置と番号を書き込む
+		//	(m_starts[b + 1] をバケット b の書き込み位置とし、書き込み後はバケット b + 1 の先頭位置となる)
+		auto place = [&](size_t const& from, size_t const& to) {
+			for (size_t part = from; part < to; ++part) {
+				unsigned int first = static_cast<unsigned int>(part) << shift;
+				unsigned int* cursors = &m_starts[first + 1U];
+				std::fill(cursors, cursors + span, 0U);
+				for (unsigned int pos = heads[part]; pos < heads[part + 1U]; ++pos) {
+					unsigned int idx = order.empty() ? pos : order[pos];
+					++cursors[m_keys[idx] - first];
+				}
+				unsigned int sum = heads[part];
+				for (unsigned int key = 0U; key < span; ++key) {
+					unsigned int num = cursors[key];
+					cursors[key] = sum;
+					sum += num;
+				}
+				for (unsigned int pos = heads[part]; pos < heads[part + 1U]; ++pos) {
+					unsigned int idx = order.empty() ? pos : order[pos];
+					unsigned int slot = cursors[m_keys[idx] - first]++;
+					m_xs[slot] = xs[idx * stride];
+					m_ys[slot] = ys[idx * stride];
+					m_zs[slot] = zs[idx * stride];
+					m_ids[slot] = idx;
+				}
+			}
+		};
+		if (parallel) {
+			jobs.parallel_for(parts, 1U, place);
+		}
+		else {
+			place(0U, parts);
+		}
+		std::fill(m_xs.begin() + count, m_xs.end(), 0.0f);
+		std::fill(m_ys.begin() + count, m_ys.end(), 0.0f);
+		std::fill(m_zs.begin() + count, m_zs.end(), 0.0f);
+		std::fill(m_ids.begin() + count, m_ids.end(), 0U);
+	}
+
+	int const CFSpatialHash::quantize(float const& value) const noexcept {
+		//	NaN は下限へ寄せる
+		float pos = std::min(std::max(-QUANT_LIMIT, value * m_inv), QUANT_LIMIT);
+		return static_cast<int>(std::floor(pos));
+	}
+
+	unsigned int const CFSpatialHash::bucket(int const& ix, int const& iy, int const& iz) const noexcept {
+		unsigned int hash = (static_cast<unsigned int>(ix) * PRIME_X) ^ (static_cast<unsigned int>(iy) * PRIME_Y) ^ (static_cast<unsigned int>(iz) * PRIME_Z);
+		//	下位ビットへ上位ビットを混ぜる
+		hash ^= hash >> 16U;
+		hash *= 0x7FEB352DU;
+		hash ^= hash >> 15U;
+		return hash & m_mask;
+	}
+}
\ No newline at end of file
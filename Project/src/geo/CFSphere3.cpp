@@ -0,0 +1,106 @@
+﻿/**	@file	CFSphere3.cpp
+ *	@brief	三次元境界球
+ */
+#include "geo/CFSphere3.hpp"
+#include "geo/CFAABB3.hpp"
+#include "math/FMathUtil.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dlav {
+	CFSphere3::CFSphere3() noexcept :
+		m_center(ZERO_FVT3),
+		m_radius(-1.0f)
+	{}
+
+	CFSphere3::CFSphere3(CFVector3 const& pos, float const& rad) noexcept :
+		m_center(pos),
+		m_radius(rad)
+	{}
+
+	CFSphere3& CFSphere3::init(CFVector3 const& pos, float const& rad) noexcept {
+		m_center = pos;
+		m_radius = rad;
+		return *this;
+	}
+
+	CFVector3 const& CFSphere3::center() const noexcept {
+		return m_center;
+	}
+
+	float const& CFSphere3::radius() const noexcept {
+		return m_radius;
+	}
+
+	bool const CFSphere3::empty() const noexcept {
+		return m_radius < 0.0f;
+	}
+
+	CFAABB3 const CFSphere3::bounds() const noexcept {
+		CFVector3 ext(m_radius, m_radius, m_radius);
+		return CFAABB3(m_center - ext, m_center + ext);
+	}
+
+	CFSphere3& CFSphere3::merge(CFVector3 const& pt) noexcept {
+		return merge(CFSphere3(pt, 0.0f));
+	}
+
+	CFSphere3& CFSphere3::merge(CFSphere3 const& sphere) noexcept {
+		if (sphere.empty()) {
+			return *this;
+		}
+		if (empty()) {
+			return *this = sphere;
+		}
+
+		CFVector3 d = sphere.m_center - m_center;
+		float dist = sqrtf(d.sqnorm());
+		if (dist + sphere.m_radius <= m_radius) {
+			return *this;
+		}
+		if (dist + m_radius <= sphere.m_radius) {
+			return *this = sphere;
+		}
+
+		// 二つの球の最遠点を結ぶ線分を直径とする
+		float rad = (dist + m_radius + sphere.m_radius) * 0.5f;
+		m_center += d * ((rad - m_radius) / dist);
+		m_radius = rad;
+		return *this;
+	}
+
+	CFSphere3 const CFSphere3::transform(EHandSide const& hs, CFMatrix4x4 const& mtx) const noexcept {
+		// 空の球は半径を掛けると空でなくなる事がある為、そのまま返す
+		if (empty()) {
+			return *this;
+		}
+		CFMatrix3x3 linear = makeLinear(hs, mtx);
+		CFVector3 pos = makeOffset(hs, mtx);
+		for (unsigned int col = 0U; col < FLT3_CNT; ++col) {
+			CFVector3 axis = linear.column(col);
+			for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+				pos.p[row] += axis.p[row] * m_center.p[col];
+			}
+		}
+		return CFSphere3(pos, m_radius * linearScale(linear));
+	}
+
+	bool const CFSphere3::contains(CFVector3 const& pt) const noexcept {
+		if (empty()) {
+			return false;
+		}
+		return (pt - m_center).sqnorm() <= m_radius * m_radius;
+	}
+
+	bool const CFSphere3::overlaps(CFSphere3 const& sphere) const noexcept {
+		if (empty() || sphere.empty()) {
+			return false;
+		}
+		float rad = m_radius + sphere.m_radius;
+		return (sphere.m_center - m_center).sqnorm() <= rad * rad;
+	}
+
+	bool const CFSphere3::overlaps(CFAABB3 const& box) const noexcept {
+		return box.overlaps(*this);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+﻿/**	@file	CFSphere3Stream.cpp
+ *	@brief	三次元境界球のストリーム
+ */
+#include "geo/CFSphere3Stream.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "math/FMathUtil.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	CFSphere3Stream::CFSphere3Stream() noexcept :
+		m_count(0U),
+		m_comps()
+	{}
+
+	CFSphere3Stream& CFSphere3Stream::init(size_t const& count) {
+		m_count = count;
+		for (auto& comp : m_comps) {
+			comp.assign((count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT, 0.0f);
+		}
+		return *this;
+	}
+
+	size_t const CFSphere3Stream::size() const noexcept {
+		return m_count;
+	}
+
+	float* const CFSphere3Stream::data(unsigned int const& comp) noexcept {
+		return m_comps[comp].data();
+	}
+
+	float const* const CFSphere3Stream::data(unsigned int const& comp) const noexcept {
+		return m_comps[comp].data();
+	}
+
+	void CFSphere3Stream::set(size_t const& idx, CFSphere3 const& arg) noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			m_comps[comp][idx] = arg.center().p[comp];
+		}
+		m_comps[FLT3_CNT][idx] = arg.radius();
+	}
+
+	CFSphere3 const CFSphere3Stream::get(size_t const& idx) const noexcept {
+		return CFSphere3(CFVector3(m_comps[0][idx], m_comps[1][idx], m_comps[2][idx]), m_comps[FLT3_CNT][idx]);
+	}
+
+	void CFSphere3Stream::transform(EHandSide const& hs, CFMatrix4x4 const& mtx, CFSphere3Stream& dst) const {
+		if (dst.m_count != m_count) {
+			dst.init(m_count);
+		}
+
+		CFMatrix3x3 linear = makeLinear(hs, mtx);
+		CFVector3 offset = makeOffset(hs, mtx);
+		__m256 l[FLT3x3_CNT];
+		for (unsigned int elem = 0U; elem < FLT3x3_CNT; ++elem) {
+			l[elem] = _mm256_set1_ps(linear.p[elem]);
+		}
+		__m256 factor = _mm256_set1_ps(linearScale(linear));
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 c[FLT3_CNT];
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				c[comp] = _mm256_loadu_ps(&m_comps[comp][idx]);
+			}
+			for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+				__m256 const* lr = &l[row * FLT3_CNT];
+				__m256 nc = _mm256_fmadd_ps(lr[0], c[0], _mm256_fmadd_ps(lr[1], c[1], _mm256_fmadd_ps(lr[2], c[2], _mm256_set1_ps(offset.p[row]))));
+				_mm256_storeu_ps(&dst.m_comps[row][idx], nc);
+			}
+			// 空 (半径が負) の要素は半径をそのまま残す
+			__m256 r = _mm256_loadu_ps(&m_comps[FLT3_CNT][idx]);
+			_mm256_storeu_ps(&dst.m_comps[FLT3_CNT][idx], _mm256_blendv_ps(_mm256_mul_ps(r, factor), r, r));
+		}
+	}
+
+	CFAABB3 const CFSphere3Stream::bounds() const noexcept {
+		__m256 lo[FLT3_CNT];
+		__m256 hi[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			lo[comp] = _mm256_set1_ps(FLT_MAX);
+			hi[comp] = _mm256_set1_ps(-FLT_MAX);
+		}
+
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 valid = tailMask(m_count - idx);
+			__m256 r = _mm256_loadu_ps(&m_comps[FLT3_CNT][idx]);
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 c = _mm256_loadu_ps(&m_comps[comp][idx]);
+				lo[comp] = _mm256_blendv_ps(lo[comp], _mm256_min_ps(lo[comp], _mm256_sub_ps(c, r)), valid);
+				hi[comp] = _mm256_blendv_ps(hi[comp], _mm256_max_ps(hi[comp], _mm256_add_ps(c, r)), valid);
+			}
+		}
+
+		return CFAABB3(
+			CFVector3(laneMin(lo[0]), laneMin(lo[1]), laneMin(lo[2])),
+			CFVector3(laneMax(hi[0]), laneMax(hi[1]), laneMax(hi[2]))
+		);
+	}
+
+	CFSphere3 const CFSphere3Stream::merged() const noexcept {
+		if (m_count == 0U) {
+			return CFSphere3();
+		}
+
+		CFVector3 pos = bounds().center();
+		__m256 p[FLT3_CNT] = { _mm256_set1_ps(pos.x), _mm256_set1_ps(pos.y), _mm256_set1_ps(pos.z) };
+		__m256 rad = _mm256_setzero_ps();
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 sq = _mm256_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 d = _mm256_sub_ps(_mm256_loadu_ps(&m_comps[comp][idx]), p[comp]);
+				sq = _mm256_fmadd_ps(d, d, sq);
+			}
+			__m256 reach = _mm256_add_ps(_mm256_sqrt_ps(sq), _mm256_loadu_ps(&m_comps[FLT3_CNT][idx]));
+			rad = _mm256_blendv_ps(rad, _mm256_max_ps(rad, reach), tailMask(m_count - idx));
+		}
+		return CFSphere3(pos, laneMax(rad));
+	}
+
+	size_t const CFSphere3Stream::contains(CFVector3 const& pt, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		__m256 p[FLT3_CNT] = { _mm256_set1_ps(pt.x), _mm256_set1_ps(pt.y), _mm256_set1_ps(pt.z) };
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 sq = _mm256_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 d = _mm256_sub_ps(p[comp], _mm256_loadu_ps(&m_comps[comp][idx]));
+				sq = _mm256_fmadd_ps(d, d, sq);
+			}
+			__m256 r = _mm256_loadu_ps(&m_comps[FLT3_CNT][idx]);
+			__m256 hit = _mm256_cmp_ps(sq, _mm256_mul_ps(r, r), _CMP_LE_OQ);
+			collectHits(hits, idx, m_count, _mm256_and_ps(hit, _mm256_cmp_ps(r, _mm256_setzero_ps(), _CMP_GE_OQ)));
+		}
+		return hits.size();
+	}
+
+	size_t const CFSphere3Stream::overlaps(CFSphere3 const& sphere, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		if (sphere.empty()) {
+			return 0U;
+		}
+		CFVector3 const& sc = sphere.center();
+		__m256 p[FLT3_CNT] = { _mm256_set1_ps(sc.x), _mm256_set1_ps(sc.y), _mm256_set1_ps(sc.z) };
+		__m256 sr = _mm256_set1_ps(sphere.radius());
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			__m256 sq = _mm256_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 d = _mm256_sub_ps(p[comp], _mm256_loadu_ps(&m_comps[comp][idx]));
+				sq = _mm256_fmadd_ps(d, d, sq);
+			}
+			__m256 own = _mm256_loadu_ps(&m_comps[FLT3_CNT][idx]);
+			__m256 r = _mm256_add_ps(sr, own);
+			__m256 hit = _mm256_cmp_ps(sq, _mm256_mul_ps(r, r), _CMP_LE_OQ);
+			collectHits(hits, idx, m_count, _mm256_and_ps(hit, _mm256_cmp_ps(own, _mm256_setzero_ps(), _CMP_GE_OQ)));
+		}
+		return hits.size();
+	}
+
+	size_t const CFSphere3Stream::overlaps(CFAABB3 const& box, std::vector<unsigned int>& hits) const {
+		hits.clear();
+		__m256 lo[FLT3_CNT] = { _mm256_set1_ps(box.lower().x), _mm256_set1_ps(box.lower().y), _mm256_set1_ps(box.lower().z) };
+		__m256 hi[FLT3_CNT] = { _mm256_set1_ps(box.upper().x), _mm256_set1_ps(box.upper().y), _mm256_set1_ps(box.upper().z) };
+		for (size_t idx = 0U; idx < m_count; idx += LANE_CNT) {
+			// 箱の中で球の中心に最も近い点までの距離の二乗を求める
+			__m256 sq = _mm256_setzero_ps();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 c = _mm256_loadu_ps(&m_comps[comp][idx]);
+				__m256 d = _mm256_sub_ps(c, _mm256_min_ps(_mm256_max_ps(c, lo[comp]), hi[comp]));
+				sq = _mm256_fmadd_ps(d, d, sq);
+			}
+			__m256 r = _mm256_loadu_ps(&m_comps[FLT3_CNT][idx]);
+			__m256 hit = _mm256_cmp_ps(sq, _mm256_mul_ps(r, r), _CMP_LE_OQ);
+			collectHits(hits, idx, m_count, _mm256_and_ps(hit, _mm256_cmp_ps(r, _mm256_setzero_ps(), _CMP_GE_OQ)));
+		}
+		return hits.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+﻿/**	@file	CFSweepAndPrune.cpp
+ *	@brief	掃引と刈り込みによる衝突候補の検出
+ */
+#include "geo/CFSweepAndPrune.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "util/CJobSystem.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <utility>
+
+namespace dlav {
+	namespace {
+		//!	@brief	掃引を並列化する要素数の下限
+		size_t constexpr PARALLEL_MIN = 4096U;
+		//!	@brief	並列度に対する掃引の区間数の倍率 (重なりの偏りを均す)
+		size_t constexpr CHUNK_SCALE = 4U;
+		//!	@brief	要素数に対する挿入ソートの交換回数の上限の倍率
+		size_t constexpr SWAP_BUDGET = 16U;
+		//!	@brief	軸を切り替える分散の比
+		double constexpr AXIS_HYSTERESIS = 1.25;
+
+		//!	@brief	最小値と要素番号の辞書順の比較関数 (同値でも順序を一意にする)
+		bool const before(float const& lhs, unsigned int const& lid, float const& rhs, unsigned int const& rid) noexcept {
+			return lhs < rhs || (lhs == rhs && lid < rid);
+		}
+
+		/**	@brief	上限付きの挿入ソート関数
+		 *	@return 交換回数が上限内で並べ終えた場合は真
+		 */
+		bool const insertion_sort(std::vector<float>& keys, std::vector<unsigned int>& ids, size_t const& count, size_t const& budget) noexcept {
+			size_t swaps = 0U;
+			for (size_t idx = 1U; idx < count; ++idx) {
+				float key = keys[idx];
+				unsigned int id = ids[idx];
+				size_t pos = idx;
+				while (pos > 0U && before(key, id, keys[pos - 1U], ids[pos - 1U])) {
+					keys[pos] = keys[pos - 1U];
+					ids[pos] = ids[pos - 1U];
+					--pos;
+				}
+				keys[pos] = key;
+				ids[pos] = id;
+				swaps += idx - pos;
+				if (swaps > budget) {
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	CFSweepAndPrune::CFSweepAndPrune() noexcept :
+		m_order(),
+		m_mins(),
+		m_maxs(),
+		m_lower(),
+		m_upper(),
+		m_axis(0U),
+		m_resorted(false)
+	{}
+
+	void CFSweepAndPrune::update(CFAABB3 const* const boxes, size_t const& count) {
+		//	中心の分散が最大の軸を選ぶ
+		double sum[FLT3_CNT] = {};
+		double sq[FLT3_CNT] = {};
+		for (size_t idx = 0U; idx < count; ++idx) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				double mid = 0.5 * (static_cast<double>(boxes[idx].lower().p[comp]) + static_cast<double>(boxes[idx].upper().p[comp]));
+				sum[comp] += mid;
+				sq[comp] += mid * mid;
+			}
+		}
+		double variance[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			double mean = count > 0U ? sum[comp] / static_cast<double>(count) : 0.0;
+			variance[comp] = count > 0U ? sq[comp] / static_cast<double>(count) - mean * mean : 0.0;
+		}
+		unsigned int best = m_axis;
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			if (variance[comp] > variance[best]) {
+				best = comp;
+			}
+		}
+		bool full = count != m_order.size();
+		if (best != m_axis && variance[best] > variance[m_axis] * AXIS_HYSTERESIS) {
+			m_axis = best;
+			full = true;
+		}
+
+		m_mins.resize(count + BATCH_LANE_CNT);
+		m_resorted = full;
+		if (!full) {
+			for (size_t idx = 0U; idx < count; ++idx) {
+				m_mins[idx] = boxes[m_order[idx]].lower().p[m_axis];
+			}
+			m_resorted = !insertion_sort(m_mins, m_order, count, count * SWAP_BUDGET);
+		}
+		if (m_resorted) {
+			//	最小値と要素番号を連続して並べて間接参照を避ける
+			std::vector<std::pair<float, unsigned int>> keys(count);
+			for (size_t idx = 0U; idx < count; ++idx) {
+				keys[idx] = std::make_pair(boxes[idx].lower().p[m_axis], static_cast<unsigned int>(idx));
+			}
+			std::sort(keys.begin(), keys.end());
+			m_order.resize(count);
+			for (size_t idx = 0U; idx < count; ++idx) {
+				m_mins[idx] = keys[idx].first;
+				m_order[idx] = keys[idx].second;
+			}
+		}
+
+		//	並び順に残りの成分を並べる (詰め物は掃引の判定で必ず外れる)
+		unsigned int other[2U] = { (m_axis + 1U) % FLT3_CNT, (m_axis + 2U) % FLT3_CNT };
+		m_maxs.resize(count + BATCH_LANE_CNT);
+		for (unsigned int lane = 0U; lane < 2U; ++lane) {
+			m_lower[lane].resize(count + BATCH_LANE_CNT);
+			m_upper[lane].resize(count + BATCH_LANE_CNT);
+		}
+		for (size_t idx = 0U; idx < count; ++idx) {
+			CFAABB3 const& box = boxes[m_order[idx]];
+			m_maxs[idx] = box.upper().p[m_axis];
+			for (unsigned int lane = 0U; lane < 2U; ++lane) {
+				m_lower[lane][idx] = box.lower().p[other[lane]];
+				m_upper[lane][idx] = box.upper().p[other[lane]];
+			}
+		}
+		std::fill(m_mins.begin() + count, m_mins.end(), FLT_MAX);
+		std::fill(m_maxs.begin() + count, m_maxs.end(), -FLT_MAX);
+		for (unsigned int lane = 0U; lane < 2U; ++lane) {
+			std::fill(m_lower[lane].begin() + count, m_lower[lane].end(), FLT_MAX);
+			std::fill(m_upper[lane].begin() + count, m_upper[lane].end(), -FLT_MAX);
+		}
+	}
+
+	void CFSweepAndPrune::clear() noexcept {
+		m_order.clear();
+		m_mins.clear();
+		m_maxs.clear();
+		for (unsigned int lane = 0U; lane < 2U; ++lane) {
+			m_lower[lane].clear();
+			m_upper[lane].clear();
+		}
+		m_resorted = false;
+	}
+
+	size_t const CFSweepAndPrune::size() const noexcept {
+		return m_order.size();
+	}
+
+	unsigned int const CFSweepAndPrune::axis() const noexcept {
+		return m_axis;
+	}
+
+	bool const CFSweepAndPrune::resorted() const noexcept {
+		return m_resorted;
+	}
+
+	void CFSweepAndPrune::pairs(std::vector<SCollisionPair>& dst) const {
+		dst.clear();
+		size_t count = m_order.size();
+		CJobSystem& jobs = CJobSystem::getInstance();
+		if (jobs.concurrency() <= 1U || count < PARALLEL_MIN) {
+			sweep(0U, count, dst);
+			return;
+		}
+		//	区間毎に別の配列へ集め、区間順に連結する
+		size_t chunks = jobs.concurrency() * CHUNK_SCALE;
+		std::vector<std::vector<SCollisionPair>> parts(chunks);
+		jobs.parallel_for(chunks, 1U, [&](size_t const& from, size_t const& to) {
+			for (size_t chunk = from; chunk < to; ++chunk) {
+				sweep(count * chunk / chunks, count * (chunk + 1U) / chunks, parts[chunk]);
+			}
+		});
+		size_t total = 0U;
+		for (auto const& part : parts) {
+			total += part.size();
+		}
+		dst.reserve(total);
+		for (auto const& part : parts) {
+			dst.insert(dst.end(), part.begin(), part.end());
+		}
+	}
+
+	void CFSweepAndPrune::sweep(size_t const& begin, size_t const& end, std::vector<SCollisionPair>& dst) const {
+		size_t count = m_order.size();
+		for (size_t idx = begin; idx < end; ++idx) {
+			__m256 reach = _mm256_set1_ps(m_maxs[idx]);
+			__m256 lo0 = _mm256_set1_ps(m_lower[0][idx]);
+			__m256 hi0 = _mm256_set1_ps(m_upper[0][idx]);
+			__m256 lo1 = _mm256_set1_ps(m_lower[1][idx]);
+			__m256 hi1 = _mm256_set1_ps(m_upper[1][idx]);
+			unsigned int id = m_order[idx];
+			for (size_t off = idx + 1U; off < count; off += BATCH_LANE_CNT) {
+				//	最小値順なので、掃引軸で外れた要素以降は全て外れる
+				__m256 span = _mm256_cmp_ps(_mm256_loadu_ps(&m_mins[off]), reach, _CMP_LE_OQ);
+				unsigned int inside = static_cast<unsigned int>(_mm256_movemask_ps(span));
+				__m256 mask = _mm256_and_ps(span, _mm256_cmp_ps(_mm256_loadu_ps(&m_lower[0][off]), hi0, _CMP_LE_OQ));
+				mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_loadu_ps(&m_upper[0][off]), lo0, _CMP_GE_OQ));
+				mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_loadu_ps(&m_lower[1][off]), hi1, _CMP_LE_OQ));
+				mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_loadu_ps(&m_upper[1][off]), lo1, _CMP_GE_OQ));
+				unsigned int bits = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_and_ps(mask, tailMask(count - off))));
+				while (bits != 0U) {
+					unsigned int other = m_order[off + _tzcnt_u32(bits)];
+					dst.push_back(id < other ? SCollisionPair{ id, other } : SCollisionPair{ other, id });
+					bits &= bits - 1U;
+				}
+				if (inside != 0xFFU) {
+					break;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+﻿/**	@file	CSplineCurves.cpp
+ *	@brief	三次スプライン曲線
+ */
+#include "geo/CSplineCurves.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	slerp を線形補間で代用する角度の正弦の閾値
+		float constexpr ARC_EPSILON = 1.0e-4f;
+
+		//!	@brief	単位四元数の対数関数 (実部は 0)
+		CFQuaternion const logarithm(CFQuaternion const& arg) noexcept {
+			float len = std::sqrt(arg.x * arg.x + arg.y * arg.y + arg.z * arg.z);
+			if (len < ARC_EPSILON) {
+				return CFQuaternion(arg.x, arg.y, arg.z, 0.0f);
+			}
+			float scale = std::atan2(len, arg.w) / len;
+			return CFQuaternion(arg.x * scale, arg.y * scale, arg.z * scale, 0.0f);
+		}
+
+		//!	@brief	純虚四元数の指数関数
+		CFQuaternion const exponent(CFQuaternion const& arg) noexcept {
+			float len = std::sqrt(arg.x * arg.x + arg.y * arg.y + arg.z * arg.z);
+			float scale = len < ARC_EPSILON ? 1.0f : std::sin(len) / len;
+			return CFQuaternion(arg.x * scale, arg.y * scale, arg.z * scale, std::cos(len));
+		}
+
+		//!	@brief	slerp の角度と正弦の逆数の計算関数
+		void arc(CFQuaternion const& begin, CFQuaternion const& end, float& angle, float& inv) noexcept {
+			float cosine = std::min(std::max(dot(begin, end), -1.0f), 1.0f);
+			angle = std::acos(cosine);
+			float sine = std::sin(angle);
+			inv = sine < ARC_EPSILON ? 0.0f : 1.0f / sine;
+		}
+
+		//!	@brief	角度を与えた slerp 関数 (正弦の逆数が 0 なら正規化線形補間とする)
+		CFQuaternion const slerp(CFQuaternion const& begin, CFQuaternion const& end, float const& angle, float const& inv, float const& rate) noexcept {
+			if (inv == 0.0f) {
+				return ((end - begin) * rate + begin).normalize();
+			}
+			return (begin * std::sin((1.0f - rate) * angle) + end * std::sin(rate * angle)) * inv;
+		}
+	}
+
+	CSplineCurves<CFQuaternion>::CSplineCurves() noexcept :
+		m_points(),
+		m_keys(),
+		m_inners(),
+		m_keyArcs(),
+		m_innerArcs(),
+		m_dirty(true)
+	{}
+
+	CSplineCurves<CFQuaternion>& CSplineCurves<CFQuaternion>::add(unsigned int const& index, CFQuaternion const& rot) noexcept {
+		m_points.insert(m_points.begin() + index, rot);
+		m_dirty = true;
+		return *this;
+	}
+
+	CSplineCurves<CFQuaternion>& CSplineCurves<CFQuaternion>::remove(unsigned int const& index) noexcept {
+		m_points.erase(m_points.begin() + index);
+		m_dirty = true;
+		return *this;
+	}
+
+	CSplineCurves<CFQuaternion>& CSplineCurves<CFQuaternion>::set(unsigned int const& index, CFQuaternion const& rot) noexcept {
+		m_points[index] = rot;
+		m_dirty = true;
+		return *this;
+	}
+
+	CFQuaternion const& CSplineCurves<CFQuaternion>::point(unsigned int const& idx) const noexcept {
+		return m_points[idx];
+	}
+
+	size_t const CSplineCurves<CFQuaternion>::size() const noexcept {
+		return m_points.size();
+	}
+
+	size_t const CSplineCurves<CFQuaternion>::segments() const noexcept {
+		return m_points.size() > 1U ? m_points.size() - 1U : 0U;
+	}
+
+	CFQuaternion const CSplineCurves<CFQuaternion>::interpolate(float const& rate) {
+		update();
+		size_t segs = segments();
+		if (segs == 0U) {
+			return m_keys.empty() ? UNIT_FQT : m_keys.front();
+		}
+		float pos = std::min(std::max(rate, 0.0f), 1.0f) * static_cast<float>(segs);
+		size_t segment = std::min(static_cast<size_t>(pos), segs - 1U);
+		return evaluate(segment, pos - static_cast<float>(segment));
+	}
+
+	void CSplineCurves<CFQuaternion>::interpolate(float const* const rates, size_t const& count, SPoints& dst) {
+		for (auto& comp : dst.p) {
+			comp.resize(count);
+		}
+		update();
+		size_t segs = segments();
+		float scale = static_cast<float>(segs);
+		for (size_t idx = 0U; idx < count; ++idx) {
+			CFQuaternion rot = m_keys.empty() ? UNIT_FQT : m_keys.front();
+			if (segs > 0U) {
+				float pos = std::min(std::max(rates[idx], 0.0f), 1.0f) * scale;
+				size_t segment = std::min(static_cast<size_t>(pos), segs - 1U);
+				rot = evaluate(segment, pos - static_cast<float>(segment));
+			}
+			for (unsigned int comp = 0U; comp < DIM; ++comp) {
+				dst.p[comp][idx] = rot.p[comp];
+			}
+		}
+	}
+
+	void CSplineCurves<CFQuaternion>::update() {
+		if (!m_dirty) {
+			return;
+		}
+		size_t cnt = m_points.size();
+		m_keys.resize(cnt);
+		for (size_t idx = 0U; idx < cnt; ++idx) {
+			//	最短経路で補間するよう前の回転と同じ半球へ揃える
+			m_keys[idx] = m_points[idx].normalize();
+			if (idx > 0U && dot(m_keys[idx - 1U], m_keys[idx]) < 0.0f) {
+				m_keys[idx] *= -1.0f;
+			}
+		}
+		m_inners.resize(cnt);
+		for (size_t idx = 0U; idx < cnt; ++idx) {
+			//	両端の中間の回転は端の回転自身とする
+			CFQuaternion const& cur = m_keys[idx];
+			if (idx == 0U || idx + 1U == cnt) {
+				m_inners[idx] = cur;
+				continue;
+			}
+			CFQuaternion inv = cur.conj();
+			CFQuaternion sum = logarithm(inv * m_keys[idx + 1U]) + logarithm(inv * m_keys[idx - 1U]);
+			m_inners[idx] = (cur * exponent(sum * -0.25f)).normalize();
+		}
+		size_t segs = segments();
+		m_keyArcs.resize(segs);
+		m_innerArcs.resize(segs);
+		for (size_t seg = 0U; seg < segs; ++seg) {
+			arc(m_keys[seg], m_keys[seg + 1U], m_keyArcs[seg].angle, m_keyArcs[seg].inv);
+			arc(m_inners[seg], m_inners[seg + 1U], m_innerArcs[seg].angle, m_innerArcs[seg].inv);
+		}
+		m_dirty = false;
+	}
+
+	CFQuaternion const CSplineCurves<CFQuaternion>::evaluate(size_t const& segment, float const& local) const noexcept {
+		SArc const& key = m_keyArcs[segment];
+		SArc const& inner = m_innerArcs[segment];
+		CFQuaternion outer = slerp(m_keys[segment], m_keys[segment + 1U], key.angle, key.inv, local);
+		CFQuaternion middle = slerp(m_inners[segment], m_inners[segment + 1U], inner.angle, inner.inv, local);
+		float angle;
+		float inv;
+		arc(outer, middle, angle, inv);
+		return slerp(outer, middle, angle, inv, 2.0f * local * (1.0f - local));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,610 @@
+﻿/**	@file	FConvex.cpp
+ *	@brief	凸形状間の距離と貫通の判定関数群
+ */
+#include "geo/FConvex.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	GJK の反復回数の上限
+		unsigned int constexpr GJK_MAX_ITER = 64U;
+		//!	@brief	GJK の収束判定の相対誤差 (距離の二乗に対する比)
+		float constexpr GJK_TOLERANCE = 1.0e-6f;
+		//!	@brief	原点を含むと見做す距離の二乗の単体の大きさに対する比
+		float constexpr OVERLAP_RATIO = 1.0e-10f;
+		//!	@brief	四面体を平らと見做す体積 (の六倍) の最長辺の三乗に対する比
+		float constexpr FLAT_RATIO = 1.0e-5f;
+		//!	@brief	EPA の展開回数の上限
+		unsigned int constexpr EPA_MAX_ITER = 64U;
+		//!	@brief	EPA の頂点数の上限
+		unsigned int constexpr EPA_MAX_VERTEX = EPA_MAX_ITER + 4U;
+		//!	@brief	EPA の面数の上限
+		unsigned int constexpr EPA_MAX_FACE = EPA_MAX_VERTEX * 2U;
+		//!	@brief	EPA の水平線の辺数の上限
+		unsigned int constexpr EPA_MAX_EDGE = EPA_MAX_FACE;
+		//!	@brief	EPA の収束判定の誤差 (形状の大きさに対する比)
+		float constexpr EPA_TOLERANCE = 1.0e-4f;
+
+		/**	@struct	SVertex
+		 *	@brief	ミンコフスキー差 A - B の頂点
+		 */
+		struct SVertex {
+			//!	@brief	A の支持点
+			CFVector3 a;
+			//!	@brief	B の支持点
+			CFVector3 b;
+			//!	@brief	a - b
+			CFVector3 w;
+			//!	@brief	探索方向
+			CFVector3 dir;
+		};
+
+		/**	@struct	SSimplex
+		 *	@brief	GJK の単体
+		 */
+		struct SSimplex {
+			//!	@brief	頂点
+			SVertex v[4U];
+			//!	@brief	原点に最も近い点の重心座標
+			float bary[4U];
+			//!	@brief	頂点数
+			unsigned int count;
+		};
+
+		/**	@struct	SFace
+		 *	@brief	EPA の多面体の面
+		 */
+		struct SFace {
+			//!	@brief	頂点番号 (外から見て反時計回り)
+			unsigned int idx[3U];
+			//!	@brief	外向きの単位法線
+			CFVector3 normal;
+			//!	@brief	原点からの距離
+			float dist;
+			//!	@brief	有効か否か
+			bool live;
+		};
+
+		//!	@brief	ミンコフスキー差の支持点取得関数
+		SVertex const support(CFConvexShape const& a, CFConvexShape const& b, CFVector3 const& dir, bool const& core) noexcept {
+			SVertex result;
+			result.a = core ? a.core(dir) : a.support(dir);
+			result.b = core ? b.core(-dir) : b.support(-dir);
+			result.w = result.a - result.b;
+			result.dir = dir;
+			return result;
+		}
+
+		//!	@brief	単体を選んだ頂点と重心座標で置き換える関数
+		void assign(SSimplex& sx, SVertex const* const* const verts, float const* const weights, unsigned int const& count) noexcept {
+			SVertex tmp[4U];
+			for (unsigned int idx = 0U; idx < count; ++idx) {
+				tmp[idx] = *verts[idx];
+			}
+			for (unsigned int idx = 0U; idx < count; ++idx) {
+				sx.v[idx] = tmp[idx];
+				sx.bary[idx] = weights[idx];
+			}
+			sx.count = count;
+		}
+
+		//!	@brief	線分上で原点に最も近い部分への縮小関数
+		void reduce_segment(SSimplex& sx) noexcept {
+			SVertex const& va = sx.v[0];
+			SVertex const& vb = sx.v[1];
+			CFVector3 ab = vb.w - va.w;
+			float t = -dot(va.w, ab);
+			float denom = dot(ab, ab);
+			if (t <= 0.0f || denom <= 0.0f) {
+				SVertex const* verts[] = { &va };
+				float weights[] = { 1.0f };
+				assign(sx, verts, weights, 1U);
+				return;
+			}
+			if (t >= denom) {
+				SVertex const* verts[] = { &vb };
+				float weights[] = { 1.0f };
+				assign(sx, verts, weights, 1U);
+				return;
+			}
+			sx.bary[1] = t / denom;
+			sx.bary[0] = 1.0f - sx.bary[1];
+		}
+
+		/**	@brief	三角形上で原点に最も近い部分への縮小関数
+		 *	@note	Ericson の点と三角形の最近点の領域判定による。
+		 */
+		void reduce_triangle(SSimplex& sx, SVertex const& va, SVertex const& vb, SVertex const& vc) noexcept {
+			CFVector3 ab = vb.w - va.w;
+			CFVector3 ac = vc.w - va.w;
+			float d1 = -dot(ab, va.w);
+			float d2 = -dot(ac, va.w);
+			if (d1 <= 0.0f && d2 <= 0.0f) {
+				SVertex const* verts[] = { &va };
+				float weights[] = { 1.0f };
+				assign(sx, verts, weights, 1U);
+				return;
+			}
+			float d3 = -dot(ab, vb.w);
+			float d4 = -dot(ac, vb.w);
+			if (d3 >= 0.0f && d4 <= d3) {
+				SVertex const* verts[] = { &vb };
+				float weights[] = { 1.0f };
+				assign(sx, verts, weights, 1U);
+				return;
+			}
+			float wc = d1 * d4 - d3 * d2;
+			if (wc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+				float t = d1 / (d1 - d3);
+				SVertex const* verts[] = { &va, &vb };
+				float weights[] = { 1.0f - t, t };
+				assign(sx, verts, weights, 2U);
+				return;
+			}
+			float d5 = -dot(ab, vc.w);
+			float d6 = -dot(ac, vc.w);
+			if (d6 >= 0.0f && d5 <= d6) {
+				SVertex const* verts[] = { &vc };
+				float weights[] = { 1.0f };
+				assign(sx, verts, weights, 1U);
+				return;
+			}
+			float wb = d5 * d2 - d1 * d6;
+			if (wb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+				float t = d2 / (d2 - d6);
+				SVertex const* verts[] = { &va, &vc };
+				float weights[] = { 1.0f - t, t };
+				assign(sx, verts, weights, 2U);
+				return;
+			}
+			float wa = d3 * d6 - d5 * d4;
+			if (wa <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+				float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+				SVertex const* verts[] = { &vb, &vc };
+				float weights[] = { 1.0f - t, t };
+				assign(sx, verts, weights, 2U);
+				return;
+			}
+			float sum = wa + wb + wc;
+			if (sum <= 0.0f) {
+				//	退化した三角形は最も近い頂点とする
+				SVertex const* cand[] = { &va, &vb, &vc };
+				SVertex const* nearest = cand[0];
+				for (SVertex const* vert : cand) {
+					if (vert->w.sqnorm() < nearest->w.sqnorm()) {
+						nearest = vert;
+					}
+				}
+				SVertex const* verts[] = { nearest };
+				float weights[] = { 1.0f };
+				assign(sx, verts, weights, 1U);
+				return;
+			}
+			float inv = 1.0f / sum;
+			SVertex const* verts[] = { &va, &vb, &vc };
+			float weights[] = { wa * inv, wb * inv, wc * inv };
+			assign(sx, verts, weights, 3U);
+		}
+
+		//!	@brief	四面体が平らか否かの判定関数 (丸め誤差に埋もれる体積では面の表裏を判定できない)
+		bool const flat(SSimplex const& sx) noexcept {
+			CFVector3 e1 = sx.v[1].w - sx.v[0].w;
+			CFVector3 e2 = sx.v[2].w - sx.v[0].w;
+			CFVector3 e3 = sx.v[3].w - sx.v[0].w;
+			float edge = std::max({ e1.sqnorm(), e2.sqnorm(), e3.sqnorm(), (e2 - e1).sqnorm(), (e3 - e1).sqnorm(), (e3 - e2).sqnorm() });
+			float volume = dot(e3, cross(e1, e2));
+			return std::fabs(volume) <= FLAT_RATIO * edge * std::sqrt(edge);
+		}
+
+		/**	@brief	四面体上で原点に最も近い部分への縮小関数
+		 *	@return 原点が四面体の内部にある場合は真 (単体は変えない)
+		 *	@note	平らな四面体は原点を含むとせず、四面の内で原点に最も近い面へ縮小する。
+		 */
+		bool const reduce_tetrahedron(SSimplex& sx) noexcept {
+			//	各面について原点が残る頂点と反対側にあれば、その面の最近点を候補とする
+			static unsigned int constexpr FACES[4U][4U] = { { 0U, 1U, 2U, 3U }, { 0U, 2U, 3U, 1U }, { 0U, 3U, 1U, 2U }, { 1U, 3U, 2U, 0U } };
+			bool degenerate = flat(sx);
+			SSimplex best = sx;
+			float bestSq = FLT_MAX;
+			bool inside = true;
+			for (auto const& face : FACES) {
+				SVertex const& va = sx.v[face[0]];
+				SVertex const& vb = sx.v[face[1]];
+				SVertex const& vc = sx.v[face[2]];
+				CFVector3 nor = cross(vb.w - va.w, vc.w - va.w);
+				float side = dot(sx.v[face[3]].w - va.w, nor);
+				float origin = -dot(va.w, nor);
+				if (!degenerate && origin * side > 0.0f) {
+					continue;
+				}
+				inside = false;
+				SSimplex cand = sx;
+				reduce_triangle(cand, va, vb, vc);
+				CFVector3 pt = ZERO_FVT3;
+				for (unsigned int idx = 0U; idx < cand.count; ++idx) {
+					pt += cand.v[idx].w * cand.bary[idx];
+				}
+				if (pt.sqnorm() < bestSq) {
+					bestSq = pt.sqnorm();
+					best = cand;
+				}
+			}
+			if (inside) {
+				return true;
+			}
+			sx = best;
+			return false;
+		}
+
+		//!	@brief	単体の原点に最も近い点の計算関数 (単体を最小の部分へ縮小する)
+		CFVector3 const solve(SSimplex& sx, bool& inside) noexcept {
+			inside = false;
+			switch (sx.count) {
+			case 1U:
+				sx.bary[0] = 1.0f;
+				break;
+			case 2U:
+				reduce_segment(sx);
+				break;
+			case 3U:
+			{
+				SVertex va = sx.v[0];
+				SVertex vb = sx.v[1];
+				SVertex vc = sx.v[2];
+				reduce_triangle(sx, va, vb, vc);
+				break;
+			}
+			default:
+				inside = reduce_tetrahedron(sx);
+				break;
+			}
+			if (inside) {
+				return ZERO_FVT3;
+			}
+			CFVector3 result = ZERO_FVT3;
+			for (unsigned int idx = 0U; idx < sx.count; ++idx) {
+				result += sx.v[idx].w * sx.bary[idx];
+			}
+			return result;
+		}
+
+		//!	@brief	単体の頂点との重複判定関数
+		bool const duplicated(SSimplex const& sx, CFVector3 const& pt) noexcept {
+			for (unsigned int idx = 0U; idx < sx.count; ++idx) {
+				if ((sx.v[idx].w - pt).sqnorm() <= FLT_EPSILON * std::max(pt.sqnorm(), 1.0f) * FLT_EPSILON) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**	@brief	GJK 本体
+		 *	@param[in] core 中核で判定するか否か
+		 *	@param[out] closest 原点に最も近い点 (交わる場合は零)
+		 *	@return 交わらない場合は真
+		 */
+		bool const run_gjk(CFConvexShape const& a, CFConvexShape const& b, bool const& core, SSimplexCache const* const cache, SSimplex& sx, CFVector3& closest, unsigned int& iterations) noexcept {
+			sx.count = 0U;
+			iterations = 0U;
+			bool inside = false;
+			if (cache != nullptr && cache->count > 0U) {
+				for (unsigned int idx = 0U; idx < cache->count && idx < 4U; ++idx) {
+					SVertex vert = support(a, b, cache->dirs[idx], core);
+					if (!duplicated(sx, vert.w)) {
+						sx.v[sx.count++] = vert;
+					}
+				}
+				closest = solve(sx, inside);
+			}
+			else {
+				CFVector3 dir = b.inner() - a.inner();
+				if (dir.sqnorm() <= 0.0f) {
+					dir = CFVector3(1.0f, 0.0f, 0.0f);
+				}
+				sx.v[0] = support(a, b, dir, core);
+				sx.bary[0] = 1.0f;
+				sx.count = 1U;
+				closest = sx.v[0].w;
+			}
+			while (!inside && iterations < GJK_MAX_ITER) {
+				float sq = closest.sqnorm();
+				float scale = 0.0f;
+				for (unsigned int idx = 0U; idx < sx.count; ++idx) {
+					scale = std::max(scale, sx.v[idx].w.sqnorm());
+				}
+				if (sq <= OVERLAP_RATIO * scale) {
+					inside = true;
+					break;
+				}
+				++iterations;
+				SVertex vert = support(a, b, -closest, core);
+				//	新たな支持点で原点に近付けない場合は収束とする
+				if (sq - dot(closest, vert.w) <= GJK_TOLERANCE * sq || duplicated(sx, vert.w)) {
+					break;
+				}
+				//	平面に近い単体では丸め誤差で遠ざかる事がある為、その場合は直前の単体に戻す
+				SSimplex prev = sx;
+				sx.v[sx.count++] = vert;
+				CFVector3 next = solve(sx, inside);
+				if (!inside && next.sqnorm() >= sq) {
+					sx = prev;
+					break;
+				}
+				closest = next;
+			}
+			if (inside) {
+				closest = ZERO_FVT3;
+			}
+			return !inside;
+		}
+
+		//!	@brief	単体の重心座標による A と B の点の計算関数
+		void witness(SSimplex const& sx, CFVector3& pa, CFVector3& pb) noexcept {
+			pa = ZERO_FVT3;
+			pb = ZERO_FVT3;
+			for (unsigned int idx = 0U; idx < sx.count; ++idx) {
+				pa += sx.v[idx].a * sx.bary[idx];
+				pb += sx.v[idx].b * sx.bary[idx];
+			}
+		}
+
+		//!	@brief	EPA の面の設定関数 (退化した面は無効とする)
+		void make_face(SFace& face, SVertex const* const verts, unsigned int const& i0, unsigned int const& i1, unsigned int const& i2) noexcept {
+			face.idx[0] = i0;
+			face.idx[1] = i1;
+			face.idx[2] = i2;
+			CFVector3 nor = cross(verts[i1].w - verts[i0].w, verts[i2].w - verts[i0].w);
+			float len = nor.norm();
+			face.live = len > 0.0f;
+			face.normal = face.live ? nor / len : ZERO_FVT3;
+			face.dist = face.live ? dot(face.normal, verts[i0].w) : FLT_MAX;
+		}
+
+		/**	@brief	原点を含む四面体への拡張関数
+		 *	@return 体積を持つ四面体を作れた場合は真
+		 *	@note	GJK が原点を面や辺の上で検出した場合に、直交する方向の支持点を加えて四頂点とする。
+		 */
+		bool const expand(CFConvexShape const& a, CFConvexShape const& b, SSimplex& sx) noexcept {
+			static CFVector3 constexpr AXES[3U] = { CFVector3(1.0f, 0.0f, 0.0f), CFVector3(0.0f, 1.0f, 0.0f), CFVector3(0.0f, 0.0f, 1.0f) };
+			if (sx.count == 1U) {
+				for (CFVector3 const& axis : AXES) {
+					for (float sign : { 1.0f, -1.0f }) {
+						SVertex vert = support(a, b, axis * sign, false);
+						if (sx.count == 1U && !duplicated(sx, vert.w)) {
+							sx.v[sx.count++] = vert;
+						}
+					}
+				}
+			}
+			if (sx.count == 2U) {
+				CFVector3 seg = sx.v[1].w - sx.v[0].w;
+				for (CFVector3 const& axis : AXES) {
+					CFVector3 dir = cross(seg, axis);
+					if (sx.count != 2U || dir.sqnorm() <= 0.0f) {
+						continue;
+					}
+					for (float sign : { 1.0f, -1.0f }) {
+						SVertex vert = support(a, b, dir * sign, false);
+						if (sx.count == 2U && cross(vert.w - sx.v[0].w, seg).sqnorm() > FLT_EPSILON * seg.sqnorm() * std::max(vert.w.sqnorm(), 1.0f)) {
+							sx.v[sx.count++] = vert;
+						}
+					}
+				}
+			}
+			if (sx.count == 3U) {
+				CFVector3 nor = cross(sx.v[1].w - sx.v[0].w, sx.v[2].w - sx.v[0].w);
+				for (float sign : { 1.0f, -1.0f }) {
+					SVertex vert = support(a, b, nor * sign, false);
+					if (sx.count == 3U && std::fabs(dot(vert.w - sx.v[0].w, nor)) > FLT_EPSILON * nor.norm() * std::max(vert.w.norm(), 1.0f)) {
+						sx.v[sx.count++] = vert;
+					}
+				}
+			}
+			return sx.count == 4U && !flat(sx);
+		}
+
+		/**	@brief	GJK による距離の計算関数
+		 *	@param[in] core 中核で判定し、最近点を余白の分だけ進めるか否か
+		 *	@return 交わらない場合は真
+		 */
+		bool const measure(CFConvexShape const& a, CFConvexShape const& b, bool const& core, SContact& contact, SSimplexCache* const cache) noexcept {
+			SSimplex sx;
+			CFVector3 closest;
+			bool apart = run_gjk(a, b, core, cache, sx, closest, contact.iterations);
+			contact.expansions = 0U;
+			if (cache != nullptr) {
+				cache->count = sx.count;
+				for (unsigned int idx = 0U; idx < sx.count; ++idx) {
+					cache->dirs[idx] = sx.v[idx].dir;
+				}
+			}
+			float len = closest.norm();
+			if (!apart || len <= 0.0f) {
+				return false;
+			}
+			//	中核の最近点は余白の分だけ法線方向へ進める
+			float marginA = core ? a.margin() : 0.0f;
+			float marginB = core ? b.margin() : 0.0f;
+			witness(sx, contact.pointA, contact.pointB);
+			contact.normal = closest * (-1.0f / len);
+			contact.pointA += contact.normal * marginA;
+			contact.pointB -= contact.normal * marginB;
+			contact.distance = len - marginA - marginB;
+			return true;
+		}
+	}
+
+	bool const gjkDistance(CFConvexShape const& a, CFConvexShape const& b, SContact& contact, SSimplexCache* const cache) noexcept {
+		return measure(a, b, true, contact, cache);
+	}
+
+	bool const epaPenetration(CFConvexShape const& a, CFConvexShape const& b, SContact& contact) noexcept {
+		SSimplex sx;
+		CFVector3 closest;
+		contact.expansions = 0U;
+		if (run_gjk(a, b, false, nullptr, sx, closest, contact.iterations)) {
+			return false;
+		}
+		if (sx.count < 4U && !expand(a, b, sx)) {
+			return false;
+		}
+
+		SVertex verts[EPA_MAX_VERTEX];
+		SFace faces[EPA_MAX_FACE];
+		unsigned int vcount = 4U;
+		unsigned int fcount = 4U;
+		for (unsigned int idx = 0U; idx < 4U; ++idx) {
+			verts[idx] = sx.v[idx];
+		}
+		//	四面体の面を外向きに揃える
+		if (dot(verts[3].w - verts[0].w, cross(verts[1].w - verts[0].w, verts[2].w - verts[0].w)) > 0.0f) {
+			std::swap(verts[1], verts[2]);
+		}
+		make_face(faces[0], verts, 0U, 1U, 2U);
+		make_face(faces[1], verts, 0U, 3U, 1U);
+		make_face(faces[2], verts, 0U, 2U, 3U);
+		make_face(faces[3], verts, 1U, 3U, 2U);
+
+		float scale = 0.0f;
+		for (unsigned int idx = 0U; idx < 4U; ++idx) {
+			scale = std::max(scale, verts[idx].w.norm());
+		}
+		unsigned int nearest = 0U;
+		for (;;) {
+			nearest = EPA_MAX_FACE;
+			float best = FLT_MAX;
+			for (unsigned int idx = 0U; idx < fcount; ++idx) {
+				if (faces[idx].live && faces[idx].dist < best) {
+					best = faces[idx].dist;
+					nearest = idx;
+				}
+			}
+			if (nearest == EPA_MAX_FACE) {
+				return false;
+			}
+			if (contact.expansions >= EPA_MAX_ITER || vcount >= EPA_MAX_VERTEX) {
+				break;
+			}
+			SFace const& face = faces[nearest];
+			SVertex vert = support(a, b, face.normal, false);
+			scale = std::max(scale, vert.w.norm());
+			if (dot(vert.w, face.normal) - face.dist <= EPA_TOLERANCE * scale) {
+				break;
+			}
+			++contact.expansions;
+
+			//	新たな頂点から見える面を除き、その境界 (水平線) の辺と新たな頂点で面を張る
+			unsigned int edges[EPA_MAX_EDGE][2U];
+			unsigned int ecount = 0U;
+			bool overflow = false;
+			for (unsigned int idx = 0U; idx < fcount; ++idx) {
+				SFace& cur = faces[idx];
+				if (!cur.live || dot(cur.normal, vert.w - verts[cur.idx[0]].w) <= 0.0f) {
+					continue;
+				}
+				cur.live = false;
+				for (unsigned int edge = 0U; edge < 3U; ++edge) {
+					unsigned int from = cur.idx[edge];
+					unsigned int to = cur.idx[(edge + 1U) % 3U];
+					unsigned int found = ecount;
+					for (unsigned int pos = 0U; pos < ecount; ++pos) {
+						if (edges[pos][0] == to && edges[pos][1] == from) {
+							found = pos;
+							break;
+						}
+					}
+					if (found < ecount) {
+						edges[found][0] = edges[ecount - 1U][0];
+						edges[found][1] = edges[ecount - 1U][1];
+						--ecount;
+					}
+					else if (ecount < EPA_MAX_EDGE) {
+						edges[ecount][0] = from;
+						edges[ecount][1] = to;
+						++ecount;
+					}
+					else {
+						overflow = true;
+					}
+				}
+			}
+			//	除いた面の枠を詰めて新たな面を加える
+			unsigned int kept = 0U;
+			for (unsigned int idx = 0U; idx < fcount; ++idx) {
+				if (faces[idx].live) {
+					faces[kept++] = faces[idx];
+				}
+			}
+			fcount = kept;
+			if (overflow || ecount == 0U || fcount + ecount > EPA_MAX_FACE) {
+				break;
+			}
+			verts[vcount] = vert;
+			for (unsigned int idx = 0U; idx < ecount; ++idx) {
+				make_face(faces[fcount++], verts, edges[idx][0], edges[idx][1], vcount);
+			}
+			++vcount;
+		}
+
+		//	原点から最も近い面へ下ろした点の重心座標で接触点を求める
+		for (unsigned int idx = 0U; idx < fcount; ++idx) {
+			if (faces[idx].live && (nearest >= fcount || faces[idx].dist < faces[nearest].dist)) {
+				nearest = idx;
+			}
+		}
+		//	最も近い面が原点の外側にある場合は原点を含まず、貫通していない
+		if (nearest >= fcount || faces[nearest].dist < 0.0f) {
+			return false;
+		}
+		SFace const& face = faces[nearest];
+		SSimplex tri;
+		tri.v[0] = verts[face.idx[0]];
+		tri.v[1] = verts[face.idx[1]];
+		tri.v[2] = verts[face.idx[2]];
+		CFVector3 foot = face.normal * face.dist;
+		CFVector3 e1 = tri.v[1].w - tri.v[0].w;
+		CFVector3 e2 = tri.v[2].w - tri.v[0].w;
+		CFVector3 rel = foot - tri.v[0].w;
+		float d00 = dot(e1, e1);
+		float d01 = dot(e1, e2);
+		float d11 = dot(e2, e2);
+		float d20 = dot(rel, e1);
+		float d21 = dot(rel, e2);
+		float denom = d00 * d11 - d01 * d01;
+		float u = denom != 0.0f ? (d11 * d20 - d01 * d21) / denom : 0.0f;
+		float v = denom != 0.0f ? (d00 * d21 - d01 * d20) / denom : 0.0f;
+		tri.bary[0] = 1.0f - u - v;
+		tri.bary[1] = u;
+		tri.bary[2] = v;
+		tri.count = 3U;
+		witness(tri, contact.pointA, contact.pointB);
+		contact.normal = face.normal;
+		contact.distance = -face.dist;
+		return true;
+	}
+
+	bool const collide(CFConvexShape const& a, CFConvexShape const& b, SContact& contact, SSimplexCache* const cache) noexcept {
+		if (gjkDistance(a, b, contact, cache)) {
+			return contact.distance <= 0.0f;
+		}
+		unsigned int iterations = contact.iterations;
+		contact.iterations = 0U;
+		if (!epaPenetration(a, b, contact)) {
+			//	余白を含めた形状が離れていれば接触しない
+			if (measure(a, b, false, contact, nullptr)) {
+				contact.iterations += iterations;
+				return contact.distance <= 0.0f;
+			}
+			//	退化した場合は接しているものとして扱う
+			contact.normal = CFVector3(1.0f, 0.0f, 0.0f);
+			contact.pointA = a.inner();
+			contact.pointB = b.inner();
+			contact.distance = 0.0f;
+			contact.expansions = 0U;
+		}
+		contact.iterations += iterations;
+		return true;
+	}
+}
\ No newline at end of file
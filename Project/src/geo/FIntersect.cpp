@@ -0,0 +1,502 @@
+﻿/**	@file	FIntersect.cpp
+ *	@brief	光線の交差判定関数群
+ */
+#include "geo/FIntersect.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace dlav {
+	namespace {
+		//!	@brief	方向成分が零の場合に代わりに用いる値
+		float constexpr DIR_EPSILON = 1.0e-20f;
+		//!	@brief	光線と三角形が平行と見做す行列式の閾値
+		float constexpr DET_EPSILON = 1.0e-12f;
+
+		//!	@brief	レーンを NaN で埋める関数
+		template <size_t N>
+		void fill_nan(float (&dst)[N][BATCH_LANE_CNT]) noexcept {
+			for (auto& comp : dst) {
+				std::fill(comp, comp + BATCH_LANE_CNT, std::numeric_limits<float>::quiet_NaN());
+			}
+		}
+
+		//!	@brief	ベクトルの各成分の読み込み関数
+		void load3(float const (&src)[FLT3_CNT][BATCH_LANE_CNT], __m256 (&dst)[FLT3_CNT]) noexcept {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst[comp] = _mm256_load_ps(src[comp]);
+			}
+		}
+
+		//!	@brief	ベクトルの各成分の複製関数
+		void splat3(CFVector3 const& src, __m256 (&dst)[FLT3_CNT]) noexcept {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst[comp] = _mm256_set1_ps(src.p[comp]);
+			}
+		}
+
+		//!	@brief	方向の逆数を求める関数 (零成分は DIR_EPSILON に置き換える)
+		__m256 const reciprocal(__m256 const& d) noexcept {
+			__m256 zero = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ);
+			return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_blendv_ps(d, _mm256_set1_ps(DIR_EPSILON), zero));
+		}
+
+		//!	@brief	結果の書き出し関数
+		unsigned int const store(__m256 const& mask, __m256 const& t, __m256 const& u, __m256 const& v, SHit8& hit) noexcept {
+			_mm256_store_ps(hit.t, t);
+			_mm256_store_ps(hit.u, u);
+			_mm256_store_ps(hit.v, v);
+			return static_cast<unsigned int>(_mm256_movemask_ps(mask));
+		}
+
+		/**	@brief	Möller–Trumbore 法の八レーン版
+		 *	@note	光線と三角形のどちらを複製しても同じ式で判定できる。
+		 */
+		__m256 const moller8(__m256 const (&o)[FLT3_CNT], __m256 const (&d)[FLT3_CNT], __m256 const (&v0)[FLT3_CNT], __m256 const (&e1)[FLT3_CNT], __m256 const (&e2)[FLT3_CNT], __m256 const& tmax, __m256& t, __m256& u, __m256& v) noexcept {
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 const one = _mm256_set1_ps(1.0f);
+			__m256 pv[FLT3_CNT] = {
+				_mm256_fmsub_ps(d[1], e2[2], _mm256_mul_ps(d[2], e2[1])),
+				_mm256_fmsub_ps(d[2], e2[0], _mm256_mul_ps(d[0], e2[2])),
+				_mm256_fmsub_ps(d[0], e2[1], _mm256_mul_ps(d[1], e2[0]))
+			};
+			__m256 det = _mm256_fmadd_ps(e1[0], pv[0], _mm256_fmadd_ps(e1[1], pv[1], _mm256_mul_ps(e1[2], pv[2])));
+			__m256 idet = _mm256_div_ps(one, det);
+			__m256 s[FLT3_CNT] = { _mm256_sub_ps(o[0], v0[0]), _mm256_sub_ps(o[1], v0[1]), _mm256_sub_ps(o[2], v0[2]) };
+			__m256 q[FLT3_CNT] = {
+				_mm256_fmsub_ps(s[1], e1[2], _mm256_mul_ps(s[2], e1[1])),
+				_mm256_fmsub_ps(s[2], e1[0], _mm256_mul_ps(s[0], e1[2])),
+				_mm256_fmsub_ps(s[0], e1[1], _mm256_mul_ps(s[1], e1[0]))
+			};
+			u = _mm256_mul_ps(_mm256_fmadd_ps(s[0], pv[0], _mm256_fmadd_ps(s[1], pv[1], _mm256_mul_ps(s[2], pv[2]))), idet);
+			v = _mm256_mul_ps(_mm256_fmadd_ps(d[0], q[0], _mm256_fmadd_ps(d[1], q[1], _mm256_mul_ps(d[2], q[2]))), idet);
+			t = _mm256_mul_ps(_mm256_fmadd_ps(e2[0], q[0], _mm256_fmadd_ps(e2[1], q[1], _mm256_mul_ps(e2[2], q[2]))), idet);
+			__m256 mask = _mm256_cmp_ps(laneAbs(det), _mm256_set1_ps(DET_EPSILON), _CMP_GE_OQ);
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, zero, _CMP_GT_OQ));
+			return _mm256_and_ps(mask, _mm256_cmp_ps(t, tmax, _CMP_LT_OQ));
+		}
+
+		/**	@brief	水密な判定の八レーン版
+		 *	@param[in] a,b,c 基準点から見た各頂点 (剪断の軸の順 x, y, z に並べ替え済み)
+		 *	@param[in] s 剪断係数 (Sx, Sy, Sz)
+		 *	@param[out] retry 辺関数が 0 となり倍精度で計算し直すべきレーン
+		 */
+		__m256 const watertight8(__m256 const (&a)[FLT3_CNT], __m256 const (&b)[FLT3_CNT], __m256 const (&c)[FLT3_CNT], __m256 const (&s)[FLT3_CNT], __m256 const& tmax, __m256& t, __m256& u, __m256& v, __m256& retry) noexcept {
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 ax = _mm256_fnmadd_ps(s[0], a[2], a[0]);
+			__m256 ay = _mm256_fnmadd_ps(s[1], a[2], a[1]);
+			__m256 bx = _mm256_fnmadd_ps(s[0], b[2], b[0]);
+			__m256 by = _mm256_fnmadd_ps(s[1], b[2], b[1]);
+			__m256 cx = _mm256_fnmadd_ps(s[0], c[2], c[0]);
+			__m256 cy = _mm256_fnmadd_ps(s[1], c[2], c[1]);
+			// 辺を共有する三角形で辺関数が符号のみ異なる値となるよう、積和演算を用いず二つの積を個別に丸める
+			__m256 eu = _mm256_sub_ps(_mm256_mul_ps(cx, by), _mm256_mul_ps(cy, bx));
+			__m256 ev = _mm256_sub_ps(_mm256_mul_ps(ax, cy), _mm256_mul_ps(ay, cx));
+			__m256 ew = _mm256_sub_ps(_mm256_mul_ps(bx, ay), _mm256_mul_ps(by, ax));
+			retry = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(eu, zero, _CMP_EQ_OQ), _mm256_cmp_ps(ev, zero, _CMP_EQ_OQ)), _mm256_cmp_ps(ew, zero, _CMP_EQ_OQ));
+
+			__m256 pos = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(eu, zero, _CMP_GE_OQ), _mm256_cmp_ps(ev, zero, _CMP_GE_OQ)), _mm256_cmp_ps(ew, zero, _CMP_GE_OQ));
+			__m256 neg = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(eu, zero, _CMP_LE_OQ), _mm256_cmp_ps(ev, zero, _CMP_LE_OQ)), _mm256_cmp_ps(ew, zero, _CMP_LE_OQ));
+			__m256 det = _mm256_add_ps(_mm256_add_ps(eu, ev), ew);
+			__m256 num = _mm256_mul_ps(s[2], _mm256_fmadd_ps(eu, a[2], _mm256_fmadd_ps(ev, b[2], _mm256_mul_ps(ew, c[2]))));
+
+			// 行列式の符号で正規化して範囲を割り算なしで判定する
+			__m256 sign = _mm256_and_ps(det, _mm256_set1_ps(-0.0f));
+			__m256 snum = _mm256_xor_ps(num, sign);
+			__m256 sdet = laneAbs(det);
+			__m256 mask = _mm256_and_ps(_mm256_or_ps(pos, neg), _mm256_cmp_ps(det, zero, _CMP_NEQ_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(snum, zero, _CMP_GT_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(snum, _mm256_mul_ps(tmax, sdet), _CMP_LT_OQ));
+
+			__m256 idet = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+			t = _mm256_mul_ps(num, idet);
+			u = _mm256_mul_ps(ev, idet);
+			v = _mm256_mul_ps(ew, idet);
+			return mask;
+		}
+
+		//!	@brief	スラブ法の八レーン版 (NaN のレーンは交差しない)
+		__m256 const slab8(__m256 const (&o)[FLT3_CNT], __m256 const (&inv)[FLT3_CNT], __m256 const (&lo)[FLT3_CNT], __m256 const (&hi)[FLT3_CNT], __m256 const& tmax, __m256& t) noexcept {
+			__m256 tn = _mm256_setzero_ps();
+			__m256 tf = tmax;
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				__m256 t0 = _mm256_mul_ps(_mm256_sub_ps(lo[comp], o[comp]), inv[comp]);
+				__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(hi[comp], o[comp]), inv[comp]);
+				// 第二引数の NaN が残る順で比較する
+				tn = _mm256_max_ps(tn, _mm256_min_ps(t0, t1));
+				tf = _mm256_min_ps(tf, _mm256_max_ps(t0, t1));
+			}
+			t = tn;
+			return _mm256_cmp_ps(tn, tf, _CMP_LE_OQ);
+		}
+
+		//!	@brief	平面との交差判定の八レーン版
+		__m256 const plane8(__m256 const (&o)[FLT3_CNT], __m256 const (&d)[FLT3_CNT], __m256 const (&n)[FLT3_CNT], __m256 const& value, __m256 const& tmax, __m256& t) noexcept {
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 den = _mm256_fmadd_ps(n[0], d[0], _mm256_fmadd_ps(n[1], d[1], _mm256_mul_ps(n[2], d[2])));
+			__m256 dist = _mm256_fmadd_ps(n[0], o[0], _mm256_fmadd_ps(n[1], o[1], _mm256_fmadd_ps(n[2], o[2], value)));
+			t = _mm256_div_ps(_mm256_sub_ps(zero, dist), den);
+			__m256 mask = _mm256_cmp_ps(den, zero, _CMP_NEQ_OQ);
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, zero, _CMP_GT_OQ));
+			return _mm256_and_ps(mask, _mm256_cmp_ps(t, tmax, _CMP_LT_OQ));
+		}
+
+		/**	@brief	水密な判定の剪断の軸の選択関数
+		 *	@param[out] axis 剪断後の x, y, z に対応する元の軸
+		 */
+		void shear_axes(CFVector3 const& d, unsigned int (&axis)[FLT3_CNT]) noexcept {
+			unsigned int kz = 0U;
+			if (fabsf(d.y) > fabsf(d.p[kz])) {
+				kz = 1U;
+			}
+			if (fabsf(d.z) > fabsf(d.p[kz])) {
+				kz = 2U;
+			}
+			unsigned int kx = (kz + 1U) % FLT3_CNT;
+			unsigned int ky = (kx + 1U) % FLT3_CNT;
+			// 向きが負なら x と y を入れ替えて三角形の回り順を保つ
+			if (d.p[kz] < 0.0f) {
+				std::swap(kx, ky);
+			}
+			axis[0] = kx;
+			axis[1] = ky;
+			axis[2] = kz;
+		}
+
+		/**	@brief	レーン毎の軸の並べ替え関数
+		 *	@param[in] m1 z 軸が元の y 軸となるレーン
+		 *	@param[in] m2 z 軸が元の z 軸となるレーン
+		 *	@param[in] flip x と y を入れ替えるレーン
+		 */
+		void permute(__m256 const (&src)[FLT3_CNT], __m256 const& m1, __m256 const& m2, __m256 const& flip, __m256 (&dst)[FLT3_CNT]) noexcept {
+			__m256 z = _mm256_blendv_ps(_mm256_blendv_ps(src[0], src[1], m1), src[2], m2);
+			__m256 x = _mm256_blendv_ps(_mm256_blendv_ps(src[1], src[2], m1), src[0], m2);
+			__m256 y = _mm256_blendv_ps(_mm256_blendv_ps(src[2], src[0], m1), src[1], m2);
+			dst[0] = _mm256_blendv_ps(x, y, flip);
+			dst[1] = _mm256_blendv_ps(y, x, flip);
+			dst[2] = z;
+		}
+
+		//!	@brief	八本の光線の一本の取り出し関数
+		CRay<CFVector3> const lane_ray(SRay8 const& rays, unsigned int const& lane) noexcept {
+			CRay<CFVector3> ray;
+			ray.position = CFVector3(rays.o[0][lane], rays.o[1][lane], rays.o[2][lane]);
+			ray.direction = CFVector3(rays.d[0][lane], rays.d[1][lane], rays.d[2][lane]);
+			return ray;
+		}
+
+		//!	@brief	八個の三角形の一頂点の取り出し関数
+		CFVector3 const lane_vertex(float const (&src)[FLT3_CNT][BATCH_LANE_CNT], unsigned int const& lane) noexcept {
+			return CFVector3(src[0][lane], src[1][lane], src[2][lane]);
+		}
+	}
+
+	size_t const loadRays(SRay8& dst, CRay<CFVector3> const* const rays, size_t const& count) noexcept {
+		size_t lanes = std::min<size_t>(count, BATCH_LANE_CNT);
+		fill_nan(dst.o);
+		fill_nan(dst.d);
+		for (size_t lane = 0U; lane < lanes; ++lane) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst.o[comp][lane] = rays[lane].position.p[comp];
+				dst.d[comp][lane] = rays[lane].direction.p[comp];
+			}
+		}
+		return lanes;
+	}
+
+	size_t const loadTriangles(STriangle8& dst, CFVector3 const* const vertices, unsigned int const* const indices, size_t const& count) noexcept {
+		size_t lanes = std::min<size_t>(count, BATCH_LANE_CNT);
+		fill_nan(dst.v0);
+		fill_nan(dst.v1);
+		fill_nan(dst.v2);
+		for (size_t lane = 0U; lane < lanes; ++lane) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst.v0[comp][lane] = vertices[indices[lane * 3U + 0U]].p[comp];
+				dst.v1[comp][lane] = vertices[indices[lane * 3U + 1U]].p[comp];
+				dst.v2[comp][lane] = vertices[indices[lane * 3U + 2U]].p[comp];
+			}
+		}
+		return lanes;
+	}
+
+	size_t const loadBoxes(SBox8& dst, CFAABB3 const* const boxes, size_t const& count) noexcept {
+		size_t lanes = std::min<size_t>(count, BATCH_LANE_CNT);
+		fill_nan(dst.lo);
+		fill_nan(dst.hi);
+		for (size_t lane = 0U; lane < lanes; ++lane) {
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst.lo[comp][lane] = boxes[lane].lower().p[comp];
+				dst.hi[comp][lane] = boxes[lane].upper().p[comp];
+			}
+		}
+		return lanes;
+	}
+
+	size_t const loadPlanes(SPlane8& dst, CFPlane3 const* const planes, size_t const& count) noexcept {
+		size_t lanes = std::min<size_t>(count, BATCH_LANE_CNT);
+		fill_nan(dst.n);
+		std::fill(dst.d, dst.d + BATCH_LANE_CNT, std::numeric_limits<float>::quiet_NaN());
+		for (size_t lane = 0U; lane < lanes; ++lane) {
+			CFVector3 n = planes[lane].normal();
+			for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+				dst.n[comp][lane] = n.p[comp];
+			}
+			dst.d[lane] = planes[lane].getDValue();
+		}
+		return lanes;
+	}
+
+	bool const rayTriangle(CRay<CFVector3> const& ray, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, float& t, float& u, float& v) noexcept {
+		CFVector3 e1 = v1 - v0;
+		CFVector3 e2 = v2 - v0;
+		CFVector3 pv = cross(ray.direction, e2);
+		float det = dot(e1, pv);
+		if (fabsf(det) < DET_EPSILON) {
+			return false;
+		}
+		float idet = 1.0f / det;
+		CFVector3 s = ray.position - v0;
+		float bu = dot(s, pv) * idet;
+		if (bu < 0.0f || bu > 1.0f) {
+			return false;
+		}
+		CFVector3 q = cross(s, e1);
+		float bv = dot(ray.direction, q) * idet;
+		if (bv < 0.0f || bu + bv > 1.0f) {
+			return false;
+		}
+		float dist = dot(e2, q) * idet;
+		if (dist <= 0.0f || dist >= tmax) {
+			return false;
+		}
+		t = dist;
+		u = bu;
+		v = bv;
+		return true;
+	}
+
+	bool const rayTriangleWatertight(CRay<CFVector3> const& ray, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, float& t, float& u, float& v) noexcept {
+		unsigned int axis[FLT3_CNT];
+		shear_axes(ray.direction, axis);
+		float const* d = ray.direction.p;
+		float sx = d[axis[0]] / d[axis[2]];
+		float sy = d[axis[1]] / d[axis[2]];
+		float sz = 1.0f / d[axis[2]];
+
+		CFVector3 a = v0 - ray.position;
+		CFVector3 b = v1 - ray.position;
+		CFVector3 c = v2 - ray.position;
+		float ax = a.p[axis[0]] - sx * a.p[axis[2]];
+		float ay = a.p[axis[1]] - sy * a.p[axis[2]];
+		float bx = b.p[axis[0]] - sx * b.p[axis[2]];
+		float by = b.p[axis[1]] - sy * b.p[axis[2]];
+		float cx = c.p[axis[0]] - sx * c.p[axis[2]];
+		float cy = c.p[axis[1]] - sy * c.p[axis[2]];
+		float eu = cx * by - cy * bx;
+		float ev = ax * cy - ay * cx;
+		float ew = bx * ay - by * ax;
+		if (eu == 0.0f || ev == 0.0f || ew == 0.0f) {
+			// 辺の上では単精度の丸めで符号が決まらない為、倍精度で計算し直す
+			eu = static_cast<float>(static_cast<double>(cx) * static_cast<double>(by) - static_cast<double>(cy) * static_cast<double>(bx));
+			ev = static_cast<float>(static_cast<double>(ax) * static_cast<double>(cy) - static_cast<double>(ay) * static_cast<double>(cx));
+			ew = static_cast<float>(static_cast<double>(bx) * static_cast<double>(ay) - static_cast<double>(by) * static_cast<double>(ax));
+		}
+		if ((eu < 0.0f || ev < 0.0f || ew < 0.0f) && (eu > 0.0f || ev > 0.0f || ew > 0.0f)) {
+			return false;
+		}
+		float det = eu + ev + ew;
+		if (det == 0.0f) {
+			return false;
+		}
+
+		float num = sz * (eu * a.p[axis[2]] + ev * b.p[axis[2]] + ew * c.p[axis[2]]);
+		float snum = det < 0.0f ? -num : num;
+		if (snum <= 0.0f || snum >= tmax * fabsf(det)) {
+			return false;
+		}
+		float idet = 1.0f / det;
+		t = num * idet;
+		u = ev * idet;
+		v = ew * idet;
+		return true;
+	}
+
+	bool const rayBox(CRay<CFVector3> const& ray, CFAABB3 const& box, float const& tmax, float& t) noexcept {
+		float tn = 0.0f;
+		float tf = tmax;
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			float d = ray.direction.p[comp];
+			float inv = 1.0f / (d != 0.0f ? d : DIR_EPSILON);
+			float t0 = (box.lower().p[comp] - ray.position.p[comp]) * inv;
+			float t1 = (box.upper().p[comp] - ray.position.p[comp]) * inv;
+			tn = std::max(tn, std::min(t0, t1));
+			tf = std::min(tf, std::max(t0, t1));
+		}
+		if (tn > tf) {
+			return false;
+		}
+		t = tn;
+		return true;
+	}
+
+	bool const rayPlane(CRay<CFVector3> const& ray, CFPlane3 const& plane, float const& tmax, float& t) noexcept {
+		CFVector3 n = plane.normal();
+		float den = dot(n, ray.direction);
+		if (den == 0.0f) {
+			return false;
+		}
+		float dist = -plane.distance(ray.position) / den;
+		if (dist <= 0.0f || dist >= tmax) {
+			return false;
+		}
+		t = dist;
+		return true;
+	}
+
+	unsigned int const rayTriangle(CRay<CFVector3> const& ray, STriangle8 const& tris, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], d[FLT3_CNT], v0[FLT3_CNT], v1[FLT3_CNT], v2[FLT3_CNT];
+		splat3(ray.position, o);
+		splat3(ray.direction, d);
+		load3(tris.v0, v0);
+		load3(tris.v1, v1);
+		load3(tris.v2, v2);
+		__m256 e1[FLT3_CNT] = { _mm256_sub_ps(v1[0], v0[0]), _mm256_sub_ps(v1[1], v0[1]), _mm256_sub_ps(v1[2], v0[2]) };
+		__m256 e2[FLT3_CNT] = { _mm256_sub_ps(v2[0], v0[0]), _mm256_sub_ps(v2[1], v0[1]), _mm256_sub_ps(v2[2], v0[2]) };
+		__m256 t, u, v;
+		__m256 mask = moller8(o, d, v0, e1, e2, _mm256_set1_ps(tmax), t, u, v);
+		return store(mask, t, u, v, hit);
+	}
+
+	unsigned int const rayTriangleWatertight(CRay<CFVector3> const& ray, STriangle8 const& tris, float const& tmax, SHit8& hit) noexcept {
+		// 剪断の軸は光線で決まる為、全レーンで共通となる
+		unsigned int axis[FLT3_CNT];
+		shear_axes(ray.direction, axis);
+		float const* d = ray.direction.p;
+		__m256 s[FLT3_CNT] = { _mm256_set1_ps(d[axis[0]] / d[axis[2]]), _mm256_set1_ps(d[axis[1]] / d[axis[2]]), _mm256_set1_ps(1.0f / d[axis[2]]) };
+		__m256 a[FLT3_CNT], b[FLT3_CNT], c[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			__m256 o = _mm256_set1_ps(ray.position.p[axis[comp]]);
+			a[comp] = _mm256_sub_ps(_mm256_load_ps(tris.v0[axis[comp]]), o);
+			b[comp] = _mm256_sub_ps(_mm256_load_ps(tris.v1[axis[comp]]), o);
+			c[comp] = _mm256_sub_ps(_mm256_load_ps(tris.v2[axis[comp]]), o);
+		}
+		__m256 t, u, v, retry;
+		unsigned int bits = store(watertight8(a, b, c, s, _mm256_set1_ps(tmax), t, u, v, retry), t, u, v, hit);
+		for (unsigned int lanes = static_cast<unsigned int>(_mm256_movemask_ps(retry)); lanes != 0U; lanes &= lanes - 1U) {
+			unsigned int lane = _tzcnt_u32(lanes);
+			bits &= ~(1U << lane);
+			if (rayTriangleWatertight(ray, lane_vertex(tris.v0, lane), lane_vertex(tris.v1, lane), lane_vertex(tris.v2, lane), tmax, hit.t[lane], hit.u[lane], hit.v[lane])) {
+				bits |= 1U << lane;
+			}
+		}
+		return bits;
+	}
+
+	unsigned int const rayBox(CRay<CFVector3> const& ray, SBox8 const& boxes, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], inv[FLT3_CNT], lo[FLT3_CNT], hi[FLT3_CNT];
+		splat3(ray.position, o);
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			inv[comp] = reciprocal(_mm256_set1_ps(ray.direction.p[comp]));
+		}
+		load3(boxes.lo, lo);
+		load3(boxes.hi, hi);
+		__m256 t;
+		__m256 mask = slab8(o, inv, lo, hi, _mm256_set1_ps(tmax), t);
+		return store(mask, t, _mm256_setzero_ps(), _mm256_setzero_ps(), hit);
+	}
+
+	unsigned int const rayPlane(CRay<CFVector3> const& ray, SPlane8 const& planes, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], d[FLT3_CNT], n[FLT3_CNT];
+		splat3(ray.position, o);
+		splat3(ray.direction, d);
+		load3(planes.n, n);
+		__m256 t;
+		__m256 mask = plane8(o, d, n, _mm256_load_ps(planes.d), _mm256_set1_ps(tmax), t);
+		return store(mask, t, _mm256_setzero_ps(), _mm256_setzero_ps(), hit);
+	}
+
+	unsigned int const rayTriangle(SRay8 const& rays, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], d[FLT3_CNT], p0[FLT3_CNT], e1[FLT3_CNT], e2[FLT3_CNT];
+		load3(rays.o, o);
+		load3(rays.d, d);
+		splat3(v0, p0);
+		splat3(v1 - v0, e1);
+		splat3(v2 - v0, e2);
+		__m256 t, u, v;
+		__m256 mask = moller8(o, d, p0, e1, e2, _mm256_set1_ps(tmax), t, u, v);
+		return store(mask, t, u, v, hit);
+	}
+
+	unsigned int const rayTriangleWatertight(SRay8 const& rays, CFVector3 const& v0, CFVector3 const& v1, CFVector3 const& v2, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], d[FLT3_CNT];
+		load3(rays.o, o);
+		load3(rays.d, d);
+
+		// レーン毎に方向の絶対値が最大の軸を z とする (同値は小さい軸を優先し、一本の場合と一致させる)
+		__m256 ax = laneAbs(d[0]);
+		__m256 ay = laneAbs(d[1]);
+		__m256 az = laneAbs(d[2]);
+		__m256 m1 = _mm256_cmp_ps(ay, ax, _CMP_GT_OQ);
+		__m256 m2 = _mm256_cmp_ps(az, _mm256_max_ps(ax, ay), _CMP_GT_OQ);
+		m1 = _mm256_andnot_ps(m2, m1);
+		__m256 dz = _mm256_blendv_ps(_mm256_blendv_ps(d[0], d[1], m1), d[2], m2);
+		__m256 flip = _mm256_cmp_ps(dz, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+		__m256 dp[FLT3_CNT];
+		permute(d, m1, m2, flip, dp);
+		__m256 sz = _mm256_div_ps(_mm256_set1_ps(1.0f), dp[2]);
+		__m256 s[FLT3_CNT] = { _mm256_mul_ps(dp[0], sz), _mm256_mul_ps(dp[1], sz), sz };
+
+		__m256 a[FLT3_CNT], b[FLT3_CNT], c[FLT3_CNT], tmp[FLT3_CNT];
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			tmp[comp] = _mm256_sub_ps(_mm256_set1_ps(v0.p[comp]), o[comp]);
+		}
+		permute(tmp, m1, m2, flip, a);
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			tmp[comp] = _mm256_sub_ps(_mm256_set1_ps(v1.p[comp]), o[comp]);
+		}
+		permute(tmp, m1, m2, flip, b);
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			tmp[comp] = _mm256_sub_ps(_mm256_set1_ps(v2.p[comp]), o[comp]);
+		}
+		permute(tmp, m1, m2, flip, c);
+
+		__m256 t, u, v, retry;
+		unsigned int bits = store(watertight8(a, b, c, s, _mm256_set1_ps(tmax), t, u, v, retry), t, u, v, hit);
+		for (unsigned int lanes = static_cast<unsigned int>(_mm256_movemask_ps(retry)); lanes != 0U; lanes &= lanes - 1U) {
+			unsigned int lane = _tzcnt_u32(lanes);
+			bits &= ~(1U << lane);
+			if (rayTriangleWatertight(lane_ray(rays, lane), v0, v1, v2, tmax, hit.t[lane], hit.u[lane], hit.v[lane])) {
+				bits |= 1U << lane;
+			}
+		}
+		return bits;
+	}
+
+	unsigned int const rayBox(SRay8 const& rays, CFAABB3 const& box, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], inv[FLT3_CNT], lo[FLT3_CNT], hi[FLT3_CNT];
+		load3(rays.o, o);
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			inv[comp] = reciprocal(_mm256_load_ps(rays.d[comp]));
+		}
+		splat3(box.lower(), lo);
+		splat3(box.upper(), hi);
+		__m256 t;
+		__m256 mask = slab8(o, inv, lo, hi, _mm256_set1_ps(tmax), t);
+		return store(mask, t, _mm256_setzero_ps(), _mm256_setzero_ps(), hit);
+	}
+
+	unsigned int const rayPlane(SRay8 const& rays, CFPlane3 const& plane, float const& tmax, SHit8& hit) noexcept {
+		__m256 o[FLT3_CNT], d[FLT3_CNT], n[FLT3_CNT];
+		load3(rays.o, o);
+		load3(rays.d, d);
+		splat3(plane.normal(), n);
+		__m256 t;
+		__m256 mask = plane8(o, d, n, _mm256_set1_ps(plane.getDValue()), _mm256_set1_ps(tmax), t);
+		return store(mask, t, _mm256_setzero_ps(), _mm256_setzero_ps(), hit);
+	}
+}
\ No newline at end of file
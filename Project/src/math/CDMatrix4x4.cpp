@@ -0,0 +1,8 @@
+﻿/**	@file	CDMatrix4x4.cpp
+ *	@brief	倍精度浮動小数点数型四次正方行列
+ */
+#include "math/CDMatrix4x4.hpp"
+
+#if !defined(DLAV_MATH_INLINE)
+#	include "math/CDMatrix4x4.inl"
+#endif
\ No newline at end of file
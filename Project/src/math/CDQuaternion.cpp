@@ -0,0 +1,8 @@
+﻿/**	@file	CDQuaternion.cpp
+ *	@brief	倍精度浮動小数点数型四元数
+ */
+#include "math/CDQuaternion.hpp"
+
+#if !defined(DLAV_MATH_INLINE)
+#	include "math/CDQuaternion.inl"
+#endif
\ No newline at end of file
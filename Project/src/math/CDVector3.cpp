@@ -0,0 +1,8 @@
+﻿/**	@file	CDVector3.cpp
+ *	@brief	倍精度浮動小数点数型三次元ベクトル
+ */
+#include "math/CDVector3.hpp"
+
+#if !defined(DLAV_MATH_INLINE)
+#	include "math/CDVector3.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+﻿/**	@file	CFFloatStream.cpp
+ *	@brief	単精度浮動小数点数型のストリーム
+ */
+#include "math/CFFloatStream.hpp"
+
+namespace dlav {
+	CFFloatStream::CFFloatStream() noexcept :
+		m_count(0U),
+		m_data()
+	{}
+
+	CFFloatStream& CFFloatStream::init(size_t const& count, float const& value) {
+		m_count = count;
+		m_data.assign((count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT, value);
+		return *this;
+	}
+
+	size_t const CFFloatStream::size() const noexcept {
+		return m_count;
+	}
+
+	float* const CFFloatStream::data() noexcept {
+		return m_data.data();
+	}
+
+	float const* const CFFloatStream::data() const noexcept {
+		return m_data.data();
+	}
+
+	float& CFFloatStream::operator[](size_t const& idx) noexcept {
+		return m_data[idx];
+	}
+
+	float const& CFFloatStream::operator[](size_t const& idx) const noexcept {
+		return m_data[idx];
+	}
+}
\ No newline at end of file
@@ -21,22 +21,22 @@ namespace dlav {
 	}
 
 	CFRotation& CFRotation::asin(float const& arg) noexcept {
-		m_angle = asinf(arg);
+		m_angle = asinf(arg) / PI<float>;
 		return *this;
 	}
 
 	CFRotation& CFRotation::acos(float const& arg) noexcept {
-		m_angle = acosf(arg);
+		m_angle = acosf(arg) / PI<float>;
 		return *this;
 	}
 
 	CFRotation& CFRotation::atan(float const& arg) noexcept {
-		m_angle = atanf(arg);
+		m_angle = atanf(arg) / PI<float>;
 		return *this;
 	}
 
 	CFRotation& CFRotation::atan(float const& x, float const& y) noexcept {
-		m_angle = atan2f(y, x);
+		m_angle = atan2pi(y, x, EPrecision::PRECISE);
 		return *this;
 	}
 
@@ -69,15 +69,25 @@ namespace dlav {
 	}
 
 	float const CFRotation::sin() const noexcept {
-		return sinf(radian());
+		float s, c;
+		sincos(s, c);
+		return s;
 	}
 
 	float const CFRotation::cos() const noexcept {
-		return cosf(radian());
+		float s, c;
+		sincos(s, c);
+		return c;
 	}
 
 	float const CFRotation::tan() const noexcept {
-		return tanf(radian());
+		float s, c;
+		sincos(s, c);
+		return s / c;
+	}
+
+	void CFRotation::sincos(float& s, float& c) const noexcept {
+		sincospi(m_angle, s, c, EPrecision::PRECISE);
 	}
 
 	CFRotation const CFRotation::anglize() const noexcept {
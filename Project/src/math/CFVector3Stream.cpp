@@ -0,0 +1,41 @@
+﻿/**	@file	CFVector3Stream.cpp
+ *	@brief	単精度浮動小数点数型三次元ベクトルのストリーム
+ */
+#include "math/CFVector3Stream.hpp"
+
+namespace dlav {
+	CFVector3Stream::CFVector3Stream() noexcept :
+		m_count(0U),
+		m_comps()
+	{}
+
+	CFVector3Stream& CFVector3Stream::init(size_t const& count) {
+		m_count = count;
+		for (auto& comp : m_comps) {
+			comp.assign((count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT, 0.0f);
+		}
+		return *this;
+	}
+
+	size_t const CFVector3Stream::size() const noexcept {
+		return m_count;
+	}
+
+	float* const CFVector3Stream::data(unsigned int const& comp) noexcept {
+		return m_comps[comp].data();
+	}
+
+	float const* const CFVector3Stream::data(unsigned int const& comp) const noexcept {
+		return m_comps[comp].data();
+	}
+
+	void CFVector3Stream::set(size_t const& idx, CFVector3 const& arg) noexcept {
+		for (unsigned int comp = 0U; comp < FLT3_CNT; ++comp) {
+			m_comps[comp][idx] = arg.p[comp];
+		}
+	}
+
+	CFVector3 const CFVector3Stream::get(size_t const& idx) const noexcept {
+		return CFVector3(m_comps[0][idx], m_comps[1][idx], m_comps[2][idx]);
+	}
+}
\ No newline at end of file
@@ -6,9 +6,94 @@
 #include "math/CFDualComplex.hpp"
 #include "math/CFDualQuaternion.hpp"
 #include "math/CFEulerRotation.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <numeric>
 
 namespace dlav {
+	namespace {
+		//!	@brief	一括変換関数の処理幅
+		unsigned int constexpr BATCH_CNT = 8U;
+		//!	@brief	ジンバルロックと見做すヨー角の余弦の閾値
+		float constexpr GIMBAL_LOCK_EPSILON = 1.0e-5f;
+
+		//!	@brief	単体変換関数を用いた一括変換関数
+		template <typename D, typename S>
+		void convert(D* const dst, S const* const src, size_t const& count, D const (*func)(S const&) noexcept) noexcept {
+			for (size_t idx = 0U; idx < count; idx++) {
+				dst[idx] = func(src[idx]);
+			}
+		}
+
+		//!	@brief	四成分の要素八つを成分毎のレジスタへ読み込む関数
+		void load8x4(__m256& x, __m256& y, __m256& z, __m256& w, float const* const src) noexcept {
+			__m256 r0 = _mm256_loadu_ps(src);
+			__m256 r1 = _mm256_loadu_ps(src + 8);
+			__m256 r2 = _mm256_loadu_ps(src + 16);
+			__m256 r3 = _mm256_loadu_ps(src + 24);
+			__m256 a = _mm256_permute2f128_ps(r0, r2, 0x20);
+			__m256 b = _mm256_permute2f128_ps(r0, r2, 0x31);
+			__m256 c = _mm256_permute2f128_ps(r1, r3, 0x20);
+			__m256 d = _mm256_permute2f128_ps(r1, r3, 0x31);
+			__m256 t0 = _mm256_unpacklo_ps(a, b);
+			__m256 t1 = _mm256_unpackhi_ps(a, b);
+			__m256 t2 = _mm256_unpacklo_ps(c, d);
+			__m256 t3 = _mm256_unpackhi_ps(c, d);
+			x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			w = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		//!	@brief	成分毎のレジスタから四成分の要素八つへ書き出す関数
+		void store8x4(float* const dst, __m256 const& x, __m256 const& y, __m256 const& z, __m256 const& w) noexcept {
+			__m256 xy0 = _mm256_unpacklo_ps(x, y);
+			__m256 xy1 = _mm256_unpackhi_ps(x, y);
+			__m256 zw0 = _mm256_unpacklo_ps(z, w);
+			__m256 zw1 = _mm256_unpackhi_ps(z, w);
+			__m256 q0 = _mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 q1 = _mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(3, 2, 3, 2));
+			__m256 q2 = _mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 q3 = _mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(3, 2, 3, 2));
+			_mm256_storeu_ps(dst, _mm256_permute2f128_ps(q0, q1, 0x20));
+			_mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(q2, q3, 0x20));
+			_mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(q0, q1, 0x31));
+			_mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(q2, q3, 0x31));
+		}
+
+		//!	@brief	成分毎のレジスタから八つの回転行列へ書き出す関数
+		void storeRotation8(CFMatrix4x4* const dst, __m256 const (&elem)[9U]) noexcept {
+			alignas(32) float lane[9U][BATCH_CNT];
+			for (unsigned int e = 0U; e < 9U; e++) {
+				_mm256_store_ps(lane[e], elem[e]);
+			}
+			for (unsigned int l = 0U; l < BATCH_CNT; l++) {
+				CFMatrix4x4& mtx = dst[l];
+				mtx = UNIT_FMTX4x4;
+				mtx.m00 = lane[0][l]; mtx.m01 = lane[1][l]; mtx.m02 = lane[2][l];
+				mtx.m10 = lane[3][l]; mtx.m11 = lane[4][l]; mtx.m12 = lane[5][l];
+				mtx.m20 = lane[6][l]; mtx.m21 = lane[7][l]; mtx.m22 = lane[8][l];
+			}
+		}
+
+		// CFRotation は π 単位の角度のみを持つ標準レイアウト型である為、
+		// オイラー角の配列は四成分 (末尾は詰め物) の float 配列として扱える
+		static_assert(sizeof(CFRotation) == sizeof(float), "CFRotation must hold a single float.");
+		static_assert(sizeof(CFEulerRotation) == sizeof(float) * 4U, "CFEulerRotation must be four floats wide.");
+
+		//!	@brief	オイラー角配列の角度 (π 単位) 取得関数
+		float const* const angles(CFEulerRotation const* const arg) noexcept {
+			return reinterpret_cast<float const*>(arg);
+		}
+
+		//!	@brief	オイラー角配列の角度 (π 単位) 取得関数
+		float* const angles(CFEulerRotation* const arg) noexcept {
+			return reinterpret_cast<float*>(arg);
+		}
+	}
+
 	template <>
 	float const convert_angle<float>(EAngleType const& type, float const& angle) noexcept {
 		float temp = 0.0f;
@@ -38,7 +123,7 @@ namespace dlav {
 	}
 
 	CFMatrix3x3 const toMtx(CFComplex const& arg) noexcept {
-		CFMatrix3x3 result;
+		CFMatrix3x3 result = UNIT_FMTX3x3;
 		float sin, cos;
 
 		sin = arg.y;
@@ -52,7 +137,7 @@ namespace dlav {
 	}
 
 	CFMatrix4x4 const toMtx(CFQuaternion const& arg) noexcept {
-		CFMatrix4x4 result;
+		CFMatrix4x4 result = UNIT_FMTX4x4;
 
 		result.m00 = sum({ arg.x * arg.x, -(arg.y * arg.y), -(arg.z * arg.z), arg.w * arg.w });
 		result.m11 = sum({ -(arg.x * arg.x), arg.y * arg.y, -(arg.z * arg.z), arg.w * arg.w });
@@ -70,11 +155,10 @@ namespace dlav {
 	}
 
 	CFMatrix3x3 const toMtx(CFRotation const& arg) noexcept {
-		static CFMatrix3x3 result;
+		CFMatrix3x3 result = UNIT_FMTX3x3;
 		float sin, cos;
 
-		sin = arg.sin();
-		cos = arg.cos();
+		arg.sincos(sin, cos);
 
 		result.m00 = result.m11 = cos;
 		result.m01 = -sin;
@@ -84,21 +168,24 @@ namespace dlav {
 	}
 
 	CFMatrix4x4 const toMtx(CFEulerRotation const& arg) noexcept {
-		CFMatrix4x4 pitch, yaw, roll;
-
-		pitch.m11 = pitch.m22 = arg.pitch.cos();
-		yaw.m00 = yaw.m22 = arg.yaw.cos();
-		roll.m00 = roll.m11 = arg.roll.cos();
-
-		pitch.m12 = pitch.m12 = arg.pitch.sin();
-		yaw.m02 = yaw.m20 = arg.yaw.sin();
-		roll.m01 = roll.m10 = arg.roll.sin();
-
-		pitch.m12 *= -1.0f;
-		yaw.m20 *= -1.0f;
-		roll.m01 *= -1.0f;
+		CFMatrix4x4 result = UNIT_FMTX4x4;
+		float sp, cp, sy, cy, sr, cr;
+		arg.pitch.sincos(sp, cp);
+		arg.yaw.sincos(sy, cy);
+		arg.roll.sincos(sr, cr);
+
+		// Rx(pitch) * Ry(yaw) * Rz(roll) を展開したもの
+		result.m00 = cy * cr;
+		result.m01 = -cy * sr;
+		result.m02 = sy;
+		result.m10 = sum({ sp * sy * cr, cp * sr });
+		result.m11 = sum({ cp * cr, -(sp * sy * sr) });
+		result.m12 = -sp * cy;
+		result.m20 = sum({ sp * sr, -(cp * sy * cr) });
+		result.m21 = sum({ cp * sy * sr, sp * cr });
+		result.m22 = cp * cy;
 
-		return pitch * yaw * roll;
+		return result;
 	}
 
 	CFRotation const toRot(CFComplex const& arg) noexcept {
@@ -107,44 +194,78 @@ namespace dlav {
 		return result;
 	}
 
-	CFEulerRotation const toRot(CFQuaternion const&) noexcept {
-		// TODO : 変換式を調べて実装する。
-		return CFEulerRotation();
+	CFEulerRotation const toRot(CFQuaternion const& arg) noexcept {
+		float xx = arg.x * arg.x, yy = arg.y * arg.y, zz = arg.z * arg.z, ww = arg.w * arg.w;
+		float sq = sum({ xx, yy, zz, ww });
+		CFMatrix4x4 mtx = UNIT_FMTX4x4;
+
+		if (sq <= 0.0f) {
+			return CFEulerRotation();
+		}
+
+		// 正規化されていない四元数でも角度が変わらないよう、ノルム二乗で割る
+		mtx.m00 = sum({ xx, -yy, -zz, ww }) / sq;
+		mtx.m11 = sum({ -xx, yy, -zz, ww }) / sq;
+		mtx.m22 = sum({ -xx, -yy, zz, ww }) / sq;
+		mtx.m01 = 2.0f * sum({ arg.x * arg.y, -(arg.z * arg.w) }) / sq;
+		mtx.m02 = 2.0f * sum({ arg.x * arg.z, arg.y * arg.w }) / sq;
+		mtx.m12 = 2.0f * sum({ arg.y * arg.z, -(arg.x * arg.w) }) / sq;
+		mtx.m21 = 2.0f * sum({ arg.y * arg.z, arg.x * arg.w }) / sq;
+
+		return toRot(mtx);
 	}
 
-	CFRotation const toRot(CFMatrix3x3 const&) noexcept {
-		// TODO : 変換式を調べて実装する。
-		return CFRotation();
+	CFRotation const toRot(CFMatrix3x3 const& arg) noexcept {
+		CFRotation result;
+		result.atan(arg.m00, arg.m10);
+		return result;
 	}
 
-	CFEulerRotation const toRot(CFMatrix4x4 const&) noexcept {
-		// TODO : 変換式を調べて実装する。
-		return CFEulerRotation();
+	CFEulerRotation const toRot(CFMatrix4x4 const& arg) noexcept {
+		CFEulerRotation result;
+		float cy = sqrt(sum({ arg.m00 * arg.m00, arg.m01 * arg.m01 }));
+
+		// ±90° 付近でも精度が落ちないよう、ヨー角は逆正接で求める
+		result.yaw.atan(cy, arg.m02);
+		if (cy > GIMBAL_LOCK_EPSILON) {
+			result.pitch.atan(arg.m22, -arg.m12);
+			result.roll.atan(arg.m00, -arg.m01);
+		}
+		else {
+			// ジンバルロック時はロール角を 0 とし、残りをピッチ角へ寄せる
+			result.pitch.atan(arg.m11, arg.m21);
+			result.roll.radian(0.0f);
+		}
+
+		return result;
 	}
 
-	CFComplex const toCmp(CFMatrix3x3 const&) noexcept {
-		// TODO : 変換式を調べて実装する。
-		return CFComplex();
+	CFComplex const toCmp(CFMatrix3x3 const& arg) noexcept {
+		CFComplex result;
+		result.x = arg.m00;
+		result.y = arg.m10;
+		return result;
 	}
 
 	CFQuaternion const toQt(CFMatrix4x4 const& arg) noexcept {
-		float mult, v, biggest = FLT_MIN;
-		unsigned long int i = 0U;
-		CFQuaternion result = ZERO_FQT;
+		float mult, v;
+		unsigned int i = 0U;
+		CFQuaternion result = UNIT_FQT;
 		CFVector4 tmp = ZERO_FVT4;
 
+		// 各成分の二乗の四倍
 		tmp.x = sum({ arg.m00, -arg.m11, -arg.m22, 1.0f });
 		tmp.y = sum({ -arg.m00,  arg.m11, -arg.m22, 1.0f });
 		tmp.z = sum({ -arg.m00, -arg.m11,  arg.m22, 1.0f });
 		tmp.w = sum({ arg.m00,  arg.m11,  arg.m22, 1.0f });
 
-		for (unsigned long int idx = 0U; idx < 4U; idx++) {
-			if (biggest > tmp.p[idx]) {
-				biggest = tmp.p[idx];
+		// 最大成分を基準にすることで除算を安定させる
+		for (unsigned int idx = 1U; idx < FLT4_CNT; idx++) {
+			if (tmp.p[idx] > tmp.p[i]) {
 				i = idx;
 			}
 		}
-		if (tmp.p[i] < 0.0f) {
+		if (tmp.p[i] <= 0.0f) {
 			return result;
 		}
 
@@ -154,23 +275,23 @@ namespace dlav {
 		switch (i) {
 		case 0:
 			result.y = sum({ arg.m01,  arg.m10 }) * mult;
-			result.z = sum({ arg.m20,  arg.m02 }) * mult;
-			result.w = sum({ arg.m12, -arg.m21 }) * mult;
+			result.z = sum({ arg.m02,  arg.m20 }) * mult;
+			result.w = sum({ arg.m21, -arg.m12 }) * mult;
 			break;
 		case 1:
 			result.x = sum({ arg.m01,  arg.m10 }) * mult;
 			result.z = sum({ arg.m12,  arg.m21 }) * mult;
-			result.w = sum({ arg.m20, -arg.m02 }) * mult;
+			result.w = sum({ arg.m02, -arg.m20 }) * mult;
 			break;
 		case 2:
-			result.x = sum({ arg.m20,  arg.m02 }) * mult;
+			result.x = sum({ arg.m02,  arg.m20 }) * mult;
 			result.y = sum({ arg.m12,  arg.m21 }) * mult;
-			result.w = sum({ arg.m01, -arg.m10 }) * mult;
+			result.w = sum({ arg.m10, -arg.m01 }) * mult;
 			break;
 		case 3:
-			result.x = sum({ arg.m12, -arg.m21 }) * mult;
-			result.y = sum({ arg.m20, -arg.m02 }) * mult;
-			result.z = sum({ arg.m01, -arg.m10 }) * mult;
+			result.x = sum({ arg.m21, -arg.m12 }) * mult;
+			result.y = sum({ arg.m02, -arg.m20 }) * mult;
+			result.z = sum({ arg.m10, -arg.m01 }) * mult;
 			break;
 		}
 
@@ -179,86 +300,256 @@ namespace dlav {
 
 	CFComplex const toCmp(CFRotation const& arg) noexcept {
 		CFComplex result;
-		result.x = arg.cos();
-		result.y = arg.sin();
+		arg.sincos(result.y, result.x);
 		return result;
 	}
 
 	CFQuaternion const toQt(CFEulerRotation const& arg) noexcept {
-		CFQuaternion pitch, yaw, roll;
-		pitch.w = arg.pitch.cos();
-		pitch.x = arg.pitch.sin();
-		yaw.w = arg.yaw.cos();
-		yaw.y = arg.yaw.sin();
-		roll.w = arg.roll.cos();
-		roll.z = arg.roll.sin();
-		return pitch * yaw * roll;
-	}
-
-	CFMatrix3x3 const makeTransit(EHandSide const& hs, CFVector2 const& vt) noexcept {
-		CFMatrix3x3 tmp = UNIT_FMTX3x3;
-		switch (hs) {
-		case EHandSide::LHS:
-			tmp.m02 = vt.x;
-			tmp.m12 = vt.y;
-			break;
-		case EHandSide::RHS:
-			tmp.m20 = vt.x;
-			tmp.m21 = vt.y;
-			break;
+		CFQuaternion result;
+		CFRotation pitch = arg.pitch * 0.5f, yaw = arg.yaw * 0.5f, roll = arg.roll * 0.5f;
+		float sp, cp, sy, cy, sr, cr;
+		pitch.sincos(sp, cp);
+		yaw.sincos(sy, cy);
+		roll.sincos(sr, cr);
+
+		// qx(pitch) * qy(yaw) * qz(roll) を展開したもの
+		result.x = sum({ sp * cy * cr, cp * sy * sr });
+		result.y = sum({ cp * sy * cr, -(sp * cy * sr) });
+		result.z = sum({ sp * sy * cr, cp * cy * sr });
+		result.w = sum({ cp * cy * cr, -(sp * sy * sr) });
+
+		return result;
+	}
+
+	void toMtx(CFMatrix3x3* const dst, CFComplex const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toMtx);
+	}
+
+	void toMtx(CFMatrix3x3* const dst, CFRotation const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toMtx);
+	}
+
+	void toMtx(CFMatrix4x4* const dst, CFQuaternion const* const src, size_t const& count) noexcept {
+		size_t idx = 0U;
+		for (; idx + BATCH_CNT <= count; idx += BATCH_CNT) {
+			__m256 x, y, z, w;
+			load8x4(x, y, z, w, src[idx].p);
+
+			__m256 two = _mm256_set1_ps(2.0f);
+			__m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y);
+			__m256 zz = _mm256_mul_ps(z, z), ww = _mm256_mul_ps(w, w);
+			__m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+			__m256 xw = _mm256_mul_ps(x, w), yw = _mm256_mul_ps(y, w), zw = _mm256_mul_ps(z, w);
+			__m256 elem[9U] = {
+				_mm256_sub_ps(_mm256_add_ps(xx, ww), _mm256_add_ps(yy, zz)),
+				_mm256_mul_ps(two, _mm256_sub_ps(xy, zw)),
+				_mm256_mul_ps(two, _mm256_add_ps(xz, yw)),
+				_mm256_mul_ps(two, _mm256_add_ps(xy, zw)),
+				_mm256_sub_ps(_mm256_add_ps(yy, ww), _mm256_add_ps(xx, zz)),
+				_mm256_mul_ps(two, _mm256_sub_ps(yz, xw)),
+				_mm256_mul_ps(two, _mm256_sub_ps(xz, yw)),
+				_mm256_mul_ps(two, _mm256_add_ps(yz, xw)),
+				_mm256_sub_ps(_mm256_add_ps(zz, ww), _mm256_add_ps(xx, yy)),
+			};
+
+			storeRotation8(&dst[idx], elem);
+		}
+		for (; idx < count; idx++) {
+			dst[idx] = toMtx(src[idx]);
 		}
-		return tmp;
 	}
 
-	CFMatrix4x4 const makeTransit(EHandSide const& hs, CFVector3 const& vt) noexcept {
-		CFMatrix4x4 tmp = UNIT_FMTX4x4;
-		switch (hs) {
-		case EHandSide::LHS:
-			tmp.m03 = vt.x;
-			tmp.m13 = vt.y;
-			tmp.m23 = vt.z;
-			break;
-		case EHandSide::RHS:
-			tmp.m30 = vt.x;
-			tmp.m31 = vt.y;
-			tmp.m32 = vt.z;
-			break;
+	void toMtx(CFMatrix4x4* const dst, CFEulerRotation const* const src, size_t const& count) noexcept {
+		size_t idx = 0U;
+		for (; idx + BATCH_CNT <= count; idx += BATCH_CNT) {
+			__m256 pitch, yaw, roll, pad;
+			load8x4(pitch, yaw, roll, pad, angles(&src[idx]));
+
+			__m256 sp, cp, sy, cy, sr, cr;
+			sincospi(pitch, sp, cp, EPrecision::PRECISE);
+			sincospi(yaw, sy, cy, EPrecision::PRECISE);
+			sincospi(roll, sr, cr, EPrecision::PRECISE);
+
+			__m256 spsy = _mm256_mul_ps(sp, sy), cpsy = _mm256_mul_ps(cp, sy);
+			__m256 elem[9U] = {
+				_mm256_mul_ps(cy, cr),
+				_mm256_xor_ps(_mm256_mul_ps(cy, sr), _mm256_set1_ps(-0.0f)),
+				sy,
+				_mm256_fmadd_ps(spsy, cr, _mm256_mul_ps(cp, sr)),
+				_mm256_fnmadd_ps(spsy, sr, _mm256_mul_ps(cp, cr)),
+				_mm256_xor_ps(_mm256_mul_ps(sp, cy), _mm256_set1_ps(-0.0f)),
+				_mm256_fnmadd_ps(cpsy, cr, _mm256_mul_ps(sp, sr)),
+				_mm256_fmadd_ps(cpsy, sr, _mm256_mul_ps(sp, cr)),
+				_mm256_mul_ps(cp, cy),
+			};
+			storeRotation8(&dst[idx], elem);
+		}
+		for (; idx < count; idx++) {
+			dst[idx] = toMtx(src[idx]);
 		}
-		return tmp;
 	}
 
-	CFMatrix4x4 const makeRotate(EHandSide const& hs, CFQuaternion const& qt) noexcept {
-		CFMatrix4x4 result = UNIT_FMTX4x4;
+	void toRot(CFRotation* const dst, CFComplex const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toRot);
+	}
+
+	void toRot(CFRotation* const dst, CFMatrix3x3 const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toRot);
+	}
 
-		result.m00 = sum({ qt.x * qt.x, -(qt.y * qt.y), -(qt.z * qt.z), qt.w * qt.w });
-		result.m11 = sum({ -(qt.x * qt.x), qt.y * qt.y, -(qt.z * qt.z), qt.w * qt.w });
-		result.m22 = sum({ -(qt.x * qt.x), -(qt.y * qt.y), qt.z * qt.z, qt.w * qt.w });
+	void toRot(CFEulerRotation* const dst, CFQuaternion const* const src, size_t const& count) noexcept {
+		size_t idx = 0U;
+		for (; idx + BATCH_CNT <= count; idx += BATCH_CNT) {
+			__m256 x, y, z, w;
+			load8x4(x, y, z, w, src[idx].p);
+
+			__m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f);
+			__m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y);
+			__m256 zz = _mm256_mul_ps(z, z), ww = _mm256_mul_ps(w, w);
+			__m256 sq = _mm256_add_ps(_mm256_add_ps(xx, yy), _mm256_add_ps(zz, ww));
+			__m256 valid = _mm256_cmp_ps(sq, _mm256_setzero_ps(), _CMP_GT_OQ);
+			__m256 inv = _mm256_blendv_ps(one, _mm256_div_ps(one, sq), valid);
+
+			// 回転行列の必要な要素のみを求める (toRot(CFQuaternion) と同じ式)
+			__m256 m00 = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(xx, ww), _mm256_add_ps(yy, zz)), inv);
+			__m256 m11 = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(yy, ww), _mm256_add_ps(xx, zz)), inv);
+			__m256 m22 = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(zz, ww), _mm256_add_ps(xx, yy)), inv);
+			__m256 m01 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_fmsub_ps(x, y, _mm256_mul_ps(z, w))), inv);
+			__m256 m02 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_fmadd_ps(x, z, _mm256_mul_ps(y, w))), inv);
+			__m256 m12 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_fmsub_ps(y, z, _mm256_mul_ps(x, w))), inv);
+			__m256 m21 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_fmadd_ps(y, z, _mm256_mul_ps(x, w))), inv);
+			__m256 cy = _mm256_sqrt_ps(_mm256_fmadd_ps(m00, m00, _mm256_mul_ps(m01, m01)));
+
+			// ジンバルロック時の分岐を選択で置き換える
+			__m256 sign = _mm256_set1_ps(-0.0f);
+			__m256 lock = _mm256_cmp_ps(cy, _mm256_set1_ps(GIMBAL_LOCK_EPSILON), _CMP_LE_OQ);
+			__m256 py = _mm256_blendv_ps(_mm256_xor_ps(m12, sign), m21, lock);
+			__m256 px = _mm256_blendv_ps(m22, m11, lock);
+			__m256 ry = _mm256_andnot_ps(lock, _mm256_xor_ps(m01, sign));
+			__m256 rx = _mm256_blendv_ps(m00, one, lock);
+
+			__m256 pitch = atan2pi(py, px, EPrecision::PRECISE);
+			__m256 yaw = atan2pi(m02, cy, EPrecision::PRECISE);
+			__m256 roll = atan2pi(ry, rx, EPrecision::PRECISE);
+			store8x4(angles(&dst[idx]), pitch, yaw, roll, _mm256_setzero_ps());
+		}
+		for (; idx < count; idx++) {
+			dst[idx] = toRot(src[idx]);
+		}
+	}
 
-		result.m21 = 2.0f * sum({ qt.y * qt.z, qt.x * qt.w });
-		result.m10 = 2.0f * sum({ qt.x * qt.y, qt.z * qt.w });
-		result.m02 = 2.0f * sum({ qt.x * qt.z, qt.y * qt.w });
+	void toRot(CFEulerRotation* const dst, CFMatrix4x4 const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toRot);
+	}
 
-		result.m01 = 2.0f * sum({ qt.x * qt.y, -(qt.z * qt.w) });
-		result.m12 = 2.0f * sum({ qt.y * qt.z, -(qt.x * qt.w) });
-		result.m20 = 2.0f * sum({ qt.x * qt.z, -(qt.y * qt.w) });
+	void toCmp(CFComplex* const dst, CFMatrix3x3 const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toCmp);
+	}
 
-		return hs == EHandSide::LHS ? result.transpose() : result;
+	void toCmp(CFComplex* const dst, CFRotation const* const src, size_t const& count) noexcept {
+		convert(dst, src, count, toCmp);
+	}
+
+	void toQt(CFQuaternion* const dst, CFMatrix4x4 const* const src, size_t const& count) noexcept {
+		__m256i const offset = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+		size_t idx = 0U;
+		for (; idx + BATCH_CNT <= count; idx += BATCH_CNT) {
+			float const* const base = src[idx].p;
+			__m256 m00 = _mm256_i32gather_ps(base +  0, offset, 4);
+			__m256 m01 = _mm256_i32gather_ps(base +  1, offset, 4);
+			__m256 m02 = _mm256_i32gather_ps(base +  2, offset, 4);
+			__m256 m10 = _mm256_i32gather_ps(base +  4, offset, 4);
+			__m256 m11 = _mm256_i32gather_ps(base +  5, offset, 4);
+			__m256 m12 = _mm256_i32gather_ps(base +  6, offset, 4);
+			__m256 m20 = _mm256_i32gather_ps(base +  8, offset, 4);
+			__m256 m21 = _mm256_i32gather_ps(base +  9, offset, 4);
+			__m256 m22 = _mm256_i32gather_ps(base + 10, offset, 4);
+
+			__m256 one = _mm256_set1_ps(1.0f);
+			__m256 t0 = _mm256_add_ps(_mm256_sub_ps(m00, _mm256_add_ps(m11, m22)), one);
+			__m256 t1 = _mm256_add_ps(_mm256_sub_ps(m11, _mm256_add_ps(m00, m22)), one);
+			__m256 t2 = _mm256_add_ps(_mm256_sub_ps(m22, _mm256_add_ps(m00, m11)), one);
+			__m256 t3 = _mm256_add_ps(_mm256_add_ps(m00, _mm256_add_ps(m11, m22)), one);
+
+			// 最大成分の選択 (toQt(CFMatrix4x4) の分岐をマスクで置き換える)
+			__m256 sel3 = _mm256_cmp_ps(t3, _mm256_max_ps(t0, _mm256_max_ps(t1, t2)), _CMP_GE_OQ);
+			__m256 sel0 = _mm256_andnot_ps(sel3, _mm256_cmp_ps(t0, _mm256_max_ps(t1, t2), _CMP_GE_OQ));
+			__m256 sel1 = _mm256_andnot_ps(_mm256_or_ps(sel3, sel0), _mm256_cmp_ps(t1, t2, _CMP_GE_OQ));
+			__m256 sel2 = _mm256_andnot_ps(_mm256_or_ps(sel3, _mm256_or_ps(sel0, sel1)), _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+
+			__m256 t = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(t2, t1, sel1), t0, sel0), t3, sel3);
+			__m256 valid = _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_GT_OQ);
+			__m256 v = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_max_ps(t, _mm256_set1_ps(FLT_MIN))), _mm256_set1_ps(0.5f));
+			__m256 mult = _mm256_div_ps(_mm256_set1_ps(0.25f), v);
+
+			__m256 a = _mm256_add_ps(m01, m10), b = _mm256_add_ps(m02, m20), c = _mm256_add_ps(m12, m21);
+			__m256 d = _mm256_sub_ps(m21, m12), e = _mm256_sub_ps(m02, m20), f = _mm256_sub_ps(m10, m01);
+
+			__m256 nx = _mm256_blendv_ps(_mm256_blendv_ps(d, b, sel2), a, sel1);
+			__m256 ny = _mm256_blendv_ps(_mm256_blendv_ps(e, c, sel2), a, sel0);
+			__m256 nz = _mm256_blendv_ps(_mm256_blendv_ps(f, c, sel1), b, sel0);
+			__m256 nw = _mm256_blendv_ps(_mm256_blendv_ps(f, e, sel1), d, sel0);
+
+			__m256 x = _mm256_blendv_ps(_mm256_mul_ps(nx, mult), v, sel0);
+			__m256 y = _mm256_blendv_ps(_mm256_mul_ps(ny, mult), v, sel1);
+			__m256 z = _mm256_blendv_ps(_mm256_mul_ps(nz, mult), v, sel2);
+			__m256 w = _mm256_blendv_ps(_mm256_mul_ps(nw, mult), v, sel3);
+
+			// 変換できない要素は単位四元数とする
+			x = _mm256_and_ps(x, valid);
+			y = _mm256_and_ps(y, valid);
+			z = _mm256_and_ps(z, valid);
+			w = _mm256_blendv_ps(one, w, valid);
+
+			store8x4(dst[idx].p, x, y, z, w);
+		}
+		for (; idx < count; idx++) {
+			dst[idx] = toQt(src[idx]);
+		}
+	}
+
+	void toQt(CFQuaternion* const dst, CFEulerRotation const* const src, size_t const& count) noexcept {
+		size_t idx = 0U;
+		for (; idx + BATCH_CNT <= count; idx += BATCH_CNT) {
+			__m256 pitch, yaw, roll, pad;
+			load8x4(pitch, yaw, roll, pad, angles(&src[idx]));
+
+			__m256 half = _mm256_set1_ps(0.5f);
+			__m256 sp, cp, sy, cy, sr, cr;
+			sincospi(_mm256_mul_ps(pitch, half), sp, cp, EPrecision::PRECISE);
+			sincospi(_mm256_mul_ps(yaw, half), sy, cy, EPrecision::PRECISE);
+			sincospi(_mm256_mul_ps(roll, half), sr, cr, EPrecision::PRECISE);
+
+			__m256 spcy = _mm256_mul_ps(sp, cy), cpsy = _mm256_mul_ps(cp, sy);
+			__m256 spsy = _mm256_mul_ps(sp, sy), cpcy = _mm256_mul_ps(cp, cy);
+			__m256 x = _mm256_fmadd_ps(spcy, cr, _mm256_mul_ps(cpsy, sr));
+			__m256 y = _mm256_fmsub_ps(cpsy, cr, _mm256_mul_ps(spcy, sr));
+			__m256 z = _mm256_fmadd_ps(spsy, cr, _mm256_mul_ps(cpcy, sr));
+			__m256 w = _mm256_fmsub_ps(cpcy, cr, _mm256_mul_ps(spsy, sr));
+			store8x4(dst[idx].p, x, y, z, w);
+		}
+		for (; idx < count; idx++) {
+			dst[idx] = toQt(src[idx]);
+		}
 	}
 
 	CFMatrix3x3 const makeRotate(EHandSide const& hs, CFRotation const& rot) noexcept {
 		CFMatrix3x3 result = UNIT_FMTX3x3;
+		float sin, cos;
+		rot.sincos(sin, cos);
 
-		result.m00 = rot.cos();
-		result.m01 =-rot.sin();
-		result.m10 = rot.sin();
-		result.m11 = rot.cos();
+		result.m00 = cos;
+		result.m01 =-sin;
+		result.m10 = sin;
+		result.m11 = cos;
 
 		return hs == EHandSide::LHS ? result.transpose() : result;
 	}
 
 	CFMatrix4x4 const makeRotate(EHandSide const& hs, CFVector3 const& axis, CFRotation const& rot) noexcept {
 		CFMatrix4x4 result;
-		float sin = rot.sin(), cos = rot.cos();
+		float sin, cos;
+		rot.sincos(sin, cos);
 		CFVector3 n = axis.normalize();
 
 		result.m00 = cos + n.x * n.x * (1.0f - cos);
@@ -276,21 +567,6 @@ namespace dlav {
 		return hs == EHandSide::LHS ? result.transpose() : result;
 	}
 
-	CFMatrix3x3 const makeScaler(CFVector2 const& vt) noexcept {
-		CFMatrix3x3 tmp = UNIT_FMTX3x3;
-		tmp.m00 = vt.x;
-		tmp.m11 = vt.y;
-		return tmp;
-	}
-
-	CFMatrix4x4 const makeScaler(CFVector3 const& vt) noexcept {
-		CFMatrix4x4 tmp = UNIT_FMTX4x4;
-		tmp.m00 = vt.x;
-		tmp.m11 = vt.y;
-		tmp.m22 = vt.z;
-		return tmp;
-	}
-
 	CFMatrix3x3 const makeSkew(EHandSide const& hs, ESkewType const& st, CFRotation const& rot) noexcept {
 		CFMatrix3x3 result = UNIT_FMTX3x3;
 		switch (st) {
@@ -338,50 +614,89 @@ namespace dlav {
 		return (hs == EHandSide::LHS) ? result.transpose() : result;
 	}
 
-	/*/
-	CFMatrix4x4 const makePerspectiveMatrix(EHandSide const& hs, float const& near, float const& far, float const& width, float const& height, float const& wndpos) noexcept {
-		CFMatrix4x4 result;
-		float z = near / far;
-		float dz = 1.0f - z;
-		float ifar = 1.0f / far;
-		float x_tan = wndpos / (width * 0.5f);
-		float y_tan = wndpos / (height * 0.5f);
-		float aspect = width / height;
+	CFMatrix4x4 const makePerspectiveMatrix(EHandSide const& hs, float const& front, float const& back, float const& width, float const& height, float const& wndpos, EDepthMode const& dm) noexcept {
+		// 列ベクトル形式で組み立て、右手系 (行ベクトル形式) では転置する
+		// 視線は -z 方向の為 w = -z とし、z = -front, -back がそれぞれ深度の両端に写る
+		float range = 1.0f / (back - front);
+		float a = 0.0f;
+		float b = 0.0f;
+		switch (dm) {
+		case EDepthMode::REVERSED:
+			a = front * range;
+			b = front * back * range;
+			break;
+		default:
+			a = -back * range;
+			b = -front * back * range;
+			break;
+		}
 
-		switch (hs) {
-		case EHandSide::LHS:
-			result = CFMatrix4x4(
-				x_tan, 0.0f, 0.0f, 0.0f,
-				0.0f, y_tan * aspect, 0.0f, 0.0f,
-				0.0f, 0.0f, 1.0f / dz, z / dz,
-				0.0f, 0.0f, -1.0f, 0.0f
-			);
+		CFMatrix4x4 result(
+			2.0f * wndpos / width, 0.0f, 0.0f, 0.0f,
+			0.0f, 2.0f * wndpos / height, 0.0f, 0.0f,
+			0.0f, 0.0f, a, b,
+			0.0f, 0.0f, -1.0f, 0.0f
+		);
+		return (hs == EHandSide::RHS) ? result.transpose() : result;
+	}
+
+	CFMatrix4x4 const makeInfinitePerspectiveMatrix(EHandSide const& hs, float const& front, float const& width, float const& height, float const& wndpos, EDepthMode const& dm) noexcept {
+		// makePerspectiveMatrix の係数の back → ∞ の極限
+		float a = 0.0f;
+		float b = 0.0f;
+		switch (dm) {
+		case EDepthMode::REVERSED:
+			b = front;
 			break;
-		case EHandSide::RHS:
-			result = CFMatrix4x4(
-				x_tan, 0.0f, 0.0f, 0.0f,
-				0.0f, y_tan * aspect, 0.0f, 0.0f,
-				0.0f, 0.0f, 1.0f / dz, -z / dz,
-				0.0f, 0.0f, 1.0f, 0.0f
-			);
+		default:
+			a = -1.0f;
+			b = -front;
 			break;
 		}
 
-		return result;
+		CFMatrix4x4 result(
+			2.0f * wndpos / width, 0.0f, 0.0f, 0.0f,
+			0.0f, 2.0f * wndpos / height, 0.0f, 0.0f,
+			0.0f, 0.0f, a, b,
+			0.0f, 0.0f, -1.0f, 0.0f
+		);
+		return (hs == EHandSide::RHS) ? result.transpose() : result;
+	}
+
+	CFMatrix4x4 const makeOrthographicMatrix(EHandSide const& hs, float const& front, float const& back, float const& width, float const& height, EDepthMode const& dm) noexcept {
+		float range = 1.0f / (back - front);
+		float a = 0.0f;
+		float b = 0.0f;
+		switch (dm) {
+		case EDepthMode::REVERSED:
+			a = range;
+			b = back * range;
+			break;
+		default:
+			a = -range;
+			b = -front * range;
+			break;
+		}
+
+		CFMatrix4x4 result(
+			2.0f / width, 0.0f, 0.0f, 0.0f,
+			0.0f, 2.0f / height, 0.0f, 0.0f,
+			0.0f, 0.0f, a, b,
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+		return (hs == EHandSide::RHS) ? result.transpose() : result;
 	}
-	/*/
 
 	CFVector2 const makeNormalizedXAxis(CFRotation const& rot) noexcept {
 		CFVector2 result;
-		result.x = rot.cos();
-		result.y =-rot.sin();
+		rot.sincos(result.y, result.x);
+		result.y = -result.y;
 		return result.normalize();
 	}
 
 	CFVector2 const makeNormalizedYAxis(CFRotation const& rot) noexcept {
 		CFVector2 result;
-		result.x = rot.sin();
-		result.y = rot.cos();
+		rot.sincos(result.x, result.y);
 		return result.normalize();
 	}
 	
@@ -408,4 +723,35 @@ namespace dlav {
 		result.z = sum({ -(qt.x * qt.x), -(qt.y * qt.y), qt.z * qt.z, qt.w * qt.w });
 		return result.normalize();
 	}
+	CFMatrix3x3 const makeLinear(EHandSide const& hs, CFMatrix4x4 const& mtx) noexcept {
+		CFMatrix3x3 result(
+			mtx.p[0], mtx.p[1], mtx.p[2],
+			mtx.p[4], mtx.p[5], mtx.p[6],
+			mtx.p[8], mtx.p[9], mtx.p[10]
+		);
+		return (hs == EHandSide::RHS) ? result.transpose() : result;
+	}
+
+	CFVector3 const makeOffset(EHandSide const& hs, CFMatrix4x4 const& mtx) noexcept {
+		switch (hs) {
+		case EHandSide::RHS:
+			return CFVector3(mtx.p[12], mtx.p[13], mtx.p[14]);
+		default:
+			return CFVector3(mtx.p[3], mtx.p[7], mtx.p[11]);
+		}
+	}
+
+	float const linearScale(CFMatrix3x3 const& linear) noexcept {
+		// 最大特異値の二乗は Ｌ^T Ｌ の最大固有値で、行列の無限大ノルム (行の絶対値和の最大値) 以下となる
+		CFVector3 axes[FLT3_CNT] = { linear.column(0U), linear.column(1U), linear.column(2U) };
+		float bound = 0.0f;
+		for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+			float sum = 0.0f;
+			for (unsigned int col = 0U; col < FLT3_CNT; ++col) {
+				sum += fabsf(dot(axes[row], axes[col]));
+			}
+			bound = std::max(bound, sum);
+		}
+		return sqrtf(bound);
+	}
 }
\ No newline at end of file
@@ -3,164 +3,190 @@
  */
 #include "math/Math.hpp"
 #include <immintrin.h>
+#include <cmath>
 #include <numeric>
 
-namespace dlav {
-	template <>
-	int const compare<float>(float const& lhs, float const& rhs) noexcept {
-		if (fabsf(lhs - rhs) < FLT_EPSILON * fmaxf(fmaxf(fabsf(lhs), fabsf(rhs)), 1.0f)) {
-			return 0;
-		}
-		if (lhs < rhs) {
-			return -1;
-		}
-		return 1;
-	}
-
-	template <>
-	int const compare<double>(double const& lhs, double const& rhs) noexcept {
-		if (fabs(lhs - rhs) < DBL_EPSILON * fmax(fmax(fabs(lhs), fabs(rhs)), 1.0f)) {
-			return 0;
-		}
-		if (lhs < rhs) {
-			return -1;
-		}
-		return 1;
-	}
+#if !defined(DLAV_MATH_INLINE)
+#	include "math/Math.inl"
+#endif
 
-	template <>
-	float const sum<float>(float const* const args, size_t const& size) noexcept {
-		float result = 0.0f;
-		if (args == nullptr || size == 0U) {
+namespace dlav {
+	namespace {
+		//!	@brief	正弦の近似多項式係数 (低精度、π 単位の角度 r に対して r * P(r^2))
+		float constexpr SIN_FAST[] = { 3.141576938e+00f, -5.165695913e+00f, 2.485356450e+00f };
+		//!	@brief	余弦の近似多項式係数 (低精度、P(r^2))
+		float constexpr COS_FAST[] = { 9.999900454e-01f, -4.931922319e+00f, 3.935192924e+00f };
+		//!	@brief	正弦の近似多項式係数 (高精度)
+		float constexpr SIN_PRECISE[] = { 3.141592610e+00f, -5.167703505e+00f, 2.549628876e+00f, -5.878128286e-01f };
+		//!	@brief	余弦の近似多項式係数 (高精度)
+		float constexpr COS_PRECISE[] = { 1.000000000e+00f, -4.934802162e+00f, 4.058707222e+00f, -1.335043557e+00f, 2.313219022e-01f };
+		//!	@brief	逆正接の近似多項式係数 (低精度、[-tan(π/8), +tan(π/8)] で t * P(t^2) / π)
+		float constexpr ATAN_FAST[] = { 3.182905871e-01f, -1.051681904e-01f, 5.207091374e-02f };
+		//!	@brief	逆正接の近似多項式係数 (高精度)
+		float constexpr ATAN_PRECISE[] = { 3.183098561e-01f, -1.060997007e-01f, 6.354090577e-02f, -4.378288733e-02f, 2.461975442e-02f };
+		//!	@brief	tan(π/8)
+		float constexpr TAN_PI_8 = 0.414213562f;
+
+		//!	@brief	多項式評価関数 (ホーナー法)
+		template <size_t N>
+		float const horner(float const (&coef)[N], float const& x) noexcept {
+			float result = coef[N - 1U];
+			for (size_t idx = N - 1U; idx > 0U; --idx) {
+				result = result * x + coef[idx - 1U];
+			}
 			return result;
 		}
 
-		volatile float y, c, t;
-		c = 0.0f;
-		for (size_t idx = 0U; idx < size; ++idx) {
-			y = *(args + idx) - c;
-			t = result + y;
-			c = (t - result) - y;
-			result = t;
+		//!	@brief	多項式評価関数 (ホーナー法)
+		template <size_t N>
+		__m256 const horner(float const (&coef)[N], __m256 const& x) noexcept {
+			__m256 result = _mm256_set1_ps(coef[N - 1U]);
+			for (size_t idx = N - 1U; idx > 0U; --idx) {
+				result = _mm256_fmadd_ps(result, x, _mm256_set1_ps(coef[idx - 1U]));
+			}
+			return result;
 		}
-
-		return result;
 	}
 
 	template <>
-	double const sum<double>(double const* const args, size_t const& size) noexcept {
-		double result = 0.0;
-		if (args == nullptr || size == 0U) {
-			return result;
-		}
-
-		volatile double y, c, t;
-		c = 0.0;
-		for (size_t idx = 0U; idx < size; ++idx) {
-			y = *(args + idx) - c;
-			t = result + y;
-			c = (t - result) - y;
-			result = t;
+	void sincospi<float>(float const& arg, float& sin, float& cos, EPrecision const& prec) noexcept {
+		// 最も近い 1/2 周で折り返し、[-1/4, +1/4] の範囲で近似する
+		float n = nearbyintf(arg * 2.0f);
+		float r = arg - n * 0.5f;
+		float r2 = r * r;
+		float s = 0.0f, c = 0.0f;
+		switch (prec) {
+		case EPrecision::FAST:
+			s = r * horner(SIN_FAST, r2);
+			c = horner(COS_FAST, r2);
+			break;
+		case EPrecision::PRECISE:
+			s = r * horner(SIN_PRECISE, r2);
+			c = horner(COS_PRECISE, r2);
+			break;
 		}
 
-		return result;
+		// 象限に応じた入れ替えと符号反転 (分岐予測の失敗を避ける為に表引きで行う)
+		unsigned int q = static_cast<unsigned int>(static_cast<long long>(n)) & 3U;
+		float const table[2U] = { s, c };
+		float const sign[2U] = { 1.0f, -1.0f };
+		sin = table[q & 1U] * sign[q >> 1U];
+		cos = table[(q & 1U) ^ 1U] * sign[((q + 1U) >> 1U) & 1U];
 	}
 
 	template <>
-	__m128 const sum<__m128>(__m128 const* const args, size_t const& size) noexcept {
-		__m128 result = _mm_set1_ps(0.0f);
-		if (args == nullptr || size == 0U) {
-			return result;
-		}
-
-		__m128 y, c, t;
-		c = _mm_set1_ps(0.0f);
-		for (size_t idx = 0U; idx < size; ++idx) {
-			y = _mm_sub_ps(*(args + idx), c);
-			t = _mm_add_ps(result, y);
-			c = _mm_sub_ps(_mm_sub_ps(t, result), y);
-			result = t;
+	void sincospi<__m256>(__m256 const& arg, __m256& sin, __m256& cos, EPrecision const& prec) noexcept {
+		__m256 n = _mm256_round_ps(_mm256_add_ps(arg, arg), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.5f), arg);
+		__m256 r2 = _mm256_mul_ps(r, r);
+		__m256 s = _mm256_setzero_ps(), c = _mm256_setzero_ps();
+		switch (prec) {
+		case EPrecision::FAST:
+			s = _mm256_mul_ps(r, horner(SIN_FAST, r2));
+			c = horner(COS_FAST, r2);
+			break;
+		case EPrecision::PRECISE:
+			s = _mm256_mul_ps(r, horner(SIN_PRECISE, r2));
+			c = horner(COS_PRECISE, r2);
+			break;
 		}
 
-		return result;
+		__m256i q = _mm256_cvtps_epi32(n);
+		__m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2);
+		__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+		__m256 ssign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, two), 30));
+		__m256 csign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), two), 30));
+		sin = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), ssign);
+		cos = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), csign);
 	}
 
 	template <>
-	__m256d const sum<__m256d>(__m256d const* const args, size_t const& size) noexcept {
-		__m256d result = _mm256_set1_pd(0.0);
-		if (args == nullptr || size == 0U) {
-			return result;
+	void sincospi<float>(float const* const args, float* const sin, float* const cos, size_t const& size, EPrecision const& prec) noexcept {
+		if (args == nullptr || sin == nullptr || cos == nullptr) {
+			return;
 		}
 
-		__m256d y, c, t;
-		c = _mm256_set1_pd(0.0);
-		for (size_t idx = 0U; idx < size; ++idx) {
-			y = _mm256_sub_pd(*(args + idx), c);
-			t = _mm256_add_pd(result, y);
-			c = _mm256_sub_pd(_mm256_sub_pd(t, result), y);
-			result = t;
+		size_t idx = 0U;
+		for (; idx + 8U <= size; idx += 8U) {
+			__m256 s, c;
+			sincospi(_mm256_loadu_ps(args + idx), s, c, prec);
+			_mm256_storeu_ps(sin + idx, s);
+			_mm256_storeu_ps(cos + idx, c);
+		}
+		for (; idx < size; ++idx) {
+			sincospi(args[idx], sin[idx], cos[idx], prec);
 		}
-
-		return result;
 	}
 
 	template <>
-	float const sqrt<float>(float const& arg) noexcept {
+	float const atan2pi<float>(float const& y, float const& x, EPrecision const& prec) noexcept {
+		float ax = fabsf(x), ay = fabsf(y);
+		float hi = ax > ay ? ax : ay;
+		float lo = ax > ay ? ay : ax;
+		float t = hi > 0.0f ? lo / hi : 0.0f;
 		float result = 0.0f;
-		if (arg < 0.0f) {
-			return result;
-		}
 
-		result = arg;
-		float half = result * 0.5f;
-		int temp = 0x5F3759DF - (*reinterpret_cast<int*>(&result) >> 1);
-		result = *reinterpret_cast<float*>(&temp);
-
-		result *= 1.5f - half * result * result;
-		result *= 1.5f - half * result * result;
-		result *= 1.5f - half * result * result;
-		result *= arg;
-
-		return result;
-	}
-
-	template <>
-	double const sqrt<double>(double const& arg) noexcept {
-		double result = 0.0;
-		if (arg < 0.0) {
-			return result;
+		// [0, 1] を tan(π/8) で二分し、上側は π/4 を中心に折り返す
+		if (t > TAN_PI_8) {
+			t = (t - 1.0f) / (t + 1.0f);
+			result = 0.25f;
+		}
+		switch (prec) {
+		case EPrecision::FAST:
+			result += t * horner(ATAN_FAST, t * t);
+			break;
+		case EPrecision::PRECISE:
+			result += t * horner(ATAN_PRECISE, t * t);
+			break;
 		}
 
-		result = arg;
-		double half = result * 0.5;
-		long long temp = 0x5FE6EB50C7B537AAL - (*reinterpret_cast<long long*>(&result) >> 1);
-		result = *reinterpret_cast<double*>(&temp);
-
-		result *= 1.5 - half * result * result;
-		result *= 1.5 - half * result * result;
-		result *= 1.5 - half * result * result;
-		result *= arg;
-
-		return result;
+		if (ay > ax) {
+			result = 0.5f - result;
+		}
+		if (std::signbit(x)) {
+			result = 1.0f - result;
+		}
+		return copysignf(result, y);
 	}
 
 	template <>
-	float const mod<float>(float const& lhs, float const& rhs) noexcept {
-		return floorf(lhs / rhs);
-	}
+	__m256 const atan2pi<__m256>(__m256 const& y, __m256 const& x, EPrecision const& prec) noexcept {
+		__m256 sign = _mm256_set1_ps(-0.0f);
+		__m256 one = _mm256_set1_ps(1.0f);
+		__m256 ax = _mm256_andnot_ps(sign, x), ay = _mm256_andnot_ps(sign, y);
+		__m256 hi = _mm256_max_ps(ax, ay), lo = _mm256_min_ps(ax, ay);
+		__m256 t = _mm256_and_ps(_mm256_div_ps(lo, hi), _mm256_cmp_ps(hi, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+		__m256 big = _mm256_cmp_ps(t, _mm256_set1_ps(TAN_PI_8), _CMP_GT_OQ);
+		t = _mm256_blendv_ps(t, _mm256_div_ps(_mm256_sub_ps(t, one), _mm256_add_ps(t, one)), big);
+		__m256 result = _mm256_and_ps(big, _mm256_set1_ps(0.25f));
+		__m256 t2 = _mm256_mul_ps(t, t);
+		switch (prec) {
+		case EPrecision::FAST:
+			result = _mm256_fmadd_ps(t, horner(ATAN_FAST, t2), result);
+			break;
+		case EPrecision::PRECISE:
+			result = _mm256_fmadd_ps(t, horner(ATAN_PRECISE, t2), result);
+			break;
+		}
 
-	template <>
-	double const mod<double>(double const& lhs, double const& rhs) noexcept {
-		return floor(lhs / rhs);
+		result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(0.5f), result), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+		result = _mm256_blendv_ps(result, _mm256_sub_ps(one, result), x);
+		return _mm256_or_ps(result, _mm256_and_ps(y, sign));
 	}
 
 	template <>
-	float const quot<float>(float const& lhs, float const& rhs) noexcept {
-		return sum({ lhs, -(mod(lhs, rhs) * rhs) });
-	}
+	void atan2pi<float>(float const* const y, float const* const x, float* const result, size_t const& size, EPrecision const& prec) noexcept {
+		if (y == nullptr || x == nullptr || result == nullptr) {
+			return;
+		}
 
-	template <>
-	double const quot<double>(double const& lhs, double const& rhs) noexcept {
-		return sum({ lhs, -(mod(lhs, rhs) * rhs) });
+		size_t idx = 0U;
+		for (; idx + 8U <= size; idx += 8U) {
+			_mm256_storeu_ps(result + idx, atan2pi(_mm256_loadu_ps(y + idx), _mm256_loadu_ps(x + idx), prec));
+		}
+		for (; idx < size; ++idx) {
+			result[idx] = atan2pi(y[idx], x[idx], prec);
+		}
 	}
 }
\ No newline at end of file
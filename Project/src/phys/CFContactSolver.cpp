@@ -0,0 +1,373 @@
+﻿/**	@file	CFContactSolver.cpp
+ *	@brief	逐次インパルス法による接触拘束の解決
+ */
+#include "phys/CFContactSolver.hpp"
+#include "phys/FBodyBatch.hpp"
+#include "geo/FBatchUtil.hpp"
+#include "util/CJobSystem.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+
+namespace dlav {
+	namespace {
+		//!	@brief	並列化する一括処理数の下限 (色毎)
+		size_t constexpr PARALLEL_MIN = 64U;
+		//!	@brief	並列化する際の一括処理の粒度
+		size_t constexpr PARALLEL_GRAIN = 16U;
+		//!	@brief	めり込みを一刻みで戻す割合
+		float constexpr BAUMGARTE = 0.2f;
+		//!	@brief	補正しないめり込みの深さ
+		float constexpr SLOP = 0.005f;
+		//!	@brief	未使用の接触点の位置
+		size_t constexpr INVALID_SLOT = ~static_cast<size_t>(0U);
+
+		//!	@brief	チャンネル番号の変換関数
+		unsigned int constexpr slot(EBodyChannel const& ch) noexcept {
+			return static_cast<unsigned int>(ch);
+		}
+
+		/**	@struct	SVelocity
+		 *	@brief	一括処理の剛体の速度
+		 */
+		struct SVelocity {
+			//!	@brief	速度
+			__m256 lin[FLT3_CNT];
+			//!	@brief	角速度
+			__m256 ang[FLT3_CNT];
+		};
+
+		//!	@brief	三成分の内積関数
+		__m256 const dot3(float const (&lhs)[FLT3_CNT][CFContactSolver::LANE_CNT], __m256 const (&rhs)[FLT3_CNT]) noexcept {
+			__m256 result = _mm256_mul_ps(_mm256_loadu_ps(lhs[0]), rhs[0]);
+			result = _mm256_fmadd_ps(_mm256_loadu_ps(lhs[1]), rhs[1], result);
+			return _mm256_fmadd_ps(_mm256_loadu_ps(lhs[2]), rhs[2], result);
+		}
+
+		//!	@brief	三成分の積和関数 (dst += src * amount)
+		void madd3(__m256 (&dst)[FLT3_CNT], float const (&src)[FLT3_CNT][CFContactSolver::LANE_CNT], __m256 const& amount) noexcept {
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				dst[i] = _mm256_fmadd_ps(_mm256_loadu_ps(src[i]), amount, dst[i]);
+			}
+		}
+
+		//!	@brief	チャンネルの集約関数
+		void gather(__m256* const dst, float const* const* const src, unsigned int const& count, int const* const bodies) noexcept {
+			__m256i idx = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bodies));
+			for (unsigned int i = 0U; i < count; ++i) {
+				dst[i] = _mm256_i32gather_ps(src[i], idx, 4);
+			}
+		}
+
+		//!	@brief	三成分のレーンへの書き込み関数
+		void store3(float (&dst)[FLT3_CNT][CFContactSolver::LANE_CNT], __m256 const (&src)[FLT3_CNT]) noexcept {
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				_mm256_storeu_ps(dst[i], src[i]);
+			}
+		}
+
+		//!	@brief	剛体の速度の集約関数
+		void gather(SVelocity& vel, float const* const* const lin, float const* const* const ang, int const* const bodies) noexcept {
+			gather(vel.lin, lin, FLT3_CNT, bodies);
+			gather(vel.ang, ang, FLT3_CNT, bodies);
+		}
+
+		//!	@brief	剛体の速度の書き戻し関数 (書き戻すレーンのみ)
+		void scatter(SVelocity const& vel, float* const* const lin, float* const* const ang, int const* const bodies, unsigned int const& lanes) noexcept {
+			float buf[2U][FLT3_CNT][CFContactSolver::LANE_CNT];
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				_mm256_storeu_ps(buf[0][i], vel.lin[i]);
+				_mm256_storeu_ps(buf[1][i], vel.ang[i]);
+			}
+			for (unsigned int bits = lanes; bits != 0U; bits &= bits - 1U) {
+				unsigned int lane = _tzcnt_u32(bits);
+				int body = bodies[lane];
+				for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+					lin[i][body] = buf[0][i][lane];
+					ang[i][body] = buf[1][i][lane];
+				}
+			}
+		}
+	}
+
+	CFContactSolver::CFContactSolver() noexcept :
+		m_batches(),
+		m_colors(),
+		m_slots()
+	{}
+
+	void CFContactSolver::prepare(CFRigidBodySoA const& bodies, SBodyContact const* const contacts, size_t const& count, float const& dt) {
+		clear();
+		m_slots.assign(count, INVALID_SLOT);
+		float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+
+		//	動的な剛体を共有しない最小の色を割り当てる (最後の色は溢れた接触点用)
+		unsigned long long constexpr OVERFLOW_BIT = 1ULL << (COLOR_CNT - 1U);
+		std::vector<unsigned long long> used(bodies.size(), 0ULL);
+		std::vector<unsigned char> color(count, 0U);
+		size_t histogram[COLOR_CNT] = {};
+		for (size_t idx = 0U; idx < count; ++idx) {
+			SBodyContact const& contact = contacts[idx];
+			bool fixA = bodies.fixed(contact.a);
+			bool fixB = bodies.fixed(contact.b);
+			if (fixA && fixB) {
+				color[idx] = static_cast<unsigned char>(COLOR_CNT);
+				continue;
+			}
+			unsigned long long mask = OVERFLOW_BIT;
+			mask |= fixA ? 0ULL : used[contact.a];
+			mask |= fixB ? 0ULL : used[contact.b];
+			unsigned int pick = mask == ~0ULL ? COLOR_CNT - 1U : static_cast<unsigned int>(_tzcnt_u64(~mask));
+			if (pick < COLOR_CNT - 1U) {
+				if (!fixA) {
+					used[contact.a] |= 1ULL << pick;
+				}
+				if (!fixB) {
+					used[contact.b] |= 1ULL << pick;
+				}
+			}
+			color[idx] = static_cast<unsigned char>(pick);
+			++histogram[pick];
+		}
+
+		//	色毎に一括処理の数を数え、接触点を色の順に並べる
+		unsigned int last = 0U;
+		for (unsigned int col = 0U; col < COLOR_CNT; ++col) {
+			if (histogram[col] > 0U) {
+				last = col + 1U;
+			}
+		}
+		m_colors.assign(last + 1U, 0U);
+		for (unsigned int col = 0U; col < last; ++col) {
+			size_t width = col == COLOR_CNT - 1U ? 1U : LANE_CNT;
+			m_colors[col + 1U] = m_colors[col] + (histogram[col] + width - 1U) / width;
+		}
+		SBatch blank = {};
+		std::fill(blank.bodyA, blank.bodyA + LANE_CNT, -1);
+		std::fill(blank.bodyB, blank.bodyB + LANE_CNT, -1);
+		m_batches.assign(m_colors[last], blank);
+		std::vector<size_t> fill(last, 0U);
+		for (unsigned int col = 0U; col < last; ++col) {
+			fill[col] = m_colors[col] * LANE_CNT;
+		}
+
+		//	接触点を一括処理のレーンへ詰める (接触点の位置は前計算まで別に持つ)
+		std::vector<float> anchors(m_batches.size() * FLT3_CNT * LANE_CNT, 0.0f);
+		for (size_t idx = 0U; idx < count; ++idx) {
+			if (color[idx] >= COLOR_CNT) {
+				continue;
+			}
+			size_t pos = fill[color[idx]];
+			fill[color[idx]] += color[idx] == COLOR_CNT - 1U ? LANE_CNT : 1U;
+			m_slots[idx] = pos;
+			SBatch& batch = m_batches[pos / LANE_CNT];
+			unsigned int lane = static_cast<unsigned int>(pos % LANE_CNT);
+			SBodyContact const& contact = contacts[idx];
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				batch.rows[0].dir[i][lane] = contact.normal.p[i];
+				anchors[(pos / LANE_CNT * FLT3_CNT + i) * LANE_CNT + lane] = contact.point.p[i];
+			}
+			//	離れている場合は距離の分だけ近付く事を許し、めり込んでいる場合は一部を押し戻す
+			batch.target[lane] = contact.distance > 0.0f ? -contact.distance * invDt : BAUMGARTE * std::max(-contact.distance - SLOP, 0.0f) * invDt;
+			batch.friction[lane] = contact.friction;
+			batch.bodyA[lane] = static_cast<int>(contact.a);
+			batch.bodyB[lane] = static_cast<int>(contact.b);
+			batch.writeA |= bodies.fixed(contact.a) ? 0U : 1U << lane;
+			batch.writeB |= bodies.fixed(contact.b) ? 0U : 1U << lane;
+		}
+
+		//	空きレーンは先頭レーンの剛体を指し、並列に書き換えられる剛体を読まないようにする
+		for (SBatch& batch : m_batches) {
+			for (unsigned int lane = 1U; lane < LANE_CNT; ++lane) {
+				if (batch.bodyA[lane] < 0) {
+					batch.bodyA[lane] = batch.bodyA[0];
+					batch.bodyB[lane] = batch.bodyB[0];
+				}
+			}
+		}
+
+		//	有効質量と腕を一括処理毎に前計算する
+		size_t total = m_batches.size();
+		CJobSystem& jobs = CJobSystem::getInstance();
+		if (jobs.concurrency() <= 1U || total < PARALLEL_MIN) {
+			for (size_t idx = 0U; idx < total; ++idx) {
+				setup(bodies, m_batches[idx], &anchors[idx * FLT3_CNT * LANE_CNT]);
+			}
+			return;
+		}
+		jobs.parallel_for(total, PARALLEL_GRAIN, [&](size_t const& from, size_t const& to) {
+			for (size_t idx = from; idx < to; ++idx) {
+				setup(bodies, m_batches[idx], &anchors[idx * FLT3_CNT * LANE_CNT]);
+			}
+		});
+	}
+
+	void CFContactSolver::solve(CFRigidBodySoA& bodies, unsigned int const& iterations) noexcept {
+		CJobSystem& jobs = CJobSystem::getInstance();
+		for (unsigned int iter = 0U; iter < iterations; ++iter) {
+			for (size_t col = 0U; col + 1U < m_colors.size(); ++col) {
+				size_t begin = m_colors[col];
+				size_t end = m_colors[col + 1U];
+				//	溢れた接触点の色は剛体を共有し得る為、常に逐次に解く
+				bool serial = col == COLOR_CNT - 1U || jobs.concurrency() <= 1U || end - begin < PARALLEL_MIN;
+				if (serial) {
+					for (size_t idx = begin; idx < end; ++idx) {
+						iterate(bodies, m_batches[idx]);
+					}
+					continue;
+				}
+				jobs.parallel_for(end - begin, PARALLEL_GRAIN, [&](size_t const& from, size_t const& to) {
+					for (size_t idx = begin + from; idx < begin + to; ++idx) {
+						iterate(bodies, m_batches[idx]);
+					}
+				});
+			}
+		}
+	}
+
+	void CFContactSolver::clear() noexcept {
+		m_batches.clear();
+		m_colors.clear();
+		m_slots.clear();
+	}
+
+	size_t const CFContactSolver::size() const noexcept {
+		return m_slots.size();
+	}
+
+	unsigned int const CFContactSolver::colors() const noexcept {
+		return m_colors.empty() ? 0U : static_cast<unsigned int>(m_colors.size() - 1U);
+	}
+
+	size_t const CFContactSolver::batches() const noexcept {
+		return m_batches.size();
+	}
+
+	float const CFContactSolver::impulse(size_t const& idx) const noexcept {
+		if (idx >= m_slots.size() || m_slots[idx] == INVALID_SLOT) {
+			return 0.0f;
+		}
+		size_t pos = m_slots[idx];
+		return m_batches[pos / LANE_CNT].rows[0].impulse[pos % LANE_CNT];
+	}
+
+	void CFContactSolver::setup(CFRigidBodySoA const& bodies, SBatch& batch, float const* const anchor) const noexcept {
+		float const* pos[FLT3_CNT];
+		float const* rot[FLT4_CNT];
+		float const* inertia[FLT3_CNT];
+		float const* mass = bodies.channel(EBodyChannel::INV_MASS);
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			pos[i] = bodies.channel(static_cast<EBodyChannel>(slot(EBodyChannel::POS_X) + i));
+			inertia[i] = bodies.channel(static_cast<EBodyChannel>(slot(EBodyChannel::INV_INERTIA_X) + i));
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			rot[i] = bodies.channel(static_cast<EBodyChannel>(slot(EBodyChannel::ROT_X) + i));
+		}
+
+		//	両剛体の腕と慣性テンソルを求める
+		int const* ids[2U] = { batch.bodyA, batch.bodyB };
+		__m256 arm[2U][FLT3_CNT];
+		__m256 mtx[2U][9U];
+		__m256 scale[2U][FLT3_CNT];
+		__m256 invMass[2U];
+		for (unsigned int side = 0U; side < 2U; ++side) {
+			__m256 center[FLT3_CNT];
+			__m256 q[FLT4_CNT];
+			gather(center, pos, FLT3_CNT, ids[side]);
+			gather(q, rot, FLT4_CNT, ids[side]);
+			gather(scale[side], inertia, FLT3_CNT, ids[side]);
+			gather(&invMass[side], &mass, 1U, ids[side]);
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				arm[side][i] = _mm256_sub_ps(_mm256_loadu_ps(anchor + i * LANE_CNT), center[i]);
+			}
+			laneRotation(q, mtx[side]);
+		}
+		_mm256_storeu_ps(batch.invMassA, invMass[0]);
+		_mm256_storeu_ps(batch.invMassB, invMass[1]);
+
+		//	法線に直交する二つの接線を求める (法線の最も小さい成分の軸を外して直交させる)
+		__m256 dirs[FLT3_CNT][FLT3_CNT];
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			dirs[0][i] = _mm256_loadu_ps(batch.rows[0].dir[i]);
+		}
+		__m256 zero = _mm256_setzero_ps();
+		__m256 pick = _mm256_cmp_ps(laneAbs(dirs[0][0]), _mm256_set1_ps(0.57735f), _CMP_GE_OQ);
+		dirs[1][0] = _mm256_blendv_ps(zero, dirs[0][1], pick);
+		dirs[1][1] = _mm256_blendv_ps(dirs[0][2], _mm256_sub_ps(zero, dirs[0][0]), pick);
+		dirs[1][2] = _mm256_blendv_ps(_mm256_sub_ps(zero, dirs[0][1]), zero, pick);
+		__m256 len = laneDot(dirs[1], dirs[1]);
+		__m256 inv = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(len)), _mm256_cmp_ps(len, zero, _CMP_GT_OQ));
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			dirs[1][i] = _mm256_mul_ps(dirs[1][i], inv);
+		}
+		laneCross(dirs[0], dirs[1], dirs[2]);
+
+		for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+			SRow& dst = batch.rows[row];
+			__m256 crossA[FLT3_CNT];
+			__m256 crossB[FLT3_CNT];
+			__m256 spinA[FLT3_CNT];
+			__m256 spinB[FLT3_CNT];
+			laneCross(arm[0], dirs[row], crossA);
+			laneCross(arm[1], dirs[row], crossB);
+			laneInvInertia(mtx[0], scale[0], crossA, spinA);
+			laneInvInertia(mtx[1], scale[1], crossB, spinB);
+			__m256 denom = _mm256_add_ps(_mm256_add_ps(invMass[0], invMass[1]), _mm256_add_ps(laneDot(crossA, spinA), laneDot(crossB, spinB)));
+			__m256 valid = _mm256_cmp_ps(denom, zero, _CMP_GT_OQ);
+			store3(dst.dir, dirs[row]);
+			store3(dst.armA, crossA);
+			store3(dst.armB, crossB);
+			store3(dst.spinA, spinA);
+			store3(dst.spinB, spinB);
+			_mm256_storeu_ps(dst.mass, _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), denom), valid));
+			_mm256_storeu_ps(dst.impulse, zero);
+		}
+	}
+
+	void CFContactSolver::iterate(CFRigidBodySoA& bodies, SBatch& batch) const noexcept {
+		float* lin[FLT3_CNT];
+		float* ang[FLT3_CNT];
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			lin[i] = bodies.channel(static_cast<EBodyChannel>(slot(EBodyChannel::LIN_X) + i));
+			ang[i] = bodies.channel(static_cast<EBodyChannel>(slot(EBodyChannel::ANG_X) + i));
+		}
+		SVelocity velA;
+		SVelocity velB;
+		gather(velA, lin, ang, batch.bodyA);
+		gather(velB, lin, ang, batch.bodyB);
+		__m256 massA = _mm256_loadu_ps(batch.invMassA);
+		__m256 massB = _mm256_loadu_ps(batch.invMassB);
+		__m256 lower = _mm256_setzero_ps();
+		__m256 upper = _mm256_set1_ps(FLT_MAX);
+		__m256 target = _mm256_loadu_ps(batch.target);
+
+		//	法線の拘束を解いてから、その累積インパルスで摩擦の上限を決める
+		for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+			SRow& cur = batch.rows[row];
+			if (row == 1U) {
+				upper = _mm256_mul_ps(_mm256_loadu_ps(batch.friction), _mm256_loadu_ps(batch.rows[0].impulse));
+				lower = _mm256_sub_ps(_mm256_setzero_ps(), upper);
+				target = _mm256_setzero_ps();
+			}
+			__m256 rel[FLT3_CNT];
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				rel[i] = _mm256_sub_ps(velB.lin[i], velA.lin[i]);
+			}
+			__m256 speed = _mm256_add_ps(dot3(cur.dir, rel), _mm256_sub_ps(dot3(cur.armB, velB.ang), dot3(cur.armA, velA.ang)));
+			__m256 prev = _mm256_loadu_ps(cur.impulse);
+			__m256 next = _mm256_fmadd_ps(_mm256_loadu_ps(cur.mass), _mm256_sub_ps(target, speed), prev);
+			next = _mm256_min_ps(_mm256_max_ps(next, lower), upper);
+			_mm256_storeu_ps(cur.impulse, next);
+			__m256 delta = _mm256_sub_ps(next, prev);
+
+			__m256 pushA = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(delta, massA));
+			__m256 pushB = _mm256_mul_ps(delta, massB);
+			madd3(velA.lin, cur.dir, pushA);
+			madd3(velB.lin, cur.dir, pushB);
+			madd3(velA.ang, cur.spinA, _mm256_sub_ps(_mm256_setzero_ps(), delta));
+			madd3(velB.ang, cur.spinB, delta);
+		}
+		scatter(velA, lin, ang, batch.bodyA, batch.writeA);
+		scatter(velB, lin, ang, batch.bodyB, batch.writeB);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,324 @@
+﻿/**	@file	CFRigidBodySoA.cpp
+ *	@brief	単精度浮動小数点数型の SoA 形式剛体群
+ */
+#include "phys/CFRigidBodySoA.hpp"
+#include "phys/FBodyBatch.hpp"
+#include "util/CJobSystem.hpp"
+#include <immintrin.h>
+#include <algorithm>
+
+namespace dlav {
+	namespace {
+		//!	@brief	積分を並列化する剛体数の下限
+		size_t constexpr PARALLEL_MIN = 16384U;
+		//!	@brief	並列化する際の一括処理の粒度
+		size_t constexpr PARALLEL_GRAIN = 2048U;
+
+		//!	@brief	チャンネル番号の変換関数
+		unsigned int constexpr slot(EBodyChannel const& ch) noexcept {
+			return static_cast<unsigned int>(ch);
+		}
+	}
+
+	CFRigidBodySoA::CFRigidBodySoA() noexcept :
+		m_count(0U),
+		m_channels()
+	{}
+
+	CFRigidBodySoA& CFRigidBodySoA::init(unsigned int const& count) {
+		unsigned int capacity = (count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT;
+		m_count = count;
+		for (unsigned int idx = 0U; idx < BODY_CHANNEL_CNT; ++idx) {
+			m_channels[idx].assign(capacity, 0.0f);
+		}
+		std::fill(m_channels[slot(EBodyChannel::ROT_W)].begin(), m_channels[slot(EBodyChannel::ROT_W)].end(), 1.0f);
+		return *this;
+	}
+
+	unsigned int const CFRigidBodySoA::size() const noexcept {
+		return m_count;
+	}
+
+	unsigned int const CFRigidBodySoA::capacity() const noexcept {
+		return static_cast<unsigned int>(m_channels[0U].size());
+	}
+
+	float* const CFRigidBodySoA::channel(EBodyChannel const& ch) noexcept {
+		return m_channels[slot(ch)].data();
+	}
+
+	float const* const CFRigidBodySoA::channel(EBodyChannel const& ch) const noexcept {
+		return m_channels[slot(ch)].data();
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::position(unsigned int const& idx, CFVector3 const& arg) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			m_channels[slot(EBodyChannel::POS_X) + i][idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::rotation(unsigned int const& idx, CFQuaternion const& arg) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			m_channels[slot(EBodyChannel::ROT_X) + i][idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::linear(unsigned int const& idx, CFVector3 const& arg) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			m_channels[slot(EBodyChannel::LIN_X) + i][idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::angular(unsigned int const& idx, CFVector3 const& arg) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			m_channels[slot(EBodyChannel::ANG_X) + i][idx] = arg.p[i];
+		}
+		return *this;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::mass(unsigned int const& idx, float const& amount, CFVector3 const& inertia) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		bool dynamic = amount > 0.0f;
+		m_channels[slot(EBodyChannel::INV_MASS)][idx] = dynamic ? 1.0f / amount : 0.0f;
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			m_channels[slot(EBodyChannel::INV_INERTIA_X) + i][idx] = dynamic && inertia.p[i] > 0.0f ? 1.0f / inertia.p[i] : 0.0f;
+		}
+		return *this;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::apply(unsigned int const& idx, CFVector3 const& force, CFVector3 const& point) noexcept {
+		if (idx >= m_count) {
+			return *this;
+		}
+		CFVector3 torque = cross(point - position(idx), force);
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			m_channels[slot(EBodyChannel::FRC_X) + i][idx] += force.p[i];
+			m_channels[slot(EBodyChannel::TRQ_X) + i][idx] += torque.p[i];
+		}
+		return *this;
+	}
+
+	CFVector3 const CFRigidBodySoA::position(unsigned int const& idx) const noexcept {
+		CFVector3 result = ZERO_FVT3;
+		if (idx >= m_count) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			result.p[i] = m_channels[slot(EBodyChannel::POS_X) + i][idx];
+		}
+		return result;
+	}
+
+	CFQuaternion const CFRigidBodySoA::rotation(unsigned int const& idx) const noexcept {
+		CFQuaternion result = UNIT_FQT;
+		if (idx >= m_count) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			result.p[i] = m_channels[slot(EBodyChannel::ROT_X) + i][idx];
+		}
+		return result;
+	}
+
+	CFVector3 const CFRigidBodySoA::linear(unsigned int const& idx) const noexcept {
+		CFVector3 result = ZERO_FVT3;
+		if (idx >= m_count) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			result.p[i] = m_channels[slot(EBodyChannel::LIN_X) + i][idx];
+		}
+		return result;
+	}
+
+	CFVector3 const CFRigidBodySoA::angular(unsigned int const& idx) const noexcept {
+		CFVector3 result = ZERO_FVT3;
+		if (idx >= m_count) {
+			return result;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			result.p[i] = m_channels[slot(EBodyChannel::ANG_X) + i][idx];
+		}
+		return result;
+	}
+
+	float const CFRigidBodySoA::invMass(unsigned int const& idx) const noexcept {
+		return idx < m_count ? m_channels[slot(EBodyChannel::INV_MASS)][idx] : 0.0f;
+	}
+
+	CFMatrix3x3 const CFRigidBodySoA::invInertia(unsigned int const& idx) const noexcept {
+		if (idx >= m_count) {
+			return ZERO_FMTX3x3;
+		}
+		//	R diag(I^-1) R^T を求める
+		CFQuaternion q = rotation(idx);
+		CFMatrix3x3 rot(
+			1.0f - 2.0f * (q.y * q.y + q.z * q.z), 2.0f * (q.x * q.y - q.z * q.w), 2.0f * (q.x * q.z + q.y * q.w),
+			2.0f * (q.x * q.y + q.z * q.w), 1.0f - 2.0f * (q.x * q.x + q.z * q.z), 2.0f * (q.y * q.z - q.x * q.w),
+			2.0f * (q.x * q.z - q.y * q.w), 2.0f * (q.y * q.z + q.x * q.w), 1.0f - 2.0f * (q.x * q.x + q.y * q.y)
+		);
+		CFMatrix3x3 scaled = rot;
+		for (unsigned int col = 0U; col < FLT3_CNT; ++col) {
+			float inv = m_channels[slot(EBodyChannel::INV_INERTIA_X) + col][idx];
+			for (unsigned int row = 0U; row < FLT3_CNT; ++row) {
+				scaled.p[row * FLT3_CNT + col] *= inv;
+			}
+		}
+		return scaled * rot.transpose();
+	}
+
+	bool const CFRigidBodySoA::fixed(unsigned int const& idx) const noexcept {
+		if (idx >= m_count) {
+			return true;
+		}
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			if (m_channels[slot(EBodyChannel::INV_INERTIA_X) + i][idx] != 0.0f) {
+				return false;
+			}
+		}
+		return m_channels[slot(EBodyChannel::INV_MASS)][idx] == 0.0f;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::integrateVelocity(float const& dt, CFVector3 const& gravity) noexcept {
+		size_t count = capacity();
+		CJobSystem& jobs = CJobSystem::getInstance();
+		if (jobs.concurrency() <= 1U || count < PARALLEL_MIN) {
+			velocity(0U, count, dt, gravity);
+			return *this;
+		}
+		jobs.parallel_for(count, PARALLEL_GRAIN, [&](size_t const& from, size_t const& to) {
+			velocity(from, to, dt, gravity);
+		});
+		return *this;
+	}
+
+	CFRigidBodySoA& CFRigidBodySoA::integratePosition(float const& dt) noexcept {
+		size_t count = capacity();
+		CJobSystem& jobs = CJobSystem::getInstance();
+		if (jobs.concurrency() <= 1U || count < PARALLEL_MIN) {
+			pose(0U, count, dt);
+			return *this;
+		}
+		jobs.parallel_for(count, PARALLEL_GRAIN, [&](size_t const& from, size_t const& to) {
+			pose(from, to, dt);
+		});
+		return *this;
+	}
+
+	void CFRigidBodySoA::velocity(size_t const& begin, size_t const& end, float const& dt, CFVector3 const& gravity) noexcept {
+		__m256 step = _mm256_set1_ps(dt);
+		__m256 zero = _mm256_setzero_ps();
+		float* lin[FLT3_CNT];
+		float* ang[FLT3_CNT];
+		float* frc[FLT3_CNT];
+		float* trq[FLT3_CNT];
+		float const* rot[FLT4_CNT];
+		float const* inertia[FLT3_CNT];
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			lin[i] = m_channels[slot(EBodyChannel::LIN_X) + i].data();
+			ang[i] = m_channels[slot(EBodyChannel::ANG_X) + i].data();
+			frc[i] = m_channels[slot(EBodyChannel::FRC_X) + i].data();
+			trq[i] = m_channels[slot(EBodyChannel::TRQ_X) + i].data();
+			inertia[i] = m_channels[slot(EBodyChannel::INV_INERTIA_X) + i].data();
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			rot[i] = m_channels[slot(EBodyChannel::ROT_X) + i].data();
+		}
+		float const* inv = m_channels[slot(EBodyChannel::INV_MASS)].data();
+
+		for (size_t idx = begin; idx < end; idx += LANE_CNT) {
+			//	重力は動的な剛体にのみ掛ける
+			__m256 im = _mm256_loadu_ps(inv + idx);
+			__m256 dynamic = _mm256_cmp_ps(im, zero, _CMP_GT_OQ);
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				__m256 acc = _mm256_and_ps(_mm256_set1_ps(gravity.p[i]), dynamic);
+				acc = _mm256_fmadd_ps(_mm256_loadu_ps(frc[i] + idx), im, acc);
+				_mm256_storeu_ps(lin[i] + idx, _mm256_fmadd_ps(acc, step, _mm256_loadu_ps(lin[i] + idx)));
+				_mm256_storeu_ps(frc[i] + idx, zero);
+			}
+
+			//	ワールド座標の慣性テンソルの逆行列をトルクに掛ける
+			__m256 q[FLT4_CNT];
+			for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+				q[i] = _mm256_loadu_ps(rot[i] + idx);
+			}
+			__m256 mtx[9U];
+			laneRotation(q, mtx);
+			__m256 torque[FLT3_CNT];
+			__m256 scale[FLT3_CNT];
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				torque[i] = _mm256_mul_ps(_mm256_loadu_ps(trq[i] + idx), step);
+				scale[i] = _mm256_loadu_ps(inertia[i] + idx);
+				_mm256_storeu_ps(trq[i] + idx, zero);
+			}
+			__m256 spin[FLT3_CNT];
+			laneInvInertia(mtx, scale, torque, spin);
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				_mm256_storeu_ps(ang[i] + idx, _mm256_add_ps(_mm256_loadu_ps(ang[i] + idx), spin[i]));
+			}
+		}
+	}
+
+	void CFRigidBodySoA::pose(size_t const& begin, size_t const& end, float const& dt) noexcept {
+		__m256 step = _mm256_set1_ps(dt);
+		__m256 half = _mm256_set1_ps(0.5f * dt);
+		float* pos[FLT3_CNT];
+		float* rot[FLT4_CNT];
+		float const* lin[FLT3_CNT];
+		float const* ang[FLT3_CNT];
+		for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+			pos[i] = m_channels[slot(EBodyChannel::POS_X) + i].data();
+			lin[i] = m_channels[slot(EBodyChannel::LIN_X) + i].data();
+			ang[i] = m_channels[slot(EBodyChannel::ANG_X) + i].data();
+		}
+		for (unsigned int i = 0U; i < FLT4_CNT; ++i) {
+			rot[i] = m_channels[slot(EBodyChannel::ROT_X) + i].data();
+		}
+
+		for (size_t idx = begin; idx < end; idx += LANE_CNT) {
+			for (unsigned int i = 0U; i < FLT3_CNT; ++i) {
+				_mm256_storeu_ps(pos[i] + idx, _mm256_fmadd_ps(_mm256_loadu_ps(lin[i] + idx), step, _mm256_loadu_ps(pos[i] + idx)));
+			}
+
+			//	q += dt / 2 * (ω, 0) q
+			__m256 wx = _mm256_loadu_ps(ang[0] + idx);
+			__m256 wy = _mm256_loadu_ps(ang[1] + idx);
+			__m256 wz = _mm256_loadu_ps(ang[2] + idx);
+			__m256 qx = _mm256_loadu_ps(rot[0] + idx);
+			__m256 qy = _mm256_loadu_ps(rot[1] + idx);
+			__m256 qz = _mm256_loadu_ps(rot[2] + idx);
+			__m256 qw = _mm256_loadu_ps(rot[3] + idx);
+			__m256 dx = _mm256_fmsub_ps(wx, qw, _mm256_fmsub_ps(wz, qy, _mm256_mul_ps(wy, qz)));
+			__m256 dy = _mm256_fmsub_ps(wy, qw, _mm256_fmsub_ps(wx, qz, _mm256_mul_ps(wz, qx)));
+			__m256 dz = _mm256_fmsub_ps(wz, qw, _mm256_fmsub_ps(wy, qx, _mm256_mul_ps(wx, qy)));
+			__m256 dw = _mm256_fmadd_ps(wx, qx, _mm256_fmadd_ps(wy, qy, _mm256_mul_ps(wz, qz)));
+			qx = _mm256_fmadd_ps(dx, half, qx);
+			qy = _mm256_fmadd_ps(dy, half, qy);
+			qz = _mm256_fmadd_ps(dz, half, qz);
+			qw = _mm256_fnmadd_ps(dw, half, qw);
+			__m256 sq = _mm256_fmadd_ps(qx, qx, _mm256_fmadd_ps(qy, qy, _mm256_fmadd_ps(qz, qz, _mm256_mul_ps(qw, qw))));
+			__m256 scale = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(sq));
+			_mm256_storeu_ps(rot[0] + idx, _mm256_mul_ps(qx, scale));
+			_mm256_storeu_ps(rot[1] + idx, _mm256_mul_ps(qy, scale));
+			_mm256_storeu_ps(rot[2] + idx, _mm256_mul_ps(qz, scale));
+			_mm256_storeu_ps(rot[3] + idx, _mm256_mul_ps(qw, scale));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+﻿/**	@file	CCameraBatch.cpp
+ *	@brief	複数視点の一括カメラ
+ */
+#include "rend/CCameraBatch.hpp"
+#include "math/FMathUtil.hpp"
+#include "math/CFVector4.hpp"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace dlav {
+	namespace {
+		//!	@brief	一括処理幅
+		unsigned int constexpr LANE_CNT = 8U;
+		//!	@brief	行列の成分数
+		unsigned int constexpr MTX_CNT = 16U;
+
+		//!	@brief	倍精度の八要素を単精度で読み込む関数
+		__m256 const load_pd(double const* const ptr) noexcept {
+			__m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(ptr));
+			__m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(ptr + 4));
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+		}
+
+		/**	@brief	平面係数の正規化関数
+		 *	@note	法線の長さが零の平面 (無限遠の後方平面) は CFPlane3::init と同じくそのまま返し、距離を常に Ｄ値とする。
+		 */
+		void normalize_plane(__m256 (&face)[FLT4_CNT]) noexcept {
+			__m256 sq = _mm256_fmadd_ps(face[0], face[0], _mm256_fmadd_ps(face[1], face[1], _mm256_mul_ps(face[2], face[2])));
+			__m256 valid = _mm256_cmp_ps(sq, _mm256_setzero_ps(), _CMP_GT_OQ);
+			__m256 inv = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(sq)), valid);
+			for (auto& coef : face) {
+				coef = _mm256_mul_ps(coef, inv);
+			}
+		}
+	}
+
+	void makeCascadeSplits(float* const dst, unsigned int const& count, float const& front, float const& back, float const& lambda) noexcept {
+		// 対数分割は正の front でしか定義できない為、back に対して十分小さな正の値へ丸める
+		float base = std::max(front, std::max(std::fabs(back) * FLT_EPSILON, FLT_MIN));
+		float ratio = std::max(back / base, 1.0f);
+		dst[0] = front;
+		for (unsigned int idx = 1U; idx < count; ++idx) {
+			float t = static_cast<float>(idx) / static_cast<float>(count);
+			float log_split = base * powf(ratio, t);
+			float uni_split = front + (back - front) * t;
+			dst[idx] = lambda * log_split + (1.0f - lambda) * uni_split;
+		}
+		dst[count] = back;
+	}
+
+	CCameraBatch::CCameraBatch() noexcept :
+		m_count(0U),
+		m_dmode(EDepthMode::STANDARD),
+		m_projs(),
+		m_ex(), m_ey(), m_ez(),
+		m_qx(), m_qy(), m_qz(), m_qw(),
+		m_sx(), m_sy(), m_pa(), m_pb(), m_pc(), m_pd(),
+		m_views(),
+		m_projections(),
+		m_viewprojs(),
+		m_planes()
+	{}
+
+	void CCameraBatch::reserve(size_t const& count) {
+		size_t padded = (count + LANE_CNT - 1U) / LANE_CNT * LANE_CNT;
+		m_projs.reserve(count);
+		for (auto* vec : { &m_ex, &m_ey, &m_ez }) {
+			vec->reserve(padded);
+		}
+		for (auto* vec : { &m_qx, &m_qy, &m_qz, &m_qw, &m_sx, &m_sy, &m_pa, &m_pb, &m_pc, &m_pd }) {
+			vec->reserve(padded);
+		}
+		m_views.reserve(count);
+		m_projections.reserve(count);
+		m_viewprojs.reserve(count);
+		m_planes.reserve(count * CFFrustum::PLANE_CNT);
+	}
+
+	size_t const CCameraBatch::add(CDVector3 const& pos, CFQuaternion const& rot) {
+		if (m_count % LANE_CNT == 0U) {
+			// 詰め物は単位姿勢・単位行列の投影とし、演算結果が有限に留まるようにする
+			size_t padded = m_count + LANE_CNT;
+			for (auto* vec : { &m_ex, &m_ey, &m_ez }) {
+				vec->resize(padded, 0.0);
+			}
+			for (auto* vec : { &m_qx, &m_qy, &m_qz, &m_pb, &m_pc }) {
+				vec->resize(padded, 0.0f);
+			}
+			for (auto* vec : { &m_qw, &m_sx, &m_sy, &m_pa, &m_pd }) {
+				vec->resize(padded, 1.0f);
+			}
+		}
+
+		size_t idx = m_count++;
+		m_projs.push_back(SProjection{ EProjectiveMode::PARSEPECTIVE, 2.0f, 2.0f, 1.0f, 1.0f, 2.0f });
+		m_views.push_back(UNIT_FMTX4x4);
+		m_projections.push_back(UNIT_FMTX4x4);
+		m_viewprojs.push_back(UNIT_FMTX4x4);
+		m_planes.resize(m_count * CFFrustum::PLANE_CNT, ZERO_FVT4);
+		eye(idx, pos);
+		posture(idx, rot);
+		coefficient(idx);
+		return idx;
+	}
+
+	size_t const CCameraBatch::size() const noexcept {
+		return m_count;
+	}
+
+	void CCameraBatch::eye(size_t const& idx, CDVector3 const& arg) noexcept {
+		m_ex[idx] = arg.x;
+		m_ey[idx] = arg.y;
+		m_ez[idx] = arg.z;
+	}
+
+	CDVector3 const CCameraBatch::eye(size_t const& idx) const noexcept {
+		return CDVector3(m_ex[idx], m_ey[idx], m_ez[idx]);
+	}
+
+	void CCameraBatch::posture(size_t const& idx, CFQuaternion const& arg) noexcept {
+		m_qx[idx] = arg.x;
+		m_qy[idx] = arg.y;
+		m_qz[idx] = arg.z;
+		m_qw[idx] = arg.w;
+	}
+
+	CFQuaternion const CCameraBatch::posture(size_t const& idx) const noexcept {
+		return CFQuaternion(m_qx[idx], m_qy[idx], m_qz[idx], m_qw[idx]);
+	}
+
+	void CCameraBatch::perspective(size_t const& idx, float const& width, float const& height, float const& wndpos, float const& front, float const& back) noexcept {
+		m_projs[idx] = SProjection{ EProjectiveMode::PARSEPECTIVE, width, height, wndpos, front, back };
+		coefficient(idx);
+	}
+
+	void CCameraBatch::orthographic(size_t const& idx, float const& width, float const& height, float const& front, float const& back) noexcept {
+		m_projs[idx] = SProjection{ EProjectiveMode::PARALLEL, width, height, 1.0f, front, back };
+		coefficient(idx);
+	}
+
+	void CCameraBatch::depth(EDepthMode const& arg) noexcept {
+		m_dmode = arg;
+		for (size_t idx = 0U; idx < m_count; ++idx) {
+			coefficient(idx);
+		}
+	}
+
+	void CCameraBatch::fit_cascades(size_t const& view, CFQuaternion const& light, float const* const splits, size_t const& first, size_t const& count, float const& backoff) noexcept {
+		// ビュー空間の点 v は世界空間で R^T (v + e) となる (CCamera::world_mtx と同じ規約)
+		// 光源空間へは L を掛ける為、L R^T を単精度で、カメラ位置の寄与 L R^T e を倍精度で求める
+		SProjection const& proj = m_projs[view];
+		CFMatrix4x4 lr = makeRotate(EHandSide::RHS, light) * makeRotate(EHandSide::RHS, posture(view)).transpose();
+		CDVector3 pos = eye(view);
+		double offset[3] = {};
+		for (unsigned int row = 0U; row < 3U; ++row) {
+			offset[row] = lr.p[row * FLT4_CNT + 0U] * pos.x + lr.p[row * FLT4_CNT + 1U] * pos.y + lr.p[row * FLT4_CNT + 2U] * pos.z;
+		}
+
+		for (size_t cascade = 0U; cascade < count; ++cascade) {
+			float lo[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+			float hi[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			for (unsigned int corner = 0U; corner < 8U; ++corner) {
+				float dist = splits[cascade + ((corner & 4U) != 0U ? 1U : 0U)];
+				float scale = proj.mode == EProjectiveMode::PARALLEL ? 0.5f : 0.5f * dist / proj.wndpos;
+				float v[3] = {
+					(corner & 1U) != 0U ? proj.width * scale : -proj.width * scale,
+					(corner & 2U) != 0U ? proj.height * scale : -proj.height * scale,
+					-dist
+				};
+				for (unsigned int row = 0U; row < 3U; ++row) {
+					float a = lr.p[row * FLT4_CNT + 0U] * v[0] + lr.p[row * FLT4_CNT + 1U] * v[1] + lr.p[row * FLT4_CNT + 2U] * v[2];
+					lo[row] = std::min(lo[row], a);
+					hi[row] = std::max(hi[row], a);
+				}
+			}
+
+			// 光源は -z 方向を向く為、境界箱の z 最大側 (光源寄り) を前方クリップ面に合わせる
+			size_t idx = first + cascade;
+			eye(idx, CDVector3(
+				offset[0] + 0.5 * (static_cast<double>(lo[0]) + hi[0]),
+				offset[1] + 0.5 * (static_cast<double>(lo[1]) + hi[1]),
+				offset[2] + static_cast<double>(hi[2]) + backoff
+			));
+			posture(idx, light);
+			orthographic(idx, hi[0] - lo[0], hi[1] - lo[1], 0.0f, hi[2] - lo[2] + backoff);
+		}
+	}
+
+	void CCameraBatch::update(EHandSide const& hs) {
+		alignas(32) float view[MTX_CNT][LANE_CNT];
+		alignas(32) float proj[MTX_CNT][LANE_CNT];
+		alignas(32) float viewproj[MTX_CNT][LANE_CNT];
+		alignas(32) float faces[CFFrustum::PLANE_CNT][FLT4_CNT][LANE_CNT];
+		__m256 const zero = _mm256_setzero_ps();
+		__m256 const one = _mm256_set1_ps(1.0f);
+		__m256 const two = _mm256_set1_ps(2.0f);
+
+		for (size_t base = 0U; base < m_count; base += LANE_CNT) {
+			// 姿勢から回転行列 R (列ベクトル形式、makeRotate の RHS と同じ) を八視点分求める
+			__m256 x = _mm256_loadu_ps(&m_qx[base]);
+			__m256 y = _mm256_loadu_ps(&m_qy[base]);
+			__m256 z = _mm256_loadu_ps(&m_qz[base]);
+			__m256 w = _mm256_loadu_ps(&m_qw[base]);
+			__m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z), ww = _mm256_mul_ps(w, w);
+			__m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+			__m256 xw = _mm256_mul_ps(x, w), yw = _mm256_mul_ps(y, w), zw = _mm256_mul_ps(z, w);
+			__m256 r[3][3] = {
+				{ _mm256_sub_ps(_mm256_add_ps(xx, ww), _mm256_add_ps(yy, zz)), _mm256_mul_ps(two, _mm256_sub_ps(xy, zw)), _mm256_mul_ps(two, _mm256_add_ps(xz, yw)) },
+				{ _mm256_mul_ps(two, _mm256_add_ps(xy, zw)), _mm256_sub_ps(_mm256_add_ps(yy, ww), _mm256_add_ps(xx, zz)), _mm256_mul_ps(two, _mm256_sub_ps(yz, xw)) },
+				{ _mm256_mul_ps(two, _mm256_sub_ps(xz, yw)), _mm256_mul_ps(two, _mm256_add_ps(yz, xw)), _mm256_sub_ps(_mm256_add_ps(zz, ww), _mm256_add_ps(xx, yy)) }
+			};
+			__m256 e[3] = {
+				load_pd(&m_ex[base]),
+				load_pd(&m_ey[base]),
+				load_pd(&m_ez[base])
+			};
+
+			// ビュー変換行列 V は world_mtx の逆行列であり、列ベクトル形式で [R | -e] となる
+			__m256 v[FLT4_CNT][FLT4_CNT] = {
+				{ r[0][0], r[0][1], r[0][2], _mm256_sub_ps(zero, e[0]) },
+				{ r[1][0], r[1][1], r[1][2], _mm256_sub_ps(zero, e[1]) },
+				{ r[2][0], r[2][1], r[2][2], _mm256_sub_ps(zero, e[2]) },
+				{ zero, zero, zero, one }
+			};
+			__m256 sx = _mm256_loadu_ps(&m_sx[base]);
+			__m256 sy = _mm256_loadu_ps(&m_sy[base]);
+			__m256 pa = _mm256_loadu_ps(&m_pa[base]);
+			__m256 pb = _mm256_loadu_ps(&m_pb[base]);
+			__m256 pc = _mm256_loadu_ps(&m_pc[base]);
+			__m256 pd = _mm256_loadu_ps(&m_pd[base]);
+			__m256 p[FLT4_CNT][FLT4_CNT] = {
+				{ sx, zero, zero, zero },
+				{ zero, sy, zero, zero },
+				{ zero, zero, pa, pb },
+				{ zero, zero, pc, pd }
+			};
+
+			// P は疎である為、P V の各行は V の行の線形結合で済む
+			__m256 m[FLT4_CNT][FLT4_CNT];
+			for (unsigned int col = 0U; col < FLT4_CNT; ++col) {
+				m[0][col] = _mm256_mul_ps(sx, v[0][col]);
+				m[1][col] = _mm256_mul_ps(sy, v[1][col]);
+				m[2][col] = _mm256_fmadd_ps(pa, v[2][col], _mm256_mul_ps(pb, v[3][col]));
+				m[3][col] = _mm256_fmadd_ps(pc, v[2][col], _mm256_mul_ps(pd, v[3][col]));
+			}
+
+			// 視錐台の平面は P V の行の線形結合 (CFFrustum::init と同じ並び)
+			for (unsigned int col = 0U; col < FLT4_CNT; ++col) {
+				__m256 face[CFFrustum::PLANE_CNT] = {
+					_mm256_add_ps(m[3][col], m[0][col]),
+					_mm256_sub_ps(m[3][col], m[0][col]),
+					_mm256_add_ps(m[3][col], m[1][col]),
+					_mm256_sub_ps(m[3][col], m[1][col]),
+					m[2][col],
+					_mm256_sub_ps(m[3][col], m[2][col])
+				};
+				for (unsigned int idx = 0U; idx < CFFrustum::PLANE_CNT; ++idx) {
+					_mm256_store_ps(faces[idx][col], face[idx]);
+				}
+			}
+			for (auto& face : faces) {
+				__m256 coef[FLT4_CNT] = {
+					_mm256_load_ps(face[0]),
+					_mm256_load_ps(face[1]),
+					_mm256_load_ps(face[2]),
+					_mm256_load_ps(face[3])
+				};
+				normalize_plane(coef);
+				for (unsigned int col = 0U; col < FLT4_CNT; ++col) {
+					_mm256_store_ps(face[col], coef[col]);
+				}
+			}
+
+			// 右手系 (行ベクトル形式) では転置した位置へ書き込む
+			for (unsigned int row = 0U; row < FLT4_CNT; ++row) {
+				for (unsigned int col = 0U; col < FLT4_CNT; ++col) {
+					unsigned int dst = hs == EHandSide::RHS ? col * FLT4_CNT + row : row * FLT4_CNT + col;
+					_mm256_store_ps(view[dst], v[row][col]);
+					_mm256_store_ps(proj[dst], p[row][col]);
+					_mm256_store_ps(viewproj[dst], m[row][col]);
+				}
+			}
+
+			size_t lanes = std::min<size_t>(LANE_CNT, m_count - base);
+			for (size_t lane = 0U; lane < lanes; ++lane) {
+				size_t idx = base + lane;
+				CFVector4* coefs = &m_planes[idx * CFFrustum::PLANE_CNT];
+				for (unsigned int elem = 0U; elem < MTX_CNT; ++elem) {
+					m_views[idx].p[elem] = view[elem][lane];
+					m_projections[idx].p[elem] = proj[elem][lane];
+					m_viewprojs[idx].p[elem] = viewproj[elem][lane];
+				}
+				for (unsigned int face = 0U; face < CFFrustum::PLANE_CNT; ++face) {
+					coefs[face] = CFVector4(faces[face][0][lane], faces[face][1][lane], faces[face][2][lane], faces[face][3][lane]);
+				}
+			}
+		}
+	}
+
+	CFMatrix4x4 const& CCameraBatch::view_mtx(size_t const& idx) const noexcept {
+		return m_views[idx];
+	}
+
+	CFMatrix4x4 const& CCameraBatch::proj_mtx(size_t const& idx) const noexcept {
+		return m_projections[idx];
+	}
+
+	CFMatrix4x4 const& CCameraBatch::viewproj_mtx(size_t const& idx) const noexcept {
+		return m_viewprojs[idx];
+	}
+
+	CFVector4 const* const CCameraBatch::planes(size_t const& idx) const noexcept {
+		return &m_planes[idx * CFFrustum::PLANE_CNT];
+	}
+
+	CFFrustum const CCameraBatch::frustum(size_t const& idx) const noexcept {
+		CFFrustum result;
+		result.init(planes(idx));
+		return result;
+	}
+
+	void CCameraBatch::coefficient(size_t const& idx) noexcept {
+		// 各生成関数から列ベクトル形式の行列を得て、非零の係数だけを取り出す
+		SProjection const& proj = m_projs[idx];
+		CFMatrix4x4 mtx = UNIT_FMTX4x4;
+		if (proj.mode == EProjectiveMode::PARALLEL) {
+			mtx = makeOrthographicMatrix(EHandSide::LHS, proj.front, proj.back, proj.width, proj.height, m_dmode);
+		}
+		else if (std::isinf(proj.back)) {
+			mtx = makeInfinitePerspectiveMatrix(EHandSide::LHS, proj.front, proj.width, proj.height, proj.wndpos, m_dmode);
+		}
+		else {
+			mtx = makePerspectiveMatrix(EHandSide::LHS, proj.front, proj.back, proj.width, proj.height, proj.wndpos, m_dmode);
+		}
+		m_sx[idx] = mtx.p[0];
+		m_sy[idx] = mtx.p[5];
+		m_pa[idx] = mtx.p[10];
+		m_pb[idx] = mtx.p[11];
+		m_pc[idx] = mtx.p[14];
+		m_pd[idx] = mtx.p[15];
+	}
+}
\ No newline at end of file
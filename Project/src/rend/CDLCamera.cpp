@@ -3,27 +3,145 @@
  */
 #include "rend/CDLCamera.hpp"
 #include "math/FMathUtil.hpp"
+#include <cmath>
 
 namespace dlav {
 	CCamera::CCamera() noexcept :
-		m_eye(),
 		m_lookat(),
+		m_eye(),
 		m_posture(UNIT_FQT),
+		m_view(UNIT_FMTX4x4),
+		m_proj(UNIT_FMTX4x4),
+		m_viewproj(UNIT_FMTX4x4),
 		m_height(),
 		m_width(),
 		m_near(),
 		m_far(),
 		m_wndpos(),
 		m_pmode(EProjectiveMode::PARSEPECTIVE),
-		m_fmode(EFollowMode::FREE)
+		m_fmode(EFollowMode::FREE),
+		m_dmode(EDepthMode::STANDARD),
+		m_hs(EHandSide::RHS),
+		m_dirty(DIRTY_ALL)
 	{}
 
+	void CCamera::eye(CDVector3 const& arg) noexcept {
+		m_eye = arg;
+		m_dirty |= DIRTY_VIEW | DIRTY_VIEWPROJ;
+	}
+
+	CDVector3 const& CCamera::eye() const noexcept {
+		return m_eye;
+	}
+
+	void CCamera::posture(CFQuaternion const& arg) noexcept {
+		m_posture = arg;
+		m_dirty |= DIRTY_VIEW | DIRTY_VIEWPROJ;
+	}
+
+	CFQuaternion const& CCamera::posture() const noexcept {
+		return m_posture;
+	}
+
+	void CCamera::screen(float const& width, float const& height, float const& wndpos) noexcept {
+		m_width = width;
+		m_height = height;
+		m_wndpos = wndpos;
+		m_dirty |= DIRTY_PROJ | DIRTY_VIEWPROJ;
+	}
+
+	void CCamera::clip(float const& front, float const& back) noexcept {
+		m_near = front;
+		m_far = back;
+		m_dirty |= DIRTY_PROJ | DIRTY_VIEWPROJ;
+	}
+
+	void CCamera::projective(EProjectiveMode const& arg) noexcept {
+		m_pmode = arg;
+		m_dirty |= DIRTY_PROJ | DIRTY_VIEWPROJ;
+	}
+
+	EProjectiveMode const& CCamera::projective() const noexcept {
+		return m_pmode;
+	}
+
+	void CCamera::depth(EDepthMode const& arg) noexcept {
+		m_dmode = arg;
+		m_dirty |= DIRTY_PROJ | DIRTY_VIEWPROJ;
+	}
+
+	EDepthMode const& CCamera::depth() const noexcept {
+		return m_dmode;
+	}
+
 	CFMatrix4x4 CCamera::world_mtx(EHandSide const& hs) noexcept {
 		switch (hs) {
 		case EHandSide::RHS:
-			return makeTransit(EHandSide::RHS, m_eye) * makeRotate(EHandSide::RHS, m_posture);
+			return makeTransit(EHandSide::RHS, toFlt(m_eye)) * makeRotate(EHandSide::RHS, m_posture);
 		default:
-			return makeRotate(EHandSide::LHS, m_posture) * makeTransit(EHandSide::LHS, m_eye);
+			return makeRotate(EHandSide::LHS, m_posture) * makeTransit(EHandSide::LHS, toFlt(m_eye));
+		}
+	}
+
+	CFMatrix4x4 CCamera::relative_world_mtx(EHandSide const& hs) noexcept {
+		return makeRotate(hs, m_posture);
+	}
+
+	CFMatrix4x4 const& CCamera::view_mtx(EHandSide const& hs) noexcept {
+		handside(hs);
+		if ((m_dirty & DIRTY_VIEW) != 0U) {
+			// world_mtx は平行移動と回転のみの為、回転を転置し平行移動を反転した逆順の積で逆行列を直接作る
+			switch (hs) {
+			case EHandSide::RHS:
+				m_view = makeRotate(EHandSide::RHS, m_posture).transpose() * makeTransit(EHandSide::RHS, -toFlt(m_eye));
+				break;
+			default:
+				m_view = makeTransit(EHandSide::LHS, -toFlt(m_eye)) * makeRotate(EHandSide::LHS, m_posture).transpose();
+				break;
+			}
+			m_dirty &= ~DIRTY_VIEW;
+		}
+		return m_view;
+	}
+
+	CFMatrix4x4 const& CCamera::proj_mtx(EHandSide const& hs) noexcept {
+		handside(hs);
+		if ((m_dirty & DIRTY_PROJ) != 0U) {
+			if (m_pmode == EProjectiveMode::PARALLEL) {
+				m_proj = makeOrthographicMatrix(hs, m_near, m_far, m_width, m_height, m_dmode);
+			}
+			else if (std::isinf(m_far)) {
+				m_proj = makeInfinitePerspectiveMatrix(hs, m_near, m_width, m_height, m_wndpos, m_dmode);
+			}
+			else {
+				m_proj = makePerspectiveMatrix(hs, m_near, m_far, m_width, m_height, m_wndpos, m_dmode);
+			}
+			m_dirty &= ~DIRTY_PROJ;
+		}
+		return m_proj;
+	}
+
+	CFMatrix4x4 const& CCamera::viewproj_mtx(EHandSide const& hs) noexcept {
+		handside(hs);
+		if ((m_dirty & DIRTY_VIEWPROJ) != 0U) {
+			// 右手系は行ベクトル形式の為 view * proj、左手系は列ベクトル形式の為 proj * view の順に作用させる
+			switch (hs) {
+			case EHandSide::RHS:
+				m_viewproj = view_mtx(hs) * proj_mtx(hs);
+				break;
+			default:
+				m_viewproj = proj_mtx(hs) * view_mtx(hs);
+				break;
+			}
+			m_dirty &= ~DIRTY_VIEWPROJ;
+		}
+		return m_viewproj;
+	}
+
+	void CCamera::handside(EHandSide const& hs) noexcept {
+		if (m_hs != hs) {
+			m_hs = hs;
+			m_dirty = DIRTY_ALL;
 		}
 	}
 }
\ No newline at end of file
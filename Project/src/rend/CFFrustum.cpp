@@ -0,0 +1,183 @@
+﻿/**	@file	CFFrustum.cpp
+ *	@brief	視錐台
+ */
+#include "rend/CFFrustum.hpp"
+#include "util/CJobSystem.hpp"
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+
+namespace dlav {
+	namespace {
+		//!	@brief	一括処理幅
+		unsigned int constexpr LANE_CNT = 8U;
+		//!	@brief	一つのジョブで処理する要素数
+		size_t constexpr GRAIN = 16384U;
+
+		/**	@struct	SPlaneLanes
+		 *	@brief	全レーンに展開した平面
+		 */
+		struct SPlaneLanes {
+			__m256 nx, ny, nz, d;
+			__m256 ax, ay, az;
+		};
+
+		//!	@brief	末尾の要素を読み込む為のマスク生成関数
+		__m256i const tail_mask(size_t const& rest) noexcept {
+			return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(rest)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		}
+
+		//!	@brief	八要素の読み込み関数 (末尾はマスクする)
+		__m256 const load(float const* const ptr, size_t const& rest, __m256i const& mask) noexcept {
+			return rest >= LANE_CNT ? _mm256_loadu_ps(ptr) : _mm256_maskload_ps(ptr, mask);
+		}
+
+		/**	@brief	一括カリングの共通処理
+		 *	@param[in] test 八要素の可視マスクを返す関数
+		 *	@note	区間毎に visible の同じ位置へ書き込み、最後に区間の順で詰める。
+		 */
+		template <typename F>
+		size_t const cull_impl(size_t const& count, std::vector<unsigned int>& visible, F const& test) {
+			visible.resize(count);
+			size_t chunks = (count + GRAIN - 1U) / GRAIN;
+			std::vector<size_t> found(chunks, 0U);
+			unsigned int* out = visible.data();
+
+			CJobSystem::getInstance().parallel_for(count, GRAIN, [&](size_t const& begin, size_t const& end) {
+				size_t num = 0U;
+				for (size_t idx = begin; idx < end; idx += LANE_CNT) {
+					size_t rest = end - idx;
+					unsigned int bits = static_cast<unsigned int>(test(idx, rest));
+					if (rest < LANE_CNT) {
+						bits &= (1U << rest) - 1U;
+					}
+					while (bits != 0U) {
+						out[begin + num] = static_cast<unsigned int>(idx) + static_cast<unsigned int>(_tzcnt_u32(bits));
+						++num;
+						bits &= bits - 1U;
+					}
+				}
+				found[begin / GRAIN] = num;
+			});
+
+			size_t total = 0U;
+			for (size_t chunk = 0U; chunk < chunks; ++chunk) {
+				if (total != chunk * GRAIN) {
+					std::memmove(&out[total], &out[chunk * GRAIN], found[chunk] * sizeof(unsigned int));
+				}
+				total += found[chunk];
+			}
+			visible.resize(total);
+			return total;
+		}
+	}
+
+	CFFrustum::CFFrustum() noexcept :
+		m_planes()
+	{}
+
+	CFFrustum& CFFrustum::init(EHandSide const& hs, CFMatrix4x4 const& viewproj) noexcept {
+		// 行列のクリップ座標成分 (c0, c1, c2, c3) の線形結合として各平面を取り出す
+		CFVector4 c[FLT4_CNT] = { ZERO_FVT4, ZERO_FVT4, ZERO_FVT4, ZERO_FVT4 };
+		for (unsigned int idx = 0U; idx < FLT4_CNT; ++idx) {
+			c[idx] = hs == EHandSide::RHS ? viewproj.column(idx) : viewproj.row(idx);
+		}
+		CFVector4 const planes[PLANE_CNT] = {
+			c[3] + c[0],
+			c[3] - c[0],
+			c[3] + c[1],
+			c[3] - c[1],
+			c[2],
+			c[3] - c[2]
+		};
+		return init(planes);
+	}
+
+	CFFrustum& CFFrustum::init(CFVector4 const* const planes) noexcept {
+		for (unsigned int idx = 0U; idx < PLANE_CNT; ++idx) {
+			m_planes[idx].init(CFVector3(planes[idx].x, planes[idx].y, planes[idx].z), planes[idx].w);
+		}
+		return *this;
+	}
+
+	CFPlane3 const& CFFrustum::plane(unsigned int const& idx) const noexcept {
+		return m_planes[idx];
+	}
+
+	bool const CFFrustum::contains(CFVector3 const& center, float const& radius) const noexcept {
+		for (auto const& face : m_planes) {
+			if (face.distance(center) < -radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool const CFFrustum::contains(CFVector3 const& center, CFVector3 const& extent) const noexcept {
+		for (auto const& face : m_planes) {
+			CFVector3 n = face.normal();
+			float r = fabsf(n.x) * extent.x + fabsf(n.y) * extent.y + fabsf(n.z) * extent.z;
+			if (face.distance(center) < -r) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t const CFFrustum::cull(SBoundingSpheres const& spheres, std::vector<unsigned int>& visible) const {
+		SPlaneLanes lanes[PLANE_CNT];
+		for (unsigned int idx = 0U; idx < PLANE_CNT; ++idx) {
+			CFVector3 n = m_planes[idx].normal();
+			lanes[idx].nx = _mm256_set1_ps(n.x);
+			lanes[idx].ny = _mm256_set1_ps(n.y);
+			lanes[idx].nz = _mm256_set1_ps(n.z);
+			lanes[idx].d = _mm256_set1_ps(m_planes[idx].getDValue());
+		}
+
+		return cull_impl(spheres.count, visible, [&](size_t const& idx, size_t const& rest) {
+			__m256i mask = tail_mask(rest);
+			__m256 x = load(&spheres.x[idx], rest, mask);
+			__m256 y = load(&spheres.y[idx], rest, mask);
+			__m256 z = load(&spheres.z[idx], rest, mask);
+			__m256 r = _mm256_xor_ps(load(&spheres.radius[idx], rest, mask), _mm256_set1_ps(-0.0f));
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (auto const& lane : lanes) {
+				__m256 dist = _mm256_fmadd_ps(lane.nx, x, _mm256_fmadd_ps(lane.ny, y, _mm256_fmadd_ps(lane.nz, z, lane.d)));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, r, _CMP_GE_OQ));
+			}
+			return _mm256_movemask_ps(inside);
+		});
+	}
+
+	size_t const CFFrustum::cull(SBoundingBoxes const& boxes, std::vector<unsigned int>& visible) const {
+		SPlaneLanes lanes[PLANE_CNT];
+		for (unsigned int idx = 0U; idx < PLANE_CNT; ++idx) {
+			CFVector3 n = m_planes[idx].normal();
+			lanes[idx].nx = _mm256_set1_ps(n.x);
+			lanes[idx].ny = _mm256_set1_ps(n.y);
+			lanes[idx].nz = _mm256_set1_ps(n.z);
+			lanes[idx].d = _mm256_set1_ps(m_planes[idx].getDValue());
+			lanes[idx].ax = _mm256_set1_ps(fabsf(n.x));
+			lanes[idx].ay = _mm256_set1_ps(fabsf(n.y));
+			lanes[idx].az = _mm256_set1_ps(fabsf(n.z));
+		}
+
+		return cull_impl(boxes.count, visible, [&](size_t const& idx, size_t const& rest) {
+			__m256i mask = tail_mask(rest);
+			__m256 x = load(&boxes.x[idx], rest, mask);
+			__m256 y = load(&boxes.y[idx], rest, mask);
+			__m256 z = load(&boxes.z[idx], rest, mask);
+			__m256 ex = load(&boxes.ex[idx], rest, mask);
+			__m256 ey = load(&boxes.ey[idx], rest, mask);
+			__m256 ez = load(&boxes.ez[idx], rest, mask);
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (auto const& lane : lanes) {
+				// 中心の符号付き距離に、法線方向へ射影した箱の半径を足す
+				__m256 dist = _mm256_fmadd_ps(lane.nx, x, _mm256_fmadd_ps(lane.ny, y, _mm256_fmadd_ps(lane.nz, z, lane.d)));
+				__m256 r = _mm256_fmadd_ps(lane.ax, ex, _mm256_fmadd_ps(lane.ay, ey, _mm256_mul_ps(lane.az, ez)));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, r), _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+			return _mm256_movemask_ps(inside);
+		});
+	}
+}
\ No newline at end of file
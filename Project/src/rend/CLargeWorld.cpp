@@ -0,0 +1,82 @@
+﻿/**	@file	CLargeWorld.cpp
+ *	@brief	広大な空間に配置された物体群
+ */
+#include "rend/CLargeWorld.hpp"
+#include <immintrin.h>
+
+namespace dlav {
+	CLargeWorld::CLargeWorld() noexcept :
+		m_positions(),
+		m_bases(),
+		m_relatives()
+	{}
+
+	void CLargeWorld::reserve(size_t const& count) {
+		m_positions.reserve(count);
+		m_bases.reserve(count);
+		m_relatives.reserve(count);
+	}
+
+	size_t const CLargeWorld::add(CDVector3 const& pos, CFMatrix4x4 const& basis) {
+		m_positions.push_back(pos);
+		m_bases.push_back(basis);
+		m_relatives.push_back(UNIT_FMTX4x4);
+		return m_positions.size() - 1U;
+	}
+
+	void CLargeWorld::position(size_t const& idx, CDVector3 const& arg) noexcept {
+		m_positions[idx] = arg;
+	}
+
+	CDVector3 const& CLargeWorld::position(size_t const& idx) const noexcept {
+		return m_positions[idx];
+	}
+
+	void CLargeWorld::basis(size_t const& idx, CFMatrix4x4 const& arg) noexcept {
+		m_bases[idx] = arg;
+	}
+
+	CFMatrix4x4 const& CLargeWorld::basis(size_t const& idx) const noexcept {
+		return m_bases[idx];
+	}
+
+	size_t const CLargeWorld::size() const noexcept {
+		return m_positions.size();
+	}
+
+	void CLargeWorld::rebase(EHandSide const& hs, CDVector3 const& origin) noexcept {
+		__m256d base = _mm256_load_pd(origin.p);
+		__m128 unit = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+		size_t count = m_positions.size();
+		CDVector3 const* pos = m_positions.data();
+		CFMatrix4x4 const* src = m_bases.data();
+		CFMatrix4x4* dst = m_relatives.data();
+
+		switch (hs) {
+		case EHandSide::LHS:
+			// 平行移動成分は第四列に置く
+			for (size_t idx = 0U; idx < count; ++idx) {
+				__m128 rel = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_load_pd(pos[idx].p), base));
+				_mm_store_ps(&dst[idx].p[0], _mm_blend_ps(_mm_load_ps(&src[idx].p[0]), _mm_shuffle_ps(rel, rel, _MM_SHUFFLE(0, 0, 0, 0)), 0x8));
+				_mm_store_ps(&dst[idx].p[4], _mm_blend_ps(_mm_load_ps(&src[idx].p[4]), _mm_shuffle_ps(rel, rel, _MM_SHUFFLE(1, 1, 1, 1)), 0x8));
+				_mm_store_ps(&dst[idx].p[8], _mm_blend_ps(_mm_load_ps(&src[idx].p[8]), _mm_shuffle_ps(rel, rel, _MM_SHUFFLE(2, 2, 2, 2)), 0x8));
+				_mm_store_ps(&dst[idx].p[12], unit);
+			}
+			break;
+		case EHandSide::RHS:
+			// 平行移動成分は第四行に置く
+			for (size_t idx = 0U; idx < count; ++idx) {
+				__m128 rel = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_load_pd(pos[idx].p), base));
+				_mm_store_ps(&dst[idx].p[0], _mm_blend_ps(_mm_load_ps(&src[idx].p[0]), _mm_setzero_ps(), 0x8));
+				_mm_store_ps(&dst[idx].p[4], _mm_blend_ps(_mm_load_ps(&src[idx].p[4]), _mm_setzero_ps(), 0x8));
+				_mm_store_ps(&dst[idx].p[8], _mm_blend_ps(_mm_load_ps(&src[idx].p[8]), _mm_setzero_ps(), 0x8));
+				_mm_store_ps(&dst[idx].p[12], _mm_blend_ps(rel, unit, 0x8));
+			}
+			break;
+		}
+	}
+
+	CFMatrix4x4 const* const CLargeWorld::relative() const noexcept {
+		return m_relatives.data();
+	}
+}
\ No newline at end of file
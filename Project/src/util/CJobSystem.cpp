@@ -0,0 +1,130 @@
+﻿/**	@file	CJobSystem.cpp
+ *	@brief	並列処理用のジョブシステム
+ */
+#include "util/CJobSystem.hpp"
+
+namespace dlav {
+	namespace {
+		//!	@brief	このスレッドが区間を処理中か否か (入れ子の parallel_for の判定用)
+		thread_local bool in_job = false;
+	}
+
+	CJobSystem::CJobSystem() noexcept :
+		ISingleton<CJobSystem>(),
+		m_threads(),
+		m_dispatch(),
+		m_mutex(),
+		m_wake(),
+		m_done(),
+		m_func(nullptr),
+		m_count(0U),
+		m_grain(1U),
+		m_next(0U),
+		m_active(0U),
+		m_generation(0U),
+		m_quit(false)
+	{}
+
+	CJobSystem::~CJobSystem() noexcept {
+		uninit();
+	}
+
+	bool const CJobSystem::init(unsigned int const& count) noexcept {
+		uninit();
+		unsigned int num = count;
+		if (num == 0U) {
+			unsigned int hw = std::thread::hardware_concurrency();
+			num = hw > 1U ? hw - 1U : 0U;
+		}
+		try {
+			m_threads.reserve(num);
+			for (unsigned int idx = 0U; idx < num; ++idx) {
+				m_threads.emplace_back(&CJobSystem::work, this);
+			}
+		}
+		catch (...) {
+			uninit();
+			return false;
+		}
+		return true;
+	}
+
+	void CJobSystem::uninit() noexcept {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wake.notify_all();
+		for (auto& thread : m_threads) {
+			thread.join();
+		}
+		m_threads.clear();
+		m_quit = false;
+	}
+
+	unsigned int const CJobSystem::concurrency() const noexcept {
+		return static_cast<unsigned int>(m_threads.size()) + 1U;
+	}
+
+	void CJobSystem::parallel_for(size_t const& count, size_t const& grain, FRange const& func) noexcept {
+		size_t step = grain > 0U ? grain : 1U;
+		// 区間の処理中に呼ばれた場合は m_dispatch を取れず、ワーカーも空かない為、その場で逐次処理する
+		if (m_threads.empty() || count <= step || in_job) {
+			for (size_t idx = 0U; idx < count; idx += step) {
+				func(idx, idx + step < count ? idx + step : count);
+			}
+			return;
+		}
+
+		std::lock_guard<std::mutex> dispatch(m_dispatch);
+		{
+			// 前のジョブから抜け切っていないワーカーが状態を読まないよう待つ
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_done.wait(lock, [this] { return m_active == 0U; });
+			m_func = &func;
+			m_count = count;
+			m_grain = step;
+			m_next.store(0U);
+			++m_generation;
+		}
+		m_wake.notify_all();
+		drain();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_active == 0U; });
+		m_func = nullptr;
+	}
+
+	void CJobSystem::work() noexcept {
+		unsigned long long seen = 0U;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this, &seen] { return m_quit || m_generation != seen; });
+				if (m_quit) {
+					return;
+				}
+				seen = m_generation;
+				++m_active;
+			}
+			drain();
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				--m_active;
+			}
+			m_done.notify_all();
+		}
+	}
+
+	void CJobSystem::drain() noexcept {
+		in_job = true;
+		for (;;) {
+			size_t begin = m_next.fetch_add(m_grain);
+			if (begin >= m_count) {
+				break;
+			}
+			(*m_func)(begin, begin + m_grain < m_count ? begin + m_grain : m_count);
+		}
+		in_job = false;
+	}
+}
\ No newline at end of file